@@ -0,0 +1,99 @@
+/**
+ * @file
+ * @brief      Benchmark of the pattern-based colorizing against searching each keyword separately
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsoleColorize.hpp"
+
+#include "BenchmarkHelpers.hpp"
+
+#include <cstdio>
+#include <string>
+
+using namespace ColorConsole;
+
+static void printThroughput( double nsPerIteration, std::size_t size )
+{
+    std::printf( "%-40s %12.2f GB/s\n", "", static_cast<double>( size ) / nsPerIteration );
+}
+
+static std::string repeat( std::string_view pattern, std::size_t size )
+{
+    std::string text;
+    text.reserve( size + pattern.size() );
+    while( text.size() < size )
+    {
+        text += pattern;
+    }
+    return text;
+}
+
+int main( int argc, const char* argv[] )
+{
+    const unsigned long iterations = 200;
+    const std::size_t size = 1024 * 1024;
+    const std::size_t chunkSize = 64 * 1024;
+
+    const std::vector<ColorizeRule> keywords = { { "FATAL", Color::FG_LIGHT_MAGENTA }, { "ERROR", Color::FG_LIGHT_RED },
+                                                 { "WARNING", Color::FG_YELLOW }, { "WARN", Color::FG_YELLOW },
+                                                 { "INFO", Color::FG_LIGHT_GREEN }, { "DEBUG", Color::FG_DARK_GREY } };
+    const std::vector<ColorizeRule> shapes = { { std::string( Colorizer::IPV4_SHAPE ), Color::FG_LIGHT_CYAN },
+                                               { std::string( Colorizer::UUID_SHAPE ), Color::FG_LIGHT_BLUE } };
+
+    const std::string log = repeat( "2020-10-19 12:00:01 INFO  [worker-7] request 123e4567-e89b-12d3-a456-426614174000 "
+                                    "from 192.168.1.20 served in 12 ms\n"
+                                    "2020-10-19 12:00:02 WARN  [worker-3] slow response from upstream service, retrying\n", size );
+
+    const Colorizer keywordColorizer( keywords );
+    const Colorizer fullColorizer( keywords, shapes );
+
+    volatile std::size_t sink = 0;
+
+    auto scan = [&]( const Colorizer &colorizer )
+    {
+        std::size_t colorized = 0;
+        ColorizeScanner scanner( colorizer, [&colorized]( std::string_view text, std::optional<Color> color )
+        {
+            colorized += color.has_value() ? text.size() : 0;
+        } );
+
+        for( std::size_t i = 0; i < log.size(); i += chunkSize )
+        {
+            scanner.process( std::string_view( log ).substr( i, chunkSize ) );
+        }
+        scanner.finish();
+
+        sink = sink + colorized;
+    };
+
+    printThroughput( runBenchmark( "ColorizeScanner (keywords)", iterations, [&]( unsigned long )
+    {
+        scan( keywordColorizer );
+    } ), log.size() );
+
+    printThroughput( runBenchmark( "ColorizeScanner (keywords and shapes)", iterations, [&]( unsigned long )
+    {
+        scan( fullColorizer );
+    } ), log.size() );
+
+    // Baseline: one pass per keyword
+    printThroughput( runBenchmark( "std::string::find per keyword", iterations, [&]( unsigned long )
+    {
+        std::size_t colorized = 0;
+        for( const ColorizeRule &rule : keywords )
+        {
+            for( std::size_t position = log.find( rule.pattern ); position != std::string::npos;
+                 position = log.find( rule.pattern, position + rule.pattern.size() ) )
+            {
+                colorized += rule.pattern.size();
+            }
+        }
+        sink = sink + colorized;
+    } ), log.size() );
+
+    return 0;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file
+ * @brief      Helper functions for the ColorConsoleLib benchmarks
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLE_BENCHMARKHELPERS_HPP
+#define COLORCONSOLE_BENCHMARKHELPERS_HPP
+
+#include <chrono>
+#include <cstdio>
+#include <streambuf>
+
+/**
+ * Stream buffer that discards everything written into it, counting the bytes.
+ */
+class NullStreamBuf : public std::streambuf
+{
+public:
+    NullStreamBuf()
+    {
+        setp( m_buffer, m_buffer + sizeof(m_buffer) );
+    }
+
+    unsigned long long bytes() const
+    {
+        return m_bytes + static_cast<unsigned long long>( pptr() - pbase() );
+    }
+
+protected:
+    int_type overflow( int_type c ) override
+    {
+        m_bytes += static_cast<unsigned long long>( pptr() - pbase() );
+        setp( m_buffer, m_buffer + sizeof(m_buffer) );
+        if( !traits_type::eq_int_type( c, traits_type::eof() ) )
+        {
+            sputc( traits_type::to_char_type( c ) );
+        }
+        return traits_type::not_eof( c );
+    }
+
+private:
+    char m_buffer[4096];
+    unsigned long long m_bytes = 0;
+};
+
+/**
+ * Runs a benchmark and prints the time per iteration.
+ *
+ * @param[in] name Benchmark name
+ * @param[in] iterations Number of iterations
+ * @param[in] function Function to run on each iteration (receives the iteration index)
+ * @return Nanoseconds per iteration
+ */
+template<class Function>
+double runBenchmark( const char *name, unsigned long iterations, Function &&function )
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for( unsigned long i = 0; i < iterations; i++ )
+    {
+        function( i );
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    double nsPerIteration = std::chrono::duration<double, std::nano>( end - start ).count() / iterations;
+
+    std::printf( "%-40s %12.1f ns/iter\n", name, nsPerIteration );
+
+    return nsPerIteration;
+}
+
+#endif // header guard
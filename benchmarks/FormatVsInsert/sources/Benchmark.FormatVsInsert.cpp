@@ -0,0 +1,51 @@
+/**
+ * @file
+ * @brief      Benchmark of Console::print() against the equivalent chain of insertions
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsole.hpp"
+
+#include "BenchmarkHelpers.hpp"
+
+#include <iomanip>
+#include <string>
+
+using namespace ColorConsole;
+
+int main( int argc, const char* argv[] )
+{
+    const unsigned long iterations = 1000000;
+    const std::string path = "/var/log/service/requests.log";
+    const char *message = "permission denied";
+
+    NullStreamBuf insertBuffer;
+    Console insertConsole( &insertBuffer );
+
+    runBenchmark( "operator<< chain", iterations, [&]( unsigned long i )
+    {
+        insertConsole << Color::FG_LIGHT_RED << "E" << Color::RESET << " "
+                      << Color::FG_DARK_GREY << path << Color::RESET << ":"
+                      << std::setw( 8 ) << i << ": " << message << '\n';
+    } );
+
+#ifdef COLORCONSOLE_HAS_FORMAT
+    NullStreamBuf printBuffer;
+    Console printConsole( &printBuffer );
+
+    runBenchmark( "Console::print", iterations, [&]( unsigned long i )
+    {
+        printConsole.print( "{} {}:{:>8}: {}\n", styled( "E", Color::FG_LIGHT_RED ),
+                            styled( path, Color::FG_DARK_GREY ), i, message );
+    } );
+
+    std::printf( "Bytes written: operator<< = %llu, print = %llu\n", insertBuffer.bytes(), printBuffer.bytes() );
+#else
+    std::printf( "Console::print not available (std::format is not supported by the standard library)\n" );
+#endif
+
+    return 0;
+}
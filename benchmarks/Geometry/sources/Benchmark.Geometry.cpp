@@ -0,0 +1,47 @@
+/**
+ * @file
+ * @brief      Benchmark of the cached terminal size against querying it on each use
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsoleGeometry.hpp"
+
+#include "BenchmarkHelpers.hpp"
+
+#include <cstdio>
+
+#if !defined(_WIN32)
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+using namespace ColorConsole;
+
+int main( int argc, const char* argv[] )
+{
+    const unsigned long iterations = 1000000;
+
+    volatile unsigned int sink = 0;
+
+    TerminalGeometry &geometry = TerminalGeometry::for_console_type( ConsoleType::STD_OUTPUT );
+    std::printf( "Standard output is %sa terminal\n", geometry.is_terminal() ? "" : "not " );
+
+    runBenchmark( "TerminalGeometry::get_size", iterations, [&]( unsigned long )
+    {
+        sink = sink + geometry.get_size().columns;
+    } );
+
+#if !defined(_WIN32)
+    runBenchmark( "ioctl(TIOCGWINSZ)", iterations, [&]( unsigned long )
+    {
+        struct winsize windowSize = {};
+        ioctl( STDOUT_FILENO, TIOCGWINSZ, &windowSize );
+        sink = sink + windowSize.ws_col;
+    } );
+#endif
+
+    return 0;
+}
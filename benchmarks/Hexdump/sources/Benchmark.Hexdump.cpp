@@ -0,0 +1,93 @@
+/**
+ * @file
+ * @brief      Benchmark of the hexadecimal dumps against per-byte insertions
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleHexdump.hpp"
+
+#include "BenchmarkHelpers.hpp"
+
+#include <cstdio>
+#include <iomanip>
+#include <vector>
+
+using namespace ColorConsole;
+
+static void printThroughput( double nsPerIteration, std::size_t size )
+{
+    std::printf( "%-40s %12.1f MB/s\n", "", static_cast<double>( size ) * 1000.0 / nsPerIteration );
+}
+
+static Color byteColor( unsigned char byte )
+{
+    return ( byte == 0 ) ? Color::FG_DARK_GREY :
+           ( byte >= 0x80 ) ? Color::FG_YELLOW :
+           ( ( byte >= 0x20 ) && ( byte < 0x7F ) ) ? Color::FG_LIGHT_CYAN : Color::FG_LIGHT_GREEN;
+}
+
+int main( int argc, const char* argv[] )
+{
+    const unsigned long iterations = 20;
+    const std::size_t size = 1024 * 1024;
+
+    // Protocol-like frames: headers with small integers, zero padding and text payloads
+    std::vector<unsigned char> data( size );
+    for( std::size_t i = 0; i < size; i++ )
+    {
+        const std::size_t position = i % 256;
+        data[i] = ( position < 16 ) ? static_cast<unsigned char>( ( i * 131 ) >> 3 ) :
+                  ( position < 64 ) ? 0 :
+                  static_cast<unsigned char>( "GET /api/v1/frames?id=42 HTTP/1.1\r\n"[position % 35] );
+    }
+
+    NullStreamBuf insertBuffer;
+    Console insertConsole( &insertBuffer, true );
+
+    // Baseline: each byte inserted with its color
+    printThroughput( runBenchmark( "operator<< per byte", iterations, [&]( unsigned long )
+    {
+        insertConsole << std::hex << std::setfill( '0' );
+        for( std::size_t line = 0; line < size; line += 16 )
+        {
+            insertConsole << Color::RESET << std::setw( 8 ) << line << ' ';
+            for( std::size_t i = line; i < line + 16; i++ )
+            {
+                insertConsole << byteColor( data[i] ) << ' ' << std::setw( 2 ) << static_cast<unsigned int>( data[i] );
+            }
+            insertConsole << Color::RESET << "  |";
+            for( std::size_t i = line; i < line + 16; i++ )
+            {
+                const bool printable = ( data[i] >= 0x20 ) && ( data[i] < 0x7F );
+                insertConsole << byteColor( data[i] ) << ( printable ? static_cast<char>( data[i] ) : '.' );
+            }
+            insertConsole << Color::RESET << "|\n";
+        }
+        insertConsole << std::dec;
+    } ), size );
+
+    NullStreamBuf dumpBuffer;
+    Console dumpConsole( &dumpBuffer, true );
+
+    printThroughput( runBenchmark( "hexdump", iterations, [&]( unsigned long )
+    {
+        hexdump( dumpConsole, std::as_bytes( std::span( data.data(), data.size() ) ) );
+    } ), size );
+
+    NullStreamBuf plainBuffer;
+    Console plainConsole( &plainBuffer, false );
+
+    printThroughput( runBenchmark( "hexdump (no colors)", iterations, [&]( unsigned long )
+    {
+        hexdump( plainConsole, std::as_bytes( std::span( data.data(), data.size() ) ) );
+    } ), size );
+
+    std::printf( "Bytes written: operator<< = %llu, hexdump = %llu\n", insertBuffer.bytes() / iterations,
+                 dumpBuffer.bytes() / iterations );
+
+    return 0;
+}
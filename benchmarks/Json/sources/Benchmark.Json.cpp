@@ -0,0 +1,147 @@
+/**
+ * @file
+ * @brief      Benchmark of the streaming JSON pretty printer against regular expression coloring
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleJson.hpp"
+
+#include "BenchmarkHelpers.hpp"
+
+#include <cstdio>
+#include <regex>
+#include <string>
+
+using namespace ColorConsole;
+
+static void printThroughput( double nsPerIteration, std::size_t size )
+{
+    std::printf( "%-40s %12.1f MB/s\n", "", static_cast<double>( size ) * 1000.0 / nsPerIteration );
+}
+
+/**
+ * Pretty prints compact JSON without validating it, as usually done before coloring it.
+ */
+static std::string indentJson( const std::string &text )
+{
+    std::string result;
+    std::size_t depth = 0;
+    bool inString = false;
+
+    for( std::size_t i = 0; i < text.size(); i++ )
+    {
+        const char c = text[i];
+        result.push_back( c );
+        if( inString )
+        {
+            if( c == '\\' )
+            {
+                result.push_back( text[++i] );
+            }
+            else if( c == '"' )
+            {
+                inString = false;
+            }
+            continue;
+        }
+
+        switch( c )
+        {
+            case '"':
+                inString = true;
+                break;
+
+            case '{':
+            case '[':
+                result.push_back( '\n' );
+                result.append( 2 * ++depth, ' ' );
+                break;
+
+            case '}':
+            case ']':
+                result.pop_back();
+                result.push_back( '\n' );
+                result.append( 2 * --depth, ' ' );
+                result.push_back( c );
+                break;
+
+            case ',':
+                result.push_back( '\n' );
+                result.append( 2 * depth, ' ' );
+                break;
+
+            case ':':
+                result.push_back( ' ' );
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return result;
+}
+
+int main( int argc, const char* argv[] )
+{
+    const std::size_t size = 1024 * 1024;
+
+    // Compact JSON records with long strings, as returned by web APIs
+    std::string text = "[";
+    for( unsigned int id = 0; text.size() < size; id++ )
+    {
+        text += "{\"id\":" + std::to_string( id ) + ",\"name\":\"record " + std::to_string( id ) +
+                "\",\"active\":" + ( ( id % 3 ) ? "true" : "false" ) + ",\"score\":" + std::to_string( id * 0.37 ) +
+                ",\"tags\":[\"alpha\",\"beta\"],\"parent\":null,\"description\":\"The quick brown fox jumps over the lazy dog, "
+                "then \\\"rests\\\" in the shade of an old tree near the river bank.\"},";
+    }
+    text.back() = ']';
+
+    NullStreamBuf regexBuffer;
+    Console regexConsole( &regexBuffer, true );
+
+    const std::regex keys( "(\"(?:[^\"\\\\]|\\\\.)*\")(?=:)" );
+    const std::regex strings( "(: |\\n +)(\"(?:[^\"\\\\]|\\\\.)*\")" );
+    const std::regex literals( "\\b(true|false|null|-?\\d+(?:\\.\\d+)?(?:[eE][+-]?\\d+)?)\\b" );
+
+    // Baseline: indented and then colored with regular expressions
+    printThroughput( runBenchmark( "indent + std::regex_replace", 2, [&]( unsigned long )
+    {
+        std::string result = indentJson( text );
+        result = std::regex_replace( result, keys, "\033[49;1;34m$1\033[0m" );
+        result = std::regex_replace( result, strings, "$1\033[49;1;32m$2\033[0m" );
+        result = std::regex_replace( result, literals, "\033[49;1;33m$1\033[0m" );
+        regexConsole.write_raw( result );
+    } ), text.size() );
+
+    NullStreamBuf printerBuffer;
+    Console printerConsole( &printerBuffer, true );
+    JsonPrinter printer( printerConsole );
+
+    printThroughput( runBenchmark( "JsonPrinter", 20, [&]( unsigned long )
+    {
+        for( std::size_t i = 0; i < text.size(); i += 64 * 1024 )
+        {
+            printer.process( std::string_view( text ).substr( i, 64 * 1024 ) );
+        }
+        printer.finish();
+    } ), text.size() );
+
+    NullStreamBuf plainBuffer;
+    Console plainConsole( &plainBuffer, false );
+    JsonPrinter plainPrinter( plainConsole );
+
+    printThroughput( runBenchmark( "JsonPrinter (no colors)", 20, [&]( unsigned long )
+    {
+        plainPrinter.process( text );
+        plainPrinter.finish();
+    } ), text.size() );
+
+    std::printf( "Bytes written: regex = %llu, JsonPrinter = %llu\n", regexBuffer.bytes() / 2, printerBuffer.bytes() / 20 );
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file
+ * @brief      Benchmark of the untrusted text sanitizer against a plain copy
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleSanitizer.hpp"
+
+#include "BenchmarkHelpers.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace ColorConsole;
+
+static void printThroughput( double nsPerIteration, std::size_t size )
+{
+    std::printf( "%-40s %12.2f GB/s\n", "", static_cast<double>( size ) / nsPerIteration );
+}
+
+int main( int argc, const char* argv[] )
+{
+    const unsigned long iterations = 2000;
+    const std::size_t size = 1024 * 1024;
+
+    std::string text;
+    text.reserve( size );
+    while( text.size() < size )
+    {
+        text += "GET /api/v1/users/12345/profile?fields=name,email HTTP/1.1\tuser=alice\n";
+    }
+    text.resize( size );
+
+    std::vector<char> copy( size );
+    volatile std::size_t sink = 0;
+
+    printThroughput( runBenchmark( "memcpy (1 MiB clean ASCII)", iterations, [&]( unsigned long )
+    {
+        std::memcpy( copy.data(), text.data(), size );
+        sink = sink + static_cast<unsigned char>( copy[size / 2] );
+    } ), size );
+
+    printThroughput( runBenchmark( "findUnsafeSequence (1 MiB clean ASCII)", iterations, [&]( unsigned long )
+    {
+        sink = sink + findUnsafeSequence( text ).position;
+    } ), size );
+
+    NullStreamBuf plainBuffer;
+    Console plainConsole( &plainBuffer );
+
+    printThroughput( runBenchmark( "Console insertion", iterations, [&]( unsigned long )
+    {
+        plainConsole << text;
+    } ), size );
+
+    NullStreamBuf sanitizedBuffer;
+    Console sanitizedConsole( &sanitizedBuffer );
+    sanitizedConsole.set_sanitize_mode( SanitizeMode::ESCAPE );
+
+    printThroughput( runBenchmark( "Console sanitized insertion", iterations, [&]( unsigned long )
+    {
+        sanitizedConsole << text;
+    } ), size );
+
+    return 0;
+}
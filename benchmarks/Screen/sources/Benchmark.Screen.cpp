@@ -0,0 +1,105 @@
+/**
+ * @file
+ * @brief      Benchmark of the bytes per frame written by the double-buffered screen
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleScreen.hpp"
+
+#include "BenchmarkHelpers.hpp"
+
+#include <cstdio>
+#include <string>
+
+using namespace ColorConsole;
+
+static constexpr std::size_t COLUMNS = 120;
+static constexpr std::size_t ROWS = 40;
+
+static const SgrStyle LABEL_STYLE = SgrStyle::from_color( Color::FG_WHITE );
+static const SgrStyle VALUE_STYLE = SgrStyle::from_color( Color::FG_LIGHT_GREEN );
+static const SgrStyle ALERT_STYLE = SgrStyle::from_color( Color::FG_WHITE | Color::BG_DARK_RED );
+
+/**
+ * Draws a dashboard of 4 columns of labeled values, where @p changes values change on each frame.
+ */
+static void drawDashboard( Screen &screen, unsigned long frame, unsigned int changes )
+{
+    for( std::size_t row = 1; row < ROWS; row++ )
+    {
+        for( std::size_t panel = 0; panel < 4; panel++ )
+        {
+            const std::size_t index = ( row - 1 ) * 4 + panel;
+            const unsigned long value = ( index < changes ) ? ( frame * 7 + index ) % 1000 : index;
+            const std::string text = std::to_string( value );
+
+            screen.print( row, panel * 30, "metric " + std::to_string( index ), LABEL_STYLE );
+            screen.print( row, panel * 30 + 14, "      ", VALUE_STYLE );
+            screen.print( row, panel * 30 + 20 - text.size(), text, ( value > 900 ) ? ALERT_STYLE : VALUE_STYLE );
+        }
+    }
+
+    screen.print( 0, 0, "Dashboard - frame " + std::to_string( frame ), LABEL_STYLE );
+}
+
+static void benchmarkScreen( const char *name, unsigned int changes )
+{
+    const unsigned long frames = 2000;
+    NullStreamBuf buffer;
+    Console console( &buffer, true );
+    unsigned long long bytes = 0;
+
+    {
+        Screen screen( console, COLUMNS, ROWS );
+        drawDashboard( screen, 0, changes );
+        screen.present();
+
+        runBenchmark( name, frames, [&]( unsigned long frame )
+        {
+            drawDashboard( screen, frame + 1, changes );
+            bytes += screen.present();
+        } );
+    }
+
+    std::printf( "%-40s %12.1f bytes/frame\n", "", static_cast<double>( bytes ) / frames );
+}
+
+int main( int argc, const char* argv[] )
+{
+    // Baseline: repainting the whole screen through the console on each frame
+    const unsigned long frames = 2000;
+    NullStreamBuf buffer;
+    Console console( &buffer, true );
+
+    runBenchmark( "Full repaint through Console", frames, [&]( unsigned long frame )
+    {
+        console.write_raw( "\033[H" );
+        console << Color::FG_WHITE << "Dashboard - frame " << frame << ColorConsole::endl;
+
+        for( std::size_t row = 1; row < ROWS; row++ )
+        {
+            for( std::size_t panel = 0; panel < 4; panel++ )
+            {
+                const std::size_t index = ( row - 1 ) * 4 + panel;
+                const unsigned long value = ( frame * 7 + index ) % 1000;
+                console << Color::FG_WHITE << "metric " << index << "  "
+                        << ( ( value > 900 ) ? ( Color::FG_WHITE | Color::BG_DARK_RED ) : Color::FG_LIGHT_GREEN ) << value
+                        << Color::RESET << "          ";
+            }
+            console << ColorConsole::endl;
+        }
+    } );
+
+    std::printf( "%-40s %12.1f bytes/frame\n", "", static_cast<double>( buffer.bytes() ) / frames );
+
+    benchmarkScreen( "Screen: clock only", 0 );
+    benchmarkScreen( "Screen: 8 values change", 8 );
+    benchmarkScreen( "Screen: 40 values change", 40 );
+    benchmarkScreen( "Screen: all values change", 160 );
+
+    return 0;
+}
@@ -0,0 +1,22 @@
+/**
+ * @file
+ * @brief      Program using the ColorConsoleLib global consoles, used by the startup benchmark
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleW.hpp"
+
+int main( int argc, const char* argv[] )
+{
+    // Reference the global consoles (without writing into them), so that their references are bound at startup
+    volatile const void *consoles[] = { &ColorConsole::cout, &ColorConsole::cerr, &ColorConsole::wcout, &ColorConsole::wcerr };
+    (void) consoles;
+    (void) argc;
+    (void) argv;
+
+    return 0;
+}
@@ -0,0 +1,13 @@
+/**
+ * @file
+ * @brief      Empty program, used as reference by the startup benchmark
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+int main()
+{
+    return 0;
+}
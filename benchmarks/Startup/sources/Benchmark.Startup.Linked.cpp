@@ -0,0 +1,25 @@
+/**
+ * @file
+ * @brief      Empty program linked with ColorConsoleLib, used by the startup benchmark
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleW.hpp"
+
+int main( int argc, const char* argv[] )
+{
+    // Reference the accessors of the global consoles (without calling them) so that they are linked
+    volatile const void *consoles[] = { reinterpret_cast<const void*>( &ColorConsole::Console::get_cout ),
+                                        reinterpret_cast<const void*>( &ColorConsole::Console::get_cerr ),
+                                        reinterpret_cast<const void*>( &ColorConsole::ConsoleW::get_wcout ),
+                                        reinterpret_cast<const void*>( &ColorConsole::ConsoleW::get_wcerr ) };
+    (void) consoles;
+    (void) argc;
+    (void) argv;
+
+    return 0;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file
+ * @brief      Benchmark of the startup time of a program linked with ColorConsoleLib against an empty program
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "BenchmarkHelpers.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef WIN32
+#include <process.h>
+#else
+#include <spawn.h>
+#include <sys/wait.h>
+#endif
+
+static void runProgram( const char *path )
+{
+#ifdef WIN32
+    if( _spawnl( _P_WAIT, path, path, NULL ) != 0 )
+#else
+    char *argv[] = { const_cast<char*>( path ), NULL };
+    char *envp[] = { NULL };
+    pid_t pid;
+    int status = -1;
+
+    if( ( posix_spawn( &pid, path, NULL, NULL, argv, envp ) != 0 ) || ( waitpid( pid, &status, 0 ) != pid ) ||
+        ( status != 0 ) )
+#endif
+    {
+        std::fprintf( stderr, "Error running %s\n", path );
+        std::exit( EXIT_FAILURE );
+    }
+}
+
+int main( int argc, const char* argv[] )
+{
+    const unsigned long iterations = ( argc > 1 ) ? std::strtoul( argv[1], NULL, 10 ) : 500;
+
+    // Warm up the file system caches
+    runProgram( STARTUP_EMPTY_PROGRAM );
+    runProgram( STARTUP_LINKED_PROGRAM );
+    runProgram( STARTUP_COUT_PROGRAM );
+
+    double empty = runBenchmark( "main(){} without ColorConsoleLib", iterations, []( unsigned long )
+    {
+        runProgram( STARTUP_EMPTY_PROGRAM );
+    } );
+
+    double linked = runBenchmark( "main(){} with ColorConsoleLib", iterations, []( unsigned long )
+    {
+        runProgram( STARTUP_LINKED_PROGRAM );
+    } );
+
+    double cout = runBenchmark( "main(){} using ColorConsole::cout", iterations, []( unsigned long )
+    {
+        runProgram( STARTUP_COUT_PROGRAM );
+    } );
+
+    std::printf( "%-40s %12.1f ns/iter\n", "Startup overhead", linked - empty );
+    std::printf( "%-40s %12.1f ns/iter\n", "Startup overhead using cout", cout - empty );
+
+#ifdef STARTUP_SHARED_PROGRAM
+    runProgram( STARTUP_SHARED_PROGRAM );
+
+    double shared = runBenchmark( "main(){} using cout (shared library)", iterations, []( unsigned long )
+    {
+        runProgram( STARTUP_SHARED_PROGRAM );
+    } );
+
+    std::printf( "%-40s %12.1f ns/iter\n", "Startup overhead (shared library)", shared - empty );
+#endif
+
+    return 0;
+}
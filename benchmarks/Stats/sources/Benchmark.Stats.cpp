@@ -0,0 +1,62 @@
+/**
+ * @file
+ * @brief      Benchmark of the cost of collecting output statistics
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsoleStats.hpp"
+
+#include "BenchmarkHelpers.hpp"
+
+#include <ostream>
+
+using namespace ColorConsole;
+
+int main( int argc, const char* argv[] )
+{
+    const unsigned long iterations = 1000000;
+    const char *line = "GET /index.html 200 1532 bytes";
+
+    // Stream writing directly into the target buffer (i.e. statistics disabled)
+    NullStreamBuf directBuffer;
+    std::ostream directStream( &directBuffer );
+
+    // Stream writing through the statistics wrapper (i.e. statistics enabled)
+    ConsoleStats stats;
+    NullStreamBuf statsTarget;
+    StatsStreamBuf<char> statsBuffer( stats );
+    statsBuffer.set_target( &statsTarget );
+    std::ostream statsStream( &statsBuffer );
+
+    double directChar = runBenchmark( "char insertion (direct)", iterations, [&]( unsigned long )
+    {
+        directStream << 'x';
+    } );
+
+    double statsChar = runBenchmark( "char insertion (stats)", iterations, [&]( unsigned long )
+    {
+        statsStream << 'x';
+    } );
+
+    double directString = runBenchmark( "string insertion (direct)", iterations, [&]( unsigned long )
+    {
+        directStream << line << '\n';
+    } );
+
+    double statsString = runBenchmark( "string insertion (stats)", iterations, [&]( unsigned long )
+    {
+        statsStream << line << '\n';
+    } );
+
+    ConsoleStatsSnapshot snapshot = stats.snapshot();
+
+    std::printf( "Overhead per char insertion:   %8.1f ns\n", statsChar - directChar );
+    std::printf( "Overhead per string insertion: %8.1f ns (2 writes each)\n", statsString - directString );
+    std::printf( "Writes counted: %llu, bytes written: direct = %llu, stats = %llu\n",
+                 snapshot.writes, directBuffer.bytes(), statsTarget.bytes() );
+
+    return 0;
+}
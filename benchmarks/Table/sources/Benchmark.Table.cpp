@@ -0,0 +1,129 @@
+/**
+ * @file
+ * @brief      Benchmark of the table renderer against insertions with std::setw
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleTable.hpp"
+
+#include "BenchmarkHelpers.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+using namespace ColorConsole;
+
+static constexpr unsigned long ROWS = 100000;
+
+/**
+ * Null stream buffer that counts the write calls (i.e. the system calls an unbuffered stream would make).
+ */
+class CountingStreamBuf : public NullStreamBuf
+{
+public:
+    unsigned long long writes() const
+    {
+        return m_writes;
+    }
+
+protected:
+    std::streamsize xsputn( const char_type *s, std::streamsize n ) override
+    {
+        m_writes++;
+        return NullStreamBuf::xsputn( s, n );
+    }
+
+    int_type overflow( int_type c ) override
+    {
+        m_writes++;
+        return NullStreamBuf::overflow( c );
+    }
+
+private:
+    unsigned long long m_writes = 0;
+};
+
+struct ServiceStatus
+{
+    std::string name;
+    std::string region;
+    bool up;
+    std::string latency;
+};
+
+int main( int argc, const char* argv[] )
+{
+    const char *regions[] = { "eu-west-1", "us-east-2", "ap-south-1" };
+    std::vector<ServiceStatus> services;
+    services.reserve( ROWS );
+    for( unsigned long i = 0; i < ROWS; i++ )
+    {
+        services.push_back( ServiceStatus{ "service-" + std::to_string( i ), regions[i % 3], ( i % 17 ) != 0,
+                                           std::to_string( ( i * 37 ) % 500 ) + " ms" } );
+    }
+
+    CountingStreamBuf insertBuffer;
+    Console insertConsole( &insertBuffer );
+
+    runBenchmark( "operator<< with std::setw (per row)", ROWS, [&]( unsigned long i )
+    {
+        const ServiceStatus &service = services[i];
+        insertConsole << std::left;
+        insertConsole << std::setw( 14 ) << service.name << "  ";
+        insertConsole << std::setw( 10 ) << service.region << "  ";
+        insertConsole << ( service.up ? Color::FG_LIGHT_GREEN : Color::FG_WHITE | Color::BG_DARK_RED );
+        insertConsole << std::setw( 4 ) << ( service.up ? "up" : "down" );
+        insertConsole << Color::RESET << "  ";
+        insertConsole << std::right << std::setw( 6 ) << service.latency << '\n';
+    } );
+
+    CountingStreamBuf tableBuffer;
+    Console tableConsole( &tableBuffer );
+
+    {
+        Table table( tableConsole, { { "Service" }, { "Region" }, { "Status" }, { "Latency", TableAlignment::RIGHT } } );
+        table.set_streaming( 100 );
+
+        runBenchmark( "Table (streaming, per row)", ROWS, [&]( unsigned long i )
+        {
+            const ServiceStatus &service = services[i];
+            table.add_row( { { service.name }, { service.region },
+                             { service.up ? "up" : "down", service.up ? Color::FG_LIGHT_GREEN : Color::FG_WHITE | Color::BG_DARK_RED },
+                             { service.latency } } );
+        } );
+    }
+
+    CountingStreamBuf heldBuffer;
+    Console heldConsole( &heldBuffer );
+
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        Table table( heldConsole, { { "Service" }, { "Region" }, { "Status" }, { "Latency", TableAlignment::RIGHT } } );
+        table.set_borders( TableBorders::BOX );
+
+        for( const ServiceStatus &service : services )
+        {
+            table.add_row( { { service.name }, { service.region },
+                             { service.up ? "up" : "down", service.up ? Color::FG_LIGHT_GREEN : Color::FG_WHITE | Color::BG_DARK_RED },
+                             { service.latency } } );
+        }
+        table.finish();
+
+        const double ns = std::chrono::duration<double, std::nano>( std::chrono::steady_clock::now() - start ).count();
+        std::printf( "%-40s %12.1f ns/iter\n", "Table (boxed, widths fit all rows)", ns / ROWS );
+    }
+
+    std::printf( "Bytes written: operator<< = %llu, streaming table = %llu, boxed table = %llu\n",
+                 insertBuffer.bytes(), tableBuffer.bytes(), heldBuffer.bytes() );
+    std::printf( "Write calls:   operator<< = %llu, streaming table = %llu, boxed table = %llu\n",
+                 insertBuffer.writes(), tableBuffer.writes(), heldBuffer.writes() );
+
+    return 0;
+}
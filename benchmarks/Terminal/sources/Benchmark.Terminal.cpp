@@ -0,0 +1,73 @@
+/**
+ * @file
+ * @brief      Benchmark of the end-to-end rendering of colored output into a virtual terminal
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleTerminal.hpp"
+
+#include "BenchmarkHelpers.hpp"
+
+#include <cstdio>
+
+using namespace ColorConsole;
+
+static const Color LEVEL_COLORS[] = { Color::FG_DARK_GREY, Color::FG_LIGHT_GREEN, Color::FG_YELLOW, Color::FG_LIGHT_RED | Color::BG_DARK_RED };
+static const char* const LEVEL_NAMES[] = { "DEBUG", "INFO ", "WARN ", "ERROR" };
+
+/**
+ * Writes a typical colored log line.
+ */
+static void writeLogLine( Console &console, unsigned long i )
+{
+    console << Color::FG_DARK_CYAN << "2020-06-01 12:00:00." << ( i % 1000 ) << Color::RESET << ' '
+            << LEVEL_COLORS[i % 4] << LEVEL_NAMES[i % 4] << Color::RESET
+            << " request " << i << " served in " << ( i % 97 ) << " ms" << ColorConsole::endl;
+}
+
+static void printOverhead( const TerminalStats &stats )
+{
+    const std::uint64_t escapeBytes = stats.bytes - stats.characters - stats.controls;
+
+    std::printf( "%-40s %12.1f %% escape bytes (%llu of %llu)\n", "", 100.0 * static_cast<double>( escapeBytes ) / static_cast<double>( stats.bytes ),
+                 static_cast<unsigned long long>( escapeBytes ), static_cast<unsigned long long>( stats.bytes ) );
+}
+
+int main( int argc, const char* argv[] )
+{
+    const unsigned long iterations = 200000;
+
+    NullStreamBuf nullBuffer;
+    Console nullConsole( &nullBuffer, true );
+
+    runBenchmark( "Log line (null sink)", iterations, [&]( unsigned long i )
+    {
+        writeLogLine( nullConsole, i );
+    } );
+
+    VirtualTerminal terminal( 120, 40 );
+    Console terminalConsole( &terminal, true );
+
+    runBenchmark( "Log line (virtual terminal)", iterations, [&]( unsigned long i )
+    {
+        writeLogLine( terminalConsole, i );
+    } );
+
+    printOverhead( terminal.get_stats() );
+
+    VirtualTerminal plainTerminal( 120, 40 );
+    Console plainConsole( &plainTerminal, false );
+
+    runBenchmark( "Log line (virtual terminal, no colors)", iterations, [&]( unsigned long i )
+    {
+        writeLogLine( plainConsole, i );
+    } );
+
+    printOverhead( plainTerminal.get_stats() );
+
+    return 0;
+}
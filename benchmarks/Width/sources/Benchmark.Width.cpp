@@ -0,0 +1,110 @@
+/**
+ * @file
+ * @brief      Benchmark of the display width functions against wcwidth()
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsoleWidth.hpp"
+
+#include "BenchmarkHelpers.hpp"
+
+#include <clocale>
+#include <cstdio>
+#include <cwchar>
+#include <string>
+
+using namespace ColorConsole;
+
+static void printThroughput( double nsPerIteration, std::size_t size )
+{
+    std::printf( "%-40s %12.2f GB/s\n", "", static_cast<double>( size ) / nsPerIteration );
+}
+
+static std::string repeat( std::string_view pattern, std::size_t size )
+{
+    std::string text;
+    text.reserve( size + pattern.size() );
+    while( text.size() < size )
+    {
+        text += pattern;
+    }
+    return text;
+}
+
+#ifndef _WIN32
+/**
+ * Display width computed decoding with mbrtowc() and calling wcwidth() for each code point.
+ */
+static std::size_t wcwidthLoop( std::string_view text )
+{
+    std::mbstate_t state{};
+    const char *p = text.data();
+    const char *end = p + text.size();
+    std::size_t width = 0;
+
+    while( p < end )
+    {
+        wchar_t c;
+        const std::size_t length = std::mbrtowc( &c, p, static_cast<std::size_t>( end - p ), &state );
+        if( ( length == 0 ) || ( length > static_cast<std::size_t>( end - p ) ) )
+        {
+            state = std::mbstate_t{};
+            p++;
+            continue;
+        }
+
+        const int charWidth = wcwidth( c );
+        width += ( charWidth > 0 ) ? static_cast<std::size_t>( charWidth ) : 0;
+        p += length;
+    }
+
+    return width;
+}
+#endif
+
+int main( int argc, const char* argv[] )
+{
+    const unsigned long iterations = 500;
+    const std::size_t size = 1024 * 1024;
+
+    const std::string ascii = repeat( "GET /api/v1/users/12345/profile?fields=name,email HTTP/1.1 user=alice ", size );
+    const std::string colored = repeat( "\033[49;1;32mINFO\033[0m request served in 12 ms by worker 7 ", size );
+    const std::string mixed = repeat( "café 日本語 \U0001F44D\U0001F3FD naïve résumé \U0001F1EA\U0001F1F8 ", size );
+
+    volatile std::size_t sink = 0;
+
+    printThroughput( runBenchmark( "display_width (1 MiB ASCII)", iterations, [&]( unsigned long )
+    {
+        sink = sink + display_width( ascii );
+    } ), ascii.size() );
+
+    printThroughput( runBenchmark( "display_width (1 MiB colored ASCII)", iterations, [&]( unsigned long )
+    {
+        sink = sink + display_width( colored );
+    } ), colored.size() );
+
+    printThroughput( runBenchmark( "display_width (1 MiB mixed UTF-8)", iterations, [&]( unsigned long )
+    {
+        sink = sink + display_width( mixed );
+    } ), mixed.size() );
+
+#ifndef _WIN32
+    if( std::setlocale( LC_CTYPE, "C.UTF-8" ) != nullptr )
+    {
+        printThroughput( runBenchmark( "mbrtowc + wcwidth (1 MiB ASCII)", iterations, [&]( unsigned long )
+        {
+            sink = sink + wcwidthLoop( ascii );
+        } ), ascii.size() );
+
+        printThroughput( runBenchmark( "mbrtowc + wcwidth (1 MiB mixed UTF-8)", iterations, [&]( unsigned long )
+        {
+            sink = sink + wcwidthLoop( mixed );
+        } ), mixed.size() );
+    }
+#endif
+
+    return 0;
+}
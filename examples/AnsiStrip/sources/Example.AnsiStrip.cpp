@@ -0,0 +1,144 @@
+/**
+ * @file
+ * @brief      ANSI escape sequences stripping app (ansi-strip)
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsoleAnsiStrip.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ANSI_STRIP_USE_MMAP
+#endif
+
+using namespace ColorConsole;
+
+static constexpr std::size_t READ_BLOCK_SIZE = 256 * 1024;
+
+static bool writeRun( std::string_view run )
+{
+    return ( std::fwrite( run.data(), 1, run.size(), stdout ) == run.size() );
+}
+
+static bool stripStream( std::FILE *input )
+{
+    AnsiStripper stripper;
+    std::vector<char> block( READ_BLOCK_SIZE );
+    bool ok = true;
+
+    std::size_t n;
+    while( ok && ( ( n = std::fread( block.data(), 1, block.size(), input ) ) > 0 ) )
+    {
+        stripper.process( std::string_view( block.data(), n ), [&ok]( std::string_view run ) { ok = ok && writeRun( run ); } );
+    }
+
+    return ok && !std::ferror( input );
+}
+
+#ifdef ANSI_STRIP_USE_MMAP
+static bool stripMappedFile( const char *path, bool &mapped )
+{
+    mapped = false;
+
+    int fd = open( path, O_RDONLY );
+    if( fd < 0 )
+    {
+        return false;
+    }
+
+    struct stat info;
+    if( ( fstat( fd, &info ) != 0 ) || !S_ISREG( info.st_mode ) || ( info.st_size == 0 ) )
+    {
+        close( fd );
+        return true;
+    }
+
+    const std::size_t size = static_cast<std::size_t>( info.st_size );
+    void *data = mmap( nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    close( fd );
+
+    if( data == MAP_FAILED )
+    {
+        return true;
+    }
+
+    mapped = true;
+    madvise( data, size, MADV_SEQUENTIAL );
+
+    AnsiStripper stripper;
+    bool ok = true;
+    stripper.process( std::string_view( static_cast<const char*>( data ), size ), [&ok]( std::string_view run ) { ok = ok && writeRun( run ); } );
+
+    munmap( data, size );
+
+    return ok;
+}
+#endif
+
+int main( int argc, const char* argv[] )
+{
+    if( ( argc > 2 ) || ( ( argc == 2 ) && ( std::strcmp( argv[1], "--help" ) == 0 ) ) )
+    {
+        std::fprintf( stderr, "Usage: ansi-strip [FILE]\n"
+                              "Removes the ANSI escape sequences from FILE (or the standard input) and writes the\n"
+                              "result into the standard output.\n" );
+        return ( argc > 2 ) ? 2 : 0;
+    }
+
+#if defined(_WIN32)
+    _setmode( _fileno( stdin ), _O_BINARY );
+    _setmode( _fileno( stdout ), _O_BINARY );
+#endif
+
+    std::setvbuf( stdout, nullptr, _IOFBF, READ_BLOCK_SIZE );
+
+    bool ok;
+
+    if( ( argc == 2 ) && ( std::strcmp( argv[1], "-" ) != 0 ) )
+    {
+        bool mapped = false;
+
+#ifdef ANSI_STRIP_USE_MMAP
+        ok = stripMappedFile( argv[1], mapped );
+#else
+        ok = true;
+#endif
+
+        if( ok && !mapped )
+        {
+            // Not a regular file (e.g. a pipe) or mapping not available
+            std::FILE *input = std::fopen( argv[1], "rb" );
+            ok = ( input != nullptr ) && stripStream( input );
+
+            if( input != nullptr )
+            {
+                std::fclose( input );
+            }
+        }
+
+        if( !ok )
+        {
+            std::perror( argv[1] );
+        }
+    }
+    else
+    {
+        ok = stripStream( stdin );
+    }
+
+    return ( ( std::fflush( stdout ) == 0 ) && ok ) ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file
+ * @brief      ANSI colored text to HTML conversion app (ansi2html)
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleHtml.hpp"
+#include "ColorConsoleW.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+using namespace ColorConsole;
+
+static constexpr std::size_t READ_BLOCK_SIZE = 256 * 1024;
+
+static void printUsage()
+{
+    std::fprintf( stderr, "Usage: ansi2html [--fragment] [--title TITLE] [FILE]\n"
+                          "Converts the colored text in FILE (or the standard input) into HTML and writes it into\n"
+                          "the standard output.\n"
+                          "\n"
+                          "  --fragment     Write only the converted text, without stylesheet and document\n"
+                          "  --title TITLE  Title of the document (by default, the file name)\n" );
+}
+
+static bool convertStream( std::FILE *input, HtmlConverter &converter )
+{
+    std::vector<char> block( READ_BLOCK_SIZE );
+    bool ok = true;
+
+    std::size_t n;
+    while( ok && ( ( n = std::fread( block.data(), 1, block.size(), input ) ) > 0 ) )
+    {
+        ok = converter.write( std::string_view( block.data(), n ) );
+    }
+
+    return converter.finish() && ok && !std::ferror( input );
+}
+
+int main( int argc, const char* argv[] )
+{
+    bool fragment = false;
+    const char *title = nullptr;
+    const char *path = nullptr;
+
+    for( int i = 1; i < argc; i++ )
+    {
+        if( std::strcmp( argv[i], "--help" ) == 0 )
+        {
+            printUsage();
+            return 0;
+        }
+        else if( std::strcmp( argv[i], "--fragment" ) == 0 )
+        {
+            fragment = true;
+        }
+        else if( ( std::strcmp( argv[i], "--title" ) == 0 ) && ( i + 1 < argc ) )
+        {
+            title = argv[++i];
+        }
+        else if( path == nullptr )
+        {
+            path = argv[i];
+        }
+        else
+        {
+            printUsage();
+            return 2;
+        }
+    }
+
+#if defined(_WIN32)
+    _setmode( _fileno( stdin ), _O_BINARY );
+    _setmode( _fileno( stdout ), _O_BINARY );
+#endif
+
+    const bool fromStdin = ( path == nullptr ) || ( std::strcmp( path, "-" ) == 0 );
+    std::FILE *input = fromStdin ? stdin : std::fopen( path, "rb" );
+
+    if( input == nullptr )
+    {
+        std::perror( path );
+        return 1;
+    }
+
+    // The output is HTML: the global consoles must not write a color reset when destroyed
+    ColorConsole::cout.disable_coloring();
+    ColorConsole::cerr.disable_coloring();
+    ColorConsole::wcout.disable_coloring();
+    ColorConsole::wcerr.disable_coloring();
+
+    std::ios::sync_with_stdio( false );
+    std::streambuf *output = std::cout.rdbuf();
+
+    if( !fragment )
+    {
+        const std::string head = "<!DOCTYPE html>\n<html>\n<head>\n<meta charset=\"utf-8\">\n<title>" +
+                                 HtmlConverter::convert( ( title != nullptr ) ? title : ( fromStdin ? "stdin" : path ) ) +
+                                 "</title>\n<style>\n" + HtmlConverter::stylesheet() +
+                                 "</style>\n</head>\n<body>\n<pre class=\"cc-console\">";
+        output->sputn( head.data(), static_cast<std::streamsize>( head.size() ) );
+    }
+
+    HtmlConverter converter( output );
+    bool ok = convertStream( input, converter );
+
+    if( !fromStdin )
+    {
+        std::fclose( input );
+    }
+
+    if( !fragment )
+    {
+        const std::string_view tail = "</pre>\n</body>\n</html>\n";
+        ok = ( output->sputn( tail.data(), static_cast<std::streamsize>( tail.size() ) ) == static_cast<std::streamsize>( tail.size() ) ) && ok;
+    }
+
+    if( !ok )
+    {
+        std::perror( fromStdin ? "stdin" : path );
+    }
+
+    return ( ( output->pubsync() == 0 ) && ok ) ? 0 : 1;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file
+ * @brief      Pattern-based colorizing app (colorize)
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleColorize.hpp"
+#include "ColorConsoleMarkup.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#define read _read
+#else
+#include <unistd.h>
+#endif
+
+using namespace ColorConsole;
+
+static constexpr std::size_t READ_BLOCK_SIZE = 256 * 1024;
+
+static void printUsage()
+{
+    std::fprintf( stderr, "Usage: colorize [--no-defaults] [-k COLOR:KEYWORD]... [-s COLOR:SHAPE]...\n"
+                          "Colorizes the keywords and shapes found in the standard input and writes it into the\n"
+                          "standard output.\n"
+                          "\n"
+                          "  -k COLOR:KEYWORD  Colorize a literal keyword\n"
+                          "  -s COLOR:SHAPE    Colorize the words with a shape, using %%d (digit), %%x (hexadecimal\n"
+                          "                    digit), %%a (letter) and %%w (letter, digit or underscore), optionally\n"
+                          "                    followed by {n}, {n,}, {n,m}, +, * or ? (e.g. req-%%x{8,})\n"
+                          "  --no-defaults     Do not colorize the default keywords (log levels) and shapes (IPv4\n"
+                          "                    addresses and UUIDs)\n"
+                          "\n"
+                          "COLOR is a color name, e.g. light_red, yellow or cyan.\n" );
+}
+
+/**
+ * Parses a COLOR:PATTERN argument.
+ */
+static bool parseRule( const char *argument, std::vector<ColorizeRule> &rules )
+{
+    const std::string_view text( argument );
+    const std::size_t separator = text.find( ':' );
+    unsigned int index = 0;
+
+    if( ( separator == std::string_view::npos ) || !lookupColorName( text.substr( 0, separator ), index ) )
+    {
+        std::fprintf( stderr, "colorize: invalid rule '%s'\n", argument );
+        return false;
+    }
+
+    rules.push_back( { std::string( text.substr( separator + 1 ) ), withForeground( Color::RESET, index ) } );
+    return true;
+}
+
+int main( int argc, const char* argv[] )
+{
+    std::vector<ColorizeRule> keywords;
+    std::vector<ColorizeRule> shapes;
+    bool defaults = true;
+
+    for( int i = 1; i < argc; i++ )
+    {
+        if( ( ( std::strcmp( argv[i], "-k" ) == 0 ) || ( std::strcmp( argv[i], "-s" ) == 0 ) ) && ( ( i + 1 ) < argc ) )
+        {
+            if( !parseRule( argv[i + 1], ( argv[i][1] == 'k' ) ? keywords : shapes ) )
+            {
+                return 2;
+            }
+            i++;
+        }
+        else if( std::strcmp( argv[i], "--no-defaults" ) == 0 )
+        {
+            defaults = false;
+        }
+        else
+        {
+            printUsage();
+            return ( std::strcmp( argv[i], "--help" ) == 0 ) ? 0 : 2;
+        }
+    }
+
+    if( defaults )
+    {
+        keywords.insert( keywords.end(), { { "FATAL", Color::FG_LIGHT_MAGENTA }, { "ERROR", Color::FG_LIGHT_RED },
+                                           { "WARNING", Color::FG_YELLOW }, { "WARN", Color::FG_YELLOW },
+                                           { "INFO", Color::FG_LIGHT_GREEN }, { "DEBUG", Color::FG_DARK_GREY } } );
+        shapes.insert( shapes.end(), { { std::string( Colorizer::IPV4_SHAPE ), Color::FG_LIGHT_CYAN },
+                                       { std::string( Colorizer::UUID_SHAPE ), Color::FG_LIGHT_BLUE } } );
+    }
+
+#if defined(_WIN32)
+    _setmode( _fileno( stdin ), _O_BINARY );
+#endif
+
+    const Colorizer colorizer( keywords, shapes );
+    bool ok = true;
+
+    {
+        ColorizeStreamBuf colorize( ColorConsole::cout, colorizer );
+        std::vector<char> block( READ_BLOCK_SIZE );
+
+        // Blocks are written as soon as they are read, so that interactive input (e.g. from tail -f) is not delayed
+        int n;
+        while( ok && ( ( n = static_cast<int>( read( 0, block.data(), static_cast<unsigned int>( block.size() ) ) ) ) > 0 ) )
+        {
+            ok = ( colorize.sputn( block.data(), n ) == n ) && ( colorize.pubsync() == 0 );
+        }
+
+        ok = ok && ( n == 0 );
+    }
+
+    ColorConsole::cout.flush();
+
+    return ( ok && ColorConsole::cout.good() ) ? 0 : 1;
+}
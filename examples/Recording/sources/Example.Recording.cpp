@@ -0,0 +1,225 @@
+/**
+ * @file
+ * @brief      Colored output recording and replay app (ccrec)
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleRecording.hpp"
+#include "ColorConsoleW.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#define read _read
+#else
+#include <unistd.h>
+#endif
+
+using namespace ColorConsole;
+
+static constexpr std::size_t READ_BLOCK_SIZE = 64 * 1024;
+
+static void printUsage()
+{
+    std::fprintf( stderr, "Usage: ccrec record OUTPUT\n"
+                          "       ccrec play [--plain | --colors 16|256|truecolor] [--from-time MS | --from-line N] FILE\n"
+                          "       ccrec info FILE\n"
+                          "\n"
+                          "record  Records the colored text read from the standard input into OUTPUT\n"
+                          "play    Replays a recording into the standard output, from the beginning or from a time\n"
+                          "        (milliseconds since the recording start) or line (0-based)\n"
+                          "info    Shows the blocks of a recording\n" );
+}
+
+static int record( const char *path )
+{
+    std::filebuf output;
+    if( output.open( path, std::ios::out | std::ios::binary | std::ios::trunc ) == nullptr )
+    {
+        std::perror( path );
+        return 1;
+    }
+
+    RecordingStreamBuf recording( &output );
+    std::vector<char> block( READ_BLOCK_SIZE );
+
+    // Input is read as it arrives (read() returns partial blocks), so that the recording keeps its timing
+    int n;
+    while( ( n = static_cast<int>( read( 0, block.data(), static_cast<unsigned int>( block.size() ) ) ) ) > 0 )
+    {
+        recording.sputn( block.data(), n );
+    }
+
+    if( n < 0 )
+    {
+        std::perror( "stdin" );
+    }
+
+    const bool ok = recording.get_writer().finish();
+    if( !ok )
+    {
+        std::perror( path );
+    }
+
+    return ( ok && ( n == 0 ) ) ? 0 : 1;
+}
+
+static int play( ColorCapability capability, bool fromTime, std::uint64_t from, const char *path )
+{
+    std::ifstream input( path, std::ios::binary );
+    RecordingReader reader( input );
+
+    if( !reader.is_valid() )
+    {
+        std::fprintf( stderr, "%s: not a recording\n", path );
+        return 1;
+    }
+
+    std::streambuf *output = std::cout.rdbuf();
+    SgrStyle currentStyle;
+
+    auto writeRun = [&]( const SgrStyle &style, std::string_view text, std::uint64_t )
+    {
+        if( !( style == currentStyle ) && ( capability != ColorCapability::NONE ) )
+        {
+            const SgrSequence sequence = sgrSequence( style, capability );
+            output->sputn( sequence.text, static_cast<std::streamsize>( sequence.length ) );
+            currentStyle = style;
+        }
+
+        output->sputn( text.data(), static_cast<std::streamsize>( text.size() ) );
+    };
+
+    const bool ok = fromTime ? reader.replay_from_time( from, writeRun ) : reader.replay_from_line( from, writeRun );
+
+    if( !currentStyle.is_default() )
+    {
+        const SgrSequence reset = sgrSequence( SgrStyle(), capability );
+        output->sputn( reset.text, static_cast<std::streamsize>( reset.length ) );
+    }
+
+    if( !ok )
+    {
+        std::fprintf( stderr, "%s: corrupted recording\n", path );
+    }
+
+    return ( ( output->pubsync() == 0 ) && ok ) ? 0 : 1;
+}
+
+static int info( const char *path )
+{
+    std::ifstream input( path, std::ios::binary );
+    RecordingReader reader( input );
+
+    if( !reader.is_valid() )
+    {
+        std::fprintf( stderr, "%s: not a recording\n", path );
+        return 1;
+    }
+
+    std::printf( "Start time: %llu ms since epoch\nBlocks: %zu\n", static_cast<unsigned long long>( reader.get_start_time() ),
+                 reader.get_blocks().size() );
+
+    for( const RecordingBlockInfo &block : reader.get_blocks() )
+    {
+        std::printf( "  offset %-12llu time %-10llu line %llu\n", static_cast<unsigned long long>( block.offset ),
+                     static_cast<unsigned long long>( block.time ), static_cast<unsigned long long>( block.line ) );
+    }
+
+    return 0;
+}
+
+int main( int argc, const char* argv[] )
+{
+    // The output is raw: the global consoles must not write a color reset when destroyed
+    ColorConsole::cout.disable_coloring();
+    ColorConsole::cerr.disable_coloring();
+    ColorConsole::wcout.disable_coloring();
+    ColorConsole::wcerr.disable_coloring();
+
+#if defined(_WIN32)
+    _setmode( _fileno( stdin ), _O_BINARY );
+    _setmode( _fileno( stdout ), _O_BINARY );
+#endif
+
+    std::ios::sync_with_stdio( false );
+
+    if( ( argc == 3 ) && ( std::strcmp( argv[1], "record" ) == 0 ) )
+    {
+        return record( argv[2] );
+    }
+
+    if( ( argc == 3 ) && ( std::strcmp( argv[1], "info" ) == 0 ) )
+    {
+        return info( argv[2] );
+    }
+
+    if( ( argc >= 3 ) && ( std::strcmp( argv[1], "play" ) == 0 ) )
+    {
+        ColorCapability capability = ColorCapability::TRUE_COLOR;
+        bool fromTime = false;
+        std::uint64_t from = 0;
+        int i = 2;
+
+        for( ; i < argc - 1; i++ )
+        {
+            const std::string_view option = argv[i];
+
+            if( option == "--plain" )
+            {
+                capability = ColorCapability::NONE;
+            }
+            else if( ( option == "--colors" ) && ( i + 2 < argc ) )
+            {
+                const std::string_view colors = argv[++i];
+
+                if( colors == "16" )
+                {
+                    capability = ColorCapability::BASIC;
+                }
+                else if( colors == "256" )
+                {
+                    capability = ColorCapability::PALETTE_256;
+                }
+                else if( colors == "truecolor" )
+                {
+                    capability = ColorCapability::TRUE_COLOR;
+                }
+                else
+                {
+                    std::fprintf( stderr, "ccrec: unknown colors '%s'\n", argv[i] );
+                    break;
+                }
+            }
+            else if( ( ( option == "--from-time" ) || ( option == "--from-line" ) ) && ( i + 2 < argc ) )
+            {
+                fromTime = ( option == "--from-time" );
+                from = std::strtoull( argv[++i], nullptr, 10 );
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        if( i == argc - 1 )
+        {
+            return play( capability, fromTime, from, argv[i] );
+        }
+    }
+
+    printUsage();
+    return ( ( argc == 2 ) && ( std::strcmp( argv[1], "--help" ) == 0 ) ) ? 0 : 2;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file
+ * @brief      Fuzz target for the ColorConsole untrusted text sanitizer
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleSanitizer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+using namespace ColorConsole;
+
+static void check( bool condition )
+{
+    if( !condition )
+    {
+        std::abort();
+    }
+}
+
+extern "C" int LLVMFuzzerTestOneInput( const std::uint8_t *data, std::size_t size )
+{
+    const std::string_view text( reinterpret_cast<const char*>( data ), size );
+
+    // The text before the first unsafe sequence is safe
+    const UnsafeSequence unsafe = findUnsafeSequence( text );
+    check( unsafe.position + unsafe.length <= size );
+    check( ( unsafe.length == 0 ) == ( unsafe.position == size ) );
+    check( findUnsafeSequence( text.substr( 0, unsafe.position ) ).position == unsafe.position );
+
+    for( SanitizeMode mode : { SanitizeMode::ESCAPE, SanitizeMode::REPLACE } )
+    {
+        // Sanitized text is safe, and safe text is left untouched
+        const std::string result = sanitizeText( text, mode );
+        check( findUnsafeSequence( result ).length == 0 );
+        check( ( unsafe.length != 0 ) || ( result == text ) );
+
+        // Consoles write the same sanitized text
+        std::stringbuf buffer;
+        {
+            Console console( &buffer, false );
+            console.set_sanitize_mode( mode );
+            console << std::string( text );
+        }
+        check( buffer.str() == result );
+    }
+
+    return 0;
+}
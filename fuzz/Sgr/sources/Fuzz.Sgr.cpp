@@ -0,0 +1,80 @@
+/**
+ * @file
+ * @brief      Fuzz target for the ColorConsole SGR escape sequences parser
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsoleAnsiStrip.hpp"
+#include "ColorConsoleSgr.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace ColorConsole;
+
+static void check( bool condition )
+{
+    if( !condition )
+    {
+        std::abort();
+    }
+}
+
+struct ParsedText
+{
+    std::string text;
+    std::vector<SgrStyle> styles;
+
+    void append( const SgrStyle &style, std::string_view run )
+    {
+        text.append( run );
+        styles.insert( styles.end(), run.size(), style );
+    }
+};
+
+extern "C" int LLVMFuzzerTestOneInput( const std::uint8_t *data, std::size_t size )
+{
+    if( size == 0 )
+    {
+        return 0;
+    }
+
+    // The first byte selects where the input is split in chunks
+    const std::size_t split = data[0] % size;
+    const std::string_view text( reinterpret_cast<const char*>( data ) + 1, size - 1 );
+
+    ParsedText whole;
+    SgrParser wholeParser;
+    wholeParser.process( text, [&whole]( const SgrStyle &style, std::string_view run ) { whole.append( style, run ); } );
+
+    // Parsing in chunks gives the same result as parsing in one go
+    ParsedText chunked;
+    SgrParser chunkedParser;
+    auto append = [&chunked]( const SgrStyle &style, std::string_view run ) { chunked.append( style, run ); };
+    chunkedParser.process( text.substr( 0, split ), append );
+    chunkedParser.process( text.substr( split ), append );
+
+    check( whole.text == chunked.text );
+    check( whole.styles == chunked.styles );
+    check( wholeParser.get_style() == chunkedParser.get_style() );
+    check( wholeParser.in_sequence() == chunkedParser.in_sequence() );
+
+    // The text of the runs is the text without escape sequences
+    check( whole.text == AnsiStripper::strip( text ) );
+
+    // Styles map to valid colors, and the colors of the library round-trip
+    for( const SgrStyle &style : whole.styles )
+    {
+        const Color color = style.to_color();
+        check( SgrStyle::from_color( color ).to_color() == color );
+    }
+
+    return 0;
+}
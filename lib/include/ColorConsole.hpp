@@ -11,6 +11,14 @@
 #define COLORCONSOLE_HPP_
 
 #include "ColorConsoleCommon.hpp"
+#include "ColorConsoleFormat.hpp"
+#include "ColorConsolePolicies.hpp"
+#include "ColorConsoleSanitizer.hpp"
+#include "ColorConsoleStats.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <string_view>
 
 #ifdef WIN32
 #include "windows.h"
@@ -23,6 +31,30 @@ struct TEST_GROUP_CppUTestGroupColorConsole;
 namespace ColorConsole
 {
 
+struct MarkupView;
+class Palette;
+class Console;
+
+/**
+ * Type-erased argument for runtime markup templates (see Console::printm()).
+ */
+struct MarkupArgument
+{
+    const void *object = nullptr;
+    void (*insert)( Console &console, const void *object ) = nullptr;
+
+    MarkupArgument() = default;
+
+    template<class T>
+    MarkupArgument( const T &value ) noexcept
+    : object( &value ), insert( &insertValue<T> )
+    {}
+
+private:
+    template<class T>
+    static void insertValue( Console &console, const void *object );
+};
+
 /**
  * Output stream representing a console oriented to narrow characters (of type char)
  * with text coloring capabilities.
@@ -44,6 +76,18 @@ public:
      */
     Console( std::streambuf *sb, bool enableColoring = true );
 
+    /**
+     * Constructor for C stdio streams.
+     *
+     * The console writes into the buffer of the C stream (see FileStreamBuf in ColorConsoleFile.hpp), therefore
+     * its output keeps its order with respect to output written using C stdio functions. Coloring (if enabled)
+     * will be performed using ANSI color escape codes.
+     *
+     * @param[in] file C stream to write to (not owned)
+     * @param[in] enableColoring Indicates if coloring shall be enabled
+     */
+    Console( std::FILE *file, bool enableColoring = true );
+
     /**
      * Destructor.
      */
@@ -64,6 +108,7 @@ public:
     void enable_coloring( bool value = true )
     {
         m_coloringEnabled = value;
+        update_color_mode();
     }
 
     /**
@@ -74,6 +119,7 @@ public:
     void disable_coloring( bool value = true )
     {
         m_coloringEnabled = !value;
+        update_color_mode();
     }
 
     /**
@@ -86,6 +132,92 @@ public:
         return m_coloringEnabled;
     }
 
+    /**
+     * Indicates if colors are rendered by embedding ANSI escape sequences in the output.
+     *
+     * @return @c true if coloring is enabled and performed using ANSI escape sequences, @c false otherwise
+     */
+    bool uses_ansi_coloring() const noexcept
+    {
+        return ( m_coloringEnabled && uses_ansi_escapes() );
+    }
+
+    /**
+     * Returns the current console color.
+     *
+     * @return The last color set, or RESET if no color has been set yet
+     */
+    Color get_color() const noexcept
+    {
+        return m_currentColor;
+    }
+
+    /**
+     * Sets how unsafe sequences (control characters and invalid UTF-8, see SanitizeMode) in text strings
+     * inserted into the console are handled.
+     *
+     * Sanitizing applies to the text strings and characters inserted using the insertion operator (including
+     * the arguments of runtime markup templates), but not to markups, fragments, print() nor write_raw().
+     * Characters are checked on their own, therefore a non-ASCII byte inserted as a character is unsafe.
+     *
+     * @param[in] mode Sanitize mode (NONE by default)
+     */
+    void set_sanitize_mode( SanitizeMode mode ) noexcept
+    {
+        m_sanitizeMode = mode;
+    }
+
+    /**
+     * Returns how unsafe sequences in text strings inserted into the console are handled.
+     *
+     * @return The sanitize mode
+     */
+    SanitizeMode get_sanitize_mode() const noexcept
+    {
+        return m_sanitizeMode;
+    }
+
+#ifdef COLORCONSOLE_ENABLE_STATS
+    /**
+     * Returns a snapshot of the output statistics of the console.
+     *
+     * Only available when the library is built with statistics enabled (see STATS_ENABLED).
+     *
+     * @return The statistics snapshot
+     */
+    ConsoleStatsSnapshot get_stats() const noexcept
+    {
+        return m_stats.snapshot();
+    }
+
+    /**
+     * Resets the output statistics of the console.
+     */
+    void reset_stats() noexcept
+    {
+        m_stats.reset();
+    }
+#endif
+
+    /**
+     * Accounts color escape sequences embedded in text written into the console by other means than
+     * set_color() (e.g. markups or fragments), for the output statistics.
+     *
+     * Does nothing unless the library is built with statistics enabled.
+     *
+     * @param[in] changes Number of color changes
+     * @param[in] size Size of the escape sequences
+     */
+    void account_escapes( std::size_t changes, std::size_t size ) noexcept
+    {
+#ifdef COLORCONSOLE_ENABLE_STATS
+        m_stats.add_embedded_escapes( changes, size );
+#else
+        (void) changes;
+        (void) size;
+#endif
+    }
+
     /**
      * Sets (or resets) the console color.
      *
@@ -94,6 +226,22 @@ public:
      */
     Console& operator<<( Color color );
 
+    /**
+     * Inserter for compiled markups (see ColorConsoleMarkup.hpp).
+     *
+     * @param[in] markup Compiled markup
+     * @return The ColorConsole object (*this)
+     */
+    Console& operator<<( const MarkupView &markup );
+
+    /**
+     * Inserter for untrusted text to be sanitized (see sanitized()).
+     *
+     * @param[in] text Text to sanitize
+     * @return The ColorConsole object (*this)
+     */
+    Console& operator<<( const SanitizedText &text );
+
     /**
      * Inserter for ostream manipulators.
      *
@@ -294,6 +442,11 @@ public:
      */
     Console& operator<<( char c )
     {
+        if( m_sanitizeMode != SanitizeMode::NONE )
+        {
+            return *this << SanitizedText { std::string_view( &c, 1 ), m_sanitizeMode };
+        }
+
         *(static_cast<std::ostream*>(this)) << c;
         return *this;
     }
@@ -306,6 +459,11 @@ public:
      */
     Console& operator<<( unsigned char c )
     {
+        if( m_sanitizeMode != SanitizeMode::NONE )
+        {
+            return *this << SanitizedText { std::string_view( reinterpret_cast<const char*>( &c ), 1 ), m_sanitizeMode };
+        }
+
         *(static_cast<std::ostream*>(this)) << c;
         return *this;
     }
@@ -318,6 +476,11 @@ public:
      */
     Console& operator<<( signed char c )
     {
+        if( m_sanitizeMode != SanitizeMode::NONE )
+        {
+            return *this << SanitizedText { std::string_view( reinterpret_cast<const char*>( &c ), 1 ), m_sanitizeMode };
+        }
+
         *(static_cast<std::ostream*>(this)) << c;
         return *this;
     }
@@ -330,6 +493,11 @@ public:
      */
     Console& operator<<( const char *text )
     {
+        if( ( m_sanitizeMode != SanitizeMode::NONE ) && ( text != NULL ) )
+        {
+            return *this << SanitizedText { text, m_sanitizeMode };
+        }
+
         *(static_cast<std::ostream*>(this)) << text;
         return *this;
     }
@@ -342,6 +510,11 @@ public:
      */
     Console& operator<<( const unsigned char *text )
     {
+        if( ( m_sanitizeMode != SanitizeMode::NONE ) && ( text != NULL ) )
+        {
+            return *this << SanitizedText { reinterpret_cast<const char*>( text ), m_sanitizeMode };
+        }
+
         *(static_cast<std::ostream*>(this)) << text;
         return *this;
     }
@@ -354,6 +527,11 @@ public:
      */
     Console& operator<<( const signed char *text )
     {
+        if( ( m_sanitizeMode != SanitizeMode::NONE ) && ( text != NULL ) )
+        {
+            return *this << SanitizedText { reinterpret_cast<const char*>( text ), m_sanitizeMode };
+        }
+
         *(static_cast<std::ostream*>(this)) << text;
         return *this;
     }
@@ -366,10 +544,132 @@ public:
      */
     Console& operator<<( const std::string &text )
     {
+        if( m_sanitizeMode != SanitizeMode::NONE )
+        {
+            return *this << SanitizedText { text, m_sanitizeMode };
+        }
+
         *(static_cast<std::ostream*>(this)) << text;
         return *this;
     }
 
+    /**
+     * Inserter for text strings.
+     *
+     * @param[in] text Text string
+     * @return The ColorConsole object (*this)
+     */
+    Console& operator<<( std::string_view text )
+    {
+        if( m_sanitizeMode != SanitizeMode::NONE )
+        {
+            return *this << SanitizedText { text, m_sanitizeMode };
+        }
+
+        *(static_cast<std::ostream*>(this)) << text;
+        return *this;
+    }
+
+    /**
+     * Writes raw bytes directly into the stream buffer, e.g. text prepared using a ColorWriter
+     * (see ColorConsoleWriter.hpp).
+     *
+     * The bytes are written as is, bypassing the stream formatting, and the console color is not updated:
+     * they shall not leave a color set. Embedded ANSI escape sequences are not rendered by Windows native
+     * consoles, therefore writers shall only enable coloring when uses_ansi_coloring() returns @c true.
+     *
+     * @param[in] data Bytes to write
+     * @return The ColorConsole object (*this)
+     */
+    Console& write_raw( std::string_view data );
+
+#ifdef COLORCONSOLE_HAS_FORMAT
+    /**
+     * Writes formatted text.
+     *
+     * The text is formatted using std::format into a reusable per-thread buffer (or a local one, for calls made
+     * by formatters while formatting), and then written into the console at once. Colors can be inserted as
+     * arguments (see the formatters in ColorConsoleFormat.hpp), and the console color is updated to the last
+     * color formatted, even if coloring is disabled.
+     *
+     * On Windows native consoles (unless ANSI escape codes are forced) the colors inserted as arguments
+     * are not rendered.
+     *
+     * @param[in] fmt Format string
+     * @param[in] args Arguments to format
+     * @return The ColorConsole object (*this)
+     */
+    template<class... Args>
+    Console& print( std::format_string<Args...> fmt, Args&&... args )
+    {
+        return vprint( fmt.get(), std::make_format_args( args... ) );
+    }
+
+    /**
+     * Writes formatted text, with type-erased arguments.
+     *
+     * @param[in] fmt Format string
+     * @param[in] args Arguments to format
+     * @return The ColorConsole object (*this)
+     */
+    Console& vprint( std::string_view fmt, std::format_args args );
+#endif
+
+    /**
+     * Writes a runtime markup template.
+     *
+     * The template syntax is the same as for compile-time markups (see parseMarkup()), plus:
+     * - Plain names in tags are first looked up as styles in the console palette (see set_palette()).
+     * - <tt>{}</tt> and <tt>{N}</tt> are replaced by the arguments, which are inserted into the console.
+     *
+     * Templates are parsed once and cached (per thread) by address and contents, so that successive
+     * calls with the same template do not parse it again. If the template is invalid, it is written as is.
+     *
+     * @code
+     * cout.printm( "{warn}Disk {}%{/}", percentage );
+     * @endcode
+     *
+     * @param[in] markup Markup template
+     * @param[in] args Arguments
+     * @return The ColorConsole object (*this)
+     */
+    template<class... Args>
+    Console& printm( std::string_view markup, const Args&... args )
+    {
+        const MarkupArgument arguments[] = { MarkupArgument( args )..., MarkupArgument() };
+        return vprintm( markup, arguments, sizeof...(Args) );
+    }
+
+    /**
+     * Writes a runtime markup template, with type-erased arguments.
+     *
+     * @param[in] markup Markup template
+     * @param[in] args Arguments
+     * @param[in] argCount Number of arguments
+     * @return The ColorConsole object (*this)
+     */
+    Console& vprintm( std::string_view markup, const MarkupArgument *args, std::size_t argCount );
+
+    /**
+     * Sets the palette used to resolve style names in runtime markup templates.
+     *
+     * @param[in] palette Palette, or NULL to use the default palette
+     */
+    void set_palette( const Palette *palette ) noexcept
+    {
+        m_palette = palette;
+    }
+
+    /**
+     * Returns the palette used to resolve style names in runtime markup templates.
+     *
+     * @return The palette set, or NULL if the default palette is used
+     */
+    const Palette* get_palette() const noexcept
+    {
+        return m_palette;
+    }
+
     /**
      * Returns the console type.
      *
@@ -380,18 +680,47 @@ public:
         return m_consoleType;
     }
 
+    /**
+     * Returns the color-enabled standard output stream (narrow characters oriented).
+     *
+     * The console is constructed on the first call (thread-safely), therefore this accessor can be used from the
+     * static initialization of other translation units.
+     */
+    static Console& get_cout();
+
+    /**
+     * Returns the color-enabled standard output stream for errors (narrow characters oriented).
+     *
+     * The console is constructed on the first call (thread-safely), therefore this accessor can be used from the
+     * static initialization of other translation units.
+     */
+    static Console& get_cerr();
+
     /**
      * Color-enabled standard output stream (narrow characters oriented).
+     *
+     * The reference is bound during static initialization, hence code running during static initialization shall
+     * use get_cout() instead. Binding it constructs the console (and the other standard consoles) at startup whenever
+     * it is linked in, which is always the case with the shared library: programs that must not pay that cost
+     * when linked statically shall only use the accessors.
      */
-    static Console cout;
+    static Console &cout;
 
     /**
      * Color-enabled standard output stream for errors (narrow characters oriented).
+     *
+     * The reference is bound during static initialization, hence code running during static initialization shall
+     * use get_cerr() instead. Binding it constructs the console (and the other standard consoles) at startup whenever
+     * it is linked in, which is always the case with the shared library: programs that must not pay that cost
+     * when linked statically shall only use the accessors.
      */
-    static Console cerr;
+    static Console &cerr;
 
     /**
      * Initializes the consoles.
+     *
+     * The standard consoles are initialized on first use (thread-safely), therefore calling this function is
+     * optional: it just anticipates the initialization.
      */
     static void Init();
 
@@ -403,15 +732,80 @@ private:
      */
     Console( ConsoleType consoleType );
 
+    /**
+     * Constructor for the global standard streams, which are initialized on first use.
+     *
+     * @param[in] consoleType Console to color
+     * @param[in] target Standard stream to write to
+     */
+    Console( ConsoleType consoleType, std::ostream &target );
+
     void initialize();
 
+    static void initialize_lazily( void *console );
+
+    bool uses_ansi_escapes() const noexcept
+    {
+#if defined(WIN32) && !defined(COLORCONSOLE_FORCE_ANSI_ESCAPE_CODES)
+        return ( m_consoleType > ConsoleType::STD_ERROR );
+#else
+        return true;
+#endif
+    }
+
+    void attach_stats() noexcept
+    {
+#ifdef COLORCONSOLE_ENABLE_STATS
+        if( rdbuf() != NULL )
+        {
+            m_statsBuffer.set_target( rdbuf() );
+            rdbuf( &m_statsBuffer );
+        }
+#endif
+    }
+
+    std::streambuf* output_buffer() const noexcept
+    {
+#ifdef COLORCONSOLE_ENABLE_STATS
+        return m_statsBuffer.get_target();
+#else
+        return rdbuf();
+#endif
+    }
+
+    void update_color_mode() noexcept
+    {
+        if( !m_coloringEnabled )
+        {
+            m_colorPolicy.set_mode( DynamicColorPolicy::Mode::NONE );
+        }
+        else if( uses_ansi_escapes() )
+        {
+            m_colorPolicy.set_mode( DynamicColorPolicy::Mode::ANSI );
+        }
+        else
+        {
+            m_colorPolicy.set_mode( DynamicColorPolicy::Mode::NATIVE );
+        }
+    }
+
     ConsoleType m_consoleType;
 
     bool m_coloringEnabled;
 
-#ifdef WIN32
-    HANDLE m_handle;
-    WORD m_origConsoleAttrs;
+    Color m_currentColor;
+
+    const Palette *m_palette;
+
+    SanitizeMode m_sanitizeMode;
+
+    std::streambuf *m_ownedBuffer;
+
+    DynamicColorPolicy m_colorPolicy;
+
+#ifdef COLORCONSOLE_ENABLE_STATS
+    ConsoleStats m_stats;
+    StatsStreamBuf<char> m_statsBuffer { m_stats };
 #endif
 
 #ifdef UNIT_TEST
@@ -429,6 +823,12 @@ extern COLORCONSOLE_API Console &cout;
  */
 extern COLORCONSOLE_API Console &cerr;
 
+template<class T>
+void MarkupArgument::insertValue( Console &console, const void *object )
+{
+    console << *static_cast<const T*>( object );
+}
+
 } // namespace
 
 #endif // header guard
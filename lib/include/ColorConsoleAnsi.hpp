@@ -0,0 +1,150 @@
+/**
+ * @file
+ * @brief      ANSI escape sequences tables for ColorConsole and ColorConsoleW
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLEANSI_HPP_
+#define COLORCONSOLEANSI_HPP_
+
+#include "ColorConsoleCommon.hpp"
+
+#include <cstddef>
+#include <string_view>
+
+namespace ColorConsole
+{
+
+/**
+ * ANSI SGR parameters for the foreground colors, indexed by the foreground bits of a Color.
+ */
+inline constexpr const char *ANSI_FOREGROUND_CODES[16] =
+{
+    "30", "34", "32", "36", "31", "35", "33", "37",
+    "1;30", "1;34", "1;32", "1;36", "1;31", "1;35", "1;33", "1;37"
+};
+
+/**
+ * ANSI SGR parameters for the background colors, indexed by the background bits of a Color.
+ *
+ * The first entry corresponds to BG_NONE, BG_BLACK is handled separately.
+ */
+inline constexpr const char *ANSI_BACKGROUND_CODES[16] =
+{
+    "49", "44", "42", "46", "41", "45", "43", "47",
+    "100", "104", "102", "106", "101", "105", "103", "107"
+};
+
+/**
+ * ANSI SGR parameter for BG_BLACK.
+ */
+inline constexpr const char *ANSI_BACKGROUND_BLACK_CODE = "40";
+
+/**
+ * ANSI escape sequence that resets the console color.
+ */
+inline constexpr std::string_view ANSI_RESET_SEQUENCE = "\033[0m";
+
+/**
+ * ANSI escape sequence that clears the line from the cursor position to its end.
+ */
+inline constexpr std::string_view ANSI_CLEAR_LINE_SEQUENCE = "\033[K";
+
+/**
+ * Maximum length of the escape sequence that sets a Color.
+ */
+inline constexpr std::size_t ANSI_ESCAPE_MAX_LENGTH = 11;
+
+/**
+ * ANSI escape sequence that sets a Color, stored inline.
+ */
+struct AnsiEscape
+{
+    char text[ANSI_ESCAPE_MAX_LENGTH + 1] = {};
+    std::size_t length = 0;
+
+    constexpr const char *data() const noexcept
+    {
+        return text;
+    }
+
+    constexpr std::size_t size() const noexcept
+    {
+        return length;
+    }
+
+    constexpr std::string_view view() const noexcept
+    {
+        return std::string_view( text, length );
+    }
+
+    constexpr void append( std::string_view str ) noexcept
+    {
+        for( char c : str )
+        {
+            if( length < ANSI_ESCAPE_MAX_LENGTH )
+            {
+                text[length++] = c;
+            }
+        }
+    }
+};
+
+/**
+ * Returns the foreground bits of a Color (0 to 15).
+ */
+constexpr unsigned int foregroundIndex( Color color ) noexcept
+{
+    return static_cast<unsigned int>( color ) & 0x0Fu;
+}
+
+/**
+ * Returns the background bits of a Color (0 to 15).
+ */
+constexpr unsigned int backgroundIndex( Color color ) noexcept
+{
+    return ( static_cast<unsigned int>( color ) >> 4 ) & 0x0Fu;
+}
+
+/**
+ * Builds the ANSI escape sequence that sets (or resets) a color.
+ *
+ * @param[in] color Color to be set, or RESET to reset to default value
+ * @return The escape sequence
+ */
+constexpr AnsiEscape ansiEscape( Color color ) noexcept
+{
+    AnsiEscape escape;
+
+    if( color >= Color::RESET )
+    {
+        escape.append( ANSI_RESET_SEQUENCE );
+    }
+    else
+    {
+        escape.append( "\033[" );
+
+        unsigned int bgIndex = backgroundIndex( color );
+        if( ( bgIndex == 0 ) && ( static_cast<unsigned int>( color ) & static_cast<unsigned int>( Color::BG_BLACK ) ) )
+        {
+            escape.append( ANSI_BACKGROUND_BLACK_CODE );
+        }
+        else
+        {
+            escape.append( ANSI_BACKGROUND_CODES[bgIndex] );
+        }
+
+        escape.append( ";" );
+        escape.append( ANSI_FOREGROUND_CODES[foregroundIndex( color )] );
+        escape.append( "m" );
+    }
+
+    return escape;
+}
+
+} // namespace
+
+#endif // header guard
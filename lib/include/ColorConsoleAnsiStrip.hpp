@@ -0,0 +1,171 @@
+/**
+ * @file
+ * @brief      Removal of ANSI escape sequences from text streams
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLEANSISTRIP_HPP_
+#define COLORCONSOLEANSISTRIP_HPP_
+
+#include "ColorConsoleAnsiTokenizer.hpp"
+
+#include <cstddef>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+namespace ColorConsole
+{
+
+/**
+ * Incremental remover of ANSI escape sequences.
+ *
+ * Removes CSI sequences (<tt>ESC [ ... final</tt>, e.g. SGR colors or cursor movements), OSC, DCS, SOS,
+ * PM and APC strings (terminated by BEL or <tt>ESC \\</tt>, e.g. hyperlinks or window titles) and the
+ * remaining two-byte and intermediate ESC sequences, as tokenized by AnsiTokenizer. CAN and SUB abort a
+ * sequence. Other control characters (e.g. newlines) are kept, also within sequences.
+ *
+ * Text can be processed in chunks of any size: sequences split across chunks are resumed on the next chunk.
+ * Plain text runs are located using @c memchr, which is vectorized by the common C libraries, so that long
+ * runs without escape sequences are skipped at memory bandwidth.
+ */
+class AnsiStripper
+{
+public:
+    /**
+     * Processes a chunk of text.
+     *
+     * @param[in] chunk Chunk of text
+     * @param[in] writer Callable invoked with each run of plain text in the chunk (as a @c std::string_view)
+     */
+    template<class Writer>
+    void process( std::string_view chunk, Writer &&writer )
+    {
+        m_tokenizer.process( chunk, writer, []( const CsiSequence& ) {} );
+    }
+
+    /**
+     * Indicates if the last chunk processed ended inside an escape sequence.
+     *
+     * @return @c true if a sequence is pending, @c false otherwise
+     */
+    bool in_sequence() const noexcept
+    {
+        return m_tokenizer.in_sequence();
+    }
+
+    /**
+     * Drops any pending escape sequence.
+     */
+    void reset() noexcept
+    {
+        m_tokenizer.reset();
+    }
+
+    /**
+     * Removes the ANSI escape sequences from a text.
+     *
+     * @param[in] text Text
+     * @return The text without escape sequences
+     */
+    static std::string strip( std::string_view text )
+    {
+        std::string result;
+        result.reserve( text.size() );
+
+        AnsiStripper stripper;
+        stripper.process( text, [&result]( std::string_view run ) { result.append( run ); } );
+
+        return result;
+    }
+
+private:
+    AnsiTokenizer m_tokenizer;
+};
+
+/**
+ * Unbuffered stream buffer that removes the ANSI escape sequences from the output written into it, and
+ * forwards the rest to another stream buffer.
+ *
+ * E.g. it can be used to archive colored output into files without colors:
+ *
+ * @code
+ * std::ofstream file( "output.log" );
+ * AnsiStripStreamBuf strip( file.rdbuf() );
+ * Console archive( &strip );
+ * @endcode
+ */
+class AnsiStripStreamBuf : public std::streambuf
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param[in] target Stream buffer to forward the output to (not owned)
+     */
+    explicit AnsiStripStreamBuf( std::streambuf *target ) noexcept
+    : m_target( target )
+    {}
+
+    /**
+     * Returns the stream buffer the output is forwarded to.
+     *
+     * @return The target stream buffer
+     */
+    std::streambuf* get_target() const noexcept
+    {
+        return m_target;
+    }
+
+    /**
+     * Returns the escape sequence remover, e.g. to check if a sequence is pending.
+     *
+     * @return The escape sequence remover
+     */
+    const AnsiStripper& get_stripper() const noexcept
+    {
+        return m_stripper;
+    }
+
+protected:
+    int_type overflow( int_type c ) override
+    {
+        if( traits_type::eq_int_type( c, traits_type::eof() ) )
+        {
+            return traits_type::not_eof( c );
+        }
+
+        const char_type ch = traits_type::to_char_type( c );
+
+        return ( xsputn( &ch, 1 ) == 1 ) ? c : traits_type::eof();
+    }
+
+    std::streamsize xsputn( const char_type *s, std::streamsize n ) override
+    {
+        bool ok = true;
+
+        m_stripper.process( std::string_view( s, static_cast<std::size_t>( n ) ), [this, &ok]( std::string_view run )
+        {
+            const std::streamsize size = static_cast<std::streamsize>( run.size() );
+            ok = ok && ( m_target->sputn( run.data(), size ) == size );
+        } );
+
+        return ok ? n : 0;
+    }
+
+    int sync() override
+    {
+        return m_target->pubsync();
+    }
+
+private:
+    std::streambuf *m_target;
+    AnsiStripper m_stripper;
+};
+
+} // namespace
+
+#endif // header guard
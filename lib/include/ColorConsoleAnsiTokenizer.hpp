@@ -0,0 +1,346 @@
+/**
+ * @file
+ * @brief      Incremental tokenizer of ECMA-48 (ANSI) escape sequences
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLEANSITOKENIZER_HPP_
+#define COLORCONSOLEANSITOKENIZER_HPP_
+
+#include "ColorConsoleCommon.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace ColorConsole
+{
+
+/**
+ * Maximum number of parameters of a CSI sequence (further parameters are ignored).
+ */
+inline constexpr std::size_t ANSI_MAX_CSI_PARAMETERS = 32;
+
+/**
+ * CSI control sequence reported by AnsiTokenizer.
+ */
+struct CsiSequence
+{
+    char final;                         ///< Final byte (e.g. @c 'K' for EL or @c 'H' for CUP)
+    char privateMarker;                 ///< Private parameter marker (e.g. @c '?'), or 0 if none
+    const std::uint16_t *parameters;    ///< Parameters (omitted parameters are 0)
+    std::size_t count;                  ///< Number of parameters (up to ANSI_MAX_CSI_PARAMETERS)
+    std::uint32_t subparameters;        ///< Bit mask of the parameters that are subparameters (i.e. preceded by a colon)
+    bool intermediate;                  ///< Indicates if the sequence has intermediate bytes
+
+    /**
+     * Returns a parameter, or a default value if it is omitted or 0.
+     */
+    std::uint16_t get( std::size_t index, std::uint16_t defaultValue ) const noexcept
+    {
+        return ( ( index < count ) && ( parameters[index] != 0 ) ) ? parameters[index] : defaultValue;
+    }
+};
+
+/**
+ * Incremental tokenizer of text with ECMA-48 (ANSI) escape sequences.
+ *
+ * Recognizes CSI sequences (<tt>ESC [ ... final</tt>, e.g. SGR colors or cursor movements), OSC, DCS, SOS,
+ * PM and APC strings (terminated by BEL or <tt>ESC \\</tt>, e.g. hyperlinks or window titles) and the
+ * remaining two-byte and intermediate ESC sequences. CAN and SUB abort a sequence, and a byte not allowed
+ * in a sequence (DEL or above) aborts it and is processed as text. Other control characters embedded in
+ * sequences (but not in strings) are executed, i.e. they are kept as text.
+ *
+ * This is the tokenizer used by AnsiStripper, SgrParser and the display width engine, so that all of them
+ * agree on where sequences start and end.
+ *
+ * Text can be processed in chunks of any size: sequences split across chunks are resumed on the next chunk.
+ * Plain text runs are located using @c memchr, which is vectorized by the common C libraries, so that long
+ * runs without escape sequences are skipped at memory bandwidth.
+ */
+class AnsiTokenizer
+{
+public:
+    /**
+     * Classification of a character inside a sequence (see advance()).
+     */
+    enum class Unit : unsigned char
+    {
+        SEQUENCE,   ///< Part of the sequence
+        CONTROL,    ///< Control character embedded in the sequence, to be executed (kept as text)
+        TEXT        ///< Not part of the sequence, which is dropped: the character must be processed as text
+    };
+
+    /**
+     * Processes a chunk of text.
+     *
+     * @param[in] chunk Chunk of text
+     * @param[in] text Callable invoked with each run of text in the chunk (as a @c std::string_view)
+     * @param[in] csi Callable invoked with each complete CSI sequence (as a <tt>const CsiSequence&</tt>),
+     *                in order with the runs of text
+     */
+    template<class TextHandler, class CsiHandler>
+    void process( std::string_view chunk, TextHandler &&text, CsiHandler &&csi )
+    {
+        const char *p = chunk.data();
+        const char *end = p + chunk.size();
+
+        while( p < end )
+        {
+            if( m_state == State::TEXT )
+            {
+                const char *esc = static_cast<const char*>( std::memchr( p, ESC, static_cast<std::size_t>( end - p ) ) );
+
+                if( esc == nullptr )
+                {
+                    text( std::string_view( p, static_cast<std::size_t>( end - p ) ) );
+                    return;
+                }
+
+                if( esc > p )
+                {
+                    text( std::string_view( p, static_cast<std::size_t>( esc - p ) ) );
+                }
+
+                start_sequence();
+                p = esc + 1;
+                continue;
+            }
+
+            const Unit unit = advance( static_cast<unsigned char>( *p ) );
+
+            if( unit == Unit::TEXT )
+            {
+                continue;
+            }
+
+            if( unit == Unit::CONTROL )
+            {
+                text( std::string_view( p, 1 ) );
+            }
+
+            if( m_csiFinal != 0 )
+            {
+                csi( CsiSequence{ m_csiFinal, m_privateMarker, m_parameters, m_count, m_subparameters, m_intermediate } );
+                m_csiFinal = 0;
+            }
+
+            p++;
+        }
+    }
+
+    /**
+     * Starts a sequence, i.e. advances the tokenizer with an ESC found in text.
+     */
+    void start_sequence() noexcept
+    {
+        m_state = State::ESCAPE;
+    }
+
+    /**
+     * Advances the tokenizer with a character inside a sequence (i.e. while in_sequence()).
+     *
+     * Characters are code units (i.e. bytes for narrow text, wide characters for wide text): only the ones
+     * below DEL can be part of a sequence.
+     *
+     * @param[in] c Character
+     * @return The classification of the character
+     */
+    Unit advance( char32_t c ) noexcept
+    {
+        if( ( c == CAN ) || ( c == SUB ) )
+        {
+            m_state = State::TEXT;
+            return Unit::SEQUENCE;
+        }
+
+        if( ( c >= 0x7F ) && ( m_state != State::STRING ) && ( m_state != State::STRING_ESCAPE ) )
+        {
+            m_state = State::TEXT;
+            return Unit::TEXT;
+        }
+
+        // Control characters embedded in sequences (but not in strings) are executed
+        if( ( c < 0x20 ) && ( c != static_cast<unsigned char>( ESC ) ) && ( m_state != State::STRING ) &&
+            ( m_state != State::STRING_ESCAPE ) )
+        {
+            return Unit::CONTROL;
+        }
+
+        switch( m_state )
+        {
+            case State::ESCAPE:
+                if( c == '[' )
+                {
+                    start_csi();
+                }
+                else if( ( c == ']' ) || ( c == 'P' ) || ( c == 'X' ) || ( c == '^' ) || ( c == '_' ) )
+                {
+                    m_state = State::STRING;
+                }
+                else if( ( c >= 0x20 ) && ( c <= 0x2F ) )
+                {
+                    m_state = State::INTERMEDIATE;
+                }
+                else if( c >= 0x30 )
+                {
+                    m_state = State::TEXT;
+                }
+                break;
+
+            case State::INTERMEDIATE:
+                if( c >= 0x30 )
+                {
+                    m_state = State::TEXT;
+                }
+                else if( c == static_cast<unsigned char>( ESC ) )
+                {
+                    m_state = State::ESCAPE;
+                }
+                break;
+
+            case State::CSI:
+                advance_csi( c );
+                break;
+
+            case State::STRING:
+                if( c == BEL )
+                {
+                    m_state = State::TEXT;
+                }
+                else if( c == static_cast<unsigned char>( ESC ) )
+                {
+                    m_state = State::STRING_ESCAPE;
+                }
+                break;
+
+            case State::STRING_ESCAPE:
+                if( c == '\\' )
+                {
+                    m_state = State::TEXT;
+                }
+                else
+                {
+                    // The ESC terminated the string and starts a new sequence
+                    m_state = State::ESCAPE;
+                    return advance( c );
+                }
+                break;
+
+            case State::TEXT:
+                break;
+        }
+
+        return Unit::SEQUENCE;
+    }
+
+    /**
+     * Indicates if the tokenizer is inside an escape sequence (e.g. if the last chunk processed ended inside
+     * a sequence).
+     *
+     * @return @c true if a sequence is pending, @c false otherwise
+     */
+    bool in_sequence() const noexcept
+    {
+        return ( m_state != State::TEXT );
+    }
+
+    /**
+     * Drops any pending escape sequence.
+     */
+    void reset() noexcept
+    {
+        m_state = State::TEXT;
+        m_csiFinal = 0;
+    }
+
+private:
+    enum class State : unsigned char
+    {
+        TEXT,               // Plain text
+        ESCAPE,             // After ESC
+        INTERMEDIATE,       // After ESC and intermediate bytes
+        CSI,                // Inside a CSI sequence
+        STRING,             // Inside an OSC, DCS, SOS, PM or APC string
+        STRING_ESCAPE       // After ESC inside a string
+    };
+
+    static constexpr char ESC = '\033';
+    static constexpr char32_t BEL = 0x07;
+    static constexpr char32_t CAN = 0x18;
+    static constexpr char32_t SUB = 0x1A;
+
+    void start_csi() noexcept
+    {
+        m_state = State::CSI;
+        m_count = 0;
+        m_current = 0;
+        m_subparameters = 0;
+        m_nextIsSubparameter = false;
+        m_intermediate = false;
+        m_privateMarker = 0;
+    }
+
+    void push_parameter() noexcept
+    {
+        if( m_count < ANSI_MAX_CSI_PARAMETERS )
+        {
+            if( m_nextIsSubparameter )
+            {
+                m_subparameters |= ( std::uint32_t( 1 ) << m_count );
+            }
+            m_parameters[m_count++] = m_current;
+        }
+        m_current = 0;
+    }
+
+    void advance_csi( char32_t c ) noexcept
+    {
+        if( ( c >= '0' ) && ( c <= '9' ) )
+        {
+            const unsigned int value = m_current * 10u + static_cast<unsigned int>( c - '0' );
+            m_current = static_cast<std::uint16_t>( ( value > 0xFFFFu ) ? 0xFFFFu : value );
+        }
+        else if( ( c == ';' ) || ( c == ':' ) )
+        {
+            push_parameter();
+            m_nextIsSubparameter = ( c == ':' );
+        }
+        else if( ( c >= 0x3C ) && ( c <= 0x3F ) )
+        {
+            m_privateMarker = static_cast<char>( c );
+        }
+        else if( ( c >= 0x20 ) && ( c <= 0x2F ) )
+        {
+            m_intermediate = true;
+        }
+        else if( c >= 0x40 )
+        {
+            push_parameter();
+            m_csiFinal = static_cast<char>( c );
+            m_state = State::TEXT;
+        }
+        else if( c == static_cast<unsigned char>( ESC ) )
+        {
+            m_state = State::ESCAPE;
+        }
+    }
+
+    State m_state = State::TEXT;
+    bool m_nextIsSubparameter = false;
+    bool m_intermediate = false;
+    char m_privateMarker = 0;
+    char m_csiFinal = 0;
+    std::uint16_t m_current = 0;
+    std::size_t m_count = 0;
+    std::uint32_t m_subparameters = 0;
+    std::uint16_t m_parameters[ANSI_MAX_CSI_PARAMETERS] = {};
+};
+
+} // namespace
+
+#endif // header guard
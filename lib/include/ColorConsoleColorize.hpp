@@ -0,0 +1,273 @@
+/**
+ * @file
+ * @brief      Pattern-based colorizing of plain text
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLECOLORIZE_HPP_
+#define COLORCONSOLECOLORIZE_HPP_
+
+#include "ColorConsole.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ColorConsole
+{
+
+/**
+ * Pattern to colorize and its color.
+ */
+struct ColorizeRule
+{
+    std::string pattern;  ///< Keyword or shape (see Colorizer)
+    Color color;          ///< Color of the matches
+};
+
+/**
+ * Compiled set of patterns to colorize in plain text.
+ *
+ * Two kinds of patterns are supported:
+ *  - Keywords: literal strings (e.g. @c "ERROR"), matched anywhere in the text, all of them in a single pass
+ *    using an Aho-Corasick automaton.
+ *  - Shapes: sequences of character classes and literal characters, each one optionally repeated, matched on
+ *    whole words (not preceded nor followed by a letter, digit, underscore or non-ASCII character). The classes
+ *    are <tt>\%d</tt> (digit), <tt>\%x</tt> (hexadecimal digit), <tt>\%a</tt> (ASCII letter) and <tt>\%w</tt>
+ *    (letter, digit or underscore); the repetitions are <tt>{n}</tt>, <tt>{n,}</tt>, <tt>{n,m}</tt>, <tt>+</tt>,
+ *    <tt>*</tt> and <tt>?</tt>, and are greedy (there is no backtracking); <tt>\%</tt> escapes the next character.
+ *    Malformed repetitions are taken literally. Shapes match at most 256 characters.
+ *
+ * When matches overlap, the leftmost one is colorized, and the longest one among those starting at the same
+ * position. Escape sequences are not recognized, so the text shall be plain.
+ *
+ * The set is immutable once constructed, so that it can be shared by several ColorizeScanner (also from
+ * different threads).
+ *
+ * @code
+ * const Colorizer colorizer( { { "ERROR", Color::FG_LIGHT_RED }, { "WARN", Color::FG_YELLOW } },
+ *                            { { std::string( Colorizer::IPV4_SHAPE ), Color::FG_LIGHT_CYAN },
+ *                              { "req-%x{8,}", Color::FG_LIGHT_MAGENTA } } );
+ * @endcode
+ */
+class COLORCONSOLE_API Colorizer
+{
+public:
+    /**
+     * Shape of IPv4 addresses.
+     */
+    static constexpr std::string_view IPV4_SHAPE = "%d{1,3}.%d{1,3}.%d{1,3}.%d{1,3}";
+
+    /**
+     * Shape of UUIDs.
+     */
+    static constexpr std::string_view UUID_SHAPE = "%x{8}-%x{4}-%x{4}-%x{4}-%x{12}";
+
+    /**
+     * Constructor.
+     *
+     * @param[in] keywords Keywords to colorize (empty ones are ignored; for duplicates, the first one applies)
+     * @param[in] shapes Shapes to colorize (for matches of the same text, keywords take precedence, and then the
+     *                   first shape)
+     */
+    explicit Colorizer( const std::vector<ColorizeRule> &keywords, const std::vector<ColorizeRule> &shapes = {} );
+
+private:
+    friend class ColorizeScanner;
+
+    static constexpr std::uint32_t NO_KEYWORD = UINT32_MAX;
+
+    static constexpr std::uint8_t WORD_BYTE = 0x01;
+    static constexpr std::uint8_t KEYWORD_START = 0x02;
+    static constexpr std::uint8_t SHAPE_START = 0x04;
+
+    static constexpr std::size_t MAX_KEYWORD_STARTS = 8;
+
+    struct Keyword
+    {
+        std::uint32_t length;
+        Color color;
+        std::uint32_t next;  // Next shorter keyword which is a suffix of this one
+    };
+
+    static constexpr std::uint16_t SHAPE_MATCH = UINT16_MAX - 1;
+    static constexpr std::uint16_t SHAPE_FAIL = UINT16_MAX;
+
+    /**
+     * Shape compiled into a DFA over byte classes, whose states are the positions (element and repetition count)
+     * of the greedy matching. Its transitions lead to SHAPE_MATCH when the shape is complete and the byte is a
+     * word boundary (the match ending before it), or to SHAPE_FAIL.
+     */
+    struct Shape
+    {
+        std::uint8_t byteClass[256];
+        std::size_t classCount;
+        std::vector<std::uint16_t> transitions;
+        std::vector<bool> complete;  // States in which the end of the text completes the shape
+        Color color;
+    };
+
+    void build_automaton( const std::vector<ColorizeRule> &keywords );
+    static bool compile_shape( const ColorizeRule &rule, Shape &shape );
+
+    // Aho-Corasick automaton, as a DFA over byte classes (bytes not used by any keyword share a class)
+    std::uint8_t m_byteClass[256];
+    std::size_t m_classCount;
+    std::vector<std::uint32_t> m_transitions;
+    std::vector<std::uint32_t> m_depth;
+    std::vector<std::uint32_t> m_output;
+    std::vector<Keyword> m_keywords;
+
+    // First bytes of the keywords (only stored if there are up to MAX_KEYWORD_STARTS), to skip text using SIMD
+    std::uint8_t m_keywordStarts[MAX_KEYWORD_STARTS];
+    std::size_t m_keywordStartCount;
+
+    std::vector<Shape> m_shapes;
+
+    std::uint8_t m_byteFlags[256];
+};
+
+/**
+ * Incremental colorizer of plain text, which splits it into runs of plain and colorized text using a Colorizer.
+ *
+ * Text can be processed in chunks of any size: matches split across chunks are found. Only the text that can
+ * still be part of a match is held between chunks (at most the longest keyword or shape), so memory usage does
+ * not depend on the size of the text. When no match is in progress, the text is skipped looking only for the
+ * bytes that can start a match (using SSE2, when available and there are only a few distinct first bytes of
+ * keywords and no shapes), and shapes are matched directly on the chunk from the start of each word.
+ */
+class COLORCONSOLE_API ColorizeScanner
+{
+public:
+    /**
+     * Function that receives the runs of text, with their color if they are colorized.
+     */
+    using Writer = std::function<void( std::string_view text, std::optional<Color> color )>;
+
+    /**
+     * Constructor.
+     *
+     * @param[in] colorizer Patterns to colorize (shall outlive the scanner)
+     * @param[in] writer Function that receives the runs of text
+     */
+    ColorizeScanner( const Colorizer &colorizer, Writer writer );
+
+    /**
+     * Processes a chunk of text, writing the runs that are complete.
+     *
+     * @param[in] chunk Chunk of text
+     */
+    void process( std::string_view chunk );
+
+    /**
+     * Ends the text, writing the runs held, and resets the scanner to process a new text.
+     */
+    void finish();
+
+private:
+    struct Match
+    {
+        std::uint64_t start;
+        std::uint64_t end;
+        Color color;
+        std::size_t precedence;  // Among matches of the same text, the lowest one is colorized
+    };
+
+    struct ShapeTracker
+    {
+        std::size_t shape;
+        std::uint64_t start;
+        std::uint16_t state;
+    };
+
+    void add_keyword_matches( std::uint32_t state, std::uint64_t end );
+    void add_match( std::uint64_t start, std::uint64_t end, Color color, std::size_t precedence );
+    void match_shapes( const unsigned char *p, const unsigned char *end, std::uint64_t position );
+    void advance_shapes( unsigned char c, std::uint64_t position );
+    bool advance_shape( ShapeTracker &tracker, unsigned char c, std::uint64_t position );
+    std::uint64_t get_horizon( std::uint64_t position ) const noexcept;
+    void commit_matches( std::uint64_t horizon );
+    void emit( std::uint64_t end, std::optional<Color> color );
+
+    const Colorizer &m_colorizer;
+    const Writer m_writer;
+
+    std::uint32_t m_state;
+    bool m_previousWord;
+    std::vector<ShapeTracker> m_shapeTrackers;
+    std::vector<Match> m_matches;
+    std::uint64_t m_committedEnd;
+
+    // Text not written yet: the held text followed by the chunk being processed
+    std::string m_held;
+    std::uint64_t m_emitted;
+    std::uint64_t m_chunkStart;
+    std::string_view m_chunk;
+};
+
+/**
+ * Unbuffered stream buffer that colorizes the plain text written into it using a Colorizer, and writes it into a
+ * Console, setting the color of each match and restoring the color of the console after it.
+ *
+ * Text that can still be part of a match is held until the match is decided, also when the stream buffer is
+ * flushed (line breaks decide all the matches in progress, unless a pattern contains them); it is written when
+ * the stream buffer is destroyed.
+ *
+ * @code
+ * ColorizeStreamBuf colorize( ColorConsole::cout, colorizer );
+ * std::ostream log( &colorize );
+ * thirdPartyComponent.set_log_stream( log );
+ * @endcode
+ */
+class COLORCONSOLE_API ColorizeStreamBuf : public std::streambuf
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param[in] target Console to write into (not owned)
+     * @param[in] colorizer Patterns to colorize (shall outlive the stream buffer)
+     */
+    ColorizeStreamBuf( Console &target, const Colorizer &colorizer );
+
+    /**
+     * Destructor. Writes the text held, if any.
+     */
+    ~ColorizeStreamBuf();
+
+    ColorizeStreamBuf( const ColorizeStreamBuf& ) = delete;
+    ColorizeStreamBuf& operator=( const ColorizeStreamBuf& ) = delete;
+
+    /**
+     * Returns the console the output is written into.
+     */
+    Console& get_target() const noexcept
+    {
+        return m_target;
+    }
+
+protected:
+    int_type overflow( int_type c ) override;
+
+    std::streamsize xsputn( const char_type *s, std::streamsize n ) override;
+
+    int sync() override;
+
+private:
+    void write_run( std::string_view text, std::optional<Color> color );
+
+    Console &m_target;
+    ColorizeScanner m_scanner;
+};
+
+} // namespace
+
+#endif // header guard
@@ -85,7 +85,7 @@ enum class Color
 /**
  * Combines colors.
  */
-inline Color operator|(Color a, Color b)
+constexpr Color operator|(Color a, Color b)
 {
     return static_cast<Color>(static_cast<int>(a) | static_cast<int>(b));
 }
@@ -0,0 +1,90 @@
+/**
+ * @file
+ * @brief      Stream buffer writing through C stdio streams for ColorConsole
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLEFILE_HPP_
+#define COLORCONSOLEFILE_HPP_
+
+#include "ColorConsoleCommon.hpp"
+
+#include <cstdio>
+#include <streambuf>
+
+namespace ColorConsole
+{
+
+/**
+ * Unbuffered stream buffer that writes into a C stdio stream (@c FILE*).
+ *
+ * Output is stored directly into the buffer of the C stream, therefore it keeps its order with respect to
+ * output written using C stdio functions (@c printf, @c fputs...) without requiring
+ * <tt>std::ios::sync_with_stdio(true)</tt>.
+ *
+ * Each write takes the C stream lock while the data (single characters included) is copied into the buffer of
+ * the C stream using the unlocked stdio functions where available, so that it is not interleaved with output
+ * from other threads. Lines written by several insertions (e.g. a chain of @c << with color changes) are kept
+ * together by holding the lock explicitly (see lock()), which also serializes threads sharing a console:
+ *
+ * @code
+ * std::lock_guard<FileStreamBuf> guard( buffer );
+ * console << Color::FG_LIGHT_RED << "error" << Color::RESET << ": " << message << '\n';
+ * @endcode
+ */
+class COLORCONSOLE_API FileStreamBuf : public std::streambuf
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param[in] file C stream to write to (not owned)
+     */
+    explicit FileStreamBuf( std::FILE *file ) noexcept
+    : m_file( file )
+    {}
+
+    FileStreamBuf( const FileStreamBuf& ) = delete;
+    FileStreamBuf& operator=( const FileStreamBuf& ) = delete;
+
+    /**
+     * Returns the C stream.
+     *
+     * @return The C stream
+     */
+    std::FILE* get_file() const noexcept
+    {
+        return m_file;
+    }
+
+    /**
+     * Locks the C stream, so that successive writes (e.g. the insertions of a line) are not interleaved with
+     * output from other threads.
+     *
+     * Locks are recursive, and each call shall be matched by a call to unlock() on the same thread (e.g. using
+     * @c std::lock_guard). Output written on the same thread using C stdio functions is not blocked by the lock.
+     */
+    void lock() noexcept;
+
+    /**
+     * Unlocks the C stream.
+     */
+    void unlock() noexcept;
+
+protected:
+    int_type overflow( int_type c ) override;
+
+    std::streamsize xsputn( const char_type *s, std::streamsize n ) override;
+
+    int sync() override;
+
+private:
+    std::FILE *m_file;
+};
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,158 @@
+/**
+ * @file
+ * @brief      std::format integration for ColorConsole
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLEFORMAT_HPP_
+#define COLORCONSOLEFORMAT_HPP_
+
+#include "ColorConsoleCommon.hpp"
+#include "ColorConsoleAnsi.hpp"
+
+#include <cstddef>
+#include <version>
+
+#if defined(__cpp_lib_format) && !defined(COLORCONSOLE_DISABLE_FORMAT)
+
+#include <algorithm>
+#include <format>
+
+/**
+ * Defined when the std::format integration (Console::print(), formatters for Color and styled()) is available.
+ */
+#define COLORCONSOLE_HAS_FORMAT
+
+namespace ColorConsole
+{
+
+/**
+ * Per-thread state shared between Console::print() and the Color formatters.
+ */
+struct FormatColorState
+{
+    bool active = false;                ///< Indicates if a Console is formatting in this thread
+    bool enabled = true;                ///< Indicates if escape sequences shall be emitted
+    bool changed = false;               ///< Indicates if a Color has been formatted (only if active)
+    Color currentColor = Color::RESET;  ///< Color in effect at the current formatting position (only if active)
+    std::size_t escapeCount = 0;        ///< Number of escape sequences emitted (only if active)
+    std::size_t escapeSize = 0;         ///< Size of the escape sequences emitted (only if active)
+};
+
+/**
+ * Returns the formatting state of the calling thread.
+ */
+inline FormatColorState& formatColorState() noexcept
+{
+    static thread_local FormatColorState state;
+    return state;
+}
+
+/**
+ * Value formatted with a color, which is restored after the value.
+ */
+template<class T>
+struct Styled
+{
+    const T &value;     ///< Value to format
+    Color color;        ///< Color of the value
+};
+
+/**
+ * Wraps a value to be formatted with a color.
+ *
+ * Format specifications (width, alignment, precision...) apply to the value, therefore padding is computed
+ * without the escape sequences.
+ *
+ * @code
+ * cout.print( "{:>8}: {}\n", styled( "ERROR", Color::FG_LIGHT_RED ), message );
+ * @endcode
+ *
+ * @param[in] value Value to format
+ * @param[in] color Color of the value
+ * @return Styled value
+ */
+template<class T>
+Styled<T> styled( const T &value, Color color ) noexcept
+{
+    return { value, color };
+}
+
+/**
+ * Writes the escape sequence for a color into a format output iterator, if enabled.
+ */
+template<class OutputIt>
+OutputIt formatColorEscape( Color color, OutputIt out )
+{
+    FormatColorState &state = formatColorState();
+
+    if( state.enabled )
+    {
+        const AnsiEscape escape = ansiEscape( color );
+        out = std::copy_n( escape.data(), escape.size(), out );
+
+        if( state.active )
+        {
+            state.escapeCount++;
+            state.escapeSize += escape.size();
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+/**
+ * Formatter for Color, which writes the escape sequence that sets the color.
+ *
+ * No format specification is accepted.
+ */
+template<>
+struct std::formatter<ColorConsole::Color, char>
+{
+    constexpr auto parse( std::format_parse_context &ctx )
+    {
+        auto it = ctx.begin();
+        if( ( it != ctx.end() ) && ( *it != '}' ) )
+        {
+            throw std::format_error( "Color does not accept format specifications" );
+        }
+        return it;
+    }
+
+    template<class FormatContext>
+    auto format( ColorConsole::Color color, FormatContext &ctx ) const
+    {
+        ColorConsole::FormatColorState &state = ColorConsole::formatColorState();
+        if( state.active )
+        {
+            state.changed = true;
+            state.currentColor = color;
+        }
+        return ColorConsole::formatColorEscape( color, ctx.out() );
+    }
+};
+
+/**
+ * Formatter for styled values, which accepts the format specifications of the wrapped value.
+ */
+template<class T>
+struct std::formatter<ColorConsole::Styled<T>, char> : std::formatter<T, char>
+{
+    template<class FormatContext>
+    auto format( const ColorConsole::Styled<T> &styled, FormatContext &ctx ) const
+    {
+        ColorConsole::FormatColorState &state = ColorConsole::formatColorState();
+
+        ctx.advance_to( ColorConsole::formatColorEscape( styled.color, ctx.out() ) );
+        ctx.advance_to( std::formatter<T, char>::format( styled.value, ctx ) );
+        return ColorConsole::formatColorEscape( state.active ? state.currentColor : ColorConsole::Color::RESET, ctx.out() );
+    }
+};
+
+#endif
+
+#endif // header guard
@@ -0,0 +1,351 @@
+/**
+ * @file
+ * @brief      Composition of colored text fragments for ColorConsole
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLEFRAGMENTS_HPP_
+#define COLORCONSOLEFRAGMENTS_HPP_
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleAnsi.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+
+namespace ColorConsole
+{
+
+/**
+ * Size of the stack buffer used to compose fragments before writing them into a console. Larger
+ * compositions use a temporary heap buffer.
+ */
+inline constexpr std::size_t FRAGMENT_INLINE_CAPACITY = 1024;
+
+/**
+ * Text fragment written with a color.
+ */
+struct ColoredText
+{
+    std::string_view text;
+    Color color;
+
+    template<class Visitor>
+    constexpr void visit( Visitor &visitor ) const
+    {
+        visitor.text( text, color );
+    }
+};
+
+/**
+ * Text fragment written with the color of the console.
+ */
+struct PlainText
+{
+    std::string_view text;
+
+    template<class Visitor>
+    constexpr void visit( Visitor &visitor ) const
+    {
+        visitor.text( text );
+    }
+};
+
+/**
+ * Concatenation of two fragments.
+ */
+template<class Left, class Right>
+struct FragmentConcat
+{
+    Left left;
+    Right right;
+
+    template<class Visitor>
+    constexpr void visit( Visitor &visitor ) const
+    {
+        left.visit( visitor );
+        right.visit( visitor );
+    }
+};
+
+template<class T>
+inline constexpr bool isFragment = false;
+
+template<>
+inline constexpr bool isFragment<ColoredText> = true;
+
+template<>
+inline constexpr bool isFragment<PlainText> = true;
+
+template<class Left, class Right>
+inline constexpr bool isFragment<FragmentConcat<Left, Right>> = true;
+
+/**
+ * Fragment or composition of fragments.
+ */
+template<class T>
+concept Fragment = isFragment<std::remove_cvref_t<T>>;
+
+/**
+ * Text that can be composed with fragments.
+ */
+template<class T>
+concept FragmentText = !Fragment<T> && std::is_convertible_v<const T&, std::string_view>;
+
+template<Fragment Left, Fragment Right>
+constexpr FragmentConcat<Left, Right> operator+( const Left &left, const Right &right )
+{
+    return { left, right };
+}
+
+template<Fragment Left, FragmentText Right>
+constexpr FragmentConcat<Left, PlainText> operator+( const Left &left, const Right &right )
+{
+    return { left, PlainText{ right } };
+}
+
+template<FragmentText Left, Fragment Right>
+constexpr FragmentConcat<PlainText, Right> operator+( const Left &left, const Right &right )
+{
+    return { PlainText{ left }, right };
+}
+
+/**
+ * Creates a fragment written with a color.
+ *
+ * Fragments are composed using the @c + operator with other fragments and strings, e.g.:
+ *
+ * @code
+ * cout << red( "E" ) + " " + dim( path ) + ": " + message << endl;
+ * @endcode
+ *
+ * Strings composed with colored fragments are written with the console color. A composition of fragments
+ * is written into the console at once, and leaves the console color unchanged.
+ *
+ * @param[in] text Text
+ * @param[in] color Color
+ * @return The fragment
+ */
+constexpr ColoredText colored( std::string_view text, Color color ) noexcept
+{
+    return { text, color };
+}
+
+constexpr ColoredText red( std::string_view text ) noexcept
+{
+    return { text, Color::FG_LIGHT_RED };
+}
+
+constexpr ColoredText green( std::string_view text ) noexcept
+{
+    return { text, Color::FG_LIGHT_GREEN };
+}
+
+constexpr ColoredText blue( std::string_view text ) noexcept
+{
+    return { text, Color::FG_LIGHT_BLUE };
+}
+
+constexpr ColoredText cyan( std::string_view text ) noexcept
+{
+    return { text, Color::FG_LIGHT_CYAN };
+}
+
+constexpr ColoredText magenta( std::string_view text ) noexcept
+{
+    return { text, Color::FG_LIGHT_MAGENTA };
+}
+
+constexpr ColoredText yellow( std::string_view text ) noexcept
+{
+    return { text, Color::FG_YELLOW };
+}
+
+constexpr ColoredText white( std::string_view text ) noexcept
+{
+    return { text, Color::FG_WHITE };
+}
+
+constexpr ColoredText dim( std::string_view text ) noexcept
+{
+    return { text, Color::FG_DARK_GREY };
+}
+
+namespace Detail
+{
+
+/**
+ * Visits fragments, sending the text and the minimal color transitions to the output.
+ */
+template<class Output>
+struct FragmentEmitter
+{
+    Output &output;
+    Color baseColor;
+    Color currentColor;
+
+    constexpr void text( std::string_view text )
+    {
+        this->text( text, baseColor );
+    }
+
+    constexpr void text( std::string_view text, Color color )
+    {
+        if( !text.empty() )
+        {
+            setColor( color );
+            output.text( text );
+        }
+    }
+
+    constexpr void setColor( Color color )
+    {
+        if( color != currentColor )
+        {
+            output.color( color );
+            currentColor = color;
+        }
+    }
+
+    constexpr void finish()
+    {
+        setColor( baseColor );
+    }
+};
+
+struct FragmentCounter
+{
+    std::size_t size = 0;
+    bool colors = true;
+
+    constexpr void text( std::string_view text )
+    {
+        size += text.size();
+    }
+
+    constexpr void color( Color color )
+    {
+        if( colors )
+        {
+            size += ansiEscape( color ).size();
+        }
+    }
+};
+
+struct FragmentWriter
+{
+    char *position;
+    bool colors = true;
+    std::size_t escapeCount = 0;
+    std::size_t escapeSize = 0;
+
+    void text( std::string_view text )
+    {
+        std::memcpy( position, text.data(), text.size() );
+        position += text.size();
+    }
+
+    void color( Color color )
+    {
+        if( colors )
+        {
+            const AnsiEscape escape = ansiEscape( color );
+            text( escape.view() );
+            escapeCount++;
+            escapeSize += escape.size();
+        }
+    }
+};
+
+struct FragmentConsoleWriter
+{
+    Console &console;
+
+    void text( std::string_view text )
+    {
+        console.write( text.data(), static_cast<std::streamsize>( text.size() ) );
+    }
+
+    void color( Color color )
+    {
+        console.set_color( color );
+    }
+};
+
+} // namespace Detail
+
+/**
+ * Computes the number of bytes of a composition of fragments, including the escape sequences.
+ *
+ * @param[in] fragments Fragments
+ * @param[in] baseColor Color in effect before writing the fragments, which is restored at the end
+ * @param[in] colors Indicates if the escape sequences shall be counted
+ * @return Number of bytes
+ */
+template<Fragment F>
+constexpr std::size_t fragmentsSize( const F &fragments, Color baseColor = Color::RESET, bool colors = true )
+{
+    Detail::FragmentCounter counter{ 0, colors };
+    Detail::FragmentEmitter<Detail::FragmentCounter> emitter{ counter, baseColor, baseColor };
+    fragments.visit( emitter );
+    emitter.finish();
+    return counter.size;
+}
+
+/**
+ * Inserter for compositions of fragments.
+ *
+ * The exact size of the composition is computed first, then the composition is rendered into a single
+ * buffer (on the stack for typical sizes) that is written into the console at once.
+ *
+ * @param[in,out] console Console to write to
+ * @param[in] fragments Fragments
+ * @return The console
+ */
+template<Fragment F>
+Console& operator<<( Console &console, const F &fragments )
+{
+    const Color baseColor = console.get_color();
+
+    if( console.is_coloring_enabled() && !console.uses_ansi_coloring() )
+    {
+        Detail::FragmentConsoleWriter writer{ console };
+        Detail::FragmentEmitter<Detail::FragmentConsoleWriter> emitter{ writer, baseColor, baseColor };
+        fragments.visit( emitter );
+        emitter.finish();
+        return console;
+    }
+
+    const bool colors = console.uses_ansi_coloring();
+    const std::size_t size = fragmentsSize( fragments, baseColor, colors );
+
+    char inlineBuffer[FRAGMENT_INLINE_CAPACITY];
+    std::unique_ptr<char[]> heapBuffer;
+    char *buffer = inlineBuffer;
+
+    if( size > FRAGMENT_INLINE_CAPACITY )
+    {
+        heapBuffer.reset( new char[size] );
+        buffer = heapBuffer.get();
+    }
+
+    Detail::FragmentWriter writer{ buffer, colors };
+    Detail::FragmentEmitter<Detail::FragmentWriter> emitter{ writer, baseColor, baseColor };
+    fragments.visit( emitter );
+    emitter.finish();
+
+    console.write( buffer, static_cast<std::streamsize>( size ) );
+    console.account_escapes( writer.escapeCount, writer.escapeSize );
+
+    return console;
+}
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,187 @@
+/**
+ * @file
+ * @brief      Cached size of the terminals of the consoles
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLEGEOMETRY_HPP_
+#define COLORCONSOLEGEOMETRY_HPP_
+
+#include "ColorConsoleCommon.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+namespace ColorConsole
+{
+
+/**
+ * Size of a terminal, in character cells.
+ */
+struct TerminalSize
+{
+    std::uint16_t columns = 0;  ///< Number of columns
+    std::uint16_t rows = 0;     ///< Number of rows
+
+    bool operator==( const TerminalSize& ) const = default;
+};
+
+/**
+ * Cached size of a terminal.
+ *
+ * The size is queried on first use and cached in an atomic, so that reading it only costs an atomic load.
+ * When the terminal is resized, notify_resize() (which is async-signal-safe) marks the cached size as stale,
+ * and it is queried again on the next read, invoking then the resize callback (see on_resize()). When the
+ * output is not a terminal (e.g. redirected to a file), the default size is returned.
+ *
+ * The geometries of the standard output and error (see for_console()) are queried using @c ioctl(TIOCGWINSZ)
+ * (or the console screen buffer on Windows), and they are notified by a @c SIGWINCH handler installed on their
+ * first use, which chains to the previously installed handler. Applications that install their own @c SIGWINCH
+ * handler afterwards shall call notify_resize() from it. On Windows there are no resize notifications, so
+ * refresh() shall be called to read the current size.
+ *
+ * @code
+ * TerminalGeometry &geometry = TerminalGeometry::for_console( ColorConsole::cout );
+ * WrapStreamBuf wrap( std::cout.rdbuf(), geometry.get_size().columns );
+ * geometry.on_resize( [&wrap]( TerminalSize size ) { wrap.set_width( size.columns ); } );
+ * @endcode
+ */
+class COLORCONSOLE_API TerminalGeometry
+{
+public:
+    /**
+     * Function that queries the size of the terminal, returning @c false if the output is not a terminal.
+     */
+    using Query = std::function<bool( TerminalSize &size )>;
+
+    /**
+     * Function invoked when the size of the terminal changes.
+     */
+    using ResizeCallback = std::function<void( TerminalSize size )>;
+
+    /**
+     * Default size of the outputs that are not terminals.
+     */
+    static constexpr TerminalSize DEFAULT_SIZE = { 80, 24 };
+
+    /**
+     * Constructor.
+     *
+     * @param[in] query Function that queries the size of the terminal (if empty, the output is not a terminal)
+     * @param[in] defaultSize Size returned if the output is not a terminal
+     */
+    explicit TerminalGeometry( Query query, TerminalSize defaultSize = DEFAULT_SIZE );
+
+    TerminalGeometry( const TerminalGeometry& ) = delete;
+    TerminalGeometry& operator=( const TerminalGeometry& ) = delete;
+
+    /**
+     * Returns the geometry of the terminal of a console type: the standard output or error, or for custom
+     * consoles a geometry that is never a terminal (shared by all of them).
+     *
+     * The geometries are never destroyed.
+     *
+     * @param[in] type Console type
+     * @return The geometry
+     */
+    static TerminalGeometry& for_console_type( ConsoleType type );
+
+    /**
+     * Returns the geometry of the terminal of a console (see for_console_type()).
+     *
+     * @param[in] console Console
+     * @return The geometry
+     */
+    template<class ConsoleT>
+    static TerminalGeometry& for_console( const ConsoleT &console )
+    {
+        return for_console_type( console.get_console_type() );
+    }
+
+    /**
+     * Returns the size of the terminal, or the default size if the output is not a terminal.
+     */
+    TerminalSize get_size()
+    {
+        return unpack( get_state() );
+    }
+
+    /**
+     * Indicates if the output is a terminal.
+     */
+    bool is_terminal()
+    {
+        return ( ( get_state() & TERMINAL ) != 0 );
+    }
+
+    /**
+     * Sets the size returned if the output is not a terminal.
+     *
+     * @param[in] size Default size
+     */
+    void set_default_size( TerminalSize size );
+
+    /**
+     * Sets the function invoked (by the thread that reads the size) when the size of the terminal changes.
+     *
+     * @param[in] callback Callback (empty to remove it)
+     */
+    void on_resize( ResizeCallback callback );
+
+    /**
+     * Marks the cached size as stale, so that it is queried again on the next read. Async-signal-safe.
+     */
+    void notify_resize() noexcept
+    {
+        m_state.fetch_or( STALE, std::memory_order_relaxed );
+    }
+
+    /**
+     * Queries the size of the terminal, invoking the resize callback if it changed.
+     *
+     * @return The size of the terminal, or the default size if the output is not a terminal
+     */
+    TerminalSize refresh();
+
+private:
+    static constexpr std::uint64_t TERMINAL = std::uint64_t( 1 ) << 32;
+    static constexpr std::uint64_t STALE = std::uint64_t( 1 ) << 33;
+
+    static constexpr std::uint64_t pack( TerminalSize size ) noexcept
+    {
+        return size.columns | ( std::uint64_t( size.rows ) << 16 );
+    }
+
+    static constexpr TerminalSize unpack( std::uint64_t state ) noexcept
+    {
+        return TerminalSize{ static_cast<std::uint16_t>( state ), static_cast<std::uint16_t>( state >> 16 ) };
+    }
+
+    std::uint64_t get_state()
+    {
+        const std::uint64_t state = m_state.load( std::memory_order_acquire );
+        if( ( state & STALE ) != 0 ) [[unlikely]]
+        {
+            refresh();
+            return m_state.load( std::memory_order_acquire );
+        }
+        return state;
+    }
+
+    const Query m_query;
+    std::atomic<std::uint64_t> m_state;
+
+    std::mutex m_mutex;
+    TerminalSize m_defaultSize;
+    ResizeCallback m_callback;
+    bool m_queried;
+};
+
+} // namespace
+
+#endif // header guard
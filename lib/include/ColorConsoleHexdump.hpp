@@ -0,0 +1,69 @@
+/**
+ * @file
+ * @brief      Colored hexadecimal dumps of binary data
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLEHEXDUMP_HPP_
+#define COLORCONSOLEHEXDUMP_HPP_
+
+#include "ColorConsoleCommon.hpp"
+#include "ColorConsole.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace ColorConsole
+{
+
+/**
+ * Layout and colors of a hexadecimal dump.
+ *
+ * The bytes are colored by class: zero, printable ASCII (0x20 to 0x7E), control (0x01 to 0x1F and 0x7F) and
+ * high-bit (0x80 to 0xFF). RESET leaves a class (or the offsets) in the default color.
+ */
+struct HexdumpOptions
+{
+    std::size_t bytesPerLine = 16;                 ///< Bytes on each line (0 is taken as 16)
+    std::size_t groupSize = 8;                     ///< Bytes between the extra spaces of the hex column (0 for none)
+    std::uint64_t offset = 0;                      ///< Offset shown for the first byte
+    bool ascii = true;                             ///< Whether the ASCII column is written
+    Color offsetColor = Color::RESET;              ///< Color of the offsets
+    Color zeroColor = Color::FG_DARK_GREY;         ///< Color of the zero bytes
+    Color printableColor = Color::FG_LIGHT_CYAN;   ///< Color of the printable ASCII bytes
+    Color controlColor = Color::FG_LIGHT_GREEN;    ///< Color of the control bytes
+    Color highColor = Color::FG_YELLOW;            ///< Color of the high-bit bytes
+};
+
+/**
+ * Writes a hexadecimal dump of binary data into a console, in the format of <tt>hexdump -C</tt>: the offset
+ * of each line (at least 8 hexadecimal digits), the bytes in hexadecimal, and the bytes in ASCII between
+ * bars, with non-printable bytes shown as dots (repeated lines are not collapsed).
+ *
+ * The lines are formatted into a buffer, which is written into the console in blocks of lines (each of them
+ * as a single write), and then the console is flushed. The hexadecimal digits are looked up in a table, and
+ * the classes of the bytes and the ASCII column are computed 16 bytes at a time using SSE2 where available.
+ * The color is only switched where the class of the bytes changes (the spaces between bytes keep it, unless it
+ * has a background), so runs of bytes of the same class cost a single escape sequence. Colors are only written
+ * if the console uses ANSI escape sequences.
+ *
+ * The current console color (see Console::get_color()) is taken as the starting color of the output and is
+ * restored after the dump.
+ *
+ * @code
+ * hexdump( ColorConsole::cout, std::as_bytes( std::span( frame.data(), frame.size() ) ) );
+ * @endcode
+ *
+ * @param[in] console Console to write into
+ * @param[in] data Data to dump
+ * @param[in] options Layout and colors
+ */
+COLORCONSOLE_API void hexdump( Console &console, std::span<const std::byte> data, const HexdumpOptions &options = {} );
+
+} // namespace
+
+#endif // header guard
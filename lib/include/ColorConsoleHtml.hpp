@@ -0,0 +1,153 @@
+/**
+ * @file
+ * @brief      Conversion of colored text to HTML
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLEHTML_HPP_
+#define COLORCONSOLEHTML_HPP_
+
+#include "ColorConsoleCommon.hpp"
+#include "ColorConsoleSgr.hpp"
+
+#include <cstddef>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+namespace ColorConsole
+{
+
+/**
+ * Default prefix of the CSS classes used by HtmlConverter.
+ */
+inline constexpr std::string_view HTML_DEFAULT_CLASS_PREFIX = "cc-";
+
+/**
+ * Maximum length of the CSS class prefix used by HtmlConverter (longer prefixes are truncated, see
+ * HtmlConverter::class_prefix()).
+ */
+inline constexpr std::size_t HTML_MAX_CLASS_PREFIX_LENGTH = 16;
+
+/**
+ * Maximum length of the opening tag of a styled span written by HtmlConverter.
+ */
+inline constexpr std::size_t HTML_MAX_TAG_LENGTH = 384;
+
+/**
+ * Streaming converter of text with ANSI escape sequences to HTML.
+ *
+ * Text is split into runs of the same style (see SgrParser), which are written as @c span elements with CSS
+ * classes named after the library colors (e.g. <tt>cc-fg-light-red cc-bg-black</tt>) and the attributes
+ * (e.g. <tt>cc-underline</tt>), so light colors rendered by the library as bold basic colors get their light
+ * color class. 256-color and direct colors are written as inline styles. Adjacent runs that render the same
+ * span are merged.
+ *
+ * HTML special characters are escaped (locating them using SIMD instructions where available), and control
+ * characters other than tabs and newlines are dropped. The output is meant to be placed inside a @c pre
+ * element with the class <tt>cc-console</tt>, together with the stylesheet returned by stylesheet().
+ *
+ * Input is processed in chunks of any size using constant memory, so the converter can be fed from a
+ * stream of any length.
+ *
+ * @code
+ * HtmlConverter converter( file.rdbuf() );
+ * converter.write( chunk );
+ * ...
+ * converter.finish();
+ * @endcode
+ */
+class COLORCONSOLE_API HtmlConverter
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param[in] target Stream buffer to write the HTML into (not owned)
+     * @param[in] classPrefix Prefix of the CSS classes (see class_prefix())
+     */
+    explicit HtmlConverter( std::streambuf *target, std::string_view classPrefix = HTML_DEFAULT_CLASS_PREFIX ) noexcept;
+
+    /**
+     * Converts a chunk of text.
+     *
+     * @param[in] chunk Chunk of text
+     * @return @c true if the HTML was written successfully so far, @c false otherwise
+     */
+    bool write( std::string_view chunk );
+
+    /**
+     * Closes the open span (if any) and resets the style, e.g. at the end of the input.
+     *
+     * @return @c true if the HTML was written successfully so far, @c false otherwise
+     */
+    bool finish();
+
+    /**
+     * Returns the stream buffer the HTML is written into.
+     *
+     * @return The target stream buffer
+     */
+    std::streambuf* get_target() const noexcept
+    {
+        return m_target;
+    }
+
+    /**
+     * Indicates if the HTML was written successfully so far.
+     */
+    bool good() const noexcept
+    {
+        return m_good;
+    }
+
+    /**
+     * Returns the part of a CSS class prefix that is used by the converter and the stylesheet.
+     *
+     * The prefix is cut at the first character that is not an ASCII letter, digit, hyphen or underscore, and
+     * at HTML_MAX_CLASS_PREFIX_LENGTH characters, so that it can be written into HTML attributes and CSS
+     * selectors without escaping. A prefix starting with a digit is not used at all.
+     *
+     * @param[in] classPrefix Prefix of the CSS classes
+     * @return The prefix used
+     */
+    static std::string_view class_prefix( std::string_view classPrefix ) noexcept;
+
+    /**
+     * Returns the CSS stylesheet defining the classes used by the converter.
+     *
+     * @param[in] classPrefix Prefix of the CSS classes (see class_prefix())
+     * @return The stylesheet
+     */
+    static std::string stylesheet( std::string_view classPrefix = HTML_DEFAULT_CLASS_PREFIX );
+
+    /**
+     * Converts a text to HTML.
+     *
+     * @param[in] text Text
+     * @param[in] classPrefix Prefix of the CSS classes (see class_prefix())
+     * @return The HTML (without the stylesheet or the enclosing @c pre element)
+     */
+    static std::string convert( std::string_view text, std::string_view classPrefix = HTML_DEFAULT_CLASS_PREFIX );
+
+private:
+    void write_run( const SgrStyle &style, std::string_view text );
+    void write_escaped( std::string_view text );
+    std::size_t render_tag( const SgrStyle &style, char *tag ) const noexcept;
+    void put( std::string_view text );
+
+    std::streambuf *m_target;
+    SgrParser m_parser;
+    bool m_good;
+    std::size_t m_prefixLength;
+    std::size_t m_openTagLength;
+    char m_prefix[HTML_MAX_CLASS_PREFIX_LENGTH];
+    char m_openTag[HTML_MAX_TAG_LENGTH];
+};
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,195 @@
+/**
+ * @file
+ * @brief      Streaming syntax-colored JSON pretty printer
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLEJSON_HPP_
+#define COLORCONSOLEJSON_HPP_
+
+#include "ColorConsoleCommon.hpp"
+#include "ColorConsole.hpp"
+#include "ColorConsoleAnsi.hpp"
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace ColorConsole
+{
+
+/**
+ * Colors of the JSON tokens. RESET leaves a kind of token in the default color.
+ */
+struct JsonColors
+{
+    Color key = Color::FG_LIGHT_BLUE;        ///< Color of the object keys
+    Color string = Color::FG_LIGHT_GREEN;    ///< Color of the string values
+    Color number = Color::FG_LIGHT_CYAN;     ///< Color of the numbers
+    Color literal = Color::FG_YELLOW;        ///< Color of @c true, @c false and @c null
+    Color punctuation = Color::RESET;        ///< Color of the brackets, braces, colons and commas
+};
+
+/**
+ * Streaming pretty printer of JSON text, which writes it into a Console indented and colored by token.
+ *
+ * The text is tokenized incrementally, so it can be processed in chunks of any size (e.g. as it is read), and
+ * each token is written as soon as it is read: no document tree is built and no token is held, so memory usage
+ * does not depend on the size of the text (only one bit per nesting level is kept, up to MAX_DEPTH levels).
+ * The bodies of the strings, copied as they are (escape sequences included), are scanned 16 bytes at a time
+ * using SSE2 where available. Several top-level values (e.g. JSON Lines) are printed one after another.
+ *
+ * The output of each chunk is written into the console as a single buffer (or a few, for large chunks), with
+ * the color switched only where it changes; colors are only written if the console uses ANSI escape sequences.
+ * The output of each chunk starts from the current console color (see Console::get_color()) and restores it.
+ *
+ * When the text is not valid JSON, it is written from the offending byte onwards, together with the whitespace
+ * skipped before it in the same chunk (whitespace skipped at the end of previous chunks is not kept), and the
+ * error is reported. As it is untrusted, that text is written sanitized (see SanitizeMode::ESCAPE), so that
+ * it can not alter the terminal state.
+ *
+ * @code
+ * JsonPrinter printer( ColorConsole::cout );
+ * while( ( n = read( fd, buffer, sizeof( buffer ) ) ) > 0 )
+ * {
+ *     printer.process( std::string_view( buffer, n ) );
+ * }
+ * printer.finish();
+ * @endcode
+ */
+class COLORCONSOLE_API JsonPrinter
+{
+public:
+    /**
+     * Maximum nesting depth of objects and arrays.
+     */
+    static constexpr std::size_t MAX_DEPTH = 1024;
+
+    /**
+     * Constructor.
+     *
+     * @param[in] console Console to write into (not owned)
+     * @param[in] colors Colors of the tokens
+     * @param[in] indent Number of spaces of each indentation level
+     */
+    explicit JsonPrinter( Console &console, const JsonColors &colors = {}, std::size_t indent = 2 );
+
+    /**
+     * Destructor. Finishes the text if not done yet.
+     */
+    ~JsonPrinter();
+
+    JsonPrinter( const JsonPrinter& ) = delete;
+    JsonPrinter& operator=( const JsonPrinter& ) = delete;
+
+    /**
+     * Processes a chunk of JSON text, writing its tokens.
+     *
+     * @param[in] chunk Chunk of text
+     * @return @c false if the text is not valid JSON (also for the chunks after the error)
+     */
+    bool process( std::string_view chunk );
+
+    /**
+     * Ends the text, completing its last token, and resets the printer to process a new text.
+     *
+     * @return @c false if the text is not valid JSON or ends in the middle of a value
+     */
+    bool finish();
+
+    /**
+     * Indicates if the text processed since the last finish() is not valid JSON.
+     */
+    bool has_error() const noexcept
+    {
+        return m_error;
+    }
+
+    /**
+     * Returns the offset of the byte where the text stopped being valid JSON (only meaningful if has_error()).
+     */
+    std::uint64_t get_error_offset() const noexcept
+    {
+        return m_errorOffset;
+    }
+
+private:
+    enum class Expect : std::uint8_t
+    {
+        VALUE,
+        FIRST_VALUE_OR_END,
+        FIRST_KEY_OR_END,
+        KEY,
+        COLON,
+        COMMA_OR_END
+    };
+
+    enum class Token : std::uint8_t
+    {
+        NONE,
+        STRING,
+        STRING_ESCAPE,
+        STRING_UNICODE,
+        NUMBER,
+        LITERAL
+    };
+
+    enum Role : std::uint8_t
+    {
+        KEY_ROLE,
+        STRING_ROLE,
+        NUMBER_ROLE,
+        LITERAL_ROLE,
+        PUNCTUATION_ROLE,
+        ROLE_COUNT
+    };
+
+    bool process_byte( char c );
+    bool begin_value( char c );
+    void begin_string( Role role );
+    bool open_container( char c, bool object );
+    void close_container( char c );
+    void end_value();
+    void fail( std::uint64_t offset, std::string_view rest );
+
+    void append_output( std::string_view text );
+    void append_invalid( std::string_view text );
+    void set_role( Role role );
+    void reset_color();
+    void restore_console_color();
+    void append_spaces( std::size_t count );
+    void new_line( std::size_t depth );
+    void write_output();
+
+    Console &m_console;
+    const std::size_t m_indent;
+    const bool m_ansi;
+    Color m_colors[ROLE_COUNT];
+    AnsiEscape m_escapes[ROLE_COUNT];
+
+    Expect m_expect;
+    Token m_token;
+    Role m_tokenRole;
+    std::uint8_t m_tokenState;         // Number grammar state, or hexadecimal digits of a \u escape
+    const char *m_literalRest;         // Characters of the literal not read yet
+    bool m_pendingOpen;                // An object or array has been opened, but its contents are not known yet
+    std::size_t m_depth;
+    std::bitset<MAX_DEPTH> m_objects;  // Whether each nesting level is an object (or an array)
+
+    bool m_error;
+    std::uint64_t m_offset;
+    std::uint64_t m_errorOffset;
+
+    std::string m_output;
+    Color m_outputColor;
+    bool m_lineOpen;                   // Text has been written after the last line break
+};
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,261 @@
+/**
+ * @file
+ * @brief      Live region of progress bars at the bottom of a console
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLELIVEREGION_HPP_
+#define COLORCONSOLELIVEREGION_HPP_
+
+#include "ColorConsoleCommon.hpp"
+#include "ColorConsole.hpp"
+#include "ColorConsoleGeometry.hpp"
+#include "ColorConsoleSgr.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace ColorConsole
+{
+
+/**
+ * Progress bar (or spinner, if its total is 0) of a LiveRegion.
+ *
+ * Its state is updated using relaxed atomic operations, therefore it can be updated from any thread without
+ * locking, and the updates are rendered by the next frame of the region.
+ */
+class COLORCONSOLE_API ProgressBar
+{
+public:
+    /**
+     * Sets the progress.
+     */
+    void set( std::uint64_t value ) noexcept
+    {
+        m_value.store( value, std::memory_order_relaxed );
+    }
+
+    /**
+     * Increments the progress.
+     */
+    void advance( std::uint64_t increment = 1 ) noexcept
+    {
+        m_value.fetch_add( increment, std::memory_order_relaxed );
+    }
+
+    /**
+     * Sets the total (0 for a spinner).
+     */
+    void set_total( std::uint64_t total ) noexcept
+    {
+        m_total.store( total, std::memory_order_relaxed );
+    }
+
+    /**
+     * Marks the task as finished (the bar is rendered as complete and spinners stop).
+     */
+    void finish() noexcept
+    {
+        m_finished.store( true, std::memory_order_relaxed );
+    }
+
+    /**
+     * Returns the progress.
+     */
+    std::uint64_t get_value() const noexcept
+    {
+        return m_value.load( std::memory_order_relaxed );
+    }
+
+    /**
+     * Returns the total (0 for a spinner).
+     */
+    std::uint64_t get_total() const noexcept
+    {
+        return m_total.load( std::memory_order_relaxed );
+    }
+
+    /**
+     * Indicates if the task is finished.
+     */
+    bool is_finished() const noexcept
+    {
+        return m_finished.load( std::memory_order_relaxed );
+    }
+
+    /**
+     * Returns the label.
+     */
+    const std::string& get_label() const noexcept
+    {
+        return m_label;
+    }
+
+private:
+    friend class LiveRegion;
+
+    ProgressBar( std::string_view label, std::uint64_t total )
+    : m_label( label ), m_value( 0 ), m_total( total ), m_finished( false )
+    {}
+
+    const std::string m_label;
+    std::atomic<std::uint64_t> m_value;
+    std::atomic<std::uint64_t> m_total;
+    std::atomic<bool> m_finished;
+};
+
+/**
+ * Region at the bottom of a console that displays progress bars and spinners, while the other output of the
+ * console scrolls above it.
+ *
+ * The region takes over the stream buffer of the console: complete lines written into the console are
+ * written above the region (which is redrawn below them in the same write, inside a synchronized update),
+ * and incomplete lines are held until they are completed. The console shall not be written while the region
+ * exists other than through its stream (e.g. not with @c printf).
+ *
+ * The region is rendered by frames at a limited rate: tick() renders a frame if the frame interval has
+ * elapsed since the previous one, and start() runs a thread that renders the frames. A frame only redraws
+ * the lines of the bars that changed. If the console does not use ANSI escape codes (e.g. coloring is
+ * disabled because it is redirected to a file), the bars are not drawn while in progress, and a line with
+ * the final state of each bar is written when it finishes.
+ *
+ * @code
+ * LiveRegion region( ColorConsole::cout );
+ * ProgressBar &download = region.add_bar( "download", totalBytes );
+ * region.start();
+ * // From any thread:
+ * download.advance( chunkSize );
+ * ColorConsole::cout << Color::FG_YELLOW << "retrying" << Color::RESET << ColorConsole::endl;
+ * @endcode
+ */
+class COLORCONSOLE_API LiveRegion
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param[in] console Console to display the region on (not owned)
+     * @param[in] fps Maximum frames per second (at least 1)
+     * @param[in] width Width of the terminal (lines are truncated to fit in it), or 0 to follow the size of the
+     *                  terminal of the console (see TerminalGeometry)
+     */
+    explicit LiveRegion( Console &console, unsigned int fps = 10, std::size_t width = 0 );
+
+    /**
+     * Destructor. Stops the render thread, renders the final frame, writes any incomplete line held and
+     * gives back the stream buffer to the console.
+     */
+    ~LiveRegion();
+
+    LiveRegion( const LiveRegion& ) = delete;
+    LiveRegion& operator=( const LiveRegion& ) = delete;
+
+    /**
+     * Adds a progress bar at the bottom of the region.
+     *
+     * @param[in] label Label
+     * @param[in] total Total of the progress
+     * @return The progress bar, which is valid while the region exists
+     */
+    ProgressBar& add_bar( std::string_view label, std::uint64_t total );
+
+    /**
+     * Adds a spinner (i.e. a progress bar without total) at the bottom of the region.
+     *
+     * @param[in] label Label
+     * @return The spinner, which is valid while the region exists
+     */
+    ProgressBar& add_spinner( std::string_view label )
+    {
+        return add_bar( label, 0 );
+    }
+
+    /**
+     * Renders a frame if the frame interval has elapsed since the previous frame and no other thread is
+     * rendering. Can be called from any thread.
+     */
+    void tick();
+
+    /**
+     * Renders a frame now.
+     */
+    void render();
+
+    /**
+     * Starts a thread that renders the frames.
+     */
+    void start();
+
+    /**
+     * Stops the render thread.
+     */
+    void stop();
+
+private:
+    /**
+     * Stream buffer that writes the output of the console above the region.
+     */
+    class OutputBuffer : public std::streambuf
+    {
+    public:
+        explicit OutputBuffer( LiveRegion &region ) : m_region( region ) {}
+
+    protected:
+        int_type overflow( int_type c ) override;
+        std::streamsize xsputn( const char_type *s, std::streamsize n ) override;
+        int sync() override;
+
+    private:
+        LiveRegion &m_region;
+    };
+
+    void write_output( std::string_view data );
+    void start_frame();
+    void append_frame( bool final );
+    void flush_frame();
+    void append_cursor_up( std::size_t lines );
+    std::string format_line( const ProgressBar &bar ) const;
+    void run();
+
+    Console &m_console;
+    std::streambuf *m_target;
+    OutputBuffer m_outputBuffer;
+    bool m_ansi;
+    TerminalGeometry *m_geometry;
+    std::size_t m_width;
+    std::chrono::steady_clock::duration m_frameInterval;
+    std::atomic<std::chrono::steady_clock::rep> m_nextFrame;
+
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<ProgressBar>> m_bars;
+    std::vector<std::string> m_lines;
+    std::vector<bool> m_reported;
+    std::size_t m_drawnLines;
+    unsigned long m_frame;
+    std::string m_pendingOutput;
+    std::string m_frameBuffer;
+    std::size_t m_frameHeaderSize;
+    SgrParser m_outputParser;
+
+    std::thread m_thread;
+    std::mutex m_threadMutex;
+    std::condition_variable m_threadCondition;
+    bool m_running;
+};
+
+} // namespace
+
+#endif // header guard
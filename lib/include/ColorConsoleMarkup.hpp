@@ -0,0 +1,649 @@
+/**
+ * @file
+ * @brief      Color markup templates for ColorConsole
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLEMARKUP_HPP_
+#define COLORCONSOLEMARKUP_HPP_
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleAnsi.hpp"
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace ColorConsole
+{
+
+/**
+ * Maximum nesting depth of markup tags.
+ */
+inline constexpr std::size_t MARKUP_MAX_DEPTH = 16;
+
+/**
+ * Maximum index of the argument slots of markup templates.
+ */
+inline constexpr std::size_t MARKUP_MAX_ARGUMENT_INDEX = 9999;
+
+/**
+ * Markup syntax errors.
+ */
+enum class MarkupError
+{
+    NONE,               ///< No error
+    UNTERMINATED_TAG,   ///< A tag was opened with '{' but not closed with '}'
+    UNMATCHED_BRACE,    ///< A '}' was found outside a tag (use "}}" for a literal brace)
+    EMPTY_TAG,          ///< A tag, or one of its comma-separated items, is empty
+    UNKNOWN_COLOR,      ///< A color (or style) name is not known
+    UNBALANCED_CLOSE,   ///< A closing tag "{/}" was found without a matching opening tag
+    NESTING_TOO_DEEP    ///< More than MARKUP_MAX_DEPTH tags are open at the same time
+};
+
+/**
+ * Result of parsing a markup template.
+ */
+struct MarkupStatus
+{
+    MarkupError error = MarkupError::NONE;  ///< Error found, if any
+    std::size_t position = 0;               ///< Position in the template where the error was found
+};
+
+/**
+ * Color change inside a compiled markup.
+ */
+struct MarkupColorChange
+{
+    std::size_t position;   ///< Position in the plain text where the color changes
+    Color color;            ///< New color
+};
+
+/**
+ * Non-owning view of a compiled markup, as written into a Console.
+ */
+struct MarkupView
+{
+    std::string_view ansi;              ///< Text with the ANSI escape sequences embedded
+    std::string_view plain;             ///< Text without colors
+    const MarkupColorChange *changes;   ///< Color changes (positions refer to the plain text)
+    std::size_t changeCount;            ///< Number of color changes
+    Color finalColor;                   ///< Console color after writing the markup (only valid if changeCount > 0)
+};
+
+/**
+ * Looks up a color name.
+ *
+ * Color names are the lowercase names of the foreground Colors without the @c FG_ prefix (e.g. @c light_red),
+ * plus the short aliases @c blue, @c green, @c cyan, @c red, @c magenta (dark variants), and @c grey / @c gray
+ * (light grey).
+ *
+ * @param[in] name Color name
+ * @param[out] index Foreground index of the color (0 to 15)
+ * @return @c true if the name is known, @c false otherwise
+ */
+constexpr bool lookupColorName( std::string_view name, unsigned int &index ) noexcept
+{
+    struct NamedColor
+    {
+        std::string_view name;
+        unsigned int index;
+    };
+
+    constexpr NamedColor namedColors[] =
+    {
+        { "black", 0x0 }, { "dark_blue", 0x1 }, { "dark_green", 0x2 }, { "dark_cyan", 0x3 },
+        { "dark_red", 0x4 }, { "dark_magenta", 0x5 }, { "brown", 0x6 }, { "light_grey", 0x7 },
+        { "light_gray", 0x7 }, { "dark_grey", 0x8 }, { "dark_gray", 0x8 }, { "light_blue", 0x9 },
+        { "light_green", 0xA }, { "light_cyan", 0xB }, { "light_red", 0xC }, { "light_magenta", 0xD },
+        { "yellow", 0xE }, { "white", 0xF },
+        { "blue", 0x1 }, { "green", 0x2 }, { "cyan", 0x3 }, { "red", 0x4 }, { "magenta", 0x5 },
+        { "grey", 0x7 }, { "gray", 0x7 }
+    };
+
+    for( const NamedColor &namedColor : namedColors )
+    {
+        if( namedColor.name == name )
+        {
+            index = namedColor.index;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Returns @p base with its foreground replaced by the foreground with the given index.
+ */
+constexpr Color withForeground( Color base, unsigned int index ) noexcept
+{
+    unsigned int value = ( base >= Color::RESET ) ? 0u : static_cast<unsigned int>( base );
+    return static_cast<Color>( ( value & ~0x0Fu ) | ( index & 0x0Fu ) );
+}
+
+/**
+ * Returns @p base with its background replaced by the background with the given index.
+ *
+ * Index 0 selects BG_BLACK, unless @p none is @c true, in which case BG_NONE is selected.
+ */
+constexpr Color withBackground( Color base, unsigned int index, bool none = false ) noexcept
+{
+    unsigned int value = ( base >= Color::RESET ) ? 0u : static_cast<unsigned int>( base );
+    value &= ~( 0xF0u | static_cast<unsigned int>( Color::BG_BLACK ) );
+
+    if( index != 0 )
+    {
+        value |= ( index & 0x0Fu ) << 4;
+    }
+    else if( !none )
+    {
+        value |= static_cast<unsigned int>( Color::BG_BLACK );
+    }
+
+    return static_cast<Color>( value );
+}
+
+/**
+ * Default resolver for plain (non-prefixed) names in markup tags, which interprets them as foreground colors.
+ */
+struct MarkupColorResolver
+{
+    constexpr bool operator()( std::string_view name, Color base, Color &result ) const noexcept
+    {
+        unsigned int index = 0;
+        if( lookupColorName( name, index ) )
+        {
+            result = withForeground( base, index );
+            return true;
+        }
+        return false;
+    }
+};
+
+/**
+ * Applies a markup tag (the text between braces) to a base color.
+ *
+ * @param[in] tag Tag contents
+ * @param[in] base Color in effect where the tag is opened
+ * @param[in] resolver Resolver for plain names
+ * @param[out] result Resulting color
+ * @return Error found, if any
+ */
+template<class Resolver>
+constexpr MarkupError applyMarkupTag( std::string_view tag, Color base, const Resolver &resolver, Color &result )
+{
+    result = ( base >= Color::RESET ) ? Color::FG_BLACK : base;
+
+    while( true )
+    {
+        std::size_t separator = tag.find( ',' );
+        std::string_view item = tag.substr( 0, separator );
+
+        while( !item.empty() && ( item.front() == ' ' ) )
+        {
+            item.remove_prefix( 1 );
+        }
+        while( !item.empty() && ( item.back() == ' ' ) )
+        {
+            item.remove_suffix( 1 );
+        }
+
+        if( item.empty() )
+        {
+            return MarkupError::EMPTY_TAG;
+        }
+
+        unsigned int index = 0;
+
+        if( item.substr( 0, 3 ) == "fg:" )
+        {
+            if( !lookupColorName( item.substr( 3 ), index ) )
+            {
+                return MarkupError::UNKNOWN_COLOR;
+            }
+            result = withForeground( result, index );
+        }
+        else if( item.substr( 0, 3 ) == "bg:" )
+        {
+            std::string_view name = item.substr( 3 );
+            if( ( name == "none" ) || ( name == "default" ) )
+            {
+                result = withBackground( result, 0, true );
+            }
+            else if( lookupColorName( name, index ) )
+            {
+                result = withBackground( result, index );
+            }
+            else
+            {
+                return MarkupError::UNKNOWN_COLOR;
+            }
+        }
+        else if( !resolver( item, result, result ) )
+        {
+            return MarkupError::UNKNOWN_COLOR;
+        }
+
+        if( separator == std::string_view::npos )
+        {
+            return MarkupError::NONE;
+        }
+
+        tag.remove_prefix( separator + 1 );
+    }
+}
+
+/**
+ * Parses an argument slot tag (empty or a decimal number).
+ *
+ * @param[in] tag Tag contents
+ * @param[in] nextArgument Index of the argument referred by an empty slot
+ * @param[out] index Index of the argument
+ * @return @c true if the tag is an argument slot, @c false otherwise (also if the index is greater than
+ *         MARKUP_MAX_ARGUMENT_INDEX)
+ */
+constexpr bool parseMarkupArgument( std::string_view tag, std::size_t nextArgument, std::size_t &index ) noexcept
+{
+    if( tag.empty() )
+    {
+        index = nextArgument;
+        return true;
+    }
+
+    index = 0;
+    for( char c : tag )
+    {
+        if( ( c < '0' ) || ( c > '9' ) )
+        {
+            return false;
+        }
+        index = ( index * 10 ) + static_cast<std::size_t>( c - '0' );
+        if( index > MARKUP_MAX_ARGUMENT_INDEX )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Parses a markup template.
+ *
+ * Markup templates are plain text with embedded color tags:
+ * - <tt>{name}</tt> or <tt>{fg:name}</tt> sets the foreground color, keeping the enclosing background.
+ * - <tt>{bg:name}</tt> sets the background color, keeping the enclosing foreground (<tt>{bg:none}</tt> selects
+ *   the default background).
+ * - Several items can be combined in a tag separated by commas, e.g. <tt>{fg:yellow,bg:dark_red}</tt>.
+ * - <tt>{/}</tt> closes the innermost open tag, returning to the color in effect before it was opened (RESET
+ *   when closing the outermost tag).
+ * - <tt>{{</tt> and <tt>}}</tt> represent literal braces.
+ * - <tt>{}</tt> and <tt>{N}</tt> (where N is a decimal number up to MARKUP_MAX_ARGUMENT_INDEX) are argument
+ *   slots, which are only accepted if the sink provides the member function <tt>argument( std::size_t )</tt>.
+ *   <tt>{}</tt> refers to the argument that follows the previous slot (or the first argument).
+ *
+ * When a tag is opened outside any other tag, the components not set by the tag take their zero values
+ * (FG_BLACK foreground, BG_NONE background), exactly as when inserting the equivalent Color.
+ *
+ * The parser reports the text and color changes to the sink, which must provide the member functions
+ * <tt>text( std::string_view )</tt> and <tt>color( Color )</tt>.
+ *
+ * @param[in] markup Markup template
+ * @param[in,out] sink Receiver of the parsed text and colors
+ * @param[in] resolver Resolver for plain names in tags
+ * @return Parsing status
+ */
+template<class Sink, class Resolver = MarkupColorResolver>
+constexpr MarkupStatus parseMarkup( std::string_view markup, Sink &sink, const Resolver &resolver = Resolver() )
+{
+    Color stack[MARKUP_MAX_DEPTH + 1] = { Color::RESET };
+    std::size_t depth = 0;
+    std::size_t nextArgument = 0;
+    std::size_t textStart = 0;
+    std::size_t i = 0;
+
+    while( i < markup.size() )
+    {
+        char c = markup[i];
+
+        if( ( c == '{' ) || ( c == '}' ) )
+        {
+            if( ( ( i + 1 ) < markup.size() ) && ( markup[i + 1] == c ) )
+            {
+                sink.text( markup.substr( textStart, i + 1 - textStart ) );
+                i += 2;
+                textStart = i;
+                continue;
+            }
+
+            if( c == '}' )
+            {
+                return { MarkupError::UNMATCHED_BRACE, i };
+            }
+
+            if( textStart < i )
+            {
+                sink.text( markup.substr( textStart, i - textStart ) );
+            }
+
+            std::size_t tagEnd = markup.find( '}', i + 1 );
+            if( tagEnd == std::string_view::npos )
+            {
+                return { MarkupError::UNTERMINATED_TAG, i };
+            }
+
+            std::string_view tag = markup.substr( i + 1, tagEnd - i - 1 );
+
+            if constexpr( requires { sink.argument( std::size_t() ); } )
+            {
+                std::size_t argumentIndex = 0;
+                if( parseMarkupArgument( tag, nextArgument, argumentIndex ) )
+                {
+                    sink.argument( argumentIndex );
+                    nextArgument = argumentIndex + 1;
+                    i = tagEnd + 1;
+                    textStart = i;
+                    continue;
+                }
+            }
+
+            if( tag == "/" )
+            {
+                if( depth == 0 )
+                {
+                    return { MarkupError::UNBALANCED_CLOSE, i };
+                }
+                depth--;
+            }
+            else
+            {
+                if( depth == MARKUP_MAX_DEPTH )
+                {
+                    return { MarkupError::NESTING_TOO_DEEP, i };
+                }
+
+                MarkupError error = applyMarkupTag( tag, stack[depth], resolver, stack[depth + 1] );
+                if( error != MarkupError::NONE )
+                {
+                    return { error, i };
+                }
+                depth++;
+            }
+
+            sink.color( stack[depth] );
+
+            i = tagEnd + 1;
+            textStart = i;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    if( textStart < markup.size() )
+    {
+        sink.text( markup.substr( textStart ) );
+    }
+
+    return { MarkupError::NONE, markup.size() };
+}
+
+/**
+ * Markup sink that coalesces color changes, so that only the colors actually in effect when text is written
+ * (and the final color) are reported to the derived sink.
+ */
+template<class Derived>
+struct MarkupCoalescingSink
+{
+    Color pendingColor = Color::RESET;
+    Color emittedColor = Color::RESET;
+    bool hasPendingColor = false;
+    bool hasEmittedColor = false;
+
+    constexpr void text( std::string_view text )
+    {
+        if( !text.empty() )
+        {
+            commitColor();
+            static_cast<Derived*>( this )->emitText( text );
+        }
+    }
+
+    constexpr void color( Color color )
+    {
+        pendingColor = color;
+        hasPendingColor = true;
+    }
+
+    constexpr void commitColor()
+    {
+        if( hasPendingColor && ( !hasEmittedColor || ( pendingColor != emittedColor ) ) )
+        {
+            static_cast<Derived*>( this )->emitColor( pendingColor );
+            emittedColor = pendingColor;
+            hasEmittedColor = true;
+        }
+        hasPendingColor = false;
+    }
+};
+
+/**
+ * Sizes of a compiled markup.
+ */
+struct MarkupSizes
+{
+    MarkupStatus status;
+    std::size_t ansiSize = 0;
+    std::size_t plainSize = 0;
+    std::size_t changeCount = 0;
+};
+
+/**
+ * Compiled markup, holding the text with the escape sequences already embedded.
+ */
+template<std::size_t AnsiSize, std::size_t PlainSize, std::size_t ChangeCount>
+struct CompiledMarkup
+{
+    std::array<char, AnsiSize> ansi {};
+    std::array<char, PlainSize> plain {};
+    std::array<MarkupColorChange, ChangeCount> changes {};
+    Color finalColor = Color::RESET;
+
+    constexpr MarkupView view() const noexcept
+    {
+        return { std::string_view( ansi.data(), AnsiSize ), std::string_view( plain.data(), PlainSize ),
+                 changes.data(), ChangeCount, finalColor };
+    }
+};
+
+/**
+ * String literal usable as a template argument.
+ */
+template<std::size_t N>
+struct MarkupLiteral
+{
+    char value[N] {};
+
+    constexpr MarkupLiteral( const char (&str)[N] ) noexcept
+    {
+        for( std::size_t i = 0; i < N; i++ )
+        {
+            value[i] = str[i];
+        }
+    }
+
+    constexpr std::string_view view() const noexcept
+    {
+        return std::string_view( value, N - 1 );
+    }
+};
+
+namespace Detail
+{
+
+struct MarkupMeasuringSink : MarkupCoalescingSink<MarkupMeasuringSink>
+{
+    MarkupSizes sizes;
+
+    constexpr void emitText( std::string_view text )
+    {
+        sizes.ansiSize += text.size();
+        sizes.plainSize += text.size();
+    }
+
+    constexpr void emitColor( Color color )
+    {
+        sizes.ansiSize += ansiEscape( color ).size();
+        sizes.changeCount++;
+    }
+};
+
+template<class Compiled>
+struct MarkupFillingSink : MarkupCoalescingSink<MarkupFillingSink<Compiled>>
+{
+    Compiled &compiled;
+    std::size_t ansiPosition = 0;
+    std::size_t plainPosition = 0;
+    std::size_t changeIndex = 0;
+
+    constexpr MarkupFillingSink( Compiled &c ) : compiled( c ) {}
+
+    constexpr void emitText( std::string_view text )
+    {
+        for( char c : text )
+        {
+            compiled.ansi[ansiPosition++] = c;
+            compiled.plain[plainPosition++] = c;
+        }
+    }
+
+    constexpr void emitColor( Color color )
+    {
+        for( char c : ansiEscape( color ).view() )
+        {
+            compiled.ansi[ansiPosition++] = c;
+        }
+        compiled.changes[changeIndex++] = { plainPosition, color };
+        compiled.finalColor = color;
+    }
+};
+
+// These functions are intentionally not constexpr: calling them while compiling a markup template
+// triggers a compilation error whose diagnostic names the syntax error found.
+void markupErrorUnterminatedTag();
+void markupErrorUnmatchedBrace();
+void markupErrorEmptyTag();
+void markupErrorUnknownColor();
+void markupErrorUnbalancedClose();
+void markupErrorNestingTooDeep();
+
+constexpr void reportMarkupError( MarkupError error )
+{
+    switch( error )
+    {
+        case MarkupError::UNTERMINATED_TAG:
+            markupErrorUnterminatedTag();
+            break;
+        case MarkupError::UNMATCHED_BRACE:
+            markupErrorUnmatchedBrace();
+            break;
+        case MarkupError::EMPTY_TAG:
+            markupErrorEmptyTag();
+            break;
+        case MarkupError::UNKNOWN_COLOR:
+            markupErrorUnknownColor();
+            break;
+        case MarkupError::UNBALANCED_CLOSE:
+            markupErrorUnbalancedClose();
+            break;
+        case MarkupError::NESTING_TOO_DEEP:
+            markupErrorNestingTooDeep();
+            break;
+        case MarkupError::NONE:
+            break;
+    }
+}
+
+} // namespace Detail
+
+/**
+ * Measures the compiled sizes of a markup template.
+ *
+ * @param[in] markup Markup template
+ * @return Parsing status and sizes
+ */
+constexpr MarkupSizes measureMarkup( std::string_view markup )
+{
+    Detail::MarkupMeasuringSink sink;
+    sink.sizes.status = parseMarkup( markup, sink );
+    sink.commitColor();
+    return sink.sizes;
+}
+
+/**
+ * Indicates if a markup template is valid.
+ *
+ * @param[in] markup Markup template
+ * @return @c true if the template is valid, @c false otherwise
+ */
+constexpr bool isValidMarkup( std::string_view markup )
+{
+    return ( measureMarkup( markup ).status.error == MarkupError::NONE );
+}
+
+/**
+ * Compiles a markup template.
+ *
+ * Syntax errors in the template are reported as compilation errors.
+ */
+template<MarkupLiteral Literal>
+consteval auto compileMarkup()
+{
+    constexpr MarkupSizes sizes = measureMarkup( Literal.view() );
+
+    Detail::reportMarkupError( sizes.status.error );
+
+    using Compiled = CompiledMarkup<sizes.ansiSize, sizes.plainSize, sizes.changeCount>;
+
+    Compiled compiled;
+    Detail::MarkupFillingSink<Compiled> sink( compiled );
+    parseMarkup( Literal.view(), sink );
+    sink.commitColor();
+
+    return compiled;
+}
+
+/**
+ * Compile-time color markup.
+ *
+ * The markup template is parsed and validated at compile time (see parseMarkup() for the syntax), and is
+ * compiled into a contiguous text with the color escape sequences already embedded, that is written into a
+ * Console at once:
+ *
+ * @code
+ * cout << markup<"{fg:light_red}ERROR{/} {bg:blue}x{/}"> << endl;
+ * @endcode
+ */
+template<MarkupLiteral Literal>
+inline constexpr auto markup = compileMarkup<Literal>();
+
+/**
+ * Inserter for compiled markups.
+ *
+ * @param[in,out] console Console to write to
+ * @param[in] markup Compiled markup
+ * @return The console
+ */
+template<std::size_t AnsiSize, std::size_t PlainSize, std::size_t ChangeCount>
+Console& operator<<( Console &console, const CompiledMarkup<AnsiSize, PlainSize, ChangeCount> &markup )
+{
+    return console << markup.view();
+}
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,111 @@
+/**
+ * @file
+ * @brief      Palette of named styles for ColorConsole runtime markup
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLEPALETTE_HPP_
+#define COLORCONSOLEPALETTE_HPP_
+
+#include "ColorConsoleMarkup.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ColorConsole
+{
+
+/**
+ * Table of named styles (semantic names like @c warn or @c error associated to Colors), used to resolve
+ * style names in runtime markup templates (see Console::printm()).
+ *
+ * A style replaces both the foreground and the background colors.
+ *
+ * Palettes are not thread-safe: they must not be modified while they are being used to print.
+ */
+class COLORCONSOLE_API Palette
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param[in] withDefaults Indicates if the default styles shall be added
+     */
+    explicit Palette( bool withDefaults = true );
+
+    /**
+     * Sets (adds or replaces) a style.
+     *
+     * @param[in] name Style name
+     * @param[in] color Style color
+     */
+    void set( std::string_view name, Color color );
+
+    /**
+     * Removes a style.
+     *
+     * @param[in] name Style name
+     * @return @c true if the style existed, @c false otherwise
+     */
+    bool remove( std::string_view name );
+
+    /**
+     * Looks up a style.
+     *
+     * @param[in] name Style name
+     * @param[out] color Style color
+     * @return @c true if the style exists, @c false otherwise
+     */
+    bool find( std::string_view name, Color &color ) const noexcept;
+
+    /**
+     * Returns the palette version, which changes each time the palette is modified.
+     *
+     * Versions are unique among all palettes.
+     *
+     * @return The palette version
+     */
+    unsigned long long get_version() const noexcept
+    {
+        return m_version;
+    }
+
+    /**
+     * Returns the palette used by consoles that have no palette set.
+     *
+     * It contains the default styles: @c error (light red), @c warn and @c warning (yellow), @c info
+     * (light cyan), @c ok and @c success (light green), @c note (light blue) and @c debug (dark grey).
+     *
+     * @return The default palette
+     */
+    static Palette& default_palette();
+
+private:
+    struct Style
+    {
+        std::string name;
+        Color color;
+    };
+
+    void touch() noexcept;
+
+    std::vector<Style> m_styles;
+    unsigned long long m_version;
+};
+
+/**
+ * Validates a runtime markup template.
+ *
+ * @param[in] markup Markup template
+ * @param[in] palette Palette used to resolve style names
+ * @return Validation status
+ */
+COLORCONSOLE_API MarkupStatus validateMarkup( std::string_view markup, const Palette &palette = Palette::default_palette() );
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,424 @@
+/**
+ * @file
+ * @brief      Color rendering policies and policy-based consoles
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLEPOLICIES_HPP_
+#define COLORCONSOLEPOLICIES_HPP_
+
+#include "ColorConsoleCommon.hpp"
+#include "ColorConsoleAnsi.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#ifdef WIN32
+#include "windows.h"
+#endif
+
+namespace ColorConsole
+{
+
+/**
+ * Policy that renders colors into an output stream.
+ *
+ * A color policy provides a <tt>set_color( std::ostream &out, Color color )</tt> member function, which is
+ * called each time the color of a BasicConsole is set.
+ */
+template<class Policy>
+concept ColorPolicy = requires( Policy &policy, std::ostream &out, Color color )
+{
+    policy.set_color( out, color );
+};
+
+/**
+ * Color policy that renders colors as ANSI escape sequences.
+ */
+struct AnsiColorPolicy
+{
+    void set_color( std::ostream &out, Color color )
+    {
+        const AnsiEscape escape = ansiEscape( color );
+        out.write( escape.data(), static_cast<std::streamsize>( escape.size() ) );
+    }
+};
+
+/**
+ * Color policy that does not render colors.
+ */
+struct NoColorPolicy
+{
+    void set_color( std::ostream&, Color ) noexcept
+    {}
+};
+
+/**
+ * Run of text written with the same color, as recorded by RecordingColorPolicy.
+ */
+struct ColorRun
+{
+    Color color;            ///< Color
+    std::string_view text;  ///< Text
+};
+
+/**
+ * Color policy that records the text and the color changes in memory, instead of rendering them.
+ *
+ * The policy is also the stream buffer of the consoles that use it, and stores the text written into them.
+ */
+class RecordingColorPolicy : public std::streambuf
+{
+public:
+    void set_color( std::ostream&, Color color )
+    {
+        if( color >= Color::RESET )
+        {
+            color = Color::RESET;
+        }
+
+        if( !m_changes.empty() && ( m_changes.back().position == m_text.size() ) )
+        {
+            m_changes.back().color = color;
+        }
+        else
+        {
+            m_changes.push_back( { m_text.size(), color } );
+        }
+    }
+
+    /**
+     * Returns the recorded text, without colors.
+     *
+     * @return The recorded text
+     */
+    std::string_view text() const noexcept
+    {
+        return m_text;
+    }
+
+    /**
+     * Returns the recorded text split in runs of the same color.
+     *
+     * Text written before setting any color has the RESET color. Empty runs are omitted, and consecutive
+     * runs with the same color are merged.
+     *
+     * @return The recorded runs
+     */
+    std::vector<ColorRun> runs() const
+    {
+        std::vector<ColorRun> result;
+        Color color = Color::RESET;
+        std::size_t start = 0;
+
+        auto addRun = [&]( std::size_t end )
+        {
+            if( end > start )
+            {
+                if( !result.empty() && ( result.back().color == color ) )
+                {
+                    result.back().text = std::string_view( result.back().text.data(), result.back().text.size() + ( end - start ) );
+                }
+                else
+                {
+                    result.push_back( { color, std::string_view( m_text ).substr( start, end - start ) } );
+                }
+            }
+            start = end;
+        };
+
+        for( const Change &change : m_changes )
+        {
+            addRun( change.position );
+            color = change.color;
+        }
+
+        addRun( m_text.size() );
+
+        return result;
+    }
+
+    /**
+     * Discards the recorded text and color changes.
+     */
+    void clear() noexcept
+    {
+        m_text.clear();
+        m_changes.clear();
+    }
+
+protected:
+    int_type overflow( int_type c ) override
+    {
+        if( !traits_type::eq_int_type( c, traits_type::eof() ) )
+        {
+            m_text.push_back( traits_type::to_char_type( c ) );
+        }
+        return traits_type::not_eof( c );
+    }
+
+    std::streamsize xsputn( const char_type *s, std::streamsize n ) override
+    {
+        m_text.append( s, static_cast<std::size_t>( n ) );
+        return n;
+    }
+
+private:
+    struct Change
+    {
+        std::size_t position;
+        Color color;
+    };
+
+    std::string m_text;
+    std::vector<Change> m_changes;
+};
+
+/**
+ * Color policy selected at runtime, used by Console.
+ *
+ * Colors are rendered as ANSI escape sequences, using the attributes of a Windows native console, or not
+ * rendered at all, depending on the mode set.
+ */
+class COLORCONSOLE_API DynamicColorPolicy
+{
+public:
+    /**
+     * Color rendering mode.
+     */
+    enum class Mode
+    {
+        NONE,       ///< Colors are not rendered
+        ANSI,       ///< Colors are rendered as ANSI escape sequences
+        NATIVE      ///< Colors are rendered setting the attributes of a Windows native console
+    };
+
+    void set_color( std::ostream &out, Color color );
+
+    void set_mode( Mode mode ) noexcept
+    {
+        m_mode = mode;
+    }
+
+    Mode get_mode() const noexcept
+    {
+        return m_mode;
+    }
+
+#ifdef WIN32
+    /**
+     * Sets the Windows native console used in NATIVE mode.
+     *
+     * @param[in] handle Console handle
+     * @param[in] defaultAttributes Attributes set when the color is reset
+     */
+    void set_native_console( HANDLE handle, WORD defaultAttributes ) noexcept
+    {
+        m_handle = handle;
+        m_defaultAttributes = defaultAttributes;
+    }
+
+    HANDLE get_native_handle() const noexcept
+    {
+        return m_handle;
+    }
+
+    WORD get_default_attributes() const noexcept
+    {
+        return m_defaultAttributes;
+    }
+#endif
+
+private:
+    Mode m_mode = Mode::ANSI;
+
+#ifdef WIN32
+    HANDLE m_handle = INVALID_HANDLE_VALUE;
+    WORD m_defaultAttributes = 0;
+#endif
+};
+
+/**
+ * Output stream with text coloring capabilities, whose color rendering is selected at compile time by a
+ * policy (see ColorPolicy).
+ *
+ * Setting a color calls the policy directly, without any runtime dispatch. E.g. consoles using
+ * NoColorPolicy reduce to a plain output stream.
+ *
+ * @code
+ * BasicConsole<AnsiColorPolicy> out( std::cout.rdbuf() );
+ * out << Color::FG_LIGHT_RED << "Error" << Color::RESET << std::endl;
+ * @endcode
+ *
+ * @tparam Policy Color policy
+ */
+template<ColorPolicy Policy>
+class BasicConsole : public std::ostream
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param[in] sb Stream buffer where the stream will write to
+     * @param[in] policy Color policy
+     */
+    explicit BasicConsole( std::streambuf *sb, Policy policy = Policy() )
+    : std::ostream( sb ), m_policy( std::move( policy ) )
+    {}
+
+    /**
+     * Constructor for policies that are also stream buffers (e.g. RecordingColorPolicy).
+     *
+     * @param[in] policy Color policy
+     */
+    explicit BasicConsole( Policy policy = Policy() ) requires std::derived_from<Policy, std::streambuf>
+    : std::ostream( NULL ), m_policy( std::move( policy ) )
+    {
+        rdbuf( &m_policy );
+    }
+
+    BasicConsole( const BasicConsole& ) = delete;
+    BasicConsole& operator=( const BasicConsole& ) = delete;
+
+    /**
+     * Destructor.
+     *
+     * Resets the color if it was left set.
+     */
+    ~BasicConsole()
+    {
+        if( m_currentColor != Color::RESET )
+        {
+            m_policy.set_color( *this, Color::RESET );
+        }
+    }
+
+    /**
+     * Sets (or resets) the console color.
+     *
+     * @param[in] color Color to be set, or RESET to reset to default value
+     */
+    void set_color( Color color )
+    {
+        m_currentColor = color;
+        m_policy.set_color( *this, color );
+    }
+
+    /**
+     * Returns the current console color.
+     *
+     * @return The last color set, or RESET if no color has been set yet
+     */
+    Color get_color() const noexcept
+    {
+        return m_currentColor;
+    }
+
+    /**
+     * Returns the color policy.
+     *
+     * @return The color policy
+     */
+    Policy& get_policy() noexcept
+    {
+        return m_policy;
+    }
+
+    const Policy& get_policy() const noexcept
+    {
+        return m_policy;
+    }
+
+    /**
+     * Sets (or resets) the console color.
+     *
+     * @param[in] color Color to be set, or RESET to reset to default value
+     * @return The console object (*this)
+     */
+    BasicConsole& operator<<( Color color )
+    {
+        set_color( color );
+        return *this;
+    }
+
+    /**
+     * Inserter for any value that can be inserted into an output stream.
+     *
+     * @param[in] value Value
+     * @return The console object (*this)
+     */
+    template<class T>
+    BasicConsole& operator<<( const T &value ) requires requires( std::ostream &out ) { out << value; }
+    {
+        *(static_cast<std::ostream*>(this)) << value;
+        return *this;
+    }
+
+    /**
+     * Inserter for ostream manipulators.
+     *
+     * @param[in] pf Manipulator
+     * @return The console object (*this)
+     */
+    BasicConsole& operator<<( std::ostream& (*pf)(std::ostream&) )
+    {
+        (*pf)(*this);
+        return *this;
+    }
+
+    /**
+     * Inserter for ios manipulators.
+     *
+     * @param[in] pf Manipulator
+     * @return The console object (*this)
+     */
+    BasicConsole& operator<<( std::ios& (*pf)(std::ios&) )
+    {
+        (*pf)(*this);
+        return *this;
+    }
+
+    /**
+     * Inserter for ios_base manipulators.
+     *
+     * @param[in] pf Manipulator
+     * @return The console object (*this)
+     */
+    BasicConsole& operator<<( std::ios_base& (*pf)(std::ios_base&) )
+    {
+        (*pf)(*this);
+        return *this;
+    }
+
+private:
+    Policy m_policy;
+    Color m_currentColor = Color::RESET;
+};
+
+/**
+ * Console that renders colors as ANSI escape sequences.
+ */
+using AnsiConsole = BasicConsole<AnsiColorPolicy>;
+
+/**
+ * Console that does not render colors.
+ */
+using PlainConsole = BasicConsole<NoColorPolicy>;
+
+/**
+ * Console that records the text and colors written into it.
+ */
+using RecordingConsole = BasicConsole<RecordingColorPolicy>;
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,374 @@
+/**
+ * @file
+ * @brief      Compact binary recording of colored output
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLERECORDING_HPP_
+#define COLORCONSOLERECORDING_HPP_
+
+#include "ColorConsoleCommon.hpp"
+#include "ColorConsoleSgr.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ColorConsole
+{
+
+/**
+ * Maximum size of the text stored in a block of a recording.
+ */
+inline constexpr std::size_t RECORDING_BLOCK_TEXT_SIZE = 64 * 1024;
+
+/**
+ * Maximum number of different styles in a block of a recording.
+ */
+inline constexpr std::size_t RECORDING_BLOCK_MAX_STYLES = 64;
+
+/**
+ * Maximum number of runs in a block of a recording.
+ */
+inline constexpr std::size_t RECORDING_BLOCK_MAX_RUNS = 8192;
+
+/**
+ * Index entry of a block of a recording.
+ */
+struct RecordingBlockInfo
+{
+    std::uint64_t offset;       ///< Offset of the block in the recording
+    std::uint64_t time;         ///< Time of the first run of the block (milliseconds since the recording start)
+    std::uint64_t line;         ///< Line number (0-based) at the start of the block
+};
+
+/**
+ * Writer of recordings of colored output.
+ *
+ * A recording stores the text and the style runs separately, so that it can be replayed at any color
+ * capability, or filtered by style, without parsing escape sequences. Its format is:
+ *
+ * - A header: the magic @c CCRC, a version (16 bits) and the wall clock time of the recording start
+ *   (milliseconds since the Unix epoch, 64 bits).
+ * - Blocks of up to RECORDING_BLOCK_TEXT_SIZE bytes of text: the magic @c CCRB, the payload size (32 bits),
+ *   and the payload, which contains the time and line number at the block start, the table of styles used in
+ *   the block, the runs (style, text length and time increment) and the text. Blocks are self-contained.
+ * - An index of the blocks (their offsets, times and line numbers), followed by its offset (64 bits) and the
+ *   magic @c CCRE.
+ *
+ * Integers in the payloads and the index are stored as unsigned LEB128 varints, and fixed-size integers are
+ * stored in little endian. If the index is missing (e.g. the recording was interrupted), readers rebuild it
+ * from the block headers.
+ */
+class COLORCONSOLE_API RecordingWriter
+{
+public:
+    /**
+     * Constructor. Writes the recording header.
+     *
+     * @param[in] target Stream buffer to write the recording into (not owned)
+     */
+    explicit RecordingWriter( std::streambuf *target );
+
+    /**
+     * Destructor. Finishes the recording.
+     */
+    ~RecordingWriter();
+
+    RecordingWriter( const RecordingWriter& ) = delete;
+    RecordingWriter& operator=( const RecordingWriter& ) = delete;
+
+    /**
+     * Appends a run of text.
+     *
+     * Consecutive runs with the same style and time are merged.
+     *
+     * @param[in] style Style of the text
+     * @param[in] text Text
+     * @param[in] time Time of the text (milliseconds since the recording start, not decreasing)
+     */
+    void write( const SgrStyle &style, std::string_view text, std::uint64_t time );
+
+    /**
+     * Writes the current block (if not empty), e.g. to make the output recorded so far durable.
+     *
+     * @return @c true if the recording was written successfully so far, @c false otherwise
+     */
+    bool flush_block();
+
+    /**
+     * Writes the current block and the index. Further runs are ignored.
+     *
+     * @return @c true if the recording was written successfully, @c false otherwise
+     */
+    bool finish();
+
+    /**
+     * Returns the stream buffer the recording is written into.
+     */
+    std::streambuf* get_target() const noexcept
+    {
+        return m_target;
+    }
+
+    /**
+     * Indicates if the recording was written successfully so far.
+     */
+    bool good() const noexcept
+    {
+        return m_good;
+    }
+
+private:
+    struct Run
+    {
+        std::uint32_t style;
+        std::uint32_t length;
+        std::uint64_t time;
+    };
+
+    void put( const void *data, std::size_t size );
+
+    std::streambuf *m_target;
+    bool m_good;
+    bool m_finished;
+    std::uint64_t m_offset;
+    std::uint64_t m_line;
+    std::uint64_t m_blockLine;
+    std::vector<SgrStyle> m_styles;
+    std::vector<Run> m_runs;
+    std::string m_text;
+    std::string m_payload;
+    std::vector<RecordingBlockInfo> m_index;
+};
+
+/**
+ * Unbuffered stream buffer that records the colored output written into it (see RecordingWriter), e.g.
+ * from a Console with ANSI escape codes.
+ *
+ * @code
+ * std::ofstream file( "output.ccrec", std::ios::binary );
+ * RecordingStreamBuf recording( file.rdbuf() );
+ * Console console( &recording );
+ * @endcode
+ */
+class COLORCONSOLE_API RecordingStreamBuf : public std::streambuf
+{
+public:
+    /**
+     * Constructor. Starts the recording.
+     *
+     * @param[in] target Stream buffer to write the recording into (not owned)
+     */
+    explicit RecordingStreamBuf( std::streambuf *target );
+
+    /**
+     * Returns the recording writer, e.g. to finish the recording before destroying the stream buffer.
+     */
+    RecordingWriter& get_writer() noexcept
+    {
+        return m_writer;
+    }
+
+protected:
+    int_type overflow( int_type c ) override;
+
+    std::streamsize xsputn( const char_type *s, std::streamsize n ) override;
+
+    int sync() override;
+
+private:
+    RecordingWriter m_writer;
+    SgrParser m_parser;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+/**
+ * Reader of recordings of colored output.
+ *
+ * Blocks are located using the recording index, so that replaying from a time or line offset does not read
+ * the preceding blocks.
+ */
+class COLORCONSOLE_API RecordingReader
+{
+public:
+    /**
+     * Constructor. Reads the recording header and index.
+     *
+     * @param[in] input Input stream of the recording (must be seekable)
+     */
+    explicit RecordingReader( std::istream &input );
+
+    /**
+     * Indicates if the recording header is valid.
+     */
+    bool is_valid() const noexcept
+    {
+        return m_valid;
+    }
+
+    /**
+     * Returns the wall clock time of the recording start (milliseconds since the Unix epoch).
+     */
+    std::uint64_t get_start_time() const noexcept
+    {
+        return m_startTime;
+    }
+
+    /**
+     * Returns the index of the blocks.
+     */
+    const std::vector<RecordingBlockInfo>& get_blocks() const noexcept
+    {
+        return m_blocks;
+    }
+
+    /**
+     * Returns the first block that may contain runs at or after a time (i.e. the last block that starts before
+     * it, or the first block).
+     *
+     * @param[in] time Time (milliseconds since the recording start)
+     * @return The block index
+     */
+    std::size_t find_time( std::uint64_t time ) const noexcept;
+
+    /**
+     * Returns the block that contains the start of a line (i.e. the last block that starts before the line, or
+     * the first block).
+     *
+     * @param[in] line Line number (0-based)
+     * @return The block index
+     */
+    std::size_t find_line( std::uint64_t line ) const noexcept;
+
+    /**
+     * Reads the runs of a block.
+     *
+     * @param[in] block Block index
+     * @param[in] handler Callable invoked for each run with its style (as a <tt>const SgrStyle&</tt>), text
+     *                    (as a @c std::string_view) and time (as a @c std::uint64_t)
+     * @return @c true if the block was read successfully, @c false otherwise
+     */
+    template<class Handler>
+    bool read_block( std::size_t block, Handler &&handler )
+    {
+        if( !load_block( block ) )
+        {
+            return false;
+        }
+
+        std::size_t textPos = 0;
+
+        for( const Run &run : m_runs )
+        {
+            handler( static_cast<const SgrStyle&>( m_styles[run.style] ), std::string_view( m_payload.data() + m_textOffset + textPos, run.length ), run.time );
+            textPos += run.length;
+        }
+
+        return true;
+    }
+
+    /**
+     * Reads the runs from a time up to the end of the recording.
+     *
+     * @param[in] time Time (milliseconds since the recording start)
+     * @param[in] handler Callable invoked for each run (see read_block())
+     * @return @c true if the recording was read successfully, @c false otherwise
+     */
+    template<class Handler>
+    bool replay_from_time( std::uint64_t time, Handler &&handler )
+    {
+        for( std::size_t block = find_time( time ); block < m_blocks.size(); block++ )
+        {
+            const bool ok = read_block( block, [&]( const SgrStyle &style, std::string_view text, std::uint64_t runTime )
+            {
+                if( runTime >= time )
+                {
+                    handler( style, text, runTime );
+                }
+            } );
+
+            if( !ok )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * Reads the runs from the start of a line up to the end of the recording.
+     *
+     * @param[in] line Line number (0-based)
+     * @param[in] handler Callable invoked for each run (see read_block())
+     * @return @c true if the recording was read successfully, @c false otherwise
+     */
+    template<class Handler>
+    bool replay_from_line( std::uint64_t line, Handler &&handler )
+    {
+        for( std::size_t block = find_line( line ); block < m_blocks.size(); block++ )
+        {
+            std::uint64_t currentLine = m_blocks[block].line;
+
+            const bool ok = read_block( block, [&]( const SgrStyle &style, std::string_view text, std::uint64_t runTime )
+            {
+                // Skip the text of the lines before the requested one
+                while( ( currentLine < line ) && !text.empty() )
+                {
+                    const std::size_t newline = text.find( '\n' );
+                    if( newline == std::string_view::npos )
+                    {
+                        return;
+                    }
+                    text.remove_prefix( newline + 1 );
+                    currentLine++;
+                }
+
+                if( !text.empty() )
+                {
+                    handler( style, text, runTime );
+                }
+            } );
+
+            if( !ok )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+private:
+    struct Run
+    {
+        std::uint32_t style;
+        std::uint32_t length;
+        std::uint64_t time;
+    };
+
+    bool load_block( std::size_t block );
+    void rebuild_index();
+
+    std::istream &m_input;
+    bool m_valid;
+    std::uint64_t m_startTime;
+    std::vector<RecordingBlockInfo> m_blocks;
+    std::vector<SgrStyle> m_styles;
+    std::vector<Run> m_runs;
+    std::string m_payload;
+    std::size_t m_textOffset;
+};
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,185 @@
+/**
+ * @file
+ * @brief      Sanitizer of untrusted text for ColorConsole
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLESANITIZER_HPP_
+#define COLORCONSOLESANITIZER_HPP_
+
+#include "ColorConsoleCommon.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace ColorConsole
+{
+
+/**
+ * Handling of unsafe sequences in untrusted text.
+ *
+ * Unsafe sequences are C0 control characters (except tab and newline), DEL, C1 control characters
+ * (U+0080 to U+009F) and bytes that are not part of a valid UTF-8 sequence. Left as is, they could be
+ * used to forge colors, move the cursor or otherwise alter the terminal state.
+ */
+enum class SanitizeMode
+{
+    NONE,       ///< Text is written as is
+    REPLACE,    ///< Each unsafe sequence is replaced by U+FFFD (replacement character)
+    ESCAPE      ///< Each unsafe sequence is replaced by a visible escape (<tt>\\x1b</tt>, <tt>\\u009b</tt>...)
+};
+
+/**
+ * Maximum length of the text that replaces an unsafe sequence.
+ */
+inline constexpr std::size_t SANITIZE_MAX_REPLACEMENT_LENGTH = 6;
+
+/**
+ * Location of an unsafe sequence in a text.
+ */
+struct UnsafeSequence
+{
+    std::size_t position;   ///< Position of the sequence (the size of the text if none was found)
+    std::size_t length;     ///< Length of the sequence (0 if none was found)
+};
+
+/**
+ * Finds the first unsafe sequence in a text.
+ *
+ * Runs of safe ASCII characters are skipped using SIMD instructions where available (SSE2, or AVX2
+ * when supported by the CPU), therefore scanning clean ASCII text is about as fast as copying it.
+ *
+ * @param[in] text Text to scan
+ * @return The first unsafe sequence, or a sequence of length 0 positioned at the end of the text if
+ *         the text is safe
+ */
+COLORCONSOLE_API UnsafeSequence findUnsafeSequence( std::string_view text ) noexcept;
+
+/**
+ * Renders the text that replaces an unsafe sequence.
+ *
+ * @param[in] sequence Unsafe sequence (as found by findUnsafeSequence())
+ * @param[in] mode Sanitize mode (REPLACE or ESCAPE)
+ * @param[out] buffer Buffer to render into
+ * @return The replacement text
+ */
+inline std::string_view renderUnsafeSequence( std::string_view sequence, SanitizeMode mode,
+                                              char (&buffer)[SANITIZE_MAX_REPLACEMENT_LENGTH] ) noexcept
+{
+    constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+    if( mode == SanitizeMode::REPLACE )
+    {
+        return "\xEF\xBF\xBD";
+    }
+
+    if( sequence.size() == 2 )
+    {
+        // C1 control character encoded as 0xC2 0x80-0x9F
+        const unsigned char code = static_cast<unsigned char>( sequence[1] ) & 0x3Fu;
+        buffer[0] = '\\';
+        buffer[1] = 'u';
+        buffer[2] = '0';
+        buffer[3] = '0';
+        buffer[4] = HEX_DIGITS[( code | 0x80u ) >> 4];
+        buffer[5] = HEX_DIGITS[code & 0x0Fu];
+        return std::string_view( buffer, 6 );
+    }
+
+    const unsigned char byte = static_cast<unsigned char>( sequence[0] );
+    buffer[0] = '\\';
+    buffer[1] = 'x';
+    buffer[2] = HEX_DIGITS[byte >> 4];
+    buffer[3] = HEX_DIGITS[byte & 0x0Fu];
+    return std::string_view( buffer, 4 );
+}
+
+/**
+ * Sanitizes a text, passing the safe runs and the replacements of the unsafe sequences to a writer.
+ *
+ * @param[in] text Text to sanitize
+ * @param[in] mode Sanitize mode
+ * @param[in] writer Callable invoked with each piece of the sanitized text (as a @c std::string_view)
+ * @return The number of unsafe sequences found
+ */
+template<class Writer>
+std::size_t sanitizeText( std::string_view text, SanitizeMode mode, Writer &&writer )
+{
+    if( mode == SanitizeMode::NONE )
+    {
+        writer( text );
+        return 0;
+    }
+
+    std::size_t count = 0;
+    char buffer[SANITIZE_MAX_REPLACEMENT_LENGTH];
+
+    while( !text.empty() )
+    {
+        const UnsafeSequence unsafe = findUnsafeSequence( text );
+
+        if( unsafe.position > 0 )
+        {
+            writer( text.substr( 0, unsafe.position ) );
+        }
+
+        if( unsafe.length == 0 )
+        {
+            break;
+        }
+
+        writer( renderUnsafeSequence( text.substr( unsafe.position, unsafe.length ), mode, buffer ) );
+        text.remove_prefix( unsafe.position + unsafe.length );
+        count++;
+    }
+
+    return count;
+}
+
+/**
+ * Sanitizes a text into a string.
+ *
+ * @param[in] text Text to sanitize
+ * @param[in] mode Sanitize mode
+ * @return The sanitized text
+ */
+inline std::string sanitizeText( std::string_view text, SanitizeMode mode = SanitizeMode::ESCAPE )
+{
+    std::string result;
+    result.reserve( text.size() );
+    sanitizeText( text, mode, [&result]( std::string_view piece ) { result.append( piece ); } );
+    return result;
+}
+
+/**
+ * Untrusted text to be sanitized when inserted into a console.
+ */
+struct SanitizedText
+{
+    std::string_view text;  ///< Text
+    SanitizeMode mode;      ///< Sanitize mode
+};
+
+/**
+ * Marks untrusted text to be sanitized when inserted into a console.
+ *
+ * @code
+ * cout << "User: " << sanitized( userName ) << endl;
+ * @endcode
+ *
+ * @param[in] text Text
+ * @param[in] mode Sanitize mode
+ * @return The text to be inserted
+ */
+inline SanitizedText sanitized( std::string_view text, SanitizeMode mode = SanitizeMode::ESCAPE ) noexcept
+{
+    return SanitizedText { text, mode };
+}
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,206 @@
+/**
+ * @file
+ * @brief      Double-buffered full-screen rendering
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLESCREEN_HPP_
+#define COLORCONSOLESCREEN_HPP_
+
+#include "ColorConsoleCommon.hpp"
+#include "ColorConsole.hpp"
+#include "ColorConsoleSgr.hpp"
+#include "ColorConsoleTerminal.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ColorConsole
+{
+
+/**
+ * Double-buffered renderer of full-screen output (e.g. status dashboards) on a terminal.
+ *
+ * Frames are drawn into a back buffer of cells, and present() writes into the console only the cells that
+ * changed since the previous frame (the front buffer), using the shortest cursor movements and SGR
+ * transitions (see sgrTransition()). Unchanged gaps shorter than a cursor movement are rewritten instead of
+ * skipped. Each frame is written at once, wrapped in a synchronized update (DEC private mode 2026), so that
+ * terminals that support it display the frame atomically and the others ignore it.
+ *
+ * A wide character covers the next cell when it holds TERMINAL_WIDE_CONTINUATION (as set by print()). Characters
+ * that do not occupy exactly their cells (e.g. wide characters without continuation cell, or combining marks set
+ * using at()) are displayed as blanks.
+ *
+ * The screen assumes that it owns the terminal while it is in use: after writing other output into the
+ * terminal (or after the terminal is resized), call invalidate() so that the next frame is fully repainted.
+ *
+ * @code
+ * Screen screen( ColorConsole::cout, 80, 24 );
+ * for( ;; )
+ * {
+ *     screen.clear();
+ *     screen.print( 0, 0, "CPU", SgrStyle::from_color( Color::FG_WHITE ) );
+ *     screen.print( 0, 4, std::to_string( cpuLoad() ), SgrStyle::from_color( Color::FG_LIGHT_GREEN ) );
+ *     screen.present();
+ *     std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+ * }
+ * @endcode
+ */
+class COLORCONSOLE_API Screen
+{
+public:
+    /**
+     * Constructor. The screen is initially blank, and it is cleared on the terminal by the first frame.
+     *
+     * @param[in] console Console of the terminal (not owned)
+     * @param[in] columns Number of columns (at least 1)
+     * @param[in] rows Number of rows (at least 1)
+     * @param[in] capability Color capability of the terminal (styles are not rendered if the console
+     *                       coloring is disabled)
+     */
+    Screen( Console &console, std::size_t columns, std::size_t rows, ColorCapability capability = ColorCapability::TRUE_COLOR );
+
+    /**
+     * Destructor. Restores the terminal (see release()) if any frame was presented.
+     */
+    ~Screen();
+
+    Screen( const Screen& ) = delete;
+    Screen& operator=( const Screen& ) = delete;
+
+    /**
+     * Returns the number of columns.
+     */
+    std::size_t get_columns() const noexcept
+    {
+        return m_columns;
+    }
+
+    /**
+     * Returns the number of rows.
+     */
+    std::size_t get_rows() const noexcept
+    {
+        return m_rows;
+    }
+
+    /**
+     * Changes the size of the screen. The back buffer is cleared, and the next frame is fully repainted.
+     *
+     * @param[in] columns Number of columns (at least 1)
+     * @param[in] rows Number of rows (at least 1)
+     */
+    void resize( std::size_t columns, std::size_t rows );
+
+    /**
+     * Enables or disables the synchronized updates (enabled by default).
+     */
+    void set_synchronized_updates( bool value ) noexcept
+    {
+        m_synchronizedUpdates = value;
+    }
+
+    /**
+     * Returns a cell of the back buffer.
+     *
+     * @param[in] row Row (0-based, less than get_rows())
+     * @param[in] column Column (0-based, less than get_columns())
+     */
+    TerminalCell& at( std::size_t row, std::size_t column ) noexcept
+    {
+        return m_back[row * m_columns + column];
+    }
+
+    /**
+     * Returns a cell of the back buffer.
+     *
+     * @param[in] row Row (0-based, less than get_rows())
+     * @param[in] column Column (0-based, less than get_columns())
+     */
+    const TerminalCell& get_cell( std::size_t row, std::size_t column ) const noexcept
+    {
+        return m_back[row * m_columns + column];
+    }
+
+    /**
+     * Fills the back buffer with blanks.
+     *
+     * @param[in] style Style of the blanks
+     */
+    void clear( const SgrStyle &style = SgrStyle() );
+
+    /**
+     * Fills a rectangle of the back buffer (clipped to the screen) with a cell.
+     *
+     * @param[in] row First row
+     * @param[in] column First column
+     * @param[in] width Number of columns
+     * @param[in] height Number of rows
+     * @param[in] cell Cell
+     */
+    void fill( std::size_t row, std::size_t column, std::size_t width, std::size_t height, const TerminalCell &cell );
+
+    /**
+     * Draws text encoded in UTF-8 into the back buffer, clipped at the end of the row. Each code point occupies
+     * its width in cells (see code_point_width()): wide characters occupy two cells (the second one holds
+     * TERMINAL_WIDE_CONTINUATION), and zero-width code points (e.g. combining marks) are skipped, as cells hold
+     * a single code point. Control characters are drawn as U+FFFD.
+     *
+     * @param[in] row Row
+     * @param[in] column First column
+     * @param[in] text Text
+     * @param[in] style Style of the text
+     * @return The number of cells drawn
+     */
+    std::size_t print( std::size_t row, std::size_t column, std::string_view text, const SgrStyle &style = SgrStyle() );
+
+    /**
+     * Writes the changes of the back buffer since the previous frame into the console, and flushes it.
+     *
+     * @return The number of bytes written (0 if nothing changed)
+     */
+    std::size_t present();
+
+    /**
+     * Forces the next frame to clear the terminal and repaint every cell.
+     */
+    void invalidate() noexcept
+    {
+        m_frontValid = false;
+    }
+
+    /**
+     * Restores the terminal after the last frame: resets the style, moves the cursor below the screen and
+     * shows it. The next frame is fully repainted.
+     */
+    void release();
+
+private:
+    void move_cursor( std::size_t row, std::size_t column, const TerminalCell *backRow );
+    void write_cell( const TerminalCell &cell, std::size_t width );
+    std::size_t rewrite_cost( const TerminalCell *cells, std::size_t first, std::size_t end ) const noexcept;
+
+    Console &m_console;
+    std::size_t m_columns;
+    std::size_t m_rows;
+    ColorCapability m_capability;
+    std::vector<TerminalCell> m_back;
+    std::vector<TerminalCell> m_front;
+    std::string m_output;
+    SgrStyle m_style;
+    std::size_t m_cursorRow;
+    std::size_t m_cursorColumn;
+    bool m_cursorKnown;
+    bool m_frontValid;
+    bool m_presented;
+    bool m_synchronizedUpdates;
+};
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,298 @@
+/**
+ * @file
+ * @brief      Incremental parser of ANSI SGR (Select Graphic Rendition) escape sequences
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLESGR_HPP_
+#define COLORCONSOLESGR_HPP_
+
+#include "ColorConsoleAnsiTokenizer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace ColorConsole
+{
+
+/**
+ * @name SGR attributes
+ * Text attributes set by SGR sequences, which can be combined ORing them.
+ * @{
+ */
+inline constexpr std::uint8_t SGR_BOLD = 0x01;        ///< Bold (or increased intensity)
+inline constexpr std::uint8_t SGR_DIM = 0x02;         ///< Dim (or decreased intensity)
+inline constexpr std::uint8_t SGR_ITALIC = 0x04;      ///< Italic
+inline constexpr std::uint8_t SGR_UNDERLINE = 0x08;   ///< Underline
+inline constexpr std::uint8_t SGR_BLINK = 0x10;       ///< Blink
+inline constexpr std::uint8_t SGR_INVERSE = 0x20;     ///< Inverse (swapped foreground and background)
+inline constexpr std::uint8_t SGR_HIDDEN = 0x40;      ///< Hidden
+inline constexpr std::uint8_t SGR_STRIKE = 0x80;      ///< Crossed out
+/** @} */
+
+/**
+ * Maximum number of parameters of an SGR sequence (further parameters are ignored).
+ */
+inline constexpr std::size_t SGR_MAX_PARAMETERS = ANSI_MAX_CSI_PARAMETERS;
+
+/**
+ * Color set by an SGR sequence.
+ */
+struct SgrColor
+{
+    /**
+     * Kind of color.
+     */
+    enum class Kind : std::uint8_t
+    {
+        DEFAULT,    ///< Terminal default color
+        INDEXED,    ///< Color of the 256-color palette (0 to 7 are the basic colors, 8 to 15 their bright variants)
+        RGB         ///< Direct (24-bit) color
+    };
+
+    Kind kind = Kind::DEFAULT;  ///< Kind of color
+    std::uint8_t index = 0;     ///< Palette index (for INDEXED colors)
+    std::uint8_t red = 0;       ///< Red component (for RGB colors)
+    std::uint8_t green = 0;     ///< Green component (for RGB colors)
+    std::uint8_t blue = 0;      ///< Blue component (for RGB colors)
+
+    static constexpr SgrColor indexed( std::uint8_t index ) noexcept
+    {
+        return SgrColor { Kind::INDEXED, index, 0, 0, 0 };
+    }
+
+    static constexpr SgrColor rgb( std::uint8_t red, std::uint8_t green, std::uint8_t blue ) noexcept
+    {
+        return SgrColor { Kind::RGB, 0, red, green, blue };
+    }
+
+    bool operator==( const SgrColor& ) const = default;
+};
+
+/**
+ * Text style set by SGR sequences.
+ */
+struct COLORCONSOLE_API SgrStyle
+{
+    SgrColor foreground;        ///< Foreground color
+    SgrColor background;        ///< Background color
+    std::uint8_t attributes = 0;///< Attributes (SGR_BOLD, SGR_UNDERLINE...)
+
+    bool operator==( const SgrStyle& ) const = default;
+
+    /**
+     * Indicates if the style is the terminal default style.
+     */
+    bool is_default() const noexcept
+    {
+        return ( *this == SgrStyle() );
+    }
+
+    /**
+     * Returns the nearest Color.
+     *
+     * Bold basic foreground colors are mapped to their light variants (as the library renders light colors
+     * using bold), palette and direct colors are mapped to the nearest of the 16 basic colors, and a default
+     * foreground is mapped to FG_LIGHT_GREY. Other attributes are ignored.
+     *
+     * @return The nearest Color, or RESET if both the foreground and background colors are the default ones
+     */
+    Color to_color() const noexcept;
+
+    /**
+     * Returns the style that the library renders for a Color (i.e. the style resulting from applying the
+     * escape sequence of the color to the default style).
+     *
+     * @param[in] color Color
+     * @return The style
+     */
+    static SgrStyle from_color( Color color ) noexcept;
+
+    /**
+     * Applies the parameters of an SGR sequence.
+     *
+     * @param[in] parameters Parameters
+     * @param[in] subparameters Bit mask of the parameters that are subparameters (i.e. preceded by a colon)
+     * @param[in] count Number of parameters
+     */
+    void apply( const std::uint16_t *parameters, std::uint32_t subparameters, std::size_t count ) noexcept;
+};
+
+/**
+ * Returns the RGB components of a color of the 256-color palette (using the xterm default palette).
+ *
+ * @param[in] index Palette index
+ * @param[out] red Red component
+ * @param[out] green Green component
+ * @param[out] blue Blue component
+ */
+COLORCONSOLE_API void sgrPaletteRgb( std::uint8_t index, std::uint8_t &red, std::uint8_t &green, std::uint8_t &blue ) noexcept;
+
+/**
+ * Color capability of a terminal, used to render styles.
+ */
+enum class ColorCapability
+{
+    NONE,           ///< No colors nor attributes
+    BASIC,          ///< The 16 colors of the library (styles are rendered as their nearest Color)
+    PALETTE_256,    ///< 256-color palette and attributes (direct colors are rendered as the nearest palette color)
+    TRUE_COLOR      ///< Direct colors and attributes
+};
+
+/**
+ * Maximum length of the SGR sequence that sets a style.
+ */
+inline constexpr std::size_t SGR_SEQUENCE_MAX_LENGTH = 64;
+
+/**
+ * SGR sequence that sets a style, stored inline.
+ */
+struct SgrSequence
+{
+    char text[SGR_SEQUENCE_MAX_LENGTH] = {};
+    std::size_t length = 0;
+
+    std::string_view view() const noexcept
+    {
+        return std::string_view( text, length );
+    }
+};
+
+/**
+ * Builds the SGR sequence that sets a style (from any previous style) at a given color capability.
+ *
+ * At the BASIC capability the sequence is the one written by the library for the nearest Color of the style.
+ * At the other capabilities, the sequence resets the previous style and then sets the attributes and colors
+ * of the style, keeping the basic colors as such (so that they follow the terminal theme).
+ *
+ * @param[in] style Style
+ * @param[in] capability Color capability
+ * @return The SGR sequence (empty for the NONE capability)
+ */
+COLORCONSOLE_API SgrSequence sgrSequence( const SgrStyle &style, ColorCapability capability ) noexcept;
+
+/**
+ * Builds the shortest SGR sequence that changes the style from a known style to another style at a given
+ * color capability: either the sequence that only sets and resets the attributes and colors that change, or
+ * the sequence returned by sgrSequence().
+ *
+ * @param[in] from Current style
+ * @param[in] to New style
+ * @param[in] capability Color capability
+ * @return The SGR sequence (empty if the style does not change at the capability)
+ */
+COLORCONSOLE_API SgrSequence sgrTransition( const SgrStyle &from, const SgrStyle &to, ColorCapability capability ) noexcept;
+
+/**
+ * Incremental parser of text with ANSI escape sequences, that splits it into runs of text with the same
+ * style.
+ *
+ * SGR sequences update the current style, including the sequences rendered by the library and the common
+ * foreign ones (attributes, bright colors, 256-color and direct colors in both semicolon and colon forms).
+ * Sequences are tokenized by AnsiTokenizer (like AnsiStripper does), therefore the text of the runs is the same
+ * text that AnsiStripper outputs, although the CSI control sequences can be reported to a second handler.
+ *
+ * Text can be processed in chunks of any size, and sequences split across chunks are resumed on the next
+ * chunk. The parser does not allocate memory and its state is bounded.
+ *
+ * @code
+ * SgrParser parser;
+ * parser.process( chunk, []( const SgrStyle &style, std::string_view text ) { ... } );
+ * @endcode
+ */
+class SgrParser
+{
+public:
+    /**
+     * Processes a chunk of text.
+     *
+     * The text of the runs points into the chunk. Runs are not merged, i.e. consecutive runs may have the
+     * same style.
+     *
+     * @param[in] chunk Chunk of text
+     * @param[in] handler Callable invoked with the style and text of each run (as a <tt>const SgrStyle&</tt>
+     *                    and a @c std::string_view)
+     */
+    template<class Handler>
+    void process( std::string_view chunk, Handler &&handler )
+    {
+        process( chunk, handler, []( const CsiSequence& ) {} );
+    }
+
+    /**
+     * Processes a chunk of text, reporting also the control sequences that are not SGR sequences.
+     *
+     * @param[in] chunk Chunk of text
+     * @param[in] handler Callable invoked with the style and text of each run (see process())
+     * @param[in] control Callable invoked with each CSI sequence that is not an SGR sequence (as a
+     *                    <tt>const CsiSequence&</tt>), in order with the runs
+     */
+    template<class Handler, class ControlHandler>
+    void process( std::string_view chunk, Handler &&handler, ControlHandler &&control )
+    {
+        const SgrStyle &style = m_style;
+
+        m_tokenizer.process( chunk, [&handler, &style]( std::string_view text ) { handler( style, text ); },
+                             [this, &control]( const CsiSequence &sequence )
+        {
+            if( sequence.intermediate )
+            {
+                return;
+            }
+
+            if( ( sequence.final == 'm' ) && ( sequence.privateMarker == 0 ) )
+            {
+                m_style.apply( sequence.parameters, sequence.subparameters, sequence.count );
+            }
+            else
+            {
+                control( sequence );
+            }
+        } );
+    }
+
+    /**
+     * Returns the current style.
+     */
+    const SgrStyle& get_style() const noexcept
+    {
+        return m_style;
+    }
+
+    /**
+     * Sets the current style.
+     */
+    void set_style( const SgrStyle &style ) noexcept
+    {
+        m_style = style;
+    }
+
+    /**
+     * Indicates if the last chunk processed ended inside an escape sequence.
+     */
+    bool in_sequence() const noexcept
+    {
+        return m_tokenizer.in_sequence();
+    }
+
+    /**
+     * Drops any pending escape sequence and resets the style to the default one.
+     */
+    void reset() noexcept
+    {
+        m_tokenizer.reset();
+        m_style = SgrStyle();
+    }
+
+private:
+    AnsiTokenizer m_tokenizer;
+    SgrStyle m_style;
+};
+
+} // namespace
+
+#endif // header guard
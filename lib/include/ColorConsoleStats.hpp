@@ -0,0 +1,249 @@
+/**
+ * @file
+ * @brief      Output statistics for ColorConsole and ColorConsoleW
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLESTATS_HPP_
+#define COLORCONSOLESTATS_HPP_
+
+#include "ColorConsoleCommon.hpp"
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <streambuf>
+
+namespace ColorConsole
+{
+
+/**
+ * Indicates if the consoles collect output statistics (i.e. if the library was built with
+ * @c COLORCONSOLE_ENABLE_STATS defined, see Console::get_stats()).
+ */
+#ifdef COLORCONSOLE_ENABLE_STATS
+inline constexpr bool STATS_ENABLED = true;
+#else
+inline constexpr bool STATS_ENABLED = false;
+#endif
+
+/**
+ * Number of buckets of the latency histograms.
+ *
+ * Bucket @c i counts the latencies between 2^i and 2^(i+1)-1 nanoseconds (bucket 0 also counts latencies of
+ * 0 ns, and the last bucket counts all the latencies above its lower limit).
+ */
+inline constexpr std::size_t STATS_LATENCY_BUCKETS = 32;
+
+/**
+ * Snapshot of the output statistics of a console.
+ *
+ * Sizes are measured in characters (i.e. bytes for Console, wide characters for ConsoleW).
+ *
+ * Writes are counted per call into the underlying stream buffer, not per line or per flush: each inserted string
+ * is one write, but each inserted character (e.g. @c std::endl or a padding fill) is one write too.
+ *
+ * The write latencies measure the insertion into the underlying stream buffer, which usually just copies the
+ * text into its buffer (e.g. the one of @c std::cout); the time spent writing into the device is measured by the
+ * flush latencies. Each write and flush reads the steady clock twice, which is included in these latencies and
+ * dominates the cost of collecting the statistics (see the Stats benchmark).
+ */
+struct ConsoleStatsSnapshot
+{
+    unsigned long long payloadBytes = 0;            ///< Size of the text written, excluding escape sequences
+    unsigned long long escapeBytes = 0;             ///< Size of the color escape sequences written
+    unsigned long long colorChangesRequested = 0;   ///< Number of color changes requested
+    unsigned long long colorChangesEmitted = 0;     ///< Number of color changes actually rendered
+    unsigned long long writes = 0;                  ///< Number of calls writing into the underlying stream buffer
+    unsigned long long flushes = 0;                 ///< Number of flushes of the underlying stream buffer
+    unsigned long long writeLatency[STATS_LATENCY_BUCKETS] = {};   ///< Histogram of the buffer insertion latencies
+    unsigned long long flushLatency[STATS_LATENCY_BUCKETS] = {};   ///< Histogram of the flush (device write) latencies
+};
+
+/**
+ * Output statistics of a console.
+ *
+ * Counters are updated using relaxed atomic operations, therefore they can be read from any thread, but a
+ * snapshot taken while the console is being written is not necessarily consistent between counters.
+ */
+class ConsoleStats
+{
+public:
+    /**
+     * Returns the histogram bucket for a latency.
+     *
+     * @param[in] nanoseconds Latency
+     * @return The bucket index
+     */
+    static constexpr std::size_t latency_bucket( unsigned long long nanoseconds ) noexcept
+    {
+        std::size_t bucket = ( nanoseconds == 0 ) ? 0 : static_cast<std::size_t>( std::bit_width( nanoseconds ) - 1 );
+        return ( bucket < STATS_LATENCY_BUCKETS ) ? bucket : ( STATS_LATENCY_BUCKETS - 1 );
+    }
+
+    void add_color_change( bool emitted, std::size_t escapeSize ) noexcept
+    {
+        m_colorChangesRequested.fetch_add( 1, std::memory_order_relaxed );
+
+        if( emitted )
+        {
+            m_colorChangesEmitted.fetch_add( 1, std::memory_order_relaxed );
+            m_escapeBytes.fetch_add( escapeSize, std::memory_order_relaxed );
+        }
+    }
+
+    void add_embedded_escapes( std::size_t changes, std::size_t escapeSize ) noexcept
+    {
+        m_colorChangesRequested.fetch_add( changes, std::memory_order_relaxed );
+        m_colorChangesEmitted.fetch_add( changes, std::memory_order_relaxed );
+        m_escapeBytes.fetch_add( escapeSize, std::memory_order_relaxed );
+    }
+
+    void add_write( std::size_t size, unsigned long long nanoseconds ) noexcept
+    {
+        m_totalBytes.fetch_add( size, std::memory_order_relaxed );
+        m_writes.fetch_add( 1, std::memory_order_relaxed );
+        m_writeLatency[latency_bucket( nanoseconds )].fetch_add( 1, std::memory_order_relaxed );
+    }
+
+    void add_flush( unsigned long long nanoseconds ) noexcept
+    {
+        m_flushes.fetch_add( 1, std::memory_order_relaxed );
+        m_flushLatency[latency_bucket( nanoseconds )].fetch_add( 1, std::memory_order_relaxed );
+    }
+
+    /**
+     * Takes a snapshot of the statistics.
+     *
+     * @return The snapshot
+     */
+    ConsoleStatsSnapshot snapshot() const noexcept
+    {
+        ConsoleStatsSnapshot result;
+
+        unsigned long long totalBytes = m_totalBytes.load( std::memory_order_relaxed );
+        result.escapeBytes = m_escapeBytes.load( std::memory_order_relaxed );
+        result.payloadBytes = ( totalBytes > result.escapeBytes ) ? ( totalBytes - result.escapeBytes ) : 0;
+        result.colorChangesRequested = m_colorChangesRequested.load( std::memory_order_relaxed );
+        result.colorChangesEmitted = m_colorChangesEmitted.load( std::memory_order_relaxed );
+        result.writes = m_writes.load( std::memory_order_relaxed );
+        result.flushes = m_flushes.load( std::memory_order_relaxed );
+
+        for( std::size_t i = 0; i < STATS_LATENCY_BUCKETS; i++ )
+        {
+            result.writeLatency[i] = m_writeLatency[i].load( std::memory_order_relaxed );
+            result.flushLatency[i] = m_flushLatency[i].load( std::memory_order_relaxed );
+        }
+
+        return result;
+    }
+
+    /**
+     * Resets all the statistics to zero.
+     */
+    void reset() noexcept
+    {
+        m_totalBytes.store( 0, std::memory_order_relaxed );
+        m_escapeBytes.store( 0, std::memory_order_relaxed );
+        m_colorChangesRequested.store( 0, std::memory_order_relaxed );
+        m_colorChangesEmitted.store( 0, std::memory_order_relaxed );
+        m_writes.store( 0, std::memory_order_relaxed );
+        m_flushes.store( 0, std::memory_order_relaxed );
+
+        for( std::size_t i = 0; i < STATS_LATENCY_BUCKETS; i++ )
+        {
+            m_writeLatency[i].store( 0, std::memory_order_relaxed );
+            m_flushLatency[i].store( 0, std::memory_order_relaxed );
+        }
+    }
+
+private:
+    std::atomic<unsigned long long> m_totalBytes { 0 };
+    std::atomic<unsigned long long> m_escapeBytes { 0 };
+    std::atomic<unsigned long long> m_colorChangesRequested { 0 };
+    std::atomic<unsigned long long> m_colorChangesEmitted { 0 };
+    std::atomic<unsigned long long> m_writes { 0 };
+    std::atomic<unsigned long long> m_flushes { 0 };
+    std::atomic<unsigned long long> m_writeLatency[STATS_LATENCY_BUCKETS] {};
+    std::atomic<unsigned long long> m_flushLatency[STATS_LATENCY_BUCKETS] {};
+};
+
+/**
+ * Unbuffered stream buffer that forwards the output to another stream buffer, measuring it.
+ *
+ * It is deliberately unbuffered, so that the output reaches the target stream buffer (and its own flushing
+ * policy) exactly as it would without statistics; therefore every @c overflow() and @c xsputn() call is counted
+ * and timed as a separate write.
+ */
+template<class CharT>
+class StatsStreamBuf : public std::basic_streambuf<CharT>
+{
+public:
+    using traits_type = typename std::basic_streambuf<CharT>::traits_type;
+    using int_type = typename traits_type::int_type;
+
+    explicit StatsStreamBuf( ConsoleStats &stats ) noexcept
+    : m_stats( stats ), m_target( nullptr )
+    {}
+
+    void set_target( std::basic_streambuf<CharT> *target ) noexcept
+    {
+        m_target = target;
+    }
+
+    std::basic_streambuf<CharT>* get_target() const noexcept
+    {
+        return m_target;
+    }
+
+protected:
+    int_type overflow( int_type c ) override
+    {
+        if( traits_type::eq_int_type( c, traits_type::eof() ) )
+        {
+            return traits_type::not_eof( c );
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        int_type result = m_target->sputc( traits_type::to_char_type( c ) );
+        m_stats.add_write( traits_type::eq_int_type( result, traits_type::eof() ) ? 0 : 1, elapsed( start ) );
+
+        return result;
+    }
+
+    std::streamsize xsputn( const CharT *s, std::streamsize n ) override
+    {
+        const auto start = std::chrono::steady_clock::now();
+        std::streamsize result = m_target->sputn( s, n );
+        m_stats.add_write( static_cast<std::size_t>( result ), elapsed( start ) );
+
+        return result;
+    }
+
+    int sync() override
+    {
+        const auto start = std::chrono::steady_clock::now();
+        int result = m_target->pubsync();
+        m_stats.add_flush( elapsed( start ) );
+
+        return result;
+    }
+
+private:
+    static unsigned long long elapsed( std::chrono::steady_clock::time_point start ) noexcept
+    {
+        return static_cast<unsigned long long>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - start ).count() );
+    }
+
+    ConsoleStats &m_stats;
+    std::basic_streambuf<CharT> *m_target;
+};
+
+} // namespace
+
+#endif // header guard
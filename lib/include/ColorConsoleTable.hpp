@@ -0,0 +1,253 @@
+/**
+ * @file
+ * @brief      Colored table rendering
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLETABLE_HPP_
+#define COLORCONSOLETABLE_HPP_
+
+#include "ColorConsoleCommon.hpp"
+#include "ColorConsole.hpp"
+#include "ColorConsoleAnsi.hpp"
+
+#include <cstddef>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ColorConsole
+{
+
+/**
+ * Alignment of the text of a table column.
+ */
+enum class TableAlignment
+{
+    LEFT,
+    RIGHT,
+    CENTER
+};
+
+/**
+ * Borders drawn around and between the cells of a table.
+ */
+enum class TableBorders
+{
+    NONE,   ///< Columns separated by two spaces
+    ASCII,  ///< Borders drawn with @c + @c - and @c |
+    BOX     ///< Borders drawn with box-drawing characters (or as ASCII borders if the output does not support Unicode)
+};
+
+/**
+ * Definition of a table column.
+ */
+struct TableColumn
+{
+    std::string title;                                 ///< Title (no header row is written if all titles are empty)
+    TableAlignment alignment = TableAlignment::LEFT;   ///< Alignment of the text
+    std::size_t minWidth = 0;                          ///< Minimum width (in columns)
+    std::size_t maxWidth = 0;                          ///< Maximum width (in columns, 0 for unlimited)
+};
+
+/**
+ * Cell of a table row.
+ */
+struct TableCell
+{
+    std::string_view text;         ///< Text encoded in UTF-8
+    Color color = Color::RESET;    ///< Color of the text (RESET for the default color)
+};
+
+/**
+ * Renderer of tables of colored text.
+ *
+ * The column widths are computed from the display width of the text (not from its length in bytes), and
+ * text wider than its column is truncated with an ellipsis (@c ~ if the output does not support Unicode, see
+ * set_unicode()). Each row is written into the console as a single
+ * buffer, switching the color only where it changes (spaces only switch it when the background changes).
+ * Control characters are written as spaces.
+ *
+ * By default the rows are held until finish() is called, so that the column widths fit all of them. In
+ * streaming mode (see set_streaming()) the widths are fixed after the first rows, which are then written
+ * together with the header, and the following rows are written as they are added.
+ *
+ * @code
+ * Table table( ColorConsole::cout, { { "Service" }, { "Status" }, { "Latency", TableAlignment::RIGHT } } );
+ * table.set_borders( TableBorders::BOX );
+ * table.add_row( { { "auth" }, { "up", Color::FG_LIGHT_GREEN }, { "12 ms" } } );
+ * table.add_row( { { "billing" }, { "down", Color::FG_WHITE | Color::BG_DARK_RED }, { "-" } } );
+ * table.finish();
+ * @endcode
+ */
+class COLORCONSOLE_API Table
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param[in] console Console to write the table into (not owned)
+     * @param[in] columns Column definitions
+     */
+    Table( Console &console, std::vector<TableColumn> columns );
+
+    /**
+     * Destructor. Finishes the table if not done yet.
+     */
+    ~Table();
+
+    Table( const Table& ) = delete;
+    Table& operator=( const Table& ) = delete;
+
+    /**
+     * Sets the borders (no borders by default). Shall be called before adding rows.
+     */
+    void set_borders( TableBorders borders ) noexcept
+    {
+        m_borders = borders;
+    }
+
+    /**
+     * Sets if the output supports Unicode characters, i.e. if box-drawing characters and the ellipsis can be
+     * written. By default it is detected from the locale environment variables (@c LC_ALL, @c LC_CTYPE or
+     * @c LANG), except on Windows, where the consoles are switched to UTF-8. Shall be called before adding rows.
+     */
+    void set_unicode( bool unicode ) noexcept
+    {
+        m_unicode = unicode;
+    }
+
+    /**
+     * Sets the color of the borders (default color by default).
+     */
+    void set_border_color( Color color ) noexcept
+    {
+        m_borderColor = color;
+    }
+
+    /**
+     * Sets the color of the column titles (default color by default).
+     */
+    void set_header_color( Color color ) noexcept
+    {
+        m_headerColor = color;
+    }
+
+    /**
+     * Enables the streaming mode: the column widths are fixed after @p sampleRows rows have been added.
+     * Shall be called before adding rows.
+     *
+     * @param[in] sampleRows Number of rows used to compute the column widths (0 disables the streaming mode)
+     */
+    void set_streaming( std::size_t sampleRows ) noexcept
+    {
+        m_sampleRows = sampleRows;
+    }
+
+    /**
+     * Adds a row. Missing cells are left empty, and extra cells are ignored.
+     *
+     * @param[in] cells Cells of the row
+     */
+    void add_row( std::span<const TableCell> cells );
+
+    /**
+     * Adds a row. Missing cells are left empty, and extra cells are ignored.
+     *
+     * @param[in] cells Cells of the row
+     */
+    void add_row( std::initializer_list<TableCell> cells )
+    {
+        add_row( std::span<const TableCell>( cells.begin(), cells.size() ) );
+    }
+
+    /**
+     * Writes the rows held (if any) and the bottom border, and flushes the console. Rows shall not be added
+     * afterwards.
+     */
+    void finish();
+
+    /**
+     * Returns the width of a column (only final once the widths are fixed).
+     *
+     * @param[in] column Column index
+     */
+    std::size_t get_width( std::size_t column ) const noexcept
+    {
+        return m_widths[column];
+    }
+
+private:
+    struct HeldCell
+    {
+        std::size_t offset;
+        std::size_t length;
+        std::size_t width;
+        Color color;
+    };
+
+    struct RowCell
+    {
+        std::string_view text;
+        std::size_t width;
+        Color color;
+    };
+
+    struct CachedEscape
+    {
+        Color color = Color::RESET;
+        AnsiEscape escape = ansiEscape( Color::RESET );
+    };
+
+    static constexpr std::size_t ESCAPE_CACHE_SIZE = 4;
+
+    enum class Rule
+    {
+        TOP,
+        MIDDLE,
+        BOTTOM
+    };
+
+    void fix_widths();
+    void write_held_rows();
+    void write_row( const RowCell *cells, bool header );
+    void write_rule( Rule rule );
+    void set_color( Color color );
+    void append_spaces( std::size_t count, Color color );
+    std::size_t append_text( const RowCell &cell, std::size_t columnWidth );
+    void reserve_row_text( std::span<const TableCell> cells );
+    std::string_view row_text( std::string_view text );
+    void flush_line();
+
+    Console &m_console;
+    const std::vector<TableColumn> m_columns;
+    std::vector<std::size_t> m_widths;
+    TableBorders m_borders;
+    Color m_borderColor;
+    Color m_headerColor;
+    std::size_t m_sampleRows;
+    bool m_ansi;
+    bool m_unicode;
+    bool m_hasHeader;
+    bool m_widthsFixed;
+    bool m_finished;
+
+    std::string m_heldText;
+    std::vector<HeldCell> m_heldCells;
+    std::vector<RowCell> m_rowCells;
+    std::string m_rowText;
+
+    std::string m_line;
+    Color m_lineColor;
+    CachedEscape m_escapeCache[ESCAPE_CACHE_SIZE];
+    std::size_t m_escapeCacheNext;
+};
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,251 @@
+/**
+ * @file
+ * @brief      In-memory virtual terminal
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLETERMINAL_HPP_
+#define COLORCONSOLETERMINAL_HPP_
+
+#include "ColorConsoleCommon.hpp"
+#include "ColorConsoleSgr.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ColorConsole
+{
+
+/**
+ * Character of the cell covered by the second half of a wide character (which occupies two cells, see
+ * code_point_width()).
+ */
+inline constexpr char32_t TERMINAL_WIDE_CONTINUATION = 0;
+
+/**
+ * Cell of a virtual terminal screen.
+ */
+struct TerminalCell
+{
+    char32_t character = U' ';      ///< Unicode code point displayed in the cell, or TERMINAL_WIDE_CONTINUATION
+    SgrStyle style;                 ///< Style of the cell
+
+    bool operator==( const TerminalCell& ) const = default;
+};
+
+/**
+ * Prepares the cells of a row to be overwritten, blanking the halves of the wide characters that are cut (as
+ * terminals do).
+ *
+ * @param[in,out] cells Cells of the row
+ * @param[in] columns Number of cells of the row
+ * @param[in] first First cell to be overwritten
+ * @param[in] end Cell following the last cell to be overwritten
+ */
+inline void splitWideCharacters( TerminalCell *cells, std::size_t columns, std::size_t first, std::size_t end ) noexcept
+{
+    if( ( first > 0 ) && ( first < columns ) && ( cells[first].character == TERMINAL_WIDE_CONTINUATION ) )
+    {
+        cells[first - 1].character = U' ';
+    }
+
+    if( ( end < columns ) && ( cells[end].character == TERMINAL_WIDE_CONTINUATION ) )
+    {
+        cells[end].character = U' ';
+    }
+}
+
+/**
+ * Statistics of the output written into a virtual terminal.
+ */
+struct TerminalStats
+{
+    std::uint64_t bytes = 0;            ///< Bytes written
+    std::uint64_t characters = 0;       ///< Characters displayed in cells
+    std::uint64_t controls = 0;         ///< Control sequences executed (other than SGR) and control characters
+    std::uint64_t scrolledLines = 0;    ///< Lines scrolled off the top of the screen
+};
+
+/**
+ * Headless terminal that interprets the output written into it and keeps a grid of cells with their
+ * characters and styles, e.g. to check what a terminal would display in tests, or to measure the cost of
+ * rendering and the overhead of escape sequences in benchmarks.
+ *
+ * The terminal interprets UTF-8 text, SGR sequences (see SgrParser), the control
+ * characters CR, LF (which also returns the carriage, as the output processing of a tty does), BS and HT,
+ * and the CSI sequences CUU, CUD, CUF, CUB, CNL, CPL, CHA, CUP, HVP, VPA, ED, EL, ECH, the cursor save and
+ * restore sequences and the DEC private modes 7 (autowrap) and 25 (cursor visibility). Other sequences are
+ * dropped.
+ *
+ * Each code point advances the cursor by its width (see code_point_width()): wide characters occupy two cells
+ * (the second one holds TERMINAL_WIDE_CONTINUATION), and zero-width code points (e.g. combining marks) are not
+ * stored, as cells hold a single code point. Overwriting a half of a wide character blanks the other half.
+ *
+ * Lines wrap like in the VT100: the cursor stays on the last column after a character is written there, and
+ * the line wraps when the next character is written. A wide character that does not fit in the rest of the
+ * line is written on the next line. Erased cells take the current background color. When
+ * the cursor moves below the last row, the screen scrolls up and the top row is discarded.
+ *
+ * @code
+ * VirtualTerminal terminal( 80, 24 );
+ * Console console( &terminal );
+ * console << Color::FG_LIGHT_RED << "Error" << Color::RESET << endl;
+ * assert( terminal.get_line( 0 ) == "Error" );
+ * @endcode
+ */
+class COLORCONSOLE_API VirtualTerminal : public std::streambuf
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param[in] columns Number of columns of the screen (at least 1)
+     * @param[in] rows Number of rows of the screen (at least 1)
+     */
+    explicit VirtualTerminal( std::size_t columns = 80, std::size_t rows = 24 );
+
+    /**
+     * Writes output into the terminal.
+     *
+     * @param[in] text Output (text and escape sequences, which can be split across calls)
+     */
+    void write( std::string_view text );
+
+    /**
+     * Clears the screen and the statistics, and resets the cursor, the style and the modes.
+     */
+    void reset();
+
+    /**
+     * Returns the number of columns of the screen.
+     */
+    std::size_t get_columns() const noexcept
+    {
+        return m_columns;
+    }
+
+    /**
+     * Returns the number of rows of the screen.
+     */
+    std::size_t get_rows() const noexcept
+    {
+        return m_rows;
+    }
+
+    /**
+     * Returns a cell of the screen.
+     *
+     * @param[in] row Row (0-based, less than get_rows())
+     * @param[in] column Column (0-based, less than get_columns())
+     */
+    const TerminalCell& get_cell( std::size_t row, std::size_t column ) const noexcept
+    {
+        return m_cells[physical_row( row ) * m_columns + column];
+    }
+
+    /**
+     * Returns the text of a row of the screen encoded in UTF-8 (with each wide character once), without
+     * trailing blanks.
+     *
+     * @param[in] row Row (0-based, less than get_rows())
+     */
+    std::string get_line( std::size_t row ) const;
+
+    /**
+     * Returns the text of the screen encoded in UTF-8: the rows without trailing blanks, separated by
+     * newlines, and without trailing blank rows.
+     */
+    std::string get_text() const;
+
+    /**
+     * Returns the row of the cursor (0-based).
+     */
+    std::size_t get_cursor_row() const noexcept
+    {
+        return m_cursorRow;
+    }
+
+    /**
+     * Returns the column of the cursor (0-based).
+     */
+    std::size_t get_cursor_column() const noexcept
+    {
+        return m_cursorColumn;
+    }
+
+    /**
+     * Indicates if the cursor is visible.
+     */
+    bool is_cursor_visible() const noexcept
+    {
+        return m_cursorVisible;
+    }
+
+    /**
+     * Returns the current style.
+     */
+    const SgrStyle& get_style() const noexcept
+    {
+        return m_parser.get_style();
+    }
+
+    /**
+     * Returns the statistics of the output written so far.
+     */
+    const TerminalStats& get_stats() const noexcept
+    {
+        return m_stats;
+    }
+
+protected:
+    int_type overflow( int_type c ) override;
+
+    std::streamsize xsputn( const char_type *s, std::streamsize n ) override;
+
+private:
+    std::size_t physical_row( std::size_t row ) const noexcept
+    {
+        const std::size_t physicalRow = m_topRow + row;
+        return ( physicalRow < m_rows ) ? physicalRow : ( physicalRow - m_rows );
+    }
+
+    TerminalCell* row_cells( std::size_t row ) noexcept
+    {
+        return m_cells.data() + physical_row( row ) * m_columns;
+    }
+
+    void print_text( std::string_view text );
+    std::size_t print_ascii( const char *text, const char *end );
+    void print( char32_t character, unsigned int width );
+    void execute( const CsiSequence &sequence );
+    void line_feed();
+    void erase( std::size_t row, std::size_t firstColumn, std::size_t lastColumn );
+    void move_cursor( std::size_t row, std::size_t column ) noexcept;
+
+    std::size_t m_columns;
+    std::size_t m_rows;
+    std::vector<TerminalCell> m_cells;
+    std::size_t m_topRow;
+    std::size_t m_cursorRow;
+    std::size_t m_cursorColumn;
+    std::size_t m_savedRow;
+    std::size_t m_savedColumn;
+    bool m_pendingWrap;
+    bool m_autowrap;
+    bool m_cursorVisible;
+    char32_t m_codepoint;
+    unsigned int m_pendingBytes;
+    SgrParser m_parser;
+    TerminalStats m_stats;
+};
+
+} // namespace
+
+#endif // header guard
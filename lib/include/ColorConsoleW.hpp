@@ -11,6 +11,7 @@
 #define COLORCONSOLEW_HPP_
 
 #include "ColorConsoleCommon.hpp"
+#include "ColorConsoleStats.hpp"
 
 #ifdef WIN32
 #include "windows.h"
@@ -86,6 +87,16 @@ public:
         return m_coloringEnabled;
     }
 
+    /**
+     * Returns the current console color.
+     *
+     * @return The last color set, or RESET if no color has been set yet
+     */
+    Color get_color() const noexcept
+    {
+        return m_currentColor;
+    }
+
     /**
      * Indicates if coloring is disabled.
      *
@@ -96,6 +107,28 @@ public:
         return m_coloringEnabled;
     }
 
+#ifdef COLORCONSOLE_ENABLE_STATS
+    /**
+     * Returns a snapshot of the output statistics of the console.
+     *
+     * Only available when the library is built with statistics enabled (see STATS_ENABLED).
+     *
+     * @return The statistics snapshot
+     */
+    ConsoleStatsSnapshot get_stats() const noexcept
+    {
+        return m_stats.snapshot();
+    }
+
+    /**
+     * Resets the output statistics of the console.
+     */
+    void reset_stats() noexcept
+    {
+        m_stats.reset();
+    }
+#endif
+
     /**
      * Sets (or resets) the console color.
      *
@@ -390,18 +423,47 @@ public:
         return m_consoleType;
     }
 
+    /**
+     * Returns the color-enabled standard output stream (wide characters oriented).
+     *
+     * The console is constructed on the first call (thread-safely), therefore this accessor can be used from the
+     * static initialization of other translation units.
+     */
+    static ConsoleW& get_wcout();
+
+    /**
+     * Returns the color-enabled standard output stream for errors (wide characters oriented).
+     *
+     * The console is constructed on the first call (thread-safely), therefore this accessor can be used from the
+     * static initialization of other translation units.
+     */
+    static ConsoleW& get_wcerr();
+
     /**
      * Color-enabled standard output stream (wide characters oriented).
+     *
+     * The reference is bound during static initialization, hence code running during static initialization shall
+     * use get_wcout() instead. Binding it constructs the console (and the other standard consoles) at startup whenever
+     * it is linked in, which is always the case with the shared library: programs that must not pay that cost
+     * when linked statically shall only use the accessors.
      */
-    static ConsoleW wcout;
+    static ConsoleW &wcout;
 
     /**
      * Color-enabled standard output stream for errors (wide characters oriented).
+     *
+     * The reference is bound during static initialization, hence code running during static initialization shall
+     * use get_wcerr() instead. Binding it constructs the console (and the other standard consoles) at startup whenever
+     * it is linked in, which is always the case with the shared library: programs that must not pay that cost
+     * when linked statically shall only use the accessors.
      */
-    static ConsoleW wcerr;
+    static ConsoleW &wcerr;
 
     /**
      * Initializes the consoles.
+     *
+     * The standard consoles are initialized on first use (thread-safely), therefore calling this function is
+     * optional: it just anticipates the initialization.
      */
     static void Init();
 
@@ -413,12 +475,42 @@ private:
      */
     ConsoleW( ConsoleType consoleType );
 
+    /**
+     * Constructor for the global standard streams, which are initialized on first use.
+     *
+     * @param[in] consoleType Console to color
+     * @param[in] target Standard stream to write to
+     */
+    ConsoleW( ConsoleType consoleType, std::wostream &target );
+
     void initialize();
 
+    static void initialize_lazily( void *console );
+
+    void attach_stats() noexcept
+    {
+#ifdef COLORCONSOLE_ENABLE_STATS
+        if( rdbuf() != NULL )
+        {
+            m_statsBuffer.set_target( rdbuf() );
+            rdbuf( &m_statsBuffer );
+        }
+#endif
+    }
+
     ConsoleType m_consoleType;
 
     bool m_coloringEnabled;
 
+    Color m_currentColor;
+
+    std::wstreambuf *m_ownedBuffer;
+
+#ifdef COLORCONSOLE_ENABLE_STATS
+    ConsoleStats m_stats;
+    StatsStreamBuf<wchar_t> m_statsBuffer { m_stats };
+#endif
+
 #ifdef WIN32
     HANDLE m_handle;
     WORD m_origConsoleAttrs;
@@ -0,0 +1,81 @@
+/**
+ * @file
+ * @brief      Display width of text on terminals
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLEWIDTH_HPP_
+#define COLORCONSOLEWIDTH_HPP_
+
+#include "ColorConsoleCommon.hpp"
+
+#include <cstddef>
+#include <string_view>
+
+namespace ColorConsole
+{
+
+/**
+ * Returns the number of terminal columns occupied by a code point displayed alone: 0 for control characters,
+ * combining marks and other zero-width characters, 2 for wide characters (East Asian wide and fullwidth
+ * characters and emoji displayed as such by default) and 1 for the others.
+ *
+ * The width does not depend on the locale: it is looked up in a compact table generated from the Unicode
+ * Character Database.
+ *
+ * @param[in] c Code point
+ * @return The number of columns
+ */
+COLORCONSOLE_API unsigned int code_point_width( char32_t c ) noexcept;
+
+/**
+ * Returns the number of terminal columns occupied by a text encoded in UTF-8.
+ *
+ * The text is split in grapheme clusters (user-perceived characters), each of them occupying the width of its
+ * first code point: combining marks, emoji modifiers and emoji joined by ZWJ do not add width, a variation
+ * selector 16 widens an emoji to 2 columns, and a pair of regional indicators (i.e. a flag) occupies 2
+ * columns. Escape sequences (e.g. SGR colors) and control characters do not occupy columns. Runs of printable
+ * ASCII characters are measured using SIMD instructions where available.
+ *
+ * @param[in] text Text
+ * @return The number of columns
+ */
+COLORCONSOLE_API std::size_t display_width( std::string_view text ) noexcept;
+
+/**
+ * Returns the number of terminal columns occupied by a wide text (UTF-16 or UTF-32, depending on the size of
+ * @c wchar_t), with the same rules as display_width( std::string_view ).
+ *
+ * @param[in] text Text
+ * @return The number of columns
+ */
+COLORCONSOLE_API std::size_t display_width( std::wstring_view text ) noexcept;
+
+/**
+ * Returns the longest prefix of a text encoded in UTF-8 that occupies at most a number of terminal columns.
+ *
+ * Grapheme clusters and escape sequences are never split. The escape sequences that follow the last grapheme
+ * cluster of the prefix are not included in it.
+ *
+ * @param[in] text Text
+ * @param[in] width Maximum number of columns
+ * @return The prefix (a view of @p text)
+ */
+COLORCONSOLE_API std::string_view truncate_to_width( std::string_view text, std::size_t width ) noexcept;
+
+/**
+ * Returns the longest prefix of a wide text that occupies at most a number of terminal columns, with the same
+ * rules as truncate_to_width( std::string_view, std::size_t ).
+ *
+ * @param[in] text Text
+ * @param[in] width Maximum number of columns
+ * @return The prefix (a view of @p text)
+ */
+COLORCONSOLE_API std::wstring_view truncate_to_width( std::wstring_view text, std::size_t width ) noexcept;
+
+} // namespace
+
+#endif // header guard
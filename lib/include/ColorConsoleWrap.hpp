@@ -0,0 +1,143 @@
+/**
+ * @file
+ * @brief      Word wrapping of colored output
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLEWRAP_HPP_
+#define COLORCONSOLEWRAP_HPP_
+
+#include "ColorConsoleCommon.hpp"
+#include "ColorConsoleSgr.hpp"
+
+#include <cstddef>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+namespace ColorConsole
+{
+
+/**
+ * Unbuffered stream buffer that wraps the output written into it at word boundaries to a width, and forwards
+ * it to another stream buffer, e.g. from a Console with ANSI escape codes.
+ *
+ * Words are measured by their display width (see display_width()), skipping escape sequences, which are
+ * forwarded as is. When a line is wrapped, the spaces at the wrap point are dropped, the current style (tracked
+ * using an SgrParser) is reset before the line break so that backgrounds do not extend to the end of the line,
+ * and it is applied again after the hanging indent of the continuation line. Words wider than a continuation
+ * line are split at grapheme cluster boundaries.
+ *
+ * The output is processed as a stream: only the word being written and the spaces before it are held, and they
+ * are forwarded when the word ends or the stream buffer is flushed. Line breaks, carriage returns and tabs
+ * (expanded to 8-column stops) are handled; colors set through the Windows console API are not seen.
+ *
+ * @code
+ * WrapStreamBuf wrap( std::cout.rdbuf(), 80, 4 );
+ * Console console( &wrap );
+ * console << Color::FG_LIGHT_RED << "error: " << Color::RESET << message << std::endl;
+ * @endcode
+ */
+class COLORCONSOLE_API WrapStreamBuf : public std::streambuf
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param[in] target Stream buffer to forward the output to (not owned)
+     * @param[in] width Width of the lines (in columns)
+     * @param[in] indent Indent of the continuation lines (in columns)
+     * @param[in] capability Color capability used to apply the style again on continuation lines
+     */
+    WrapStreamBuf( std::streambuf *target, std::size_t width, std::size_t indent = 0,
+                   ColorCapability capability = ColorCapability::TRUE_COLOR );
+
+    /**
+     * Destructor. Forwards the word being written, if any.
+     */
+    ~WrapStreamBuf();
+
+    WrapStreamBuf( const WrapStreamBuf& ) = delete;
+    WrapStreamBuf& operator=( const WrapStreamBuf& ) = delete;
+
+    /**
+     * Changes the width of the lines (e.g. when the terminal is resized), from the next word on. The indent is
+     * reduced if needed to leave at least 2 columns in continuation lines.
+     *
+     * @param[in] width Width of the lines (in columns)
+     */
+    void set_width( std::size_t width ) noexcept;
+
+    /**
+     * Returns the width of the lines.
+     */
+    std::size_t get_width() const noexcept
+    {
+        return m_width;
+    }
+
+    /**
+     * Returns the indent of the continuation lines.
+     */
+    std::size_t get_indent() const noexcept
+    {
+        return m_indent;
+    }
+
+    /**
+     * Returns the stream buffer the output is forwarded to.
+     */
+    std::streambuf* get_target() const noexcept
+    {
+        return m_target;
+    }
+
+protected:
+    int_type overflow( int_type c ) override;
+
+    std::streamsize xsputn( const char_type *s, std::streamsize n ) override;
+
+    int sync() override;
+
+private:
+    void route_escapes( std::string_view bytes, const SgrStyle &style );
+    void process_text( std::string_view text, const SgrStyle &style );
+    void commit_word( const SgrStyle &style );
+    void place_word_start( std::size_t wordWidth );
+    void split_word();
+    void break_line( const SgrStyle &style );
+    void end_line( char c, const SgrStyle &style );
+    bool write_output();
+
+    std::streambuf *m_target;
+    std::size_t m_width;
+    std::size_t m_requestedIndent;
+    std::size_t m_indent;
+    const ColorCapability m_capability;
+    SgrParser m_parser;
+
+    // Current output line
+    std::size_t m_column;
+    std::size_t m_lineStart;
+    bool m_continuation;
+    SgrStyle m_outputStyle;
+
+    // Spaces (and escape sequences between them) before the word being written
+    std::string m_spaces;
+    std::string m_spaceEscapes;
+    std::size_t m_spacesWidth;
+
+    // Word being written (with its escape sequences)
+    std::string m_word;
+    std::size_t m_wordWidth;
+    SgrStyle m_wordStyle;
+
+    std::string m_output;
+};
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,331 @@
+/**
+ * @file
+ * @brief      Lightweight colored text writer over caller-provided buffers
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLEWRITER_HPP_
+#define COLORCONSOLEWRITER_HPP_
+
+#include "ColorConsoleAnsi.hpp"
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+namespace ColorConsole
+{
+
+/**
+ * Integer types written as numbers by ColorWriter.
+ */
+template<class T>
+concept WriterInteger = std::integral<T> && !std::same_as<T, bool> && !std::same_as<T, char>;
+
+/**
+ * Writer of colored text into a caller-provided buffer.
+ *
+ * Colors are rendered as ANSI escape sequences. The writer never allocates memory nor throws exceptions:
+ * when the buffer is full the output is truncated (see is_truncated()), without splitting escape sequences
+ * nor UTF-8 characters. While a color is set, room for the sequence that resets it is always kept, so that
+ * finish() can restore the color even if the output was truncated.
+ *
+ * The finished buffer can be written to a console (see Console::write_raw()), to a file descriptor, queued...
+ *
+ * @code
+ * char line[128];
+ * ColorWriter writer( line );
+ * writer << Color::FG_LIGHT_RED << "E" << Color::RESET << " code " << errorCode;
+ * cout.write_raw( writer.finish() );
+ * @endcode
+ */
+class ColorWriter
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param[in] buffer Buffer to write to
+     * @param[in] enableColoring Indicates if coloring shall be enabled
+     */
+    explicit ColorWriter( std::span<char> buffer, bool enableColoring = true ) noexcept
+    : m_buffer( buffer ), m_coloringEnabled( enableColoring )
+    {}
+
+    ColorWriter( const ColorWriter& ) = delete;
+    ColorWriter& operator=( const ColorWriter& ) = delete;
+
+    /**
+     * Appends text.
+     *
+     * @param[in] text Text to append
+     * @return @c false if the text had to be truncated, @c true otherwise
+     */
+    bool append( std::string_view text ) noexcept
+    {
+        std::size_t available = available_for_text();
+        std::size_t length = text.size();
+        bool fits = ( length <= available );
+
+        if( !fits )
+        {
+            length = available;
+
+            // Do not split UTF-8 characters
+            while( ( length > 0 ) && ( ( static_cast<unsigned char>( text[length] ) & 0xC0u ) == 0x80u ) )
+            {
+                length--;
+            }
+
+            m_truncated = true;
+        }
+
+        std::memcpy( m_buffer.data() + m_size, text.data(), length );
+        m_size += length;
+
+        return fits;
+    }
+
+    /**
+     * Appends a character.
+     *
+     * @param[in] c Character to append
+     * @return @c false if the character did not fit, @c true otherwise
+     */
+    bool append( char c ) noexcept
+    {
+        if( available_for_text() == 0 )
+        {
+            m_truncated = true;
+            return false;
+        }
+
+        m_buffer[m_size++] = c;
+        return true;
+    }
+
+    /**
+     * Appends an integer number in decimal notation.
+     *
+     * @param[in] n Number to append
+     * @return @c false if the number did not fit, @c true otherwise
+     */
+    template<WriterInteger T>
+    bool append_integer( T n ) noexcept
+    {
+        char digits[24];
+        std::to_chars_result result = std::to_chars( digits, digits + sizeof(digits), n );
+        return append_whole( std::string_view( digits, static_cast<std::size_t>( result.ptr - digits ) ) );
+    }
+
+    /**
+     * Sets (or resets) the color of the text appended next.
+     *
+     * @param[in] color Color to be set, or RESET to reset to default value
+     * @return @c false if the escape sequence did not fit, @c true otherwise
+     */
+    bool set_color( Color color ) noexcept
+    {
+        if( color >= Color::RESET )
+        {
+            color = Color::RESET;
+        }
+
+        if( !m_coloringEnabled || ( color == m_currentColor ) )
+        {
+            return true;
+        }
+
+        AnsiEscape escape = ansiEscape( color );
+
+        // Room for the reset sequence must remain while a color is set
+        std::size_t needed = escape.size();
+        if( color != Color::RESET )
+        {
+            needed += ANSI_RESET_SEQUENCE.size();
+        }
+
+        if( needed > ( m_buffer.size() - m_size ) )
+        {
+            m_truncated = true;
+            return false;
+        }
+
+        std::memcpy( m_buffer.data() + m_size, escape.data(), escape.size() );
+        m_size += escape.size();
+        m_currentColor = color;
+
+        return true;
+    }
+
+    /**
+     * Resets the color and returns the written text.
+     *
+     * @return The written text
+     */
+    std::string_view finish() noexcept
+    {
+        set_color( Color::RESET );
+        return view();
+    }
+
+    /**
+     * Discards the written text, and resets the color and the truncation indicator.
+     */
+    void clear() noexcept
+    {
+        m_size = 0;
+        m_currentColor = Color::RESET;
+        m_truncated = false;
+    }
+
+    ColorWriter& operator<<( std::string_view text ) noexcept
+    {
+        append( text );
+        return *this;
+    }
+
+    ColorWriter& operator<<( const char *text ) noexcept
+    {
+        append( std::string_view( text ) );
+        return *this;
+    }
+
+    ColorWriter& operator<<( char c ) noexcept
+    {
+        append( c );
+        return *this;
+    }
+
+    template<WriterInteger T>
+    ColorWriter& operator<<( T n ) noexcept
+    {
+        append_integer( n );
+        return *this;
+    }
+
+    ColorWriter& operator<<( Color color ) noexcept
+    {
+        set_color( color );
+        return *this;
+    }
+
+    /**
+     * Returns the written text.
+     *
+     * @return The written text
+     */
+    std::string_view view() const noexcept
+    {
+        return std::string_view( m_buffer.data(), m_size );
+    }
+
+    const char* data() const noexcept
+    {
+        return m_buffer.data();
+    }
+
+    std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    std::size_t capacity() const noexcept
+    {
+        return m_buffer.size();
+    }
+
+    /**
+     * Indicates if some text or escape sequence did not fit into the buffer.
+     *
+     * @return @c true if the output was truncated, @c false otherwise
+     */
+    bool is_truncated() const noexcept
+    {
+        return m_truncated;
+    }
+
+    /**
+     * Returns the current color.
+     *
+     * @return The last color set, or RESET if no color has been set yet
+     */
+    Color get_color() const noexcept
+    {
+        return m_currentColor;
+    }
+
+    /**
+     * Indicates if coloring is enabled.
+     *
+     * @return @c true if coloring is enabled, @c false otherwise
+     */
+    bool is_coloring_enabled() const noexcept
+    {
+        return m_coloringEnabled;
+    }
+
+private:
+    std::size_t available_for_text() const noexcept
+    {
+        std::size_t reserved = ( m_currentColor != Color::RESET ) ? ANSI_RESET_SEQUENCE.size() : 0;
+        return m_buffer.size() - m_size - reserved;
+    }
+
+    bool append_whole( std::string_view text ) noexcept
+    {
+        if( text.size() > available_for_text() )
+        {
+            m_truncated = true;
+            return false;
+        }
+
+        return append( text );
+    }
+
+    std::span<char> m_buffer;
+    std::size_t m_size = 0;
+    Color m_currentColor = Color::RESET;
+    bool m_coloringEnabled;
+    bool m_truncated = false;
+};
+
+namespace Detail
+{
+
+template<std::size_t N>
+struct InlineWriterStorage
+{
+    char m_storage[N];
+};
+
+} // namespace Detail
+
+/**
+ * ColorWriter with a fixed-capacity inline buffer.
+ *
+ * @tparam N Buffer capacity
+ */
+template<std::size_t N>
+class InlineColorWriter : private Detail::InlineWriterStorage<N>, public ColorWriter
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param[in] enableColoring Indicates if coloring shall be enabled
+     */
+    explicit InlineColorWriter( bool enableColoring = true ) noexcept
+    : ColorWriter( std::span<char>( this->m_storage, N ), enableColoring )
+    {}
+};
+
+} // namespace
+
+#endif // header guard
@@ -8,9 +8,27 @@
  */
 
 #include "ColorConsole.hpp"
+#include "ColorConsoleMarkup.hpp"
 
 #include "ColorConsoleHelpers.hpp"
 
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && ( _M_IX86_FP >= 2 ) )
+#define COLORCONSOLE_SANITIZER_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(COLORCONSOLE_SANITIZER_SSE2) && ( defined(__GNUC__) || defined(__clang__) )
+#define COLORCONSOLE_SANITIZER_AVX2
+#include <immintrin.h>
+#endif
+
+#ifdef COLORCONSOLE_HAS_FORMAT
+#include <iterator>
+#include <string>
+#endif
+
 #if defined(WIN32) && defined(UNIT_TEST)
 
 #define GetStdHandle UT_GetStdHandle
@@ -27,53 +45,321 @@ BOOL UT_SetConsoleOutputCP( UINT wCodePageID );
 
 #endif // WIN32 && UNIT_TEST
 
+#ifdef COLORCONSOLE_ENABLE_PROBES
+extern "C"
+{
+volatile unsigned short colorconsole_color_change_semaphore __attribute__((section(".probes"))) = 0;
+volatile unsigned short colorconsole_write_semaphore __attribute__((section(".probes"))) = 0;
+volatile unsigned short colorconsole_flush_semaphore __attribute__((section(".probes"))) = 0;
+}
+#endif
+
 namespace ColorConsole
 {
 
-#ifndef UNIT_TEST
-Console &cout = Console::cout;
-Console &cerr = Console::cerr;
+#ifdef COLORCONSOLE_HAS_FORMAT
+static constexpr std::size_t FORMAT_BUFFER_MAX_RETAINED_SIZE = 64 * 1024;
+#endif
+
+static std::size_t renderedEscapeSize( DynamicColorPolicy::Mode mode, Color color ) noexcept
+{
+    return ( mode == DynamicColorPolicy::Mode::ANSI ) ? ansiEscape( color ).size() : 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Sanitizer
+//
+
+static inline bool isSafeAscii( unsigned char c ) noexcept
+{
+    return ( ( c >= 0x20 ) && ( c < 0x7F ) ) || ( c == '\t' ) || ( c == '\n' );
+}
+
+static std::size_t skipSafeAsciiScalar( const unsigned char *data, std::size_t size, std::size_t pos ) noexcept
+{
+    while( ( pos < size ) && isSafeAscii( data[pos] ) )
+    {
+        pos++;
+    }
 
-Console Console::cout( ConsoleType::STD_OUTPUT );
-Console Console::cerr( ConsoleType::STD_ERROR );
+    return pos;
+}
+
+#ifdef COLORCONSOLE_SANITIZER_SSE2
+static std::size_t skipSafeAsciiSSE2( const unsigned char *data, std::size_t size, std::size_t pos ) noexcept
+{
+    // Bytes below 0x20 and bytes above 0x7F (negative as signed) are found with a single signed comparison
+    const __m128i space = _mm_set1_epi8( 0x20 );
+    const __m128i del = _mm_set1_epi8( 0x7F );
+    const __m128i tab = _mm_set1_epi8( '\t' );
+    const __m128i newline = _mm_set1_epi8( '\n' );
+
+    while( pos + 16 <= size )
+    {
+        const __m128i v = _mm_loadu_si128( reinterpret_cast<const __m128i*>( data + pos ) );
+        const __m128i unsafe = _mm_or_si128( _mm_cmplt_epi8( v, space ), _mm_cmpeq_epi8( v, del ) );
+        const __m128i allowed = _mm_or_si128( _mm_cmpeq_epi8( v, tab ), _mm_cmpeq_epi8( v, newline ) );
+        const unsigned int mask = static_cast<unsigned int>( _mm_movemask_epi8( _mm_andnot_si128( allowed, unsafe ) ) );
+
+        if( mask != 0 )
+        {
+            return pos + static_cast<std::size_t>( std::countr_zero( mask ) );
+        }
+
+        pos += 16;
+    }
+
+    return skipSafeAsciiScalar( data, size, pos );
+}
 #endif
 
+#ifdef COLORCONSOLE_SANITIZER_AVX2
+__attribute__((target("avx2")))
+static std::size_t skipSafeAsciiAVX2( const unsigned char *data, std::size_t size, std::size_t pos ) noexcept
+{
+    const __m256i space = _mm256_set1_epi8( 0x20 );
+    const __m256i del = _mm256_set1_epi8( 0x7F );
+    const __m256i tab = _mm256_set1_epi8( '\t' );
+    const __m256i newline = _mm256_set1_epi8( '\n' );
+
+    while( pos + 32 <= size )
+    {
+        const __m256i v = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( data + pos ) );
+        const __m256i unsafe = _mm256_or_si256( _mm256_cmpgt_epi8( space, v ), _mm256_cmpeq_epi8( v, del ) );
+        const __m256i allowed = _mm256_or_si256( _mm256_cmpeq_epi8( v, tab ), _mm256_cmpeq_epi8( v, newline ) );
+        const unsigned int mask = static_cast<unsigned int>( _mm256_movemask_epi8( _mm256_andnot_si256( allowed, unsafe ) ) );
+
+        if( mask != 0 )
+        {
+            return pos + static_cast<std::size_t>( std::countr_zero( mask ) );
+        }
+
+        pos += 32;
+    }
+
+    return skipSafeAsciiSSE2( data, size, pos );
+}
+#endif
+
+using SkipSafeAsciiFunction = std::size_t (*)( const unsigned char*, std::size_t, std::size_t ) noexcept;
+
+static SkipSafeAsciiFunction selectSkipSafeAscii() noexcept
+{
+#if defined(COLORCONSOLE_SANITIZER_AVX2)
+    __builtin_cpu_init();
+
+    if( __builtin_cpu_supports( "avx2" ) )
+    {
+        return &skipSafeAsciiAVX2;
+    }
+#endif
+
+#if defined(COLORCONSOLE_SANITIZER_SSE2)
+    return &skipSafeAsciiSSE2;
+#else
+    return &skipSafeAsciiScalar;
+#endif
+}
+
+/**
+ * Returns the length of the valid UTF-8 sequence starting with a non-ASCII byte, or 0 if the sequence is
+ * not valid (truncated, overlong, surrogate or beyond U+10FFFF).
+ */
+static std::size_t validUtf8Length( const unsigned char *data, std::size_t size ) noexcept
+{
+    const unsigned char lead = data[0];
+    std::size_t length;
+    unsigned char minSecond = 0x80;
+    unsigned char maxSecond = 0xBF;
+
+    if( ( lead >= 0xC2 ) && ( lead <= 0xDF ) )
+    {
+        length = 2;
+    }
+    else if( ( lead >= 0xE0 ) && ( lead <= 0xEF ) )
+    {
+        length = 3;
+        if( lead == 0xE0 )
+        {
+            minSecond = 0xA0;
+        }
+        else if( lead == 0xED )
+        {
+            maxSecond = 0x9F;
+        }
+    }
+    else if( ( lead >= 0xF0 ) && ( lead <= 0xF4 ) )
+    {
+        length = 4;
+        if( lead == 0xF0 )
+        {
+            minSecond = 0x90;
+        }
+        else if( lead == 0xF4 )
+        {
+            maxSecond = 0x8F;
+        }
+    }
+    else
+    {
+        return 0;
+    }
+
+    if( ( size < length ) || ( data[1] < minSecond ) || ( data[1] > maxSecond ) )
+    {
+        return 0;
+    }
+
+    for( std::size_t i = 2; i < length; i++ )
+    {
+        if( ( data[i] & 0xC0 ) != 0x80 )
+        {
+            return 0;
+        }
+    }
+
+    return length;
+}
+
+UnsafeSequence findUnsafeSequence( std::string_view text ) noexcept
+{
+    static const SkipSafeAsciiFunction skipSafeAscii = selectSkipSafeAscii();
+
+    const unsigned char *data = reinterpret_cast<const unsigned char*>( text.data() );
+    const std::size_t size = text.size();
+    std::size_t pos = 0;
+
+    while( true )
+    {
+        pos = skipSafeAscii( data, size, pos );
+
+        if( pos >= size )
+        {
+            return UnsafeSequence { size, 0 };
+        }
+
+        if( data[pos] < 0x80 )
+        {
+            return UnsafeSequence { pos, 1 };
+        }
+
+        const std::size_t length = validUtf8Length( data + pos, size - pos );
+
+        if( length == 0 )
+        {
+            return UnsafeSequence { pos, 1 };
+        }
+
+        if( ( data[pos] == 0xC2 ) && ( data[pos + 1] < 0xA0 ) )
+        {
+            return UnsafeSequence { pos, 2 };
+        }
+
+        pos += length;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// DynamicColorPolicy
+//
+
+void DynamicColorPolicy::set_color( std::ostream &out, Color color )
+{
+    switch( m_mode )
+    {
+        case Mode::ANSI:
+            AnsiColorPolicy().set_color( out, color );
+            break;
+
+        case Mode::NATIVE:
+#ifdef WIN32
+            out.flush();
+
+            if( color >= Color::RESET )
+            {
+                SetConsoleTextAttribute( m_handle, m_defaultAttributes );
+            }
+            else
+            {
+                SetConsoleTextAttribute( m_handle, static_cast<WORD>(color) );
+            }
+#endif
+            break;
+
+        case Mode::NONE:
+            break;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Console
+//
+
 // LCOV_EXCL_START
+Console& Console::get_cout()
+{
+    static Console console( ConsoleType::STD_OUTPUT, std::cout );
+    return console;
+}
+
+Console& Console::get_cerr()
+{
+    static Console console( ConsoleType::STD_ERROR, std::cerr );
+    return console;
+}
+
 void Console::Init()
 {
-#if defined(COLORCONSOLE_REQUIRE_INITIALIZATION) && !defined(UNIT_TEST)
-    cout.initialize();
-    cerr.initialize();
-#endif
+    static_cast<LazyStreamBuf<char>*>( get_cout().m_ownedBuffer )->ensure_initialized();
+    static_cast<LazyStreamBuf<char>*>( get_cerr().m_ownedBuffer )->ensure_initialized();
 }
 // LCOV_EXCL_STOP
 
 Console::Console( ConsoleType consoleType )
 #ifdef COLORCONSOLE_REQUIRE_INITIALIZATION
-: std::ostream( NULL ), m_coloringEnabled( true )
+: std::ostream( NULL ), m_coloringEnabled( true ), m_currentColor( Color::RESET ), m_palette( NULL ),
+  m_sanitizeMode( SanitizeMode::NONE ), m_ownedBuffer( NULL )
 #else
-: std::ostream( ( consoleType == ConsoleType::STD_ERROR ) ? std::cerr.rdbuf() : std::cout.rdbuf() ), m_coloringEnabled( true )
+: std::ostream( ( consoleType == ConsoleType::STD_ERROR ) ? std::cerr.rdbuf() : std::cout.rdbuf() ), m_coloringEnabled( true ), m_currentColor( Color::RESET ), m_palette( NULL ),
+  m_sanitizeMode( SanitizeMode::NONE ), m_ownedBuffer( NULL )
 #endif
 {
     m_consoleType = consoleType;
-
-#ifdef WIN32
-    m_handle = INVALID_HANDLE_VALUE;
-#endif
+    update_color_mode();
 
 #ifndef COLORCONSOLE_REQUIRE_INITIALIZATION
     initialize();
 #endif
+
+    attach_stats();
+}
+
+Console::Console( ConsoleType consoleType, std::ostream &target )
+: std::ostream( NULL ), m_coloringEnabled( true ), m_currentColor( Color::RESET ), m_palette( NULL ),
+  m_sanitizeMode( SanitizeMode::NONE ), m_ownedBuffer( NULL )
+{
+    m_consoleType = consoleType;
+    update_color_mode();
+
+    m_ownedBuffer = new LazyStreamBuf<char>( target, consoleType, &Console::initialize_lazily, this );
+    rdbuf( m_ownedBuffer );
+
+    attach_stats();
+}
+
+void Console::initialize_lazily( void *console )
+{
+    static_cast<Console*>( console )->initialize();
 }
 
 Console::Console( std::streambuf *sb, bool enableColoring )
-: std::ostream( sb ), m_coloringEnabled( enableColoring )
+: std::ostream( sb ), m_coloringEnabled( enableColoring ), m_currentColor( Color::RESET ), m_palette( NULL ),
+  m_sanitizeMode( SanitizeMode::NONE ), m_ownedBuffer( NULL )
 {
     m_consoleType = ConsoleType::CUSTOM;
+    update_color_mode();
 
-#ifdef WIN32
-    m_handle = INVALID_HANDLE_VALUE;
-#endif
+    attach_stats();
 }
 
 Console::~Console()
@@ -83,9 +369,9 @@ Console::~Console()
     {
         flush();
 
-        if( ( m_handle != INVALID_HANDLE_VALUE ) && m_coloringEnabled )
+        if( ( m_colorPolicy.get_native_handle() != INVALID_HANDLE_VALUE ) && m_coloringEnabled )
         {
-            SetConsoleTextAttribute( m_handle, m_origConsoleAttrs );
+            SetConsoleTextAttribute( m_colorPolicy.get_native_handle(), m_colorPolicy.get_default_attributes() );
         }
     }
     else if( m_coloringEnabled )
@@ -98,6 +384,8 @@ Console::~Console()
         setAnsiColor( this, Color::RESET );
     }
 #endif
+
+    delete m_ownedBuffer;
 }
 
 void Console::initialize()
@@ -106,23 +394,24 @@ void Console::initialize()
     if( rdbuf() == NULL )
     {
         init( ( m_consoleType == ConsoleType::STD_ERROR ) ? std::cerr.rdbuf() : std::cout.rdbuf() );
+        attach_stats();
     }
 #endif
 
 #ifdef WIN32
-    if( ( m_handle == INVALID_HANDLE_VALUE ) && ( m_consoleType <= ConsoleType::STD_ERROR ) )
+    if( ( m_colorPolicy.get_native_handle() == INVALID_HANDLE_VALUE ) && ( m_consoleType <= ConsoleType::STD_ERROR ) )
     {
         if( m_consoleType == ConsoleType::STD_OUTPUT )
         {
             SetConsoleOutputCP( 65001 );
         }
 
-        m_handle = GetStdHandle( ( m_consoleType == ConsoleType::STD_ERROR ) ? STD_ERROR_HANDLE : STD_OUTPUT_HANDLE );
+        HANDLE handle = GetStdHandle( ( m_consoleType == ConsoleType::STD_ERROR ) ? STD_ERROR_HANDLE : STD_OUTPUT_HANDLE );
 
         CONSOLE_SCREEN_BUFFER_INFO consoleInfo;
-        GetConsoleScreenBufferInfo( m_handle, &consoleInfo );
+        GetConsoleScreenBufferInfo( handle, &consoleInfo );
 
-        m_origConsoleAttrs = consoleInfo.wAttributes;
+        m_colorPolicy.set_native_console( handle, consoleInfo.wAttributes );
     }
 #endif
 }
@@ -135,30 +424,172 @@ Console& Console::operator<<( Color color )
 
 void Console::set_color( Color color )
 {
-    if( m_coloringEnabled )
+    ProbeTimer timer( COLORCONSOLE_PROBE_ENABLED( color_change ) );
+
+    m_currentColor = color;
+    m_colorPolicy.set_color( *this, color );
+
+#ifdef COLORCONSOLE_ENABLE_STATS
+    DynamicColorPolicy::Mode mode = m_colorPolicy.get_mode();
+    m_stats.add_color_change( mode != DynamicColorPolicy::Mode::NONE, renderedEscapeSize( mode, color ) );
+#endif
+
+    COLORCONSOLE_PROBE4( color_change, static_cast<int>( m_consoleType ), static_cast<unsigned int>( color ),
+                         timer.is_running() ? renderedEscapeSize( m_colorPolicy.get_mode(), color ) : 0, timer.elapsed() );
+}
+
+Console& Console::write_raw( std::string_view data )
+{
+    std::streambuf *sb = rdbuf();
+    std::streamsize size = static_cast<std::streamsize>( data.size() );
+
+    if( ( sb == NULL ) || ( sb->sputn( data.data(), size ) != size ) )
     {
-#if defined(WIN32) && !defined(COLORCONSOLE_FORCE_ANSI_ESCAPE_CODES)
-        if( m_consoleType <= ConsoleType::STD_ERROR )
+        setstate( std::ios_base::badbit );
+    }
+
+    return *this;
+}
+
+Console& Console::operator<<( const SanitizedText &text )
+{
+    if( width() != 0 )
+    {
+        // Let the stream apply the field width, fill and adjustment to the whole sanitized text
+        *(static_cast<std::ostream*>(this)) << sanitizeText( text.text, text.mode );
+    }
+    else
+    {
+        sanitizeText( text.text, text.mode, [this]( std::string_view piece )
         {
-            flush();
+            write( piece.data(), static_cast<std::streamsize>( piece.size() ) );
+        } );
+    }
 
-            if( color >= Color::RESET )
-            {
-                SetConsoleTextAttribute( m_handle, m_origConsoleAttrs );
-            }
-            else
+    return *this;
+}
+
+Console& Console::operator<<( const MarkupView &markup )
+{
+    if( m_coloringEnabled && ( markup.changeCount > 0 ) )
+    {
+        if( uses_ansi_escapes() )
+        {
+            write( markup.ansi.data(), static_cast<std::streamsize>( markup.ansi.size() ) );
+            account_escapes( markup.changeCount, markup.ansi.size() - markup.plain.size() );
+        }
+        else
+        {
+            std::size_t position = 0;
+
+            for( std::size_t i = 0; i < markup.changeCount; i++ )
             {
-                SetConsoleTextAttribute( m_handle, static_cast<WORD>(color) );
+                const MarkupColorChange &change = markup.changes[i];
+                write( markup.plain.data() + position, static_cast<std::streamsize>( change.position - position ) );
+                set_color( change.color );
+                position = change.position;
             }
+
+            write( markup.plain.data() + position, static_cast<std::streamsize>( markup.plain.size() - position ) );
         }
-        else
+    }
+    else
+    {
+        write( markup.plain.data(), static_cast<std::streamsize>( markup.plain.size() ) );
+    }
+
+    if( markup.changeCount > 0 )
+    {
+        m_currentColor = markup.finalColor;
+    }
+
+    return *this;
+}
+
+#ifdef COLORCONSOLE_HAS_FORMAT
+/**
+ * Marks the per-thread format buffer as in use while it is alive.
+ */
+class FormatBufferLock
+{
+public:
+    explicit FormatBufferLock( bool &inUse ) noexcept : m_inUse( inUse ), m_locked( !inUse )
+    {
+        m_inUse = true;
+    }
+
+    ~FormatBufferLock()
+    {
+        if( m_locked )
         {
-            setAnsiColor( this, color );
+            m_inUse = false;
         }
-#else
-        setAnsiColor( this, color );
-#endif
     }
+
+    bool is_locked() const noexcept
+    {
+        return m_locked;
+    }
+
+private:
+    bool &m_inUse;
+    const bool m_locked;
+};
+
+Console& Console::vprint( std::string_view fmt, std::format_args args )
+{
+    static thread_local std::string sharedBuffer;
+    static thread_local bool sharedBufferInUse = false;
+
+    // Formatters that print into a console re-enter this function, and shall not clobber the outer buffer
+    FormatBufferLock lock( sharedBufferInUse );
+    std::string nestedBuffer;
+    std::string &buffer = lock.is_locked() ? sharedBuffer : nestedBuffer;
+
+    FormatColorState &state = formatColorState();
+    const FormatColorState savedState = state;
+
+    state.active = true;
+    state.enabled = uses_ansi_coloring();
+    state.changed = false;
+    state.currentColor = m_currentColor;
+    state.escapeCount = 0;
+    state.escapeSize = 0;
+
+    buffer.clear();
+
+    try
+    {
+        std::vformat_to( std::back_inserter( buffer ), fmt, args );
+    }
+    catch( ... )
+    {
+        state = savedState;
+        throw;
+    }
+
+    // The color is tracked even if not rendered, so that it is kept if coloring is enabled later
+    if( state.changed )
+    {
+        m_currentColor = state.currentColor;
+    }
+
+    const std::size_t escapeCount = state.escapeCount;
+    const std::size_t escapeSize = state.escapeSize;
+
+    state = savedState;
+
+    write( buffer.data(), static_cast<std::streamsize>( buffer.size() ) );
+    account_escapes( escapeCount, escapeSize );
+
+    if( buffer.capacity() > FORMAT_BUFFER_MAX_RETAINED_SIZE )
+    {
+        buffer.clear();
+        buffer.shrink_to_fit();
+    }
+
+    return *this;
 }
+#endif
 
 } // namespace
@@ -0,0 +1,849 @@
+/**
+ * @file
+ * @brief      Implementation of the pattern-based colorizing of plain text
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsoleColorize.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <bitset>
+#include <map>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && ( _M_IX86_FP >= 2 ) )
+#define COLORCONSOLE_COLORIZE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace ColorConsole
+{
+
+static constexpr std::uint32_t UNBOUNDED = UINT32_MAX;
+
+/**
+ * Maximum length of the matches of the shapes, which bounds the text held while a shape is being matched.
+ */
+static constexpr std::uint64_t MAX_SHAPE_LENGTH = 256;
+
+static constexpr bool isDigit( unsigned char c ) noexcept
+{
+    return ( c >= '0' ) && ( c <= '9' );
+}
+
+static constexpr bool isAlpha( unsigned char c ) noexcept
+{
+    return ( ( c >= 'a' ) && ( c <= 'z' ) ) || ( ( c >= 'A' ) && ( c <= 'Z' ) );
+}
+
+static constexpr bool isHexDigit( unsigned char c ) noexcept
+{
+    return isDigit( c ) || ( ( c >= 'a' ) && ( c <= 'f' ) ) || ( ( c >= 'A' ) && ( c <= 'F' ) );
+}
+
+static constexpr bool isWordByte( unsigned char c ) noexcept
+{
+    return isDigit( c ) || isAlpha( c ) || ( c == '_' ) || ( c >= 0x80 );
+}
+
+/**
+ * Parses an unsigned number, advancing the position past it.
+ *
+ * @return @c false if there are no digits at the position
+ */
+static bool parseNumber( std::string_view text, std::size_t &position, std::uint32_t &value )
+{
+    const std::size_t start = position;
+    std::uint64_t number = 0;
+
+    for( ; ( position < text.size() ) && isDigit( static_cast<unsigned char>( text[position] ) ); position++ )
+    {
+        number = std::min<std::uint64_t>( ( number * 10 ) + static_cast<std::uint64_t>( text[position] - '0' ), UNBOUNDED - 1 );
+    }
+
+    value = static_cast<std::uint32_t>( number );
+    return ( position > start );
+}
+
+/**
+ * Element of a shape: set of bytes, repeated.
+ */
+struct ShapeElement
+{
+    std::bitset<256> bytes;
+    std::uint32_t min;
+    std::uint32_t max;
+};
+
+/**
+ * Parses a shape into its elements (see Colorizer).
+ *
+ * Repetitions are clamped beyond the maximum length of the matches, which keeps the compiled shape small.
+ */
+static std::vector<ShapeElement> parseShape( std::string_view pattern )
+{
+    constexpr std::uint32_t MAX_COUNT = static_cast<std::uint32_t>( MAX_SHAPE_LENGTH + 1 );
+
+    std::vector<ShapeElement> elements;
+
+    std::size_t i = 0;
+    while( i < pattern.size() )
+    {
+        ShapeElement element;
+        element.min = 1;
+        element.max = 1;
+
+        const unsigned char c = static_cast<unsigned char>( pattern[i++] );
+        if( ( c == '%' ) && ( i < pattern.size() ) )
+        {
+            const unsigned char cls = static_cast<unsigned char>( pattern[i++] );
+            for( unsigned int byte = 0; byte < 128; byte++ )
+            {
+                const unsigned char b = static_cast<unsigned char>( byte );
+                const bool member = ( cls == 'd' ) ? isDigit( b ) :
+                                    ( cls == 'x' ) ? isHexDigit( b ) :
+                                    ( cls == 'a' ) ? isAlpha( b ) :
+                                    ( cls == 'w' ) ? ( isDigit( b ) || isAlpha( b ) || ( b == '_' ) ) :
+                                    ( b == cls );
+                element.bytes.set( byte, member );
+            }
+            if( cls >= 128 )
+            {
+                element.bytes.set( cls );
+            }
+        }
+        else
+        {
+            element.bytes.set( c );
+        }
+
+        if( i < pattern.size() )
+        {
+            switch( pattern[i] )
+            {
+                case '+':
+                    element.max = UNBOUNDED;
+                    i++;
+                    break;
+
+                case '*':
+                    element.min = 0;
+                    element.max = UNBOUNDED;
+                    i++;
+                    break;
+
+                case '?':
+                    element.min = 0;
+                    i++;
+                    break;
+
+                case '{':
+                {
+                    std::size_t position = i + 1;
+                    std::uint32_t min;
+                    std::uint32_t max;
+
+                    if( parseNumber( pattern, position, min ) && ( position < pattern.size() ) )
+                    {
+                        max = min;
+                        if( pattern[position] == ',' )
+                        {
+                            position++;
+                            if( !parseNumber( pattern, position, max ) )
+                            {
+                                max = UNBOUNDED;
+                            }
+                        }
+
+                        // Malformed repetitions are taken literally
+                        if( ( position < pattern.size() ) && ( pattern[position] == '}' ) && ( max >= min ) )
+                        {
+                            element.min = std::min( min, MAX_COUNT );
+                            element.max = ( max == UNBOUNDED ) ? UNBOUNDED : std::min( max, MAX_COUNT );
+                            i = position + 1;
+                        }
+                    }
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        }
+
+        elements.push_back( element );
+    }
+
+    return elements;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Colorizer
+//
+
+Colorizer::Colorizer( const std::vector<ColorizeRule> &keywords, const std::vector<ColorizeRule> &shapes )
+: m_classCount( 0 ), m_keywordStartCount( 0 )
+{
+    build_automaton( keywords );
+
+    for( const ColorizeRule &rule : shapes )
+    {
+        Shape shape;
+        if( compile_shape( rule, shape ) )
+        {
+            m_shapes.push_back( std::move( shape ) );
+        }
+    }
+
+    // Bytes that can be the first one of a shape
+    bool shapeStart[256] = {};
+    for( const Shape &shape : m_shapes )
+    {
+        for( unsigned int c = 0; c < 256; c++ )
+        {
+            shapeStart[c] = shapeStart[c] || ( shape.transitions[shape.byteClass[c]] < SHAPE_MATCH );
+        }
+    }
+
+    for( unsigned int c = 0; c < 256; c++ )
+    {
+        m_byteFlags[c] = static_cast<std::uint8_t>( ( isWordByte( static_cast<unsigned char>( c ) ) ? WORD_BYTE : 0 ) |
+                                                    ( ( m_transitions[m_byteClass[c]] != 0 ) ? KEYWORD_START : 0 ) |
+                                                    ( shapeStart[c] ? SHAPE_START : 0 ) );
+    }
+
+    m_keywordStartCount = 0;
+    for( unsigned int c = 0; c < 256; c++ )
+    {
+        if( ( m_byteFlags[c] & KEYWORD_START ) != 0 )
+        {
+            if( m_keywordStartCount == MAX_KEYWORD_STARTS )
+            {
+                m_keywordStartCount = 0;
+                break;
+            }
+            m_keywordStarts[m_keywordStartCount++] = static_cast<std::uint8_t>( c );
+        }
+    }
+}
+
+void Colorizer::build_automaton( const std::vector<ColorizeRule> &keywords )
+{
+    // Byte classes: one for each byte used by the keywords, and one shared by the rest (if any)
+    bool used[256] = {};
+    std::size_t usedCount = 0;
+    for( const ColorizeRule &rule : keywords )
+    {
+        for( char c : rule.pattern )
+        {
+            const unsigned char byte = static_cast<unsigned char>( c );
+            usedCount += used[byte] ? 0 : 1;
+            used[byte] = true;
+        }
+    }
+
+    m_classCount = ( usedCount < 256 ) ? 1 : 0;
+    for( unsigned int c = 0; c < 256; c++ )
+    {
+        m_byteClass[c] = used[c] ? static_cast<std::uint8_t>( m_classCount++ ) : 0;
+    }
+
+    // Trie of the keywords (state 0 is the root, so that 0 is never the target of a trie edge)
+    m_transitions.assign( m_classCount, 0 );
+    m_depth.assign( 1, 0 );
+    m_output.assign( 1, NO_KEYWORD );
+
+    for( const ColorizeRule &rule : keywords )
+    {
+        if( rule.pattern.empty() )
+        {
+            continue;
+        }
+
+        std::uint32_t state = 0;
+        for( char c : rule.pattern )
+        {
+            std::uint32_t &next = m_transitions[( state * m_classCount ) + m_byteClass[static_cast<unsigned char>( c )]];
+            if( next == 0 )
+            {
+                next = static_cast<std::uint32_t>( m_depth.size() );
+                m_transitions.resize( m_transitions.size() + m_classCount, 0 );
+                m_depth.push_back( m_depth[state] + 1 );
+                m_output.push_back( NO_KEYWORD );
+            }
+            state = m_transitions[( state * m_classCount ) + m_byteClass[static_cast<unsigned char>( c )]];
+        }
+
+        if( m_output[state] == NO_KEYWORD )
+        {
+            m_output[state] = static_cast<std::uint32_t>( m_keywords.size() );
+            m_keywords.push_back( { static_cast<std::uint32_t>( rule.pattern.size() ), rule.color, NO_KEYWORD } );
+        }
+    }
+
+    // Failure links, breadth-first, turning the trie into a DFA (the missing edges of each state are taken from
+    // its failure state, already complete) and chaining the keywords that are suffixes of longer ones
+    std::vector<std::uint32_t> failure( m_depth.size(), 0 );
+    std::vector<std::uint32_t> queue;
+    queue.reserve( m_depth.size() );
+    queue.push_back( 0 );
+
+    for( std::size_t i = 0; i < queue.size(); i++ )
+    {
+        const std::uint32_t state = queue[i];
+        const std::size_t row = state * m_classCount;
+        const std::size_t failureRow = failure[state] * m_classCount;
+
+        for( std::size_t c = 0; c < m_classCount; c++ )
+        {
+            const std::uint32_t child = m_transitions[row + c];
+
+            if( child != 0 )
+            {
+                failure[child] = ( state == 0 ) ? 0 : m_transitions[failureRow + c];
+
+                const std::uint32_t suffixOutput = m_output[failure[child]];
+                if( m_output[child] == NO_KEYWORD )
+                {
+                    m_output[child] = suffixOutput;
+                }
+                else
+                {
+                    m_keywords[m_output[child]].next = suffixOutput;
+                }
+
+                queue.push_back( child );
+            }
+            else if( state != 0 )
+            {
+                m_transitions[row + c] = m_transitions[failureRow + c];
+            }
+        }
+    }
+}
+
+bool Colorizer::compile_shape( const ColorizeRule &rule, Shape &shape )
+{
+    const std::vector<ShapeElement> elements = parseShape( rule.pattern );
+    if( elements.empty() )
+    {
+        return false;
+    }
+
+    // Byte classes: bytes accepted by the same elements, and equally being word boundaries or not, share a class
+    std::map<std::vector<bool>, std::uint8_t> classes;
+    for( unsigned int c = 0; c < 256; c++ )
+    {
+        std::vector<bool> signature;
+        signature.reserve( elements.size() + 1 );
+        for( const ShapeElement &element : elements )
+        {
+            signature.push_back( element.bytes.test( c ) );
+        }
+        signature.push_back( isWordByte( static_cast<unsigned char>( c ) ) );
+
+        const auto inserted = classes.emplace( std::move( signature ), static_cast<std::uint8_t>( classes.size() ) );
+        shape.byteClass[c] = inserted.first->second;
+    }
+    shape.classCount = classes.size();
+
+    // States: element and repetition count, which is not tracked beyond the minimum for unbounded repetitions
+    std::vector<std::size_t> firstState( elements.size() + 1, 0 );
+    for( std::size_t e = 0; e < elements.size(); e++ )
+    {
+        const ShapeElement &element = elements[e];
+        firstState[e + 1] = firstState[e] + ( ( element.max == UNBOUNDED ) ? element.min : element.max ) + 1;
+    }
+
+    const std::size_t stateCount = firstState.back();
+    if( stateCount >= SHAPE_MATCH )
+    {
+        return false;
+    }
+
+    shape.transitions.assign( stateCount * shape.classCount, SHAPE_FAIL );
+    shape.complete.assign( stateCount, false );
+    shape.color = rule.color;
+
+    for( std::size_t e = 0; e < elements.size(); e++ )
+    {
+        for( std::uint32_t count = 0; ( firstState[e] + count ) < firstState[e + 1]; count++ )
+        {
+            const std::size_t state = firstState[e] + count;
+
+            // Greedy matching: the element takes the byte if it can, otherwise the next elements are tried
+            for( unsigned int c = 0; c < 256; c++ )
+            {
+                std::uint16_t next = SHAPE_FAIL;
+                std::size_t element = e;
+                std::uint32_t elementCount = count;
+
+                while( true )
+                {
+                    const ShapeElement &current = elements[element];
+                    if( ( elementCount < current.max ) && current.bytes.test( c ) )
+                    {
+                        const std::uint32_t nextCount = ( current.max == UNBOUNDED ) ? std::min( elementCount + 1, current.min ) : ( elementCount + 1 );
+                        next = static_cast<std::uint16_t>( firstState[element] + nextCount );
+                        break;
+                    }
+
+                    if( elementCount < current.min )
+                    {
+                        break;
+                    }
+
+                    if( ( element + 1 ) < elements.size() )
+                    {
+                        element++;
+                        elementCount = 0;
+                        continue;
+                    }
+
+                    // Complete: it matches if it ends at a word boundary (and it is not empty)
+                    if( !isWordByte( static_cast<unsigned char>( c ) ) && ( state != 0 ) )
+                    {
+                        next = SHAPE_MATCH;
+                    }
+                    break;
+                }
+
+                shape.transitions[( state * shape.classCount ) + shape.byteClass[c]] = next;
+            }
+
+            bool complete = ( count >= elements[e].min ) && ( state != 0 );
+            for( std::size_t later = e + 1; complete && ( later < elements.size() ); later++ )
+            {
+                complete = ( elements[later].min == 0 );
+            }
+            shape.complete[state] = complete;
+        }
+    }
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Colorize scanner
+//
+
+#ifdef COLORCONSOLE_COLORIZE_SSE2
+/**
+ * Skips the text up to the first byte equal to any of the given ones, comparing 16 bytes at a time.
+ *
+ * @return Pointer to the first byte found, or to the last bytes (less than 16) of the text
+ */
+static const unsigned char* skipToBytes( const unsigned char *p, const unsigned char *end, const std::uint8_t *bytes,
+                                         std::size_t count ) noexcept
+{
+    __m128i targets[8];
+    for( std::size_t i = 0; i < count; i++ )
+    {
+        targets[i] = _mm_set1_epi8( static_cast<char>( bytes[i] ) );
+    }
+
+    for( ; ( end - p ) >= 16; p += 16 )
+    {
+        const __m128i block = _mm_loadu_si128( reinterpret_cast<const __m128i*>( p ) );
+        __m128i found = _mm_cmpeq_epi8( block, targets[0] );
+        for( std::size_t i = 1; i < count; i++ )
+        {
+            found = _mm_or_si128( found, _mm_cmpeq_epi8( block, targets[i] ) );
+        }
+
+        const unsigned int mask = static_cast<unsigned int>( _mm_movemask_epi8( found ) );
+        if( mask != 0 )
+        {
+            return p + std::countr_zero( mask );
+        }
+    }
+
+    return p;
+}
+#endif
+
+ColorizeScanner::ColorizeScanner( const Colorizer &colorizer, Writer writer )
+: m_colorizer( colorizer ), m_writer( std::move( writer ) ), m_state( 0 ), m_previousWord( false ), m_committedEnd( 0 ),
+  m_emitted( 0 ), m_chunkStart( 0 )
+{}
+
+void ColorizeScanner::process( std::string_view chunk )
+{
+    const unsigned char *begin = reinterpret_cast<const unsigned char*>( chunk.data() );
+    const unsigned char *end = begin + chunk.size();
+    const unsigned char *p = begin;
+
+    const std::uint8_t *byteFlags = m_colorizer.m_byteFlags;
+    const std::uint8_t *byteClass = m_colorizer.m_byteClass;
+    const std::uint32_t *transitions = m_colorizer.m_transitions.data();
+    const std::uint32_t *output = m_colorizer.m_output.data();
+    const std::size_t classCount = m_colorizer.m_classCount;
+
+#ifdef COLORCONSOLE_COLORIZE_SSE2
+    const bool vectorSkip = m_colorizer.m_shapes.empty() && ( m_colorizer.m_keywordStartCount > 0 );
+#endif
+
+    std::uint32_t state = m_state;
+    bool previousWord = m_previousWord;
+
+    m_chunk = chunk;
+
+    while( p < end )
+    {
+        if( ( state == 0 ) && m_shapeTrackers.empty() && m_matches.empty() )
+        {
+            // No match in progress: skip up to a byte that can start one
+#ifdef COLORCONSOLE_COLORIZE_SSE2
+            if( vectorSkip )
+            {
+                const unsigned char *next = skipToBytes( p, end, m_colorizer.m_keywordStarts, m_colorizer.m_keywordStartCount );
+                if( next > p )
+                {
+                    previousWord = ( ( byteFlags[next[-1]] & Colorizer::WORD_BYTE ) != 0 );
+                    p = next;
+                }
+            }
+#endif
+            for( ; p < end; p++ )
+            {
+                const std::uint8_t flags = byteFlags[*p];
+                if( ( ( flags & Colorizer::KEYWORD_START ) != 0 ) || ( ( ( flags & Colorizer::SHAPE_START ) != 0 ) && !previousWord ) )
+                {
+                    break;
+                }
+                previousWord = ( ( flags & Colorizer::WORD_BYTE ) != 0 );
+            }
+
+            if( p == end )
+            {
+                break;
+            }
+        }
+
+        const unsigned char c = *p;
+        const std::uint8_t flags = byteFlags[c];
+        const std::uint64_t position = m_chunkStart + static_cast<std::uint64_t>( p - begin );
+
+        state = transitions[( state * classCount ) + byteClass[c]];
+
+        if( !m_shapeTrackers.empty() )
+        {
+            advance_shapes( c, position );
+        }
+
+        // Shapes starting inside a colorized match can not be colorized
+        if( ( ( flags & Colorizer::SHAPE_START ) != 0 ) && !previousWord && ( position >= m_committedEnd ) )
+        {
+            match_shapes( p, end, position );
+        }
+
+        if( output[state] != Colorizer::NO_KEYWORD )
+        {
+            add_keyword_matches( state, position + 1 );
+        }
+
+        if( !m_matches.empty() )
+        {
+            m_state = state;
+            commit_matches( get_horizon( position + 1 ) );
+        }
+
+        previousWord = ( ( flags & Colorizer::WORD_BYTE ) != 0 );
+        p++;
+    }
+
+    m_state = state;
+    m_previousWord = previousWord;
+
+    // Write the text that can no longer be part of a match, and hold the rest
+    const std::uint64_t chunkEnd = m_chunkStart + chunk.size();
+    std::uint64_t horizon = get_horizon( chunkEnd );
+    commit_matches( horizon );
+
+    for( const Match &match : m_matches )
+    {
+        horizon = std::min( horizon, match.start );
+    }
+    emit( horizon, std::nullopt );
+
+    const std::uint64_t heldStart = m_chunkStart - m_held.size();
+    if( m_emitted < m_chunkStart )
+    {
+        m_held.erase( 0, static_cast<std::size_t>( m_emitted - heldStart ) );
+        m_held.append( chunk );
+    }
+    else
+    {
+        m_held.assign( chunk.substr( static_cast<std::size_t>( m_emitted - m_chunkStart ) ) );
+    }
+
+    m_chunkStart = chunkEnd;
+    m_chunk = std::string_view();
+}
+
+void ColorizeScanner::finish()
+{
+    // The end of the text is a word boundary for the shapes in progress
+    for( const ShapeTracker &tracker : m_shapeTrackers )
+    {
+        const Colorizer::Shape &shape = m_colorizer.m_shapes[tracker.shape];
+        if( shape.complete[tracker.state] && ( m_chunkStart > tracker.start ) )
+        {
+            add_match( tracker.start, m_chunkStart, shape.color, tracker.shape + 1 );
+        }
+    }
+    m_shapeTrackers.clear();
+
+    commit_matches( UINT64_MAX );
+    emit( m_chunkStart, std::nullopt );
+
+    m_held.clear();
+    m_state = 0;
+    m_previousWord = false;
+}
+
+void ColorizeScanner::add_keyword_matches( std::uint32_t state, std::uint64_t end )
+{
+    for( std::uint32_t k = m_colorizer.m_output[state]; k != Colorizer::NO_KEYWORD; k = m_colorizer.m_keywords[k].next )
+    {
+        const Colorizer::Keyword &keyword = m_colorizer.m_keywords[k];
+        add_match( end - keyword.length, end, keyword.color, 0 );
+    }
+}
+
+void ColorizeScanner::add_match( std::uint64_t start, std::uint64_t end, Color color, std::size_t precedence )
+{
+    if( start >= m_committedEnd )
+    {
+        m_matches.push_back( { start, end, color, precedence } );
+    }
+}
+
+void ColorizeScanner::match_shapes( const unsigned char *p, const unsigned char *end, std::uint64_t position )
+{
+    const std::uint64_t available = static_cast<std::uint64_t>( end - p );
+    const unsigned char *limit = p + std::min( available, MAX_SHAPE_LENGTH + 1 );
+
+    for( std::size_t i = 0; i < m_colorizer.m_shapes.size(); i++ )
+    {
+        const Colorizer::Shape &shape = m_colorizer.m_shapes[i];
+        const std::uint8_t *byteClass = shape.byteClass;
+        const std::uint16_t *transitions = shape.transitions.data();
+        const std::size_t classCount = shape.classCount;
+
+        // Matched directly on the chunk, unless it is still undecided at the end of the chunk
+        const unsigned char *q = p;
+        std::uint16_t state = 0;
+        for( ; q < limit; q++ )
+        {
+            state = transitions[( state * classCount ) + byteClass[*q]];
+            if( state >= Colorizer::SHAPE_MATCH )
+            {
+                break;
+            }
+        }
+
+        if( q == limit )
+        {
+            if( limit == end )
+            {
+                // Tracked byte by byte from the current one
+                ShapeTracker &added = m_shapeTrackers.emplace_back( ShapeTracker{ i, position, 0 } );
+                if( !advance_shape( added, *p, position ) )
+                {
+                    m_shapeTrackers.pop_back();
+                }
+            }
+        }
+        else if( state == Colorizer::SHAPE_MATCH )
+        {
+            add_match( position, position + static_cast<std::uint64_t>( q - p ), shape.color, i + 1 );
+        }
+    }
+}
+
+void ColorizeScanner::advance_shapes( unsigned char c, std::uint64_t position )
+{
+    for( std::size_t i = 0; i < m_shapeTrackers.size(); )
+    {
+        if( advance_shape( m_shapeTrackers[i], c, position ) )
+        {
+            i++;
+        }
+        else
+        {
+            m_shapeTrackers[i] = m_shapeTrackers.back();
+            m_shapeTrackers.pop_back();
+        }
+    }
+}
+
+bool ColorizeScanner::advance_shape( ShapeTracker &tracker, unsigned char c, std::uint64_t position )
+{
+    const Colorizer::Shape &shape = m_colorizer.m_shapes[tracker.shape];
+    const std::uint16_t state = shape.transitions[( tracker.state * shape.classCount ) + shape.byteClass[c]];
+
+    if( state < Colorizer::SHAPE_MATCH )
+    {
+        tracker.state = state;
+        return ( ( position + 1 - tracker.start ) <= MAX_SHAPE_LENGTH );
+    }
+
+    if( ( state == Colorizer::SHAPE_MATCH ) && ( position > tracker.start ) )
+    {
+        add_match( tracker.start, position, shape.color, tracker.shape + 1 );
+    }
+
+    return false;
+}
+
+std::uint64_t ColorizeScanner::get_horizon( std::uint64_t position ) const noexcept
+{
+    // Matches still in progress can not start before the horizon
+    std::uint64_t horizon = position - m_colorizer.m_depth[m_state];
+
+    for( const ShapeTracker &tracker : m_shapeTrackers )
+    {
+        horizon = std::min( horizon, tracker.start );
+    }
+
+    return horizon;
+}
+
+void ColorizeScanner::commit_matches( std::uint64_t horizon )
+{
+    while( !m_matches.empty() )
+    {
+        // Leftmost match, the longest one among those starting at the same position, and then the one with the
+        // highest precedence
+        const Match *best = &m_matches.front();
+        for( const Match &match : m_matches )
+        {
+            if( ( match.start < best->start ) ||
+                ( ( match.start == best->start ) && ( ( match.end > best->end ) ||
+                                                      ( ( match.end == best->end ) && ( match.precedence < best->precedence ) ) ) ) )
+            {
+                best = &match;
+            }
+        }
+
+        // A longer or more leftward match may still be found
+        if( best->start >= horizon )
+        {
+            break;
+        }
+
+        const Match match = *best;
+        emit( match.start, std::nullopt );
+        emit( match.end, match.color );
+        m_committedEnd = match.end;
+
+        m_matches.erase( std::remove_if( m_matches.begin(), m_matches.end(),
+                                         [&match]( const Match &other ) { return other.start < match.end; } ),
+                         m_matches.end() );
+    }
+}
+
+void ColorizeScanner::emit( std::uint64_t end, std::optional<Color> color )
+{
+    if( end <= m_emitted )
+    {
+        return;
+    }
+
+    const std::uint64_t heldStart = m_chunkStart - m_held.size();
+    std::string_view held;
+    std::string_view fresh;
+
+    if( m_emitted < m_chunkStart )
+    {
+        held = std::string_view( m_held ).substr( static_cast<std::size_t>( m_emitted - heldStart ),
+                                                 static_cast<std::size_t>( std::min( end, m_chunkStart ) - m_emitted ) );
+    }
+    if( end > m_chunkStart )
+    {
+        const std::uint64_t start = std::max( m_emitted, m_chunkStart );
+        fresh = m_chunk.substr( static_cast<std::size_t>( start - m_chunkStart ), static_cast<std::size_t>( end - start ) );
+    }
+
+    m_emitted = end;
+
+    if( !held.empty() && !fresh.empty() && color.has_value() )
+    {
+        // Colorized runs are written at once
+        std::string run;
+        run.reserve( held.size() + fresh.size() );
+        run.append( held ).append( fresh );
+        m_writer( run, color );
+        return;
+    }
+
+    if( !held.empty() )
+    {
+        m_writer( held, color );
+    }
+    if( !fresh.empty() )
+    {
+        m_writer( fresh, color );
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Colorize stream buffer
+//
+
+ColorizeStreamBuf::ColorizeStreamBuf( Console &target, const Colorizer &colorizer )
+: m_target( target ),
+  m_scanner( colorizer, [this]( std::string_view text, std::optional<Color> color ) { write_run( text, color ); } )
+{}
+
+ColorizeStreamBuf::~ColorizeStreamBuf()
+{
+    m_scanner.finish();
+}
+
+ColorizeStreamBuf::int_type ColorizeStreamBuf::overflow( int_type c )
+{
+    if( traits_type::eq_int_type( c, traits_type::eof() ) )
+    {
+        return traits_type::not_eof( c );
+    }
+
+    const char_type ch = traits_type::to_char_type( c );
+
+    return ( xsputn( &ch, 1 ) == 1 ) ? c : traits_type::eof();
+}
+
+std::streamsize ColorizeStreamBuf::xsputn( const char_type *s, std::streamsize n )
+{
+    m_scanner.process( std::string_view( s, static_cast<std::size_t>( n ) ) );
+
+    return m_target.good() ? n : 0;
+}
+
+int ColorizeStreamBuf::sync()
+{
+    m_target.flush();
+
+    return m_target.good() ? 0 : -1;
+}
+
+void ColorizeStreamBuf::write_run( std::string_view text, std::optional<Color> color )
+{
+    if( !color.has_value() )
+    {
+        m_target.write( text.data(), static_cast<std::streamsize>( text.size() ) );
+        return;
+    }
+
+    const Color previousColor = m_target.get_color();
+    m_target.set_color( *color );
+    m_target.write( text.data(), static_cast<std::streamsize>( text.size() ) );
+    m_target.set_color( previousColor );
+}
+
+} // namespace
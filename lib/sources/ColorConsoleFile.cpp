@@ -0,0 +1,117 @@
+/**
+ * @file
+ * @brief      Implementation of ColorConsole C stdio backend
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleFile.hpp"
+#include "ColorConsoleProbes.hpp"
+
+#include <cstdio>
+
+#if defined(_WIN32)
+
+#define lockFile( f ) _lock_file( f )
+#define unlockFile( f ) _unlock_file( f )
+#define writeUnlocked( p, s, n, f ) _fwrite_nolock( p, s, n, f )
+#define putcUnlocked( c, f ) _putc_nolock( c, f )
+
+#elif defined(__GLIBC__) || defined(__APPLE__) || defined(__FreeBSD__)
+
+#define lockFile( f ) flockfile( f )
+#define unlockFile( f ) funlockfile( f )
+#if defined(__GLIBC__)
+#define writeUnlocked( p, s, n, f ) fwrite_unlocked( p, s, n, f )
+#else
+#define writeUnlocked( p, s, n, f ) std::fwrite( p, s, n, f )
+#endif
+#define putcUnlocked( c, f ) putc_unlocked( c, f )
+
+#else
+
+#define lockFile( f ) flockfile( f )
+#define unlockFile( f ) funlockfile( f )
+#define writeUnlocked( p, s, n, f ) std::fwrite( p, s, n, f )
+#define putcUnlocked( c, f ) putc_unlocked( c, f )
+
+#endif
+
+namespace ColorConsole
+{
+
+//////////////////////////////////////////////////////////////////////////
+// FileStreamBuf
+//
+
+void FileStreamBuf::lock() noexcept
+{
+    lockFile( m_file );
+}
+
+void FileStreamBuf::unlock() noexcept
+{
+    unlockFile( m_file );
+}
+
+FileStreamBuf::int_type FileStreamBuf::overflow( int_type c )
+{
+    if( traits_type::eq_int_type( c, traits_type::eof() ) )
+    {
+        return traits_type::not_eof( c );
+    }
+
+    ProbeTimer timer( COLORCONSOLE_PROBE_ENABLED( write ) );
+
+    lockFile( m_file );
+    int result = putcUnlocked( traits_type::to_char_type( c ), m_file );
+    unlockFile( m_file );
+
+    COLORCONSOLE_PROBE3( write, static_cast<int>( ConsoleType::CUSTOM ), ( result == EOF ) ? 0 : 1, timer.elapsed() );
+
+    return ( result == EOF ) ? traits_type::eof() : c;
+}
+
+std::streamsize FileStreamBuf::xsputn( const char_type *s, std::streamsize n )
+{
+    if( n <= 0 )
+    {
+        return 0;
+    }
+
+    ProbeTimer timer( COLORCONSOLE_PROBE_ENABLED( write ) );
+
+    lockFile( m_file );
+    std::size_t written = writeUnlocked( s, 1, static_cast<std::size_t>( n ), m_file );
+    unlockFile( m_file );
+
+    COLORCONSOLE_PROBE3( write, static_cast<int>( ConsoleType::CUSTOM ), written, timer.elapsed() );
+
+    return static_cast<std::streamsize>( written );
+}
+
+int FileStreamBuf::sync()
+{
+    ProbeTimer timer( COLORCONSOLE_PROBE_ENABLED( flush ) );
+
+    int result = ( std::fflush( m_file ) == 0 ) ? 0 : -1;
+
+    COLORCONSOLE_PROBE3( flush, static_cast<int>( ConsoleType::CUSTOM ), result, timer.elapsed() );
+
+    return result;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Console
+//
+
+Console::Console( std::FILE *file, bool enableColoring )
+: Console( new FileStreamBuf( file ), enableColoring )
+{
+    m_ownedBuffer = output_buffer();
+}
+
+} // namespace
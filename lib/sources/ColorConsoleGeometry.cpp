@@ -0,0 +1,209 @@
+/**
+ * @file
+ * @brief      Implementation of the cached terminal size
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsoleGeometry.hpp"
+
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <csignal>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+namespace ColorConsole
+{
+
+//////////////////////////////////////////////////////////////////////////
+// Platform
+//
+
+#if defined(_WIN32)
+
+static bool queryConsole( DWORD stdHandle, TerminalSize &size )
+{
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if( !GetConsoleScreenBufferInfo( GetStdHandle( stdHandle ), &info ) )
+    {
+        return false;
+    }
+
+    size.columns = static_cast<std::uint16_t>( info.srWindow.Right - info.srWindow.Left + 1 );
+    size.rows = static_cast<std::uint16_t>( info.srWindow.Bottom - info.srWindow.Top + 1 );
+    return true;
+}
+
+static TerminalGeometry::Query standardQuery( ConsoleType type )
+{
+    const DWORD stdHandle = ( type == ConsoleType::STD_ERROR ) ? STD_ERROR_HANDLE : STD_OUTPUT_HANDLE;
+    return [stdHandle]( TerminalSize &size ) { return queryConsole( stdHandle, size ); };
+}
+
+static void installResizeHandler()
+{
+}
+
+#else
+
+static bool queryTerminal( int fd, TerminalSize &size )
+{
+    struct winsize windowSize;
+    if( ( ioctl( fd, TIOCGWINSZ, &windowSize ) != 0 ) || ( windowSize.ws_col == 0 ) )
+    {
+        return false;
+    }
+
+    size.columns = windowSize.ws_col;
+    size.rows = windowSize.ws_row;
+    return true;
+}
+
+static TerminalGeometry::Query standardQuery( ConsoleType type )
+{
+    const int fd = ( type == ConsoleType::STD_ERROR ) ? STDERR_FILENO : STDOUT_FILENO;
+    return [fd]( TerminalSize &size ) { return queryTerminal( fd, size ); };
+}
+
+// The signal handler only performs lock-free atomic operations
+static_assert( std::atomic<std::uint64_t>::is_always_lock_free );
+static_assert( std::atomic<TerminalGeometry*>::is_always_lock_free );
+
+static std::atomic<TerminalGeometry*> s_resizeTargets[2];
+static struct sigaction s_previousAction;
+
+static void handleResize( int signal, siginfo_t *info, void *context )
+{
+    for( std::atomic<TerminalGeometry*> &target : s_resizeTargets )
+    {
+        TerminalGeometry *geometry = target.load( std::memory_order_relaxed );
+        if( geometry != nullptr )
+        {
+            geometry->notify_resize();
+        }
+    }
+
+    if( ( s_previousAction.sa_flags & SA_SIGINFO ) != 0 )
+    {
+        if( s_previousAction.sa_sigaction != nullptr )
+        {
+            s_previousAction.sa_sigaction( signal, info, context );
+        }
+    }
+    else if( ( s_previousAction.sa_handler != SIG_DFL ) && ( s_previousAction.sa_handler != SIG_IGN ) )
+    {
+        s_previousAction.sa_handler( signal );
+    }
+}
+
+static void installResizeHandler()
+{
+    struct sigaction action = {};
+    action.sa_sigaction = handleResize;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset( &action.sa_mask );
+
+    sigaction( SIGWINCH, &action, &s_previousAction );
+}
+
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+// Terminal geometry
+//
+
+TerminalGeometry::TerminalGeometry( Query query, TerminalSize defaultSize )
+: m_query( std::move( query ) ), m_state( STALE ), m_defaultSize( defaultSize ), m_queried( false )
+{}
+
+TerminalGeometry& TerminalGeometry::for_console_type( ConsoleType type )
+{
+    // Never destroyed, so that the signal handler can always reach them
+    static TerminalGeometry *const standardGeometries[2] =
+    {
+        new TerminalGeometry( standardQuery( ConsoleType::STD_OUTPUT ) ),
+        new TerminalGeometry( standardQuery( ConsoleType::STD_ERROR ) )
+    };
+    static TerminalGeometry *const customGeometry = new TerminalGeometry( Query() );
+
+    static const bool handlerInstalled = []
+    {
+#if !defined(_WIN32)
+        s_resizeTargets[0].store( standardGeometries[0], std::memory_order_relaxed );
+        s_resizeTargets[1].store( standardGeometries[1], std::memory_order_relaxed );
+#endif
+        installResizeHandler();
+        return true;
+    }();
+    (void) handlerInstalled;
+
+    switch( type )
+    {
+        case ConsoleType::STD_OUTPUT:
+            return *standardGeometries[0];
+
+        case ConsoleType::STD_ERROR:
+            return *standardGeometries[1];
+
+        default:
+            return *customGeometry;
+    }
+}
+
+void TerminalGeometry::set_default_size( TerminalSize size )
+{
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_defaultSize = size;
+    }
+
+    notify_resize();
+}
+
+void TerminalGeometry::on_resize( ResizeCallback callback )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_callback = std::move( callback );
+}
+
+TerminalSize TerminalGeometry::refresh()
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+
+    // The stale flag is cleared before querying, so that a resize notified meanwhile is not lost
+    const std::uint64_t previousState = m_state.fetch_and( ~STALE, std::memory_order_acq_rel );
+
+    TerminalSize size;
+    const bool terminal = m_query && m_query( size ) && ( size.columns > 0 );
+    if( !terminal )
+    {
+        size = m_defaultSize;
+    }
+
+    const std::uint64_t state = pack( size ) | ( terminal ? TERMINAL : 0 );
+    std::uint64_t current = m_state.load( std::memory_order_relaxed );
+    while( !m_state.compare_exchange_weak( current, state | ( current & STALE ), std::memory_order_acq_rel ) )
+    {
+    }
+
+    const bool changed = m_queried && ( unpack( previousState ) != size );
+    m_queried = true;
+
+    if( changed && m_callback )
+    {
+        const ResizeCallback callback = m_callback;
+        lock.unlock();
+        callback( size );
+    }
+
+    return size;
+}
+
+} // namespace
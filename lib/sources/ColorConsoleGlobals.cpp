@@ -0,0 +1,24 @@
+/**
+ * @file
+ * @brief      Definition of the ColorConsole global consoles references
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsole.hpp"
+
+namespace ColorConsole
+{
+
+// Defined apart from the consoles, so that programs linked statically that only use the accessors (or no console
+// at all) do not construct the consoles at startup.
+
+Console &Console::cout = Console::get_cout();
+Console &Console::cerr = Console::get_cerr();
+
+Console &cout = Console::get_cout();
+Console &cerr = Console::get_cerr();
+
+} // namespace
@@ -11,6 +11,13 @@
 #define COLORCONSOLEHELPERS_HPP_
 
 #include "ColorConsoleCommon.hpp"
+#include "ColorConsoleAnsi.hpp"
+#include "ColorConsoleProbes.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
 
 namespace ColorConsole
 {
@@ -25,135 +32,128 @@ inline bool cast_bool( Color color )
     return static_cast<bool>( color );
 }
 
+inline void writeAnsiEscape( std::ostream *out, const AnsiEscape &escape )
+{
+    out->write( escape.data(), static_cast<std::streamsize>( escape.size() ) );
+}
+
+inline void writeAnsiEscape( std::wostream *out, const AnsiEscape &escape )
+{
+    wchar_t wideEscape[ANSI_ESCAPE_MAX_LENGTH];
+
+    for( std::size_t i = 0; i < escape.size(); i++ )
+    {
+        wideEscape[i] = static_cast<wchar_t>( escape.text[i] );
+    }
+
+    out->write( wideEscape, static_cast<std::streamsize>( escape.size() ) );
+}
+
 template<class Stream>
 void setAnsiColor( Stream *out, Color color )
 {
-    if( color >= Color::RESET )
+    writeAnsiEscape( out, ansiEscape( color ) );
+}
+
+/**
+ * Unbuffered stream buffer used by the global consoles, which initializes its console on first use and then
+ * forwards the output to the stream buffer of a standard stream.
+ *
+ * This avoids initializing the consoles (setting locales, querying the Windows console...) during static
+ * initialization, and accessing the standard streams before they are constructed.
+ */
+template<class CharT>
+class LazyStreamBuf : public std::basic_streambuf<CharT>
+{
+public:
+    using traits_type = typename std::basic_streambuf<CharT>::traits_type;
+    using int_type = typename traits_type::int_type;
+
+    LazyStreamBuf( std::basic_ostream<CharT> &target, ConsoleType consoleType, void (*initializer)( void *console ), void *console ) noexcept
+    : m_target( target ), m_consoleType( consoleType ), m_initializer( initializer ), m_console( console ), m_buffer( nullptr )
+    {}
+
+    /**
+     * Initializes the console (once, thread-safely) and binds the standard stream buffer.
+     *
+     * @return The standard stream buffer
+     */
+    std::basic_streambuf<CharT>* ensure_initialized()
     {
-        *out << "\033[0m";
+        std::basic_streambuf<CharT> *buffer = m_buffer.load( std::memory_order_acquire );
+
+        if( buffer == nullptr )
+        {
+            std::call_once( m_once, [this]()
+            {
+                m_initializer( m_console );
+                m_buffer.store( m_target.rdbuf(), std::memory_order_release );
+            } );
+
+            buffer = m_buffer.load( std::memory_order_acquire );
+        }
+
+        return buffer;
     }
-    else
+
+    /**
+     * Indicates if the console has been initialized.
+     *
+     * @return @c true if the console has been initialized, @c false otherwise
+     */
+    bool is_initialized() const noexcept
     {
-        *out << "\033[";
+        return ( m_buffer.load( std::memory_order_acquire ) != nullptr );
+    }
 
-        Color bg_color = ( color & (Color::BG_LIGHT_RED|Color::BG_LIGHT_GREEN|Color::BG_LIGHT_BLUE) );
+protected:
+    int_type overflow( int_type c ) override
+    {
+        std::basic_streambuf<CharT> *buffer = ensure_initialized();
 
-        switch( bg_color )
+        if( traits_type::eq_int_type( c, traits_type::eof() ) )
         {
-            default:
-            case Color::BG_NONE:
-                if( cast_bool( color & Color::BG_BLACK ) )
-                {
-                    *out << "40";
-                }
-                else
-                {
-                    *out << "49";
-                }
-                break;
-            case Color::BG_DARK_RED:
-                *out << "41";
-                break;
-            case Color::BG_DARK_GREEN:
-                *out << "42";
-                break;
-            case Color::BG_BROWN:
-                *out << "43";
-                break;
-            case Color::BG_DARK_BLUE:
-                *out << "44";
-                break;
-            case Color::BG_DARK_MAGENTA:
-                *out << "45";
-                break;
-            case Color::BG_DARK_CYAN:
-                *out << "46";
-                break;
-            case Color::BG_LIGHT_GREY:
-                *out << "47";
-                break;
-            case Color::BG_DARK_GREY:
-                *out << "100";
-                break;
-            case Color::BG_LIGHT_RED:
-                *out << "101";
-                break;
-            case Color::BG_LIGHT_GREEN:
-                *out << "102";
-                break;
-            case Color::BG_YELLOW:
-                *out << "103";
-                break;
-            case Color::BG_LIGHT_BLUE:
-                *out << "104";
-                break;
-            case Color::BG_LIGHT_MAGENTA:
-                *out << "105";
-                break;
-            case Color::BG_LIGHT_CYAN:
-                *out << "106";
-                break;
-            case Color::BG_WHITE:
-                *out << "107";
-                break;
+            return traits_type::not_eof( c );
         }
-        *out << ";";
 
-        switch( color & (Color::FG_LIGHT_RED|Color::FG_LIGHT_GREEN|Color::FG_LIGHT_BLUE) )
-        {
-            case Color::FG_BLACK:
-                *out << "30";
-                break;
-            case Color::FG_DARK_RED:
-                *out << "31";
-                break;
-            case Color::FG_DARK_GREEN:
-                *out << "32";
-                break;
-            case Color::FG_BROWN:
-                *out << "33";
-                break;
-            case Color::FG_DARK_BLUE:
-                *out << "34";
-                break;
-            case Color::FG_DARK_MAGENTA:
-                *out << "35";
-                break;
-            case Color::FG_DARK_CYAN:
-                *out << "36";
-                break;
-            case Color::FG_LIGHT_GREY:
-                *out << "37";
-                break;
-            case Color::FG_DARK_GREY:
-                *out << "1;30";
-                break;
-            case Color::FG_LIGHT_RED:
-                *out << "1;31";
-                break;
-            case Color::FG_LIGHT_GREEN:
-                *out << "1;32";
-                break;
-            case Color::FG_YELLOW:
-                *out << "1;33";
-                break;
-            case Color::FG_LIGHT_BLUE:
-                *out << "1;34";
-                break;
-            case Color::FG_LIGHT_MAGENTA:
-                *out << "1;35";
-                break;
-            case Color::FG_LIGHT_CYAN:
-                *out << "1;36";
-                break;
-            default:
-            case Color::FG_WHITE:
-                *out << "1;37";
-                break;
-        }
-        *out << "m";
+        ProbeTimer timer( COLORCONSOLE_PROBE_ENABLED( write ) );
+        int_type result = buffer->sputc( traits_type::to_char_type( c ) );
+        COLORCONSOLE_PROBE3( write, static_cast<int>( m_consoleType ),
+                             traits_type::eq_int_type( result, traits_type::eof() ) ? 0 : 1, timer.elapsed() );
+
+        return result;
     }
-}
+
+    std::streamsize xsputn( const CharT *s, std::streamsize n ) override
+    {
+        std::basic_streambuf<CharT> *buffer = ensure_initialized();
+
+        ProbeTimer timer( COLORCONSOLE_PROBE_ENABLED( write ) );
+        std::streamsize result = buffer->sputn( s, n );
+        COLORCONSOLE_PROBE3( write, static_cast<int>( m_consoleType ), result, timer.elapsed() );
+
+        return result;
+    }
+
+    int sync() override
+    {
+        std::basic_streambuf<CharT> *buffer = ensure_initialized();
+
+        ProbeTimer timer( COLORCONSOLE_PROBE_ENABLED( flush ) );
+        int result = buffer->pubsync();
+        COLORCONSOLE_PROBE3( flush, static_cast<int>( m_consoleType ), result, timer.elapsed() );
+
+        return result;
+    }
+
+private:
+    std::basic_ostream<CharT> &m_target;
+    ConsoleType m_consoleType;
+    void (*m_initializer)( void *console );
+    void *m_console;
+    std::atomic<std::basic_streambuf<CharT>*> m_buffer;
+    std::once_flag m_once;
+};
 
 } // namespace
 
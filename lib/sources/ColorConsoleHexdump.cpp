@@ -0,0 +1,364 @@
+/**
+ * @file
+ * @brief      Implementation of the colored hexadecimal dumps
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsoleHexdump.hpp"
+#include "ColorConsoleAnsi.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && ( _M_IX86_FP >= 2 ) )
+#define COLORCONSOLE_HEXDUMP_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace ColorConsole
+{
+
+/**
+ * Classes of the bytes, in the order of their colors.
+ */
+enum ByteClass : std::uint8_t
+{
+    ZERO_BYTE,
+    PRINTABLE_BYTE,
+    CONTROL_BYTE,
+    HIGH_BYTE,
+    BYTE_CLASS_COUNT
+};
+
+/**
+ * Size of the blocks of lines written into the console.
+ */
+static constexpr std::size_t BLOCK_SIZE = 32 * 1024;
+
+static constexpr std::array<char, 512> makeHexPairs() noexcept
+{
+    constexpr char DIGITS[] = "0123456789abcdef";
+
+    std::array<char, 512> pairs = {};
+    for( std::size_t i = 0; i < 256; i++ )
+    {
+        pairs[i * 2] = DIGITS[i >> 4];
+        pairs[( i * 2 ) + 1] = DIGITS[i & 0x0F];
+    }
+    return pairs;
+}
+
+static constexpr std::array<std::uint8_t, 256> makeByteClasses() noexcept
+{
+    std::array<std::uint8_t, 256> classes = {};
+    for( std::size_t i = 0; i < 256; i++ )
+    {
+        classes[i] = ( i == 0 ) ? ZERO_BYTE :
+                     ( i >= 0x80 ) ? HIGH_BYTE :
+                     ( ( i >= 0x20 ) && ( i < 0x7F ) ) ? PRINTABLE_BYTE : CONTROL_BYTE;
+    }
+    return classes;
+}
+
+/**
+ * Hexadecimal digits of each byte.
+ */
+static constexpr std::array<char, 512> HEX_PAIRS = makeHexPairs();
+
+/**
+ * Class of each byte.
+ */
+static constexpr std::array<std::uint8_t, 256> BYTE_CLASSES = makeByteClasses();
+
+/**
+ * Returns the background bits of a color.
+ */
+static constexpr unsigned int backgroundBits( Color color ) noexcept
+{
+    return ( color >= Color::RESET ) ? 0 : ( static_cast<unsigned int>( color ) & ( 0xF0u | static_cast<unsigned int>( Color::BG_BLACK ) ) );
+}
+
+/**
+ * Computes the classes of some bytes and their characters in the ASCII column (dots for the non-printable ones).
+ */
+static void classifyBytes( const unsigned char *bytes, std::size_t count, std::uint8_t *classes, char *ascii ) noexcept
+{
+    std::size_t i = 0;
+
+#ifdef COLORCONSOLE_HEXDUMP_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i dots = _mm_set1_epi8( '.' );
+
+    for( ; ( count - i ) >= 16; i += 16 )
+    {
+        // Signed comparisons: high-bit bytes are negative
+        const __m128i block = _mm_loadu_si128( reinterpret_cast<const __m128i*>( bytes + i ) );
+        const __m128i isZero = _mm_cmpeq_epi8( block, zero );
+        const __m128i isHigh = _mm_cmplt_epi8( block, zero );
+        const __m128i isPrintable = _mm_and_si128( _mm_cmpgt_epi8( block, _mm_set1_epi8( 0x1F ) ),
+                                                   _mm_cmplt_epi8( block, _mm_set1_epi8( 0x7F ) ) );
+        const __m128i isControl = _mm_andnot_si128( _mm_or_si128( _mm_or_si128( isZero, isHigh ), isPrintable ),
+                                                    _mm_cmpeq_epi8( zero, zero ) );
+
+        const __m128i byteClasses = _mm_or_si128( _mm_and_si128( isPrintable, _mm_set1_epi8( PRINTABLE_BYTE ) ),
+                                                  _mm_or_si128( _mm_and_si128( isControl, _mm_set1_epi8( CONTROL_BYTE ) ),
+                                                                _mm_and_si128( isHigh, _mm_set1_epi8( HIGH_BYTE ) ) ) );
+        const __m128i characters = _mm_or_si128( _mm_and_si128( isPrintable, block ), _mm_andnot_si128( isPrintable, dots ) );
+
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( classes + i ), byteClasses );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( ascii + i ), characters );
+    }
+#endif
+
+    for( ; i < count; i++ )
+    {
+        classes[i] = BYTE_CLASSES[bytes[i]];
+        ascii[i] = ( classes[i] == PRINTABLE_BYTE ) ? static_cast<char>( bytes[i] ) : '.';
+    }
+}
+
+/**
+ * Formatter of the lines of a hexadecimal dump into blocks written into a console.
+ */
+class HexdumpWriter
+{
+public:
+    HexdumpWriter( Console &console, const HexdumpOptions &options, std::uint64_t lastOffset )
+    : m_console( console ), m_options( options ),
+      m_bytesPerLine( ( options.bytesPerLine > 0 ) ? options.bytesPerLine : 16 ),
+      m_groupSize( ( options.groupSize > 0 ) ? options.groupSize : m_bytesPerLine ),
+      m_offsetDigits( 8 ), m_ansi( console.uses_ansi_coloring() ),
+      m_consoleColor( normalize( console.get_color() ) ), m_lineColor( m_consoleColor ), m_used( 0 )
+    {
+        while( ( m_offsetDigits < 16 ) && ( ( lastOffset >> ( m_offsetDigits * 4 ) ) != 0 ) )
+        {
+            m_offsetDigits++;
+        }
+
+        const Color colors[BYTE_CLASS_COUNT] = { options.zeroColor, options.printableColor, options.controlColor, options.highColor };
+        for( std::size_t i = 0; i < BYTE_CLASS_COUNT; i++ )
+        {
+            m_classColors[i] = normalize( colors[i] );
+        }
+
+        m_classes.resize( m_bytesPerLine );
+        m_ascii.resize( m_bytesPerLine );
+
+        // Worst case: a color switch before each byte in both columns, and a reset before each space (when the
+        // color has a background), i.e. per byte two spaces, a reset, an escape and two digits in the hexadecimal
+        // column, and an escape and a character in the ASCII column
+        const std::size_t maxLineSize = 16 + ( 6 * ANSI_ESCAPE_MAX_LENGTH ) + m_offsetDigits +
+                                        ( m_bytesPerLine * ( 5 + ( 3 * ANSI_ESCAPE_MAX_LENGTH ) ) );
+        m_buffer.resize( BLOCK_SIZE + maxLineSize + sizeof( AnsiEscape::text ) );
+    }
+
+    void write_line( const unsigned char *bytes, std::size_t count, std::uint64_t offset )
+    {
+        classifyBytes( bytes, count, m_classes.data(), m_ascii.data() );
+
+        char *p = m_buffer.data() + m_used;
+
+        p = set_color( p, m_options.offsetColor );
+        p = append_offset( p, offset );
+        p = append_spaces( p, 2 );
+
+        // The hexadecimal column of the last line is padded only to align its ASCII column
+        const std::size_t columns = m_options.ascii ? m_bytesPerLine : count;
+
+        std::size_t groupLeft = m_groupSize;
+
+        for( std::size_t i = 0; i < columns; i++ )
+        {
+            if( i > 0 )
+            {
+                p = append_spaces( p, 1 );
+                if( --groupLeft == 0 )
+                {
+                    *p++ = ' ';
+                    groupLeft = m_groupSize;
+                }
+            }
+
+            if( i < count )
+            {
+                p = set_class_color( p, m_classes[i] );
+                std::memcpy( p, &HEX_PAIRS[bytes[i] * 2u], 2 );
+                p += 2;
+            }
+            else
+            {
+                *p++ = ' ';
+                *p++ = ' ';
+            }
+        }
+
+        if( m_options.ascii )
+        {
+            p = append_spaces( p, 2 );
+            p = set_color( p, Color::RESET );
+            *p++ = '|';
+
+            if( m_ansi )
+            {
+                for( std::size_t i = 0; i < count; i++ )
+                {
+                    p = set_class_color( p, m_classes[i] );
+                    *p++ = m_ascii[i];
+                }
+            }
+            else
+            {
+                std::memcpy( p, m_ascii.data(), count );
+                p += count;
+            }
+
+            p = set_color( p, Color::RESET );
+            *p++ = '|';
+        }
+
+        end_line( p );
+    }
+
+    void write_end( std::uint64_t offset )
+    {
+        char *p = m_buffer.data() + m_used;
+
+        p = set_color( p, m_options.offsetColor );
+        p = append_offset( p, offset );
+
+        end_line( p );
+    }
+
+    void flush()
+    {
+        // Restore the console color (the buffer has room for an escape sequence after the last line)
+        m_used = static_cast<std::size_t>( set_color( m_buffer.data() + m_used, m_consoleColor ) - m_buffer.data() );
+
+        if( m_used > 0 )
+        {
+            m_console.write_raw( std::string_view( m_buffer.data(), m_used ) );
+            m_used = 0;
+        }
+        m_console.flush();
+    }
+
+private:
+    static constexpr Color normalize( Color color ) noexcept
+    {
+        return ( color >= Color::RESET ) ? Color::RESET : color;
+    }
+
+    char* set_color( char *p, Color color )
+    {
+        color = normalize( color );
+
+        if( m_ansi && ( color != m_lineColor ) )
+        {
+            const AnsiEscape escape = ansiEscape( color );
+            std::memcpy( p, escape.data(), escape.size() );
+            p += escape.size();
+            m_lineColor = color;
+        }
+
+        return p;
+    }
+
+    char* set_class_color( char *p, std::uint8_t byteClass )
+    {
+        // The escape sequences of the classes are cached, as there is one lookup per byte
+        if( m_ansi && ( m_classColors[byteClass] != m_lineColor ) )
+        {
+            if( m_classEscapes[byteClass].size() == 0 )
+            {
+                m_classEscapes[byteClass] = ansiEscape( m_classColors[byteClass] );
+            }
+
+            // Copied whole (the buffer has room for it), which is faster than copying a variable length
+            std::memcpy( p, m_classEscapes[byteClass].text, sizeof( m_classEscapes[byteClass].text ) );
+            p += m_classEscapes[byteClass].size();
+            m_lineColor = m_classColors[byteClass];
+        }
+
+        return p;
+    }
+
+    char* append_spaces( char *p, std::size_t count )
+    {
+        // Spaces only switch the color to show no background
+        if( backgroundBits( m_lineColor ) != 0 )
+        {
+            p = set_color( p, Color::RESET );
+        }
+
+        std::memset( p, ' ', count );
+        return p + count;
+    }
+
+    char* append_offset( char *p, std::uint64_t offset ) const noexcept
+    {
+        for( std::size_t i = m_offsetDigits; i > 0; i-- )
+        {
+            p[i - 1] = HEX_PAIRS[( ( offset & 0x0F ) * 2u ) + 1];
+            offset >>= 4;
+        }
+        return p + m_offsetDigits;
+    }
+
+    void end_line( char *p )
+    {
+        p = set_color( p, Color::RESET );
+        *p++ = '\n';
+
+        m_used = static_cast<std::size_t>( p - m_buffer.data() );
+        if( m_used >= BLOCK_SIZE )
+        {
+            m_console.write_raw( std::string_view( m_buffer.data(), m_used ) );
+            m_used = 0;
+        }
+    }
+
+    Console &m_console;
+    const HexdumpOptions &m_options;
+    const std::size_t m_bytesPerLine;
+    const std::size_t m_groupSize;
+    std::size_t m_offsetDigits;
+    const bool m_ansi;
+    const Color m_consoleColor;
+
+    Color m_classColors[BYTE_CLASS_COUNT];
+    AnsiEscape m_classEscapes[BYTE_CLASS_COUNT];
+    Color m_lineColor;
+
+    std::vector<std::uint8_t> m_classes;
+    std::vector<char> m_ascii;
+    std::vector<char> m_buffer;
+    std::size_t m_used;
+};
+
+void hexdump( Console &console, std::span<const std::byte> data, const HexdumpOptions &options )
+{
+    const std::uint64_t endOffset = options.offset + data.size();
+    HexdumpWriter writer( console, options, endOffset );
+
+    if( !data.empty() )
+    {
+        const unsigned char *bytes = reinterpret_cast<const unsigned char*>( data.data() );
+        const std::size_t bytesPerLine = ( options.bytesPerLine > 0 ) ? options.bytesPerLine : 16;
+
+        for( std::size_t i = 0; i < data.size(); i += bytesPerLine )
+        {
+            writer.write_line( bytes + i, std::min( bytesPerLine, data.size() - i ), options.offset + i );
+        }
+
+        writer.write_end( endOffset );
+    }
+
+    writer.flush();
+}
+
+} // namespace
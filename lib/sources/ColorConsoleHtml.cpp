@@ -0,0 +1,441 @@
+/**
+ * @file
+ * @brief      Implementation of the ColorConsole HTML converter
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsoleHtml.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <sstream>
+
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && ( _M_IX86_FP >= 2 ) )
+#define COLORCONSOLE_HTML_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace ColorConsole
+{
+
+//////////////////////////////////////////////////////////////////////////
+// Escaping
+//
+
+/**
+ * Names of the basic colors used in CSS classes, in ANSI order.
+ */
+static constexpr std::string_view COLOR_CLASS_NAMES[16] =
+{
+    "black", "dark-red", "dark-green", "brown", "dark-blue", "dark-magenta", "dark-cyan", "light-grey",
+    "dark-grey", "light-red", "light-green", "yellow", "light-blue", "light-magenta", "light-cyan", "white"
+};
+
+static inline bool isHtmlSpecial( unsigned char c ) noexcept
+{
+    return ( c == '&' ) || ( c == '<' ) || ( c == '>' ) || ( c == '"' ) || ( ( c < 0x20 ) && ( c != '\t' ) && ( c != '\n' ) );
+}
+
+static std::size_t findHtmlSpecialScalar( const unsigned char *data, std::size_t size, std::size_t pos ) noexcept
+{
+    while( ( pos < size ) && !isHtmlSpecial( data[pos] ) )
+    {
+        pos++;
+    }
+
+    return pos;
+}
+
+/**
+ * Returns the position of the first character that must be escaped or dropped, or @p size if none.
+ */
+static std::size_t findHtmlSpecial( const unsigned char *data, std::size_t size, std::size_t pos ) noexcept
+{
+#ifdef COLORCONSOLE_HTML_SSE2
+    const __m128i ampersand = _mm_set1_epi8( '&' );
+    const __m128i less = _mm_set1_epi8( '<' );
+    const __m128i greater = _mm_set1_epi8( '>' );
+    const __m128i quote = _mm_set1_epi8( '"' );
+    const __m128i maxControl = _mm_set1_epi8( 0x1F );
+    const __m128i tab = _mm_set1_epi8( '\t' );
+    const __m128i newline = _mm_set1_epi8( '\n' );
+
+    while( pos + 16 <= size )
+    {
+        const __m128i v = _mm_loadu_si128( reinterpret_cast<const __m128i*>( data + pos ) );
+
+        // Unsigned comparison (v <= 0x1F), so that UTF-8 bytes are not taken as control characters
+        const __m128i control = _mm_andnot_si128( _mm_or_si128( _mm_cmpeq_epi8( v, tab ), _mm_cmpeq_epi8( v, newline ) ),
+                                                  _mm_cmpeq_epi8( _mm_min_epu8( v, maxControl ), v ) );
+        const __m128i special = _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( v, ampersand ), _mm_cmpeq_epi8( v, less ) ),
+                                              _mm_or_si128( _mm_cmpeq_epi8( v, greater ), _mm_cmpeq_epi8( v, quote ) ) );
+        const unsigned int mask = static_cast<unsigned int>( _mm_movemask_epi8( _mm_or_si128( control, special ) ) );
+
+        if( mask != 0 )
+        {
+            return pos + static_cast<std::size_t>( std::countr_zero( mask ) );
+        }
+
+        pos += 16;
+    }
+#endif
+
+    return findHtmlSpecialScalar( data, size, pos );
+}
+
+/**
+ * Bounded string builder used to render tags.
+ */
+struct TagBuilder
+{
+    char *data;
+    std::size_t length;
+
+    void append( std::string_view str ) noexcept
+    {
+        const std::size_t n = std::min( str.size(), HTML_MAX_TAG_LENGTH - length );
+        if( n == 0 )
+        {
+            // An empty string_view may have a null pointer, which memcpy does not accept
+            return;
+        }
+
+        std::memcpy( data + length, str.data(), n );
+        length += n;
+    }
+
+    void append_hex( std::uint8_t value ) noexcept
+    {
+        const char digits[] = "0123456789abcdef";
+        const char hex[2] = { digits[value >> 4], digits[value & 0x0F] };
+        append( std::string_view( hex, 2 ) );
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Converter
+//
+
+HtmlConverter::HtmlConverter( std::streambuf *target, std::string_view classPrefix ) noexcept
+: m_target( target ), m_good( true ), m_prefixLength( 0 ), m_openTagLength( 0 )
+{
+    const std::string_view prefix = class_prefix( classPrefix );
+
+    m_prefixLength = prefix.size();
+    std::memcpy( m_prefix, prefix.data(), m_prefixLength );
+}
+
+std::string_view HtmlConverter::class_prefix( std::string_view classPrefix ) noexcept
+{
+    std::size_t length = 0;
+
+    while( ( length < classPrefix.size() ) && ( length < HTML_MAX_CLASS_PREFIX_LENGTH ) )
+    {
+        const char c = classPrefix[length];
+
+        if( ( ( c >= '0' ) && ( c <= '9' ) ) ? ( length == 0 ) :
+            !( ( ( c >= 'a' ) && ( c <= 'z' ) ) || ( ( c >= 'A' ) && ( c <= 'Z' ) ) || ( c == '-' ) || ( c == '_' ) ) )
+        {
+            break;
+        }
+
+        length++;
+    }
+
+    return classPrefix.substr( 0, length );
+}
+
+bool HtmlConverter::write( std::string_view chunk )
+{
+    m_parser.process( chunk, [this]( const SgrStyle &style, std::string_view text ) { write_run( style, text ); } );
+
+    return m_good;
+}
+
+bool HtmlConverter::finish()
+{
+    if( m_openTagLength > 0 )
+    {
+        put( "</span>" );
+        m_openTagLength = 0;
+    }
+
+    m_parser.reset();
+
+    return m_good;
+}
+
+void HtmlConverter::put( std::string_view text )
+{
+    const std::streamsize size = static_cast<std::streamsize>( text.size() );
+    m_good = m_good && ( m_target->sputn( text.data(), size ) == size );
+}
+
+void HtmlConverter::write_run( const SgrStyle &style, std::string_view text )
+{
+    char tag[HTML_MAX_TAG_LENGTH];
+    const std::size_t tagLength = render_tag( style, tag );
+
+    // Runs that render the same span are merged
+    if( ( tagLength != m_openTagLength ) || ( std::memcmp( tag, m_openTag, tagLength ) != 0 ) )
+    {
+        if( m_openTagLength > 0 )
+        {
+            put( "</span>" );
+        }
+
+        put( std::string_view( tag, tagLength ) );
+
+        std::memcpy( m_openTag, tag, tagLength );
+        m_openTagLength = tagLength;
+    }
+
+    write_escaped( text );
+}
+
+void HtmlConverter::write_escaped( std::string_view text )
+{
+    const unsigned char *data = reinterpret_cast<const unsigned char*>( text.data() );
+    const std::size_t size = text.size();
+    std::size_t start = 0;
+
+    while( start < size )
+    {
+        const std::size_t pos = findHtmlSpecial( data, size, start );
+
+        if( pos > start )
+        {
+            put( text.substr( start, pos - start ) );
+        }
+
+        if( pos >= size )
+        {
+            break;
+        }
+
+        switch( data[pos] )
+        {
+            case '&': put( "&amp;" ); break;
+            case '<': put( "&lt;" ); break;
+            case '>': put( "&gt;" ); break;
+            case '"': put( "&quot;" ); break;
+            default: break; // Control characters are dropped
+        }
+
+        start = pos + 1;
+    }
+}
+
+std::size_t HtmlConverter::render_tag( const SgrStyle &style, char *tag ) const noexcept
+{
+    // Color slot: basic color (class), direct color (inline style) or default
+    struct Slot
+    {
+        SgrColor::Kind kind;
+        unsigned int basic;
+        std::uint8_t rgb[3];
+    };
+
+    auto toSlot = []( const SgrColor &color ) noexcept
+    {
+        Slot slot { color.kind, 0, { color.red, color.green, color.blue } };
+
+        if( color.kind == SgrColor::Kind::INDEXED )
+        {
+            if( color.index < 16 )
+            {
+                slot.basic = color.index;
+            }
+            else
+            {
+                slot.kind = SgrColor::Kind::RGB;
+                sgrPaletteRgb( color.index, slot.rgb[0], slot.rgb[1], slot.rgb[2] );
+            }
+        }
+
+        return slot;
+    };
+
+    Slot fg = toSlot( style.foreground );
+    Slot bg = toSlot( style.background );
+    std::uint8_t attributes = style.attributes;
+
+    // Bold basic colors are the light colors of the library
+    if( ( fg.kind == SgrColor::Kind::INDEXED ) && ( fg.basic < 8 ) && ( attributes & SGR_BOLD ) )
+    {
+        fg.basic += 8;
+        attributes &= static_cast<std::uint8_t>( ~SGR_BOLD );
+    }
+
+    const bool inverse = ( attributes & SGR_INVERSE ) != 0;
+    if( inverse )
+    {
+        std::swap( fg, bg );
+    }
+
+    const std::string_view prefix( m_prefix, m_prefixLength );
+    TagBuilder classes { tag, 0 };
+    bool hasClasses = false;
+
+    auto addClass = [&]( std::string_view name1, std::string_view name2 = {} ) noexcept
+    {
+        classes.append( hasClasses ? " " : "<span class=\"" );
+        classes.append( prefix );
+        classes.append( name1 );
+        classes.append( name2 );
+        hasClasses = true;
+    };
+
+    if( fg.kind == SgrColor::Kind::INDEXED )
+    {
+        addClass( "fg-", COLOR_CLASS_NAMES[fg.basic] );
+    }
+    else if( ( fg.kind == SgrColor::Kind::DEFAULT ) && inverse )
+    {
+        addClass( "fg-inverse" );
+    }
+
+    if( bg.kind == SgrColor::Kind::INDEXED )
+    {
+        addClass( "bg-", COLOR_CLASS_NAMES[bg.basic] );
+    }
+    else if( ( bg.kind == SgrColor::Kind::DEFAULT ) && inverse )
+    {
+        addClass( "bg-inverse" );
+    }
+
+    if( attributes & SGR_BOLD )
+    {
+        addClass( "bold" );
+    }
+    if( attributes & SGR_DIM )
+    {
+        addClass( "dim" );
+    }
+    if( attributes & SGR_ITALIC )
+    {
+        addClass( "italic" );
+    }
+    if( attributes & SGR_UNDERLINE )
+    {
+        addClass( "underline" );
+    }
+    if( attributes & SGR_STRIKE )
+    {
+        addClass( "strike" );
+    }
+    if( attributes & SGR_HIDDEN )
+    {
+        addClass( "hidden" );
+    }
+
+    const bool hasStyle = ( fg.kind == SgrColor::Kind::RGB ) || ( bg.kind == SgrColor::Kind::RGB );
+
+    if( !hasClasses && !hasStyle )
+    {
+        return 0;
+    }
+
+    classes.append( hasClasses ? "\"" : "<span" );
+
+    if( hasStyle )
+    {
+        classes.append( " style=\"" );
+
+        if( fg.kind == SgrColor::Kind::RGB )
+        {
+            classes.append( "color:#" );
+            for( std::uint8_t component : fg.rgb )
+            {
+                classes.append_hex( component );
+            }
+            classes.append( ";" );
+        }
+
+        if( bg.kind == SgrColor::Kind::RGB )
+        {
+            classes.append( "background-color:#" );
+            for( std::uint8_t component : bg.rgb )
+            {
+                classes.append_hex( component );
+            }
+            classes.append( ";" );
+        }
+
+        classes.append( "\"" );
+    }
+
+    classes.append( ">" );
+
+    return classes.length;
+}
+
+std::string HtmlConverter::stylesheet( std::string_view classPrefix )
+{
+    std::ostringstream css;
+
+    classPrefix = class_prefix( classPrefix );
+
+    auto rgb = [&css]( unsigned int index )
+    {
+        std::uint8_t red, green, blue;
+        sgrPaletteRgb( static_cast<std::uint8_t>( index ), red, green, blue );
+
+        const char digits[] = "0123456789abcdef";
+        css << '#';
+        for( std::uint8_t component : { red, green, blue } )
+        {
+            css << digits[component >> 4] << digits[component & 0x0F];
+        }
+    };
+
+    // Default colors are light grey on black, as the default foreground of the library
+    css << "pre." << classPrefix << "console { --" << classPrefix << "fg: ";
+    rgb( 7 );
+    css << "; --" << classPrefix << "bg: ";
+    rgb( 0 );
+    css << "; color: var(--" << classPrefix << "fg); background-color: var(--" << classPrefix << "bg); }\n";
+
+    for( unsigned int i = 0; i < 16; i++ )
+    {
+        css << '.' << classPrefix << "fg-" << COLOR_CLASS_NAMES[i] << " { color: ";
+        rgb( i );
+        css << "; }\n";
+    }
+
+    for( unsigned int i = 0; i < 16; i++ )
+    {
+        css << '.' << classPrefix << "bg-" << COLOR_CLASS_NAMES[i] << " { background-color: ";
+        rgb( i );
+        css << "; }\n";
+    }
+
+    css << '.' << classPrefix << "fg-inverse { color: var(--" << classPrefix << "bg); }\n"
+        << '.' << classPrefix << "bg-inverse { background-color: var(--" << classPrefix << "fg); }\n"
+        << '.' << classPrefix << "bold { font-weight: bold; }\n"
+        << '.' << classPrefix << "dim { opacity: 0.6; }\n"
+        << '.' << classPrefix << "italic { font-style: italic; }\n"
+        << '.' << classPrefix << "underline { text-decoration: underline; }\n"
+        << '.' << classPrefix << "strike { text-decoration: line-through; }\n"
+        << '.' << classPrefix << "underline." << classPrefix << "strike { text-decoration: underline line-through; }\n"
+        << '.' << classPrefix << "hidden { visibility: hidden; }\n";
+
+    return css.str();
+}
+
+std::string HtmlConverter::convert( std::string_view text, std::string_view classPrefix )
+{
+    std::stringbuf html;
+
+    HtmlConverter converter( &html, classPrefix );
+    converter.write( text );
+    converter.finish();
+
+    return html.str();
+}
+
+} // namespace
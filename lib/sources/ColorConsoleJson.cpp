@@ -0,0 +1,665 @@
+/**
+ * @file
+ * @brief      Implementation of the streaming JSON pretty printer
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsoleJson.hpp"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && ( _M_IX86_FP >= 2 ) )
+#define COLORCONSOLE_JSON_SSE2
+#include <bit>
+#include <emmintrin.h>
+#endif
+
+namespace ColorConsole
+{
+
+/**
+ * Size of the output above which it is written into the console before the end of the chunk.
+ */
+static constexpr std::size_t BLOCK_SIZE = 32 * 1024;
+
+/**
+ * States of the number grammar: the number can end after ZERO, INT, FRAC and EXP.
+ */
+enum NumberState : std::uint8_t
+{
+    NUMBER_MINUS,
+    NUMBER_ZERO,
+    NUMBER_INT,
+    NUMBER_DOT,
+    NUMBER_FRAC,
+    NUMBER_E,
+    NUMBER_E_SIGN,
+    NUMBER_EXP
+};
+
+/**
+ * Result of a byte in a number.
+ */
+enum class NumberStep
+{
+    CONTINUE,  // The byte is part of the number
+    END,       // The byte is not part of the number, which is complete
+    FAIL       // The byte is not part of the number, which is not complete
+};
+
+static constexpr bool isDigit( char c ) noexcept
+{
+    return ( c >= '0' ) && ( c <= '9' );
+}
+
+static constexpr bool isHexDigit( char c ) noexcept
+{
+    return isDigit( c ) || ( ( c >= 'a' ) && ( c <= 'f' ) ) || ( ( c >= 'A' ) && ( c <= 'F' ) );
+}
+
+static constexpr bool isWhitespace( char c ) noexcept
+{
+    return ( c == ' ' ) || ( c == '\n' ) || ( c == '\r' ) || ( c == '\t' );
+}
+
+static constexpr bool isNumberEnd( std::uint8_t state ) noexcept
+{
+    return ( state == NUMBER_ZERO ) || ( state == NUMBER_INT ) || ( state == NUMBER_FRAC ) || ( state == NUMBER_EXP );
+}
+
+/**
+ * Advances the number grammar with a byte.
+ */
+static NumberStep stepNumber( std::uint8_t &state, char c ) noexcept
+{
+    switch( state )
+    {
+        case NUMBER_MINUS:
+            state = ( c == '0' ) ? NUMBER_ZERO : NUMBER_INT;
+            return isDigit( c ) ? NumberStep::CONTINUE : NumberStep::FAIL;
+
+        case NUMBER_ZERO:
+        case NUMBER_INT:
+        case NUMBER_FRAC:
+            if( isDigit( c ) )
+            {
+                // Leading zeros are not allowed
+                return ( state == NUMBER_ZERO ) ? NumberStep::FAIL : NumberStep::CONTINUE;
+            }
+            if( ( c == '.' ) && ( state != NUMBER_FRAC ) )
+            {
+                state = NUMBER_DOT;
+                return NumberStep::CONTINUE;
+            }
+            if( ( c == 'e' ) || ( c == 'E' ) )
+            {
+                state = NUMBER_E;
+                return NumberStep::CONTINUE;
+            }
+            return NumberStep::END;
+
+        case NUMBER_DOT:
+            state = NUMBER_FRAC;
+            return isDigit( c ) ? NumberStep::CONTINUE : NumberStep::FAIL;
+
+        case NUMBER_E:
+            if( ( c == '+' ) || ( c == '-' ) )
+            {
+                state = NUMBER_E_SIGN;
+                return NumberStep::CONTINUE;
+            }
+            state = NUMBER_EXP;
+            return isDigit( c ) ? NumberStep::CONTINUE : NumberStep::FAIL;
+
+        case NUMBER_E_SIGN:
+            state = NUMBER_EXP;
+            return isDigit( c ) ? NumberStep::CONTINUE : NumberStep::FAIL;
+
+        default:
+            return isDigit( c ) ? NumberStep::CONTINUE : NumberStep::END;
+    }
+}
+
+/**
+ * Skips the body of a string up to its first byte that is a quote, a backslash or a control character.
+ *
+ * @return Pointer to the byte found, or to the end of the text
+ */
+static const char* skipStringBody( const char *p, const char *end ) noexcept
+{
+#ifdef COLORCONSOLE_JSON_SSE2
+    const __m128i quotes = _mm_set1_epi8( '"' );
+    const __m128i backslashes = _mm_set1_epi8( '\\' );
+    const __m128i controlBits = _mm_set1_epi8( static_cast<char>( 0xE0 ) );
+    const __m128i zero = _mm_setzero_si128();
+
+    for( ; ( end - p ) >= 16; p += 16 )
+    {
+        const __m128i block = _mm_loadu_si128( reinterpret_cast<const __m128i*>( p ) );
+        const __m128i found = _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( block, quotes ), _mm_cmpeq_epi8( block, backslashes ) ),
+                                            _mm_cmpeq_epi8( _mm_and_si128( block, controlBits ), zero ) );
+
+        const unsigned int mask = static_cast<unsigned int>( _mm_movemask_epi8( found ) );
+        if( mask != 0 )
+        {
+            return p + std::countr_zero( mask );
+        }
+    }
+#endif
+
+    for( ; p < end; p++ )
+    {
+        const unsigned char c = static_cast<unsigned char>( *p );
+        if( ( c == '"' ) || ( c == '\\' ) || ( c < 0x20 ) )
+        {
+            break;
+        }
+    }
+
+    return p;
+}
+
+/**
+ * Returns the background bits of a color.
+ */
+static constexpr unsigned int backgroundBits( Color color ) noexcept
+{
+    return ( color >= Color::RESET ) ? 0 : ( static_cast<unsigned int>( color ) & ( 0xF0u | static_cast<unsigned int>( Color::BG_BLACK ) ) );
+}
+
+/**
+ * Returns a color, or RESET for the values beyond it (which are not colors).
+ */
+static constexpr Color normalize( Color color ) noexcept
+{
+    return ( color >= Color::RESET ) ? Color::RESET : color;
+}
+
+JsonPrinter::JsonPrinter( Console &console, const JsonColors &colors, std::size_t indent )
+: m_console( console ), m_indent( indent ), m_ansi( console.uses_ansi_coloring() ), m_expect( Expect::VALUE ),
+  m_token( Token::NONE ), m_tokenRole( PUNCTUATION_ROLE ), m_tokenState( 0 ), m_literalRest( nullptr ), m_pendingOpen( false ),
+  m_depth( 0 ), m_error( false ), m_offset( 0 ), m_errorOffset( 0 ), m_outputColor( normalize( console.get_color() ) ), m_lineOpen( false )
+{
+    const Color roleColors[ROLE_COUNT] = { colors.key, colors.string, colors.number, colors.literal, colors.punctuation };
+    for( std::size_t i = 0; i < ROLE_COUNT; i++ )
+    {
+        m_colors[i] = normalize( roleColors[i] );
+        m_escapes[i] = ansiEscape( m_colors[i] );
+    }
+}
+
+JsonPrinter::~JsonPrinter()
+{
+    finish();
+}
+
+bool JsonPrinter::process( std::string_view chunk )
+{
+    // The output starts in the console color (which may have been changed since the last chunk)
+    m_outputColor = normalize( m_console.get_color() );
+
+    if( m_error )
+    {
+        append_invalid( chunk );
+        m_offset += chunk.size();
+        write_output();
+        return false;
+    }
+
+    const char *begin = chunk.data();
+    const char *end = begin + chunk.size();
+    const char *p = begin;
+    const char *blank = begin;  // Start of the whitespace skipped before p
+
+    // A token split across chunks continues in its color
+    if( m_token != Token::NONE )
+    {
+        set_role( m_tokenRole );
+    }
+
+    while( p < end )
+    {
+        if( m_token == Token::STRING )
+        {
+            const char *bodyEnd = skipStringBody( p, end );
+            append_output( std::string_view( p, static_cast<std::size_t>( bodyEnd - p ) ) );
+            p = bodyEnd;
+            blank = p;
+
+            if( p == end )
+            {
+                break;
+            }
+        }
+
+        if( !process_byte( *p ) )
+        {
+            // The whitespace skipped before the offending byte is written too
+            fail( m_offset + static_cast<std::uint64_t>( p - begin ), std::string_view( blank, static_cast<std::size_t>( end - blank ) ) );
+            break;
+        }
+        if( !isWhitespace( *p++ ) )
+        {
+            blank = p;
+        }
+
+        if( m_output.size() >= BLOCK_SIZE )
+        {
+            write_output();
+            if( m_token != Token::NONE )
+            {
+                set_role( m_tokenRole );
+            }
+        }
+    }
+
+    m_offset += chunk.size();
+    write_output();
+
+    return !m_error;
+}
+
+bool JsonPrinter::finish()
+{
+    m_outputColor = normalize( m_console.get_color() );
+
+    if( !m_error )
+    {
+        if( ( m_token == Token::NUMBER ) && isNumberEnd( m_tokenState ) )
+        {
+            m_token = Token::NONE;
+            end_value();
+        }
+
+        // The text ends in the middle of a value
+        if( ( m_token != Token::NONE ) || ( m_depth > 0 ) || ( m_expect != Expect::VALUE ) )
+        {
+            m_error = true;
+            m_errorOffset = m_offset;
+        }
+    }
+
+    const bool ok = !m_error;
+
+    // The text written shall end in a line break
+    const bool lineOpen = m_output.empty() ? m_lineOpen : ( m_output.back() != '\n' );
+    if( lineOpen )
+    {
+        reset_color();
+        m_output.push_back( '\n' );
+    }
+    write_output();
+    m_console.flush();
+
+    m_expect = Expect::VALUE;
+    m_token = Token::NONE;
+    m_pendingOpen = false;
+    m_depth = 0;
+    m_error = false;
+    m_offset = 0;
+    m_lineOpen = false;
+
+    return ok;
+}
+
+bool JsonPrinter::process_byte( char c )
+{
+    switch( m_token )
+    {
+        case Token::STRING:
+            // The body of the string has been skipped: only quotes, backslashes and control characters remain
+            if( ( c != '"' ) && ( c != '\\' ) )
+            {
+                return false;
+            }
+            m_output.push_back( c );
+            if( c == '\\' )
+            {
+                m_token = Token::STRING_ESCAPE;
+            }
+            else
+            {
+                m_token = Token::NONE;
+                if( m_expect != Expect::COLON )
+                {
+                    end_value();
+                }
+            }
+            return true;
+
+        case Token::STRING_ESCAPE:
+            if( ( c == '\0' ) || ( std::strchr( "\"\\/bfnrtu", c ) == nullptr ) )
+            {
+                return false;
+            }
+            m_output.push_back( c );
+            m_token = ( c == 'u' ) ? Token::STRING_UNICODE : Token::STRING;
+            m_tokenState = 0;
+            return true;
+
+        case Token::STRING_UNICODE:
+            if( !isHexDigit( c ) )
+            {
+                return false;
+            }
+            m_output.push_back( c );
+            if( ++m_tokenState == 4 )
+            {
+                m_token = Token::STRING;
+            }
+            return true;
+
+        case Token::LITERAL:
+            if( c != *m_literalRest )
+            {
+                return false;
+            }
+            m_output.push_back( c );
+            if( *( ++m_literalRest ) == '\0' )
+            {
+                m_token = Token::NONE;
+                end_value();
+            }
+            return true;
+
+        case Token::NUMBER:
+            switch( stepNumber( m_tokenState, c ) )
+            {
+                case NumberStep::CONTINUE:
+                    m_output.push_back( c );
+                    return true;
+
+                case NumberStep::FAIL:
+                    return false;
+
+                default:
+                    // The byte after the number is processed as punctuation
+                    m_token = Token::NONE;
+                    end_value();
+                    break;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    if( isWhitespace( c ) )
+    {
+        return true;
+    }
+
+    switch( m_expect )
+    {
+        case Expect::VALUE:
+            return begin_value( c );
+
+        case Expect::FIRST_VALUE_OR_END:
+            if( c == ']' )
+            {
+                close_container( c );
+                return true;
+            }
+            m_pendingOpen = false;
+            new_line( m_depth );
+            return begin_value( c );
+
+        case Expect::FIRST_KEY_OR_END:
+            if( c == '}' )
+            {
+                close_container( c );
+                return true;
+            }
+            if( c != '"' )
+            {
+                return false;
+            }
+            m_pendingOpen = false;
+            new_line( m_depth );
+            begin_string( KEY_ROLE );
+            return true;
+
+        case Expect::KEY:
+            if( c != '"' )
+            {
+                return false;
+            }
+            begin_string( KEY_ROLE );
+            return true;
+
+        case Expect::COLON:
+            if( c != ':' )
+            {
+                return false;
+            }
+            set_role( PUNCTUATION_ROLE );
+            m_output.push_back( ':' );
+            append_spaces( 1 );
+            m_expect = Expect::VALUE;
+            return true;
+
+        default:
+        {
+            const bool object = m_objects[m_depth - 1];
+            if( c == ',' )
+            {
+                set_role( PUNCTUATION_ROLE );
+                m_output.push_back( ',' );
+                new_line( m_depth );
+                m_expect = object ? Expect::KEY : Expect::VALUE;
+                return true;
+            }
+            if( c == ( object ? '}' : ']' ) )
+            {
+                close_container( c );
+                return true;
+            }
+            return false;
+        }
+    }
+}
+
+bool JsonPrinter::begin_value( char c )
+{
+    switch( c )
+    {
+        case '"':
+            begin_string( STRING_ROLE );
+            return true;
+
+        case '{':
+        case '[':
+            return open_container( c, ( c == '{' ) );
+
+        case 't':
+        case 'f':
+        case 'n':
+            set_role( LITERAL_ROLE );
+            m_output.push_back( c );
+            m_token = Token::LITERAL;
+            m_tokenRole = LITERAL_ROLE;
+            m_literalRest = ( c == 't' ) ? "rue" : ( c == 'f' ) ? "alse" : "ull";
+            return true;
+
+        default:
+            if( ( c != '-' ) && !isDigit( c ) )
+            {
+                return false;
+            }
+            set_role( NUMBER_ROLE );
+            m_output.push_back( c );
+            m_token = Token::NUMBER;
+            m_tokenRole = NUMBER_ROLE;
+            m_tokenState = ( c == '-' ) ? NUMBER_MINUS : ( c == '0' ) ? NUMBER_ZERO : NUMBER_INT;
+            return true;
+    }
+}
+
+void JsonPrinter::begin_string( Role role )
+{
+    set_role( role );
+    m_output.push_back( '"' );
+    m_token = Token::STRING;
+    m_tokenRole = role;
+
+    // Keys are followed by a colon, values by the end of the value
+    m_expect = ( role == KEY_ROLE ) ? Expect::COLON : Expect::VALUE;
+}
+
+bool JsonPrinter::open_container( char c, bool object )
+{
+    if( m_depth == MAX_DEPTH )
+    {
+        return false;
+    }
+
+    set_role( PUNCTUATION_ROLE );
+    m_output.push_back( c );
+
+    m_objects[m_depth] = object;
+    m_depth++;
+
+    // Empty objects and arrays are written in a single line
+    m_pendingOpen = true;
+    m_expect = object ? Expect::FIRST_KEY_OR_END : Expect::FIRST_VALUE_OR_END;
+    return true;
+}
+
+void JsonPrinter::close_container( char c )
+{
+    m_depth--;
+
+    if( m_pendingOpen )
+    {
+        m_pendingOpen = false;
+    }
+    else
+    {
+        new_line( m_depth );
+    }
+
+    set_role( PUNCTUATION_ROLE );
+    m_output.push_back( c );
+
+    end_value();
+}
+
+void JsonPrinter::end_value()
+{
+    if( m_depth == 0 )
+    {
+        // Top-level values are written in their own lines
+        reset_color();
+        m_output.push_back( '\n' );
+        m_expect = Expect::VALUE;
+    }
+    else
+    {
+        m_expect = Expect::COMMA_OR_END;
+    }
+}
+
+void JsonPrinter::fail( std::uint64_t offset, std::string_view rest )
+{
+    m_error = true;
+    m_errorOffset = offset;
+
+    reset_color();
+    append_invalid( rest );
+}
+
+void JsonPrinter::append_output( std::string_view text )
+{
+    // Long texts are written in blocks, so that the output does not grow beyond the block size
+    while( m_output.size() + text.size() > BLOCK_SIZE )
+    {
+        const std::size_t size = ( m_output.size() < BLOCK_SIZE ) ? ( BLOCK_SIZE - m_output.size() ) : 0;
+        m_output.append( text.substr( 0, size ) );
+        text.remove_prefix( size );
+
+        write_output();
+        if( !m_error && ( m_token != Token::NONE ) )
+        {
+            set_role( m_tokenRole );
+        }
+    }
+
+    m_output.append( text );
+}
+
+void JsonPrinter::append_invalid( std::string_view text )
+{
+    // The text is untrusted, so its control characters and invalid UTF-8 are escaped
+    sanitizeText( text, SanitizeMode::ESCAPE, [this]( std::string_view piece ) { append_output( piece ); } );
+}
+
+void JsonPrinter::set_role( Role role )
+{
+    if( m_ansi && ( m_colors[role] != m_outputColor ) )
+    {
+        m_output.append( m_escapes[role].view() );
+        m_outputColor = m_colors[role];
+    }
+}
+
+void JsonPrinter::reset_color()
+{
+    if( m_ansi && ( m_outputColor != Color::RESET ) )
+    {
+        m_output.append( ANSI_RESET_SEQUENCE );
+        m_outputColor = Color::RESET;
+    }
+}
+
+void JsonPrinter::restore_console_color()
+{
+    const Color consoleColor = normalize( m_console.get_color() );
+
+    if( m_ansi && ( m_outputColor != consoleColor ) )
+    {
+        m_output.append( ansiEscape( consoleColor ).view() );
+        m_outputColor = consoleColor;
+    }
+}
+
+void JsonPrinter::append_spaces( std::size_t count )
+{
+    // Spaces only switch the color to show no background
+    if( backgroundBits( m_outputColor ) != 0 )
+    {
+        reset_color();
+    }
+
+    m_output.append( count, ' ' );
+}
+
+void JsonPrinter::new_line( std::size_t depth )
+{
+    if( backgroundBits( m_outputColor ) != 0 )
+    {
+        reset_color();
+    }
+
+    m_output.push_back( '\n' );
+    m_output.append( depth * m_indent, ' ' );
+}
+
+void JsonPrinter::write_output()
+{
+    if( m_output.empty() )
+    {
+        return;
+    }
+
+    m_lineOpen = ( m_output.back() != '\n' );
+
+    // The output shall leave the console in its own color
+    restore_console_color();
+    m_console.write_raw( m_output );
+    m_output.clear();
+}
+
+} // namespace
@@ -0,0 +1,462 @@
+/**
+ * @file
+ * @brief      Implementation of the ColorConsole live region
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsoleLiveRegion.hpp"
+#include "ColorConsoleAnsi.hpp"
+#include "ColorConsoleWidth.hpp"
+
+#include <algorithm>
+
+namespace ColorConsole
+{
+
+static constexpr std::string_view SYNCHRONIZED_UPDATE_BEGIN = "\033[?2026h";
+static constexpr std::string_view SYNCHRONIZED_UPDATE_END = "\033[?2026l";
+
+/**
+ * Width of the labels of the bars (longer labels are truncated).
+ */
+static constexpr std::size_t LABEL_WIDTH = 24;
+
+static constexpr char SPINNER_FRAMES[] = { '|', '/', '-', '\\' };
+
+static void appendNumber( std::string &text, std::uint64_t value )
+{
+    char digits[20];
+    std::size_t n = 0;
+
+    do
+    {
+        digits[sizeof( digits ) - 1 - n++] = static_cast<char>( '0' + value % 10 );
+        value /= 10;
+    } while( value > 0 );
+
+    text.append( digits + sizeof( digits ) - n, n );
+}
+
+/**
+ * Truncates a line of the region that does not fit in a number of columns, so that the terminal does not wrap it.
+ */
+static void truncateLine( std::string &line, std::size_t width, bool ansi )
+{
+    if( display_width( line ) <= width )
+    {
+        return;
+    }
+
+    line.resize( truncate_to_width( line, width ).size() );
+    if( ansi )
+    {
+        line.append( ANSI_RESET_SEQUENCE );
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Output stream buffer
+//
+
+LiveRegion::OutputBuffer::int_type LiveRegion::OutputBuffer::overflow( int_type c )
+{
+    if( traits_type::eq_int_type( c, traits_type::eof() ) )
+    {
+        return traits_type::not_eof( c );
+    }
+
+    const char_type ch = traits_type::to_char_type( c );
+    m_region.write_output( std::string_view( &ch, 1 ) );
+
+    return c;
+}
+
+std::streamsize LiveRegion::OutputBuffer::xsputn( const char_type *s, std::streamsize n )
+{
+    m_region.write_output( std::string_view( s, static_cast<std::size_t>( n ) ) );
+
+    return n;
+}
+
+int LiveRegion::OutputBuffer::sync()
+{
+    std::lock_guard<std::mutex> lock( m_region.m_mutex );
+
+    return ( m_region.m_target != nullptr ) ? m_region.m_target->pubsync() : -1;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Live region
+//
+
+LiveRegion::LiveRegion( Console &console, unsigned int fps, std::size_t width )
+: m_console( console ), m_target( console.rdbuf() ), m_outputBuffer( *this ), m_ansi( console.uses_ansi_coloring() ),
+  m_geometry( ( width == 0 ) ? &TerminalGeometry::for_console( console ) : nullptr ), m_width( width ),
+  m_frameInterval( std::chrono::duration_cast<std::chrono::steady_clock::duration>( std::chrono::nanoseconds( 1000000000 / std::max( fps, 1u ) ) ) ),
+  m_nextFrame( 0 ), m_drawnLines( 0 ), m_frame( 0 ), m_running( false )
+{
+    m_console.flush();
+    m_console.rdbuf( &m_outputBuffer );
+}
+
+LiveRegion::~LiveRegion()
+{
+    stop();
+
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        start_frame();
+        append_frame( true );
+
+        // Leave the cursor below the region, followed by the incomplete output line held (if any)
+        if( m_drawnLines > 0 )
+        {
+            m_frameBuffer.append( "\r\n" );
+            m_drawnLines = 0;
+        }
+        m_frameBuffer.append( m_pendingOutput );
+        m_pendingOutput.clear();
+
+        flush_frame();
+    }
+
+    m_console.rdbuf( m_target );
+}
+
+ProgressBar& LiveRegion::add_bar( std::string_view label, std::uint64_t total )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    m_bars.emplace_back( new ProgressBar( label, total ) );
+    m_reported.push_back( false );
+
+    return *m_bars.back();
+}
+
+void LiveRegion::tick()
+{
+    const std::chrono::steady_clock::rep now = std::chrono::steady_clock::now().time_since_epoch().count();
+
+    if( now < m_nextFrame.load( std::memory_order_relaxed ) )
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock( m_mutex, std::try_to_lock );
+    if( !lock.owns_lock() )
+    {
+        // Another thread is rendering or writing output
+        return;
+    }
+
+    m_nextFrame.store( now + m_frameInterval.count(), std::memory_order_relaxed );
+
+    start_frame();
+    append_frame( false );
+    flush_frame();
+}
+
+void LiveRegion::render()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    m_nextFrame.store( ( std::chrono::steady_clock::now() + m_frameInterval ).time_since_epoch().count(), std::memory_order_relaxed );
+
+    start_frame();
+    append_frame( false );
+    flush_frame();
+}
+
+void LiveRegion::start()
+{
+    std::lock_guard<std::mutex> lock( m_threadMutex );
+
+    if( !m_running )
+    {
+        m_running = true;
+        m_thread = std::thread( &LiveRegion::run, this );
+    }
+}
+
+void LiveRegion::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock( m_threadMutex );
+
+        if( !m_running )
+        {
+            return;
+        }
+
+        m_running = false;
+    }
+
+    m_threadCondition.notify_all();
+    m_thread.join();
+}
+
+void LiveRegion::run()
+{
+    std::unique_lock<std::mutex> lock( m_threadMutex );
+
+    while( m_running )
+    {
+        lock.unlock();
+        render();
+        lock.lock();
+
+        m_threadCondition.wait_for( lock, m_frameInterval, [this]() { return !m_running; } );
+    }
+}
+
+void LiveRegion::write_output( std::string_view data )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    const std::size_t newline = data.rfind( '\n' );
+    if( newline == std::string_view::npos )
+    {
+        // Incomplete lines are held, so that the region is not redrawn in the middle of a line
+        m_pendingOutput.append( data );
+        return;
+    }
+
+    start_frame();
+
+    if( m_drawnLines > 0 )
+    {
+        // Erase the region and write the output lines in its place
+        m_frameBuffer.push_back( '\r' );
+        append_cursor_up( m_drawnLines - 1 );
+        m_frameBuffer.append( "\033[J" );
+
+        if( !m_outputParser.get_style().is_default() )
+        {
+            m_frameBuffer.append( sgrSequence( m_outputParser.get_style(), ColorCapability::TRUE_COLOR ).view() );
+        }
+
+        m_drawnLines = 0;
+        m_lines.clear();
+    }
+
+    const std::string_view lines = data.substr( 0, newline + 1 );
+    m_frameBuffer.append( m_pendingOutput );
+    m_frameBuffer.append( lines );
+    m_outputParser.process( m_pendingOutput, []( const SgrStyle&, std::string_view ) {} );
+    m_outputParser.process( lines, []( const SgrStyle&, std::string_view ) {} );
+    m_pendingOutput.assign( data.substr( newline + 1 ) );
+
+    // Redraw the region below the output
+    append_frame( false );
+    flush_frame();
+}
+
+void LiveRegion::start_frame()
+{
+    if( m_geometry != nullptr )
+    {
+        m_width = m_geometry->get_size().columns;
+    }
+
+    m_frameBuffer.clear();
+
+    if( m_ansi )
+    {
+        m_frameBuffer.append( SYNCHRONIZED_UPDATE_BEGIN );
+    }
+
+    m_frameHeaderSize = m_frameBuffer.size();
+}
+
+void LiveRegion::append_frame( bool final )
+{
+    m_frame++;
+
+    if( !m_ansi )
+    {
+        // Only the final state of each bar is written
+        for( std::size_t i = 0; i < m_bars.size(); i++ )
+        {
+            if( !m_reported[i] && ( final || m_bars[i]->is_finished() ) )
+            {
+                m_frameBuffer.append( format_line( *m_bars[i] ) );
+                m_frameBuffer.push_back( '\n' );
+                m_reported[i] = true;
+            }
+        }
+        return;
+    }
+
+    const std::size_t frameStart = m_frameBuffer.size();
+    const bool styledOutput = !m_outputParser.get_style().is_default();
+
+    if( styledOutput )
+    {
+        m_frameBuffer.append( ANSI_RESET_SEQUENCE );
+    }
+
+    const std::size_t linesStart = m_frameBuffer.size();
+    m_lines.resize( m_bars.size() );
+
+    for( std::size_t i = 0; i < m_bars.size(); i++ )
+    {
+        std::string line = format_line( *m_bars[i] );
+
+        if( i < m_drawnLines )
+        {
+            if( line == m_lines[i] )
+            {
+                continue;
+            }
+
+            // Move up from the last line of the region to the line, redraw it and go back
+            const std::size_t distance = m_drawnLines - 1 - i;
+            m_frameBuffer.push_back( '\r' );
+            append_cursor_up( distance );
+            m_frameBuffer.append( line );
+            m_frameBuffer.append( ANSI_CLEAR_LINE_SEQUENCE );
+            if( distance > 0 )
+            {
+                m_frameBuffer.append( "\033[" );
+                appendNumber( m_frameBuffer, distance );
+                m_frameBuffer.push_back( 'B' );
+            }
+        }
+        else
+        {
+            if( m_drawnLines > 0 )
+            {
+                m_frameBuffer.append( "\r\n" );
+            }
+            m_frameBuffer.append( line );
+            m_frameBuffer.append( ANSI_CLEAR_LINE_SEQUENCE );
+            m_drawnLines++;
+        }
+
+        m_lines[i] = std::move( line );
+    }
+
+    if( m_frameBuffer.size() == linesStart )
+    {
+        // Nothing changed
+        m_frameBuffer.resize( frameStart );
+    }
+    else if( styledOutput )
+    {
+        m_frameBuffer.append( sgrSequence( m_outputParser.get_style(), ColorCapability::TRUE_COLOR ).view() );
+    }
+}
+
+void LiveRegion::flush_frame()
+{
+    if( m_frameBuffer.size() == m_frameHeaderSize )
+    {
+        return;
+    }
+
+    if( m_ansi )
+    {
+        m_frameBuffer.append( SYNCHRONIZED_UPDATE_END );
+    }
+
+    m_target->sputn( m_frameBuffer.data(), static_cast<std::streamsize>( m_frameBuffer.size() ) );
+    m_target->pubsync();
+}
+
+void LiveRegion::append_cursor_up( std::size_t lines )
+{
+    if( lines > 0 )
+    {
+        m_frameBuffer.append( "\033[" );
+        appendNumber( m_frameBuffer, lines );
+        m_frameBuffer.push_back( 'A' );
+    }
+}
+
+std::string LiveRegion::format_line( const ProgressBar &bar ) const
+{
+    // The line must not reach the last column, so that the terminal does not wrap it: the cursor is moved up one
+    // row per line of the region. On narrow terminals the label is shortened, and then the line is truncated.
+    const std::size_t lineWidth = ( m_width > 0 ) ? ( m_width - 1 ) : 0;
+    const std::size_t labelWidth = std::min( LABEL_WIDTH, lineWidth / 2 );
+
+    std::string line;
+    line.reserve( m_width + 32 );
+
+    // Label, truncated at a grapheme cluster boundary and padded
+    const std::string_view label = truncate_to_width( bar.get_label(), labelWidth );
+    line.append( label );
+    line.append( labelWidth + 1 - display_width( label ), ' ' );
+
+    const std::uint64_t total = bar.get_total();
+    const bool finished = bar.is_finished();
+    const std::uint64_t value = ( finished && ( total > 0 ) ) ? total : std::min( bar.get_value(), ( total > 0 ) ? total : UINT64_MAX );
+
+    if( total == 0 )
+    {
+        // Spinner
+        if( m_ansi )
+        {
+            line.append( ansiEscape( finished ? Color::FG_LIGHT_GREEN : Color::FG_LIGHT_CYAN ).view() );
+        }
+        if( finished )
+        {
+            line.append( "done" );
+        }
+        else
+        {
+            line.push_back( SPINNER_FRAMES[m_frame % sizeof( SPINNER_FRAMES )] );
+        }
+        if( m_ansi )
+        {
+            line.append( ANSI_RESET_SEQUENCE );
+        }
+        if( value > 0 )
+        {
+            line.push_back( ' ' );
+            appendNumber( line, value );
+        }
+        truncateLine( line, lineWidth, m_ansi );
+        return line;
+    }
+
+    std::string suffix = " ";
+    const std::uint64_t percent = ( value >= total ) ? 100 : ( value * 100 / total );
+    suffix.append( ( percent < 10 ) ? "  " : ( percent < 100 ) ? " " : "" );
+    appendNumber( suffix, percent );
+    suffix.append( "% " );
+    appendNumber( suffix, value );
+    suffix.push_back( '/' );
+    appendNumber( suffix, total );
+
+    const std::size_t used = labelWidth + 1 + 2 + suffix.size();
+    const std::size_t barWidth = ( lineWidth > used ) ? ( lineWidth - used ) : 0;
+    const std::size_t filled = ( value >= total ) ? barWidth : static_cast<std::size_t>( ( static_cast<double>( value ) / total ) * barWidth );
+
+    line.push_back( '[' );
+    if( m_ansi && ( filled > 0 ) )
+    {
+        line.append( ansiEscape( Color::FG_LIGHT_GREEN ).view() );
+    }
+    line.append( filled, '#' );
+    if( m_ansi && ( filled < barWidth ) )
+    {
+        line.append( ansiEscape( Color::FG_DARK_GREY ).view() );
+    }
+    line.append( barWidth - filled, '-' );
+    if( m_ansi && ( barWidth > 0 ) )
+    {
+        line.append( ANSI_RESET_SEQUENCE );
+    }
+    line.push_back( ']' );
+    line.append( suffix );
+    truncateLine( line, lineWidth, m_ansi );
+
+    return line;
+}
+
+} // namespace
@@ -0,0 +1,114 @@
+/**
+ * @file
+ * @brief      USDT static probes for ColorConsole and ColorConsoleW
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLEPROBES_HPP_
+#define COLORCONSOLEPROBES_HPP_
+
+/*
+ * When the library is built with COLORCONSOLE_ENABLE_PROBES defined (which requires <sys/sdt.h>), the
+ * following USDT probes of the "colorconsole" provider are available to tracers (perf, bpftrace,
+ * SystemTap...):
+ *
+ * - color_change( int consoleType, unsigned int color, size_t escapeSize, uint64_t nanoseconds )
+ *   Fired each time the color of a console is set.
+ *
+ * - write( int consoleType, size_t size, uint64_t nanoseconds )
+ *   Fired each time text is written into the underlying stream buffer of the global consoles and of the
+ *   C stdio consoles. Sizes are measured in characters.
+ *
+ * - flush( int consoleType, int result, uint64_t nanoseconds )
+ *   Fired each time the underlying stream buffer of the global consoles or the C stdio consoles is flushed.
+ *
+ * When not traced, each probe is just a nop instruction. Probes have semaphores, so that the escape sizes
+ * and elapsed times are only measured while a tracer is attached (tracers not supporting semaphores will
+ * receive 0 instead).
+ *
+ * Otherwise, probes are compiled out.
+ */
+
+#ifdef COLORCONSOLE_ENABLE_PROBES
+
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+
+#include <chrono>
+
+extern "C"
+{
+extern volatile unsigned short colorconsole_color_change_semaphore;
+extern volatile unsigned short colorconsole_write_semaphore;
+extern volatile unsigned short colorconsole_flush_semaphore;
+}
+
+#define COLORCONSOLE_PROBE_ENABLED( name ) __builtin_expect( colorconsole_##name##_semaphore != 0, 0 )
+#define COLORCONSOLE_PROBE3( name, a1, a2, a3 ) DTRACE_PROBE3( colorconsole, name, a1, a2, a3 )
+#define COLORCONSOLE_PROBE4( name, a1, a2, a3, a4 ) DTRACE_PROBE4( colorconsole, name, a1, a2, a3, a4 )
+
+#else
+
+#define COLORCONSOLE_PROBE_ENABLED( name ) false
+#define COLORCONSOLE_PROBE3( name, a1, a2, a3 ) ColorConsole::ignoreProbeArguments( a1, a2, a3 )
+#define COLORCONSOLE_PROBE4( name, a1, a2, a3, a4 ) ColorConsole::ignoreProbeArguments( a1, a2, a3, a4 )
+
+#endif
+
+namespace ColorConsole
+{
+
+/**
+ * Discards the arguments of compiled-out probes (which are free of side effects, and thus optimized away).
+ */
+template<class... Args>
+inline void ignoreProbeArguments( const Args&... ) noexcept
+{}
+
+/**
+ * Measures the elapsed time reported by a probe, only when the probe is being traced.
+ */
+class ProbeTimer
+{
+public:
+    explicit ProbeTimer( bool enabled ) noexcept
+    : m_start( enabled ? now() : 0 )
+    {}
+
+    /**
+     * Indicates if the time is being measured.
+     */
+    bool is_running() const noexcept
+    {
+        return ( m_start != 0 );
+    }
+
+    /**
+     * Returns the elapsed time since construction in nanoseconds, or 0 if the time is not being measured.
+     */
+    unsigned long long elapsed() const noexcept
+    {
+        return ( m_start != 0 ) ? ( now() - m_start ) : 0;
+    }
+
+private:
+    static unsigned long long now() noexcept
+    {
+#ifdef COLORCONSOLE_ENABLE_PROBES
+        // The lowest bit is set so that a measured start time is never 0
+        return static_cast<unsigned long long>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count() ) | 1u;
+#else
+        return 0;
+#endif
+    }
+
+    unsigned long long m_start;
+};
+
+} // namespace
+
+#endif // header guard
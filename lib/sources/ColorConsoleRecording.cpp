@@ -0,0 +1,544 @@
+/**
+ * @file
+ * @brief      Implementation of the ColorConsole recordings of colored output
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsoleRecording.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ColorConsole
+{
+
+//////////////////////////////////////////////////////////////////////////
+// Encoding
+//
+
+static constexpr char HEADER_MAGIC[4] = { 'C', 'C', 'R', 'C' };
+static constexpr char BLOCK_MAGIC[4] = { 'C', 'C', 'R', 'B' };
+static constexpr char TRAILER_MAGIC[4] = { 'C', 'C', 'R', 'E' };
+static constexpr std::uint16_t FORMAT_VERSION = 1;
+static constexpr std::size_t HEADER_SIZE = 14;
+static constexpr std::size_t BLOCK_HEADER_SIZE = 8;
+static constexpr std::size_t TRAILER_SIZE = 12;
+
+static void appendVarint( std::string &out, std::uint64_t value )
+{
+    while( value >= 0x80 )
+    {
+        out.push_back( static_cast<char>( ( value & 0x7F ) | 0x80 ) );
+        value >>= 7;
+    }
+    out.push_back( static_cast<char>( value ) );
+}
+
+static void appendFixed( std::string &out, std::uint64_t value, std::size_t size )
+{
+    for( std::size_t i = 0; i < size; i++ )
+    {
+        out.push_back( static_cast<char>( ( value >> ( 8 * i ) ) & 0xFF ) );
+    }
+}
+
+static std::uint64_t readFixed( const char *data, std::size_t size ) noexcept
+{
+    std::uint64_t value = 0;
+
+    for( std::size_t i = 0; i < size; i++ )
+    {
+        value |= std::uint64_t( static_cast<unsigned char>( data[i] ) ) << ( 8 * i );
+    }
+
+    return value;
+}
+
+static void appendColor( std::string &out, const SgrColor &color )
+{
+    out.push_back( static_cast<char>( color.kind ) );
+
+    if( color.kind == SgrColor::Kind::INDEXED )
+    {
+        out.push_back( static_cast<char>( color.index ) );
+    }
+    else if( color.kind == SgrColor::Kind::RGB )
+    {
+        out.push_back( static_cast<char>( color.red ) );
+        out.push_back( static_cast<char>( color.green ) );
+        out.push_back( static_cast<char>( color.blue ) );
+    }
+}
+
+/**
+ * Bounds-checked decoder of payloads.
+ */
+struct Decoder
+{
+    const unsigned char *pos;
+    const unsigned char *end;
+
+    bool byte( std::uint8_t &value ) noexcept
+    {
+        if( pos >= end )
+        {
+            return false;
+        }
+        value = *pos++;
+        return true;
+    }
+
+    bool varint( std::uint64_t &value ) noexcept
+    {
+        value = 0;
+
+        for( unsigned int shift = 0; shift < 64; shift += 7 )
+        {
+            std::uint8_t b;
+            if( !byte( b ) )
+            {
+                return false;
+            }
+
+            value |= std::uint64_t( b & 0x7F ) << shift;
+
+            if( ( b & 0x80 ) == 0 )
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool color( SgrColor &color ) noexcept
+    {
+        std::uint8_t kind;
+        if( !byte( kind ) || ( kind > static_cast<std::uint8_t>( SgrColor::Kind::RGB ) ) )
+        {
+            return false;
+        }
+
+        color = SgrColor();
+        color.kind = static_cast<SgrColor::Kind>( kind );
+
+        if( color.kind == SgrColor::Kind::INDEXED )
+        {
+            return byte( color.index );
+        }
+        else if( color.kind == SgrColor::Kind::RGB )
+        {
+            return byte( color.red ) && byte( color.green ) && byte( color.blue );
+        }
+
+        return true;
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Writer
+//
+
+RecordingWriter::RecordingWriter( std::streambuf *target )
+: m_target( target ), m_good( true ), m_finished( false ), m_offset( 0 ), m_line( 0 ), m_blockLine( 0 )
+{
+    m_text.reserve( RECORDING_BLOCK_TEXT_SIZE );
+
+    const std::uint64_t startTime = static_cast<std::uint64_t>( std::chrono::duration_cast<std::chrono::milliseconds>(
+                                        std::chrono::system_clock::now().time_since_epoch() ).count() );
+
+    std::string header( HEADER_MAGIC, sizeof( HEADER_MAGIC ) );
+    appendFixed( header, FORMAT_VERSION, 2 );
+    appendFixed( header, startTime, 8 );
+
+    put( header.data(), header.size() );
+}
+
+RecordingWriter::~RecordingWriter()
+{
+    finish();
+}
+
+void RecordingWriter::put( const void *data, std::size_t size )
+{
+    const std::streamsize n = static_cast<std::streamsize>( size );
+    m_good = m_good && ( m_target->sputn( static_cast<const char*>( data ), n ) == n );
+    m_offset += size;
+}
+
+void RecordingWriter::write( const SgrStyle &style, std::string_view text, std::uint64_t time )
+{
+    while( !m_finished && !text.empty() )
+    {
+        if( m_text.size() >= RECORDING_BLOCK_TEXT_SIZE )
+        {
+            flush_block();
+        }
+
+        auto found = std::find( m_styles.begin(), m_styles.end(), style );
+        if( found == m_styles.end() )
+        {
+            if( m_styles.size() >= RECORDING_BLOCK_MAX_STYLES )
+            {
+                flush_block();
+            }
+            m_styles.push_back( style );
+            found = m_styles.end() - 1;
+        }
+
+        const std::uint32_t styleIndex = static_cast<std::uint32_t>( found - m_styles.begin() );
+        const std::string_view piece = text.substr( 0, RECORDING_BLOCK_TEXT_SIZE - m_text.size() );
+
+        if( !m_runs.empty() && ( m_runs.back().style == styleIndex ) && ( m_runs.back().time == time ) )
+        {
+            m_runs.back().length += static_cast<std::uint32_t>( piece.size() );
+        }
+        else
+        {
+            if( m_runs.size() >= RECORDING_BLOCK_MAX_RUNS )
+            {
+                flush_block();
+                continue;
+            }
+            m_runs.push_back( Run { styleIndex, static_cast<std::uint32_t>( piece.size() ), time } );
+        }
+
+        m_text.append( piece );
+        m_line += static_cast<std::uint64_t>( std::count( piece.begin(), piece.end(), '\n' ) );
+        text.remove_prefix( piece.size() );
+    }
+}
+
+bool RecordingWriter::flush_block()
+{
+    if( m_runs.empty() )
+    {
+        m_styles.clear();
+        return m_good;
+    }
+
+    const std::uint64_t blockTime = m_runs.front().time;
+
+    m_payload.clear();
+    appendVarint( m_payload, blockTime );
+    appendVarint( m_payload, m_blockLine );
+
+    appendVarint( m_payload, m_styles.size() );
+    for( const SgrStyle &style : m_styles )
+    {
+        m_payload.push_back( static_cast<char>( style.attributes ) );
+        appendColor( m_payload, style.foreground );
+        appendColor( m_payload, style.background );
+    }
+
+    appendVarint( m_payload, m_runs.size() );
+    std::uint64_t previousTime = blockTime;
+    for( const Run &run : m_runs )
+    {
+        appendVarint( m_payload, run.style );
+        appendVarint( m_payload, run.length );
+        appendVarint( m_payload, run.time - previousTime );
+        previousTime = run.time;
+    }
+
+    std::string blockHeader( BLOCK_MAGIC, sizeof( BLOCK_MAGIC ) );
+    appendFixed( blockHeader, m_payload.size() + m_text.size(), 4 );
+
+    m_index.push_back( RecordingBlockInfo { m_offset, blockTime, m_blockLine } );
+
+    put( blockHeader.data(), blockHeader.size() );
+    put( m_payload.data(), m_payload.size() );
+    put( m_text.data(), m_text.size() );
+
+    m_blockLine = m_line;
+    m_styles.clear();
+    m_runs.clear();
+    m_text.clear();
+
+    return m_good;
+}
+
+bool RecordingWriter::finish()
+{
+    if( m_finished )
+    {
+        return m_good;
+    }
+
+    flush_block();
+    m_finished = true;
+
+    const std::uint64_t indexOffset = m_offset;
+    RecordingBlockInfo previous { 0, 0, 0 };
+
+    m_payload.clear();
+    appendVarint( m_payload, m_index.size() );
+    for( const RecordingBlockInfo &block : m_index )
+    {
+        appendVarint( m_payload, block.offset - previous.offset );
+        appendVarint( m_payload, block.time - previous.time );
+        appendVarint( m_payload, block.line - previous.line );
+        previous = block;
+    }
+
+    appendFixed( m_payload, indexOffset, 8 );
+    m_payload.append( TRAILER_MAGIC, sizeof( TRAILER_MAGIC ) );
+
+    put( m_payload.data(), m_payload.size() );
+
+    m_good = m_good && ( m_target->pubsync() == 0 );
+
+    return m_good;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Stream buffer
+//
+
+RecordingStreamBuf::RecordingStreamBuf( std::streambuf *target )
+: m_writer( target ), m_start( std::chrono::steady_clock::now() )
+{}
+
+RecordingStreamBuf::int_type RecordingStreamBuf::overflow( int_type c )
+{
+    if( traits_type::eq_int_type( c, traits_type::eof() ) )
+    {
+        return traits_type::not_eof( c );
+    }
+
+    const char_type ch = traits_type::to_char_type( c );
+
+    return ( xsputn( &ch, 1 ) == 1 ) ? c : traits_type::eof();
+}
+
+std::streamsize RecordingStreamBuf::xsputn( const char_type *s, std::streamsize n )
+{
+    const std::uint64_t time = static_cast<std::uint64_t>( std::chrono::duration_cast<std::chrono::milliseconds>(
+                                   std::chrono::steady_clock::now() - m_start ).count() );
+
+    m_parser.process( std::string_view( s, static_cast<std::size_t>( n ) ), [this, time]( const SgrStyle &style, std::string_view text )
+    {
+        m_writer.write( style, text, time );
+    } );
+
+    return m_writer.good() ? n : 0;
+}
+
+int RecordingStreamBuf::sync()
+{
+    return m_writer.good() ? m_writer.get_target()->pubsync() : -1;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Reader
+//
+
+RecordingReader::RecordingReader( std::istream &input )
+: m_input( input ), m_valid( false ), m_startTime( 0 ), m_textOffset( 0 )
+{
+    char header[HEADER_SIZE];
+
+    m_input.seekg( 0, std::ios::beg );
+    if( !m_input.read( header, HEADER_SIZE ) || ( std::memcmp( header, HEADER_MAGIC, sizeof( HEADER_MAGIC ) ) != 0 ) ||
+        ( readFixed( header + 4, 2 ) != FORMAT_VERSION ) )
+    {
+        return;
+    }
+
+    m_valid = true;
+    m_startTime = readFixed( header + 6, 8 );
+
+    // Read the index from the trailer
+    m_input.seekg( 0, std::ios::end );
+    const std::uint64_t size = static_cast<std::uint64_t>( m_input.tellg() );
+
+    if( size >= HEADER_SIZE + TRAILER_SIZE )
+    {
+        char trailer[TRAILER_SIZE];
+        m_input.seekg( static_cast<std::streamoff>( size - TRAILER_SIZE ), std::ios::beg );
+
+        if( m_input.read( trailer, TRAILER_SIZE ) && ( std::memcmp( trailer + 8, TRAILER_MAGIC, sizeof( TRAILER_MAGIC ) ) == 0 ) )
+        {
+            const std::uint64_t indexOffset = readFixed( trailer, 8 );
+
+            if( ( indexOffset >= HEADER_SIZE ) && ( indexOffset <= size - TRAILER_SIZE ) )
+            {
+                m_payload.resize( static_cast<std::size_t>( size - TRAILER_SIZE - indexOffset ) );
+                m_input.seekg( static_cast<std::streamoff>( indexOffset ), std::ios::beg );
+
+                if( m_input.read( m_payload.data(), static_cast<std::streamsize>( m_payload.size() ) ) )
+                {
+                    Decoder decoder { reinterpret_cast<const unsigned char*>( m_payload.data() ),
+                                      reinterpret_cast<const unsigned char*>( m_payload.data() + m_payload.size() ) };
+                    RecordingBlockInfo block { 0, 0, 0 };
+                    std::uint64_t count;
+                    bool ok = decoder.varint( count ) && ( count <= m_payload.size() );
+
+                    for( std::uint64_t i = 0; ok && ( i < count ); i++ )
+                    {
+                        std::uint64_t offset = 0, time = 0, line = 0;
+                        ok = decoder.varint( offset ) && decoder.varint( time ) && decoder.varint( line );
+
+                        block.offset += offset;
+                        block.time += time;
+                        block.line += line;
+                        m_blocks.push_back( block );
+                    }
+
+                    if( ok )
+                    {
+                        return;
+                    }
+                }
+            }
+        }
+    }
+
+    // No valid index (e.g. interrupted recording)
+    m_input.clear();
+    rebuild_index();
+}
+
+void RecordingReader::rebuild_index()
+{
+    m_blocks.clear();
+
+    std::uint64_t offset = HEADER_SIZE;
+
+    while( true )
+    {
+        char blockHeader[BLOCK_HEADER_SIZE + 20];
+
+        m_input.clear();
+        m_input.seekg( static_cast<std::streamoff>( offset ), std::ios::beg );
+        m_input.read( blockHeader, sizeof( blockHeader ) );
+
+        const std::size_t read = static_cast<std::size_t>( m_input.gcount() );
+        if( ( read < BLOCK_HEADER_SIZE ) || ( std::memcmp( blockHeader, BLOCK_MAGIC, sizeof( BLOCK_MAGIC ) ) != 0 ) )
+        {
+            break;
+        }
+
+        const std::uint64_t payloadSize = readFixed( blockHeader + 4, 4 );
+
+        Decoder decoder { reinterpret_cast<const unsigned char*>( blockHeader + BLOCK_HEADER_SIZE ),
+                          reinterpret_cast<const unsigned char*>( blockHeader + read ) };
+        RecordingBlockInfo block { offset, 0, 0 };
+
+        if( !decoder.varint( block.time ) || !decoder.varint( block.line ) )
+        {
+            break;
+        }
+
+        // Check that the block is complete
+        m_input.clear();
+        m_input.seekg( static_cast<std::streamoff>( offset + BLOCK_HEADER_SIZE + payloadSize - 1 ), std::ios::beg );
+        if( ( payloadSize == 0 ) || ( m_input.get() == std::istream::traits_type::eof() ) )
+        {
+            break;
+        }
+
+        m_blocks.push_back( block );
+        offset += BLOCK_HEADER_SIZE + payloadSize;
+    }
+
+    m_input.clear();
+}
+
+std::size_t RecordingReader::find_time( std::uint64_t time ) const noexcept
+{
+    auto found = std::lower_bound( m_blocks.begin(), m_blocks.end(), time,
+                                   []( const RecordingBlockInfo &block, std::uint64_t value ) { return block.time < value; } );
+
+    return ( found == m_blocks.begin() ) ? 0 : static_cast<std::size_t>( found - m_blocks.begin() - 1 );
+}
+
+std::size_t RecordingReader::find_line( std::uint64_t line ) const noexcept
+{
+    auto found = std::lower_bound( m_blocks.begin(), m_blocks.end(), line,
+                                   []( const RecordingBlockInfo &block, std::uint64_t value ) { return block.line < value; } );
+
+    return ( found == m_blocks.begin() ) ? 0 : static_cast<std::size_t>( found - m_blocks.begin() - 1 );
+}
+
+bool RecordingReader::load_block( std::size_t block )
+{
+    m_styles.clear();
+    m_runs.clear();
+
+    if( block >= m_blocks.size() )
+    {
+        return false;
+    }
+
+    char blockHeader[BLOCK_HEADER_SIZE];
+
+    m_input.clear();
+    m_input.seekg( static_cast<std::streamoff>( m_blocks[block].offset ), std::ios::beg );
+    if( !m_input.read( blockHeader, BLOCK_HEADER_SIZE ) || ( std::memcmp( blockHeader, BLOCK_MAGIC, sizeof( BLOCK_MAGIC ) ) != 0 ) )
+    {
+        return false;
+    }
+
+    m_payload.resize( static_cast<std::size_t>( readFixed( blockHeader + 4, 4 ) ) );
+    if( !m_input.read( m_payload.data(), static_cast<std::streamsize>( m_payload.size() ) ) )
+    {
+        return false;
+    }
+
+    const unsigned char *begin = reinterpret_cast<const unsigned char*>( m_payload.data() );
+    Decoder decoder { begin, begin + m_payload.size() };
+    std::uint64_t time, line, styleCount, runCount;
+
+    if( !decoder.varint( time ) || !decoder.varint( line ) || !decoder.varint( styleCount ) ||
+        ( styleCount > RECORDING_BLOCK_MAX_STYLES ) )
+    {
+        return false;
+    }
+
+    for( std::uint64_t i = 0; i < styleCount; i++ )
+    {
+        SgrStyle style;
+        if( !decoder.byte( style.attributes ) || !decoder.color( style.foreground ) || !decoder.color( style.background ) )
+        {
+            return false;
+        }
+        m_styles.push_back( style );
+    }
+
+    if( !decoder.varint( runCount ) || ( runCount > RECORDING_BLOCK_MAX_RUNS ) )
+    {
+        return false;
+    }
+
+    std::uint64_t textSize = 0;
+
+    for( std::uint64_t i = 0; i < runCount; i++ )
+    {
+        std::uint64_t style, length, timeDelta;
+        if( !decoder.varint( style ) || !decoder.varint( length ) || !decoder.varint( timeDelta ) ||
+            ( style >= styleCount ) || ( length > RECORDING_BLOCK_TEXT_SIZE ) )
+        {
+            return false;
+        }
+
+        time += timeDelta;
+        textSize += length;
+        m_runs.push_back( Run { static_cast<std::uint32_t>( style ), static_cast<std::uint32_t>( length ), time } );
+    }
+
+    m_textOffset = static_cast<std::size_t>( decoder.pos - begin );
+
+    if( textSize != m_payload.size() - m_textOffset )
+    {
+        m_runs.clear();
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace
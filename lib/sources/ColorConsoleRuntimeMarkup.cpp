@@ -0,0 +1,306 @@
+/**
+ * @file
+ * @brief      Implementation of ColorConsole runtime markup templates and palettes
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsole.hpp"
+#include "ColorConsolePalette.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+
+namespace ColorConsole
+{
+
+/**
+ * Maximum number of runtime markup templates cached per thread.
+ */
+static constexpr std::size_t MARKUP_CACHE_CAPACITY = 32;
+
+static std::atomic<unsigned long long> paletteVersionCounter( 0 );
+
+//////////////////////////////////////////////////////////////////////////
+// Palette
+//
+
+Palette::Palette( bool withDefaults )
+{
+    touch();
+
+    if( withDefaults )
+    {
+        set( "error", Color::FG_LIGHT_RED );
+        set( "warn", Color::FG_YELLOW );
+        set( "warning", Color::FG_YELLOW );
+        set( "info", Color::FG_LIGHT_CYAN );
+        set( "ok", Color::FG_LIGHT_GREEN );
+        set( "success", Color::FG_LIGHT_GREEN );
+        set( "note", Color::FG_LIGHT_BLUE );
+        set( "debug", Color::FG_DARK_GREY );
+    }
+}
+
+void Palette::touch() noexcept
+{
+    m_version = ++paletteVersionCounter;
+}
+
+void Palette::set( std::string_view name, Color color )
+{
+    for( Style &style : m_styles )
+    {
+        if( style.name == name )
+        {
+            style.color = color;
+            touch();
+            return;
+        }
+    }
+
+    m_styles.push_back( { std::string( name ), color } );
+    touch();
+}
+
+bool Palette::remove( std::string_view name )
+{
+    auto it = std::find_if( m_styles.begin(), m_styles.end(), [name]( const Style &style ) { return style.name == name; } );
+
+    if( it == m_styles.end() )
+    {
+        return false;
+    }
+
+    m_styles.erase( it );
+    touch();
+    return true;
+}
+
+bool Palette::find( std::string_view name, Color &color ) const noexcept
+{
+    for( const Style &style : m_styles )
+    {
+        if( style.name == name )
+        {
+            color = style.color;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+Palette& Palette::default_palette()
+{
+    static Palette defaultPalette;
+    return defaultPalette;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Runtime markup compilation
+//
+
+namespace
+{
+
+struct PaletteResolver
+{
+    const Palette &palette;
+
+    bool operator()( std::string_view name, Color base, Color &result ) const noexcept
+    {
+        if( palette.find( name, result ) )
+        {
+            return true;
+        }
+        return MarkupColorResolver()( name, base, result );
+    }
+};
+
+/**
+ * Operation of a compiled runtime markup template.
+ */
+struct MarkupOp
+{
+    enum class Kind : unsigned char
+    {
+        TEXT,       ///< Write text (offset and length into the program text)
+        COLOR,      ///< Set color
+        ARGUMENT    ///< Insert argument (index)
+    };
+
+    Kind kind;
+    Color color;
+    std::size_t offset;
+    std::size_t length;
+};
+
+/**
+ * Compiled runtime markup template.
+ */
+struct MarkupProgram
+{
+    std::string text;
+    std::vector<MarkupOp> ops;
+    MarkupStatus status;
+};
+
+struct MarkupCompilingSink : MarkupCoalescingSink<MarkupCompilingSink>
+{
+    MarkupProgram &program;
+
+    explicit MarkupCompilingSink( MarkupProgram &p ) : program( p ) {}
+
+    void emitText( std::string_view text )
+    {
+        if( !program.ops.empty() && ( program.ops.back().kind == MarkupOp::Kind::TEXT ) )
+        {
+            program.ops.back().length += text.size();
+        }
+        else
+        {
+            program.ops.push_back( { MarkupOp::Kind::TEXT, Color::RESET, program.text.size(), text.size() } );
+        }
+        program.text.append( text );
+    }
+
+    void emitColor( Color color )
+    {
+        program.ops.push_back( { MarkupOp::Kind::COLOR, color, 0, 0 } );
+    }
+
+    void argument( std::size_t index )
+    {
+        commitColor();
+        program.ops.push_back( { MarkupOp::Kind::ARGUMENT, Color::RESET, index, 0 } );
+    }
+};
+
+void compileMarkupProgram( std::string_view markup, const Palette &palette, MarkupProgram &program )
+{
+    program.text.clear();
+    program.ops.clear();
+
+    MarkupCompilingSink sink( program );
+    program.status = parseMarkup( markup, sink, PaletteResolver{ palette } );
+    sink.commitColor();
+}
+
+/**
+ * Per-thread cache of compiled runtime markup templates, keyed by template address and contents.
+ *
+ * When the cache is full, the least recently used entry is replaced. The programs are shared with their users,
+ * so that an entry replaced while its program is being written (by a template written from an argument) keeps
+ * the program alive; the storage of programs not in use is reused.
+ */
+class MarkupCache
+{
+public:
+    std::shared_ptr<const MarkupProgram> get( std::string_view markup, const Palette &palette )
+    {
+        m_tick++;
+
+        Entry *victim = &m_entries[0];
+
+        for( Entry &entry : m_entries )
+        {
+            if( ( entry.address == markup.data() ) && ( entry.key.size() == markup.size() ) &&
+                ( entry.palette == &palette ) && ( entry.paletteVersion == palette.get_version() ) &&
+                ( std::memcmp( entry.key.data(), markup.data(), markup.size() ) == 0 ) )
+            {
+                entry.lastUse = m_tick;
+                return entry.program;
+            }
+
+            if( entry.lastUse < victim->lastUse )
+            {
+                victim = &entry;
+            }
+        }
+
+        victim->address = markup.data();
+        victim->key.assign( markup.data(), markup.size() );
+        victim->palette = &palette;
+        victim->paletteVersion = palette.get_version();
+        victim->lastUse = m_tick;
+        if( !victim->program || ( victim->program.use_count() > 1 ) )
+        {
+            victim->program = std::make_shared<MarkupProgram>();
+        }
+        compileMarkupProgram( markup, palette, *victim->program );
+
+        return victim->program;
+    }
+
+private:
+    struct Entry
+    {
+        const char *address = nullptr;
+        std::string key;
+        const Palette *palette = nullptr;
+        unsigned long long paletteVersion = 0;
+        unsigned long long lastUse = 0;
+        std::shared_ptr<MarkupProgram> program;
+    };
+
+    Entry m_entries[MARKUP_CACHE_CAPACITY];
+    unsigned long long m_tick = 0;
+};
+
+} // namespace
+
+MarkupStatus validateMarkup( std::string_view markup, const Palette &palette )
+{
+    MarkupProgram program;
+    compileMarkupProgram( markup, palette, program );
+    return program.status;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Console
+//
+
+Console& Console::vprintm( std::string_view markup, const MarkupArgument *args, std::size_t argCount )
+{
+    static thread_local MarkupCache cache;
+
+    const Palette &palette = ( m_palette != NULL ) ? *m_palette : Palette::default_palette();
+    const std::shared_ptr<const MarkupProgram> pinnedProgram = cache.get( markup, palette );
+    const MarkupProgram &program = *pinnedProgram;
+
+    if( program.status.error != MarkupError::NONE )
+    {
+        write( markup.data(), static_cast<std::streamsize>( markup.size() ) );
+        return *this;
+    }
+
+    for( const MarkupOp &op : program.ops )
+    {
+        switch( op.kind )
+        {
+            case MarkupOp::Kind::TEXT:
+                write( program.text.data() + op.offset, static_cast<std::streamsize>( op.length ) );
+                break;
+
+            case MarkupOp::Kind::COLOR:
+                set_color( op.color );
+                break;
+
+            case MarkupOp::Kind::ARGUMENT:
+                if( op.offset < argCount )
+                {
+                    args[op.offset].insert( *this, args[op.offset].object );
+                }
+                break;
+        }
+    }
+
+    return *this;
+}
+
+} // namespace
@@ -0,0 +1,432 @@
+/**
+ * @file
+ * @brief      Implementation of the ColorConsole double-buffered screen
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsoleScreen.hpp"
+#include "ColorConsoleUtf8.hpp"
+#include "ColorConsoleWidth.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace ColorConsole
+{
+
+static constexpr std::string_view SYNCHRONIZED_UPDATE_BEGIN = "\033[?2026h";
+static constexpr std::string_view SYNCHRONIZED_UPDATE_END = "\033[?2026l";
+
+/**
+ * Sequence written by the first frame: resets the style, hides the cursor and clears the screen.
+ */
+static constexpr std::string_view FIRST_FRAME_SEQUENCE = "\033[0m\033[?25l\033[H\033[2J";
+
+/**
+ * Longest unchanged gap that is considered for rewriting instead of moving the cursor over it (a cursor
+ * movement is never longer).
+ */
+static constexpr std::size_t MAX_REWRITE_GAP = 16;
+
+/**
+ * Cursor movement sequence, stored inline.
+ */
+struct CursorMotion
+{
+    char text[48];
+    std::size_t length = 0;
+
+    void append( std::string_view str ) noexcept
+    {
+        std::memcpy( text + length, str.data(), str.size() );
+        length += str.size();
+    }
+
+    void append_number( std::size_t value ) noexcept
+    {
+        char digits[20];
+        std::size_t n = 0;
+
+        do
+        {
+            digits[sizeof( digits ) - 1 - n++] = static_cast<char>( '0' + value % 10 );
+            value /= 10;
+        } while( value > 0 );
+
+        append( std::string_view( digits + sizeof( digits ) - n, n ) );
+    }
+
+    /**
+     * Appends a CSI sequence with a count (omitted if 1), or nothing if the count is 0.
+     */
+    void append_csi( std::size_t count, char final ) noexcept
+    {
+        if( count == 0 )
+        {
+            return;
+        }
+
+        append( "\033[" );
+        if( count > 1 )
+        {
+            append_number( count );
+        }
+        text[length++] = final;
+    }
+
+    /**
+     * Appends the shortest movement from a column to another column in the same row.
+     */
+    void append_horizontal( std::size_t from, std::size_t to ) noexcept
+    {
+        if( to >= from )
+        {
+            append_csi( to - from, 'C' );
+            return;
+        }
+
+        CursorMotion back;
+        back.append_csi( from - to, 'D' );
+
+        CursorMotion carriageReturn;
+        carriageReturn.append( "\r" );
+        carriageReturn.append_csi( to, 'C' );
+
+        if( from - to < back.length )
+        {
+            // Backspaces are shorter for short distances
+            back.length = 0;
+            back.append( std::string_view( "\b\b\b", from - to ) );
+        }
+
+        const CursorMotion &best = ( back.length <= carriageReturn.length ) ? back : carriageReturn;
+        append( std::string_view( best.text, best.length ) );
+    }
+};
+
+/**
+ * Returns the number of columns that a cell of a row occupies when displayed: 2 for a wide character followed
+ * by its continuation cell, 1 otherwise.
+ */
+static std::size_t cellWidth( const TerminalCell *cells, std::size_t column, std::size_t columns ) noexcept
+{
+    return ( ( column + 1 < columns ) && ( cells[column + 1].character == TERMINAL_WIDE_CONTINUATION ) &&
+             ( code_point_width( cells[column].character ) == 2 ) ) ? 2 : 1;
+}
+
+Screen::Screen( Console &console, std::size_t columns, std::size_t rows, ColorCapability capability )
+: m_console( console ), m_columns( 0 ), m_rows( 0 ), m_capability( capability ), m_cursorRow( 0 ), m_cursorColumn( 0 ),
+  m_cursorKnown( false ), m_frontValid( false ), m_presented( false ), m_synchronizedUpdates( true )
+{
+    resize( columns, rows );
+}
+
+Screen::~Screen()
+{
+    if( m_presented )
+    {
+        release();
+    }
+}
+
+void Screen::resize( std::size_t columns, std::size_t rows )
+{
+    m_columns = std::max<std::size_t>( columns, 1 );
+    m_rows = std::max<std::size_t>( rows, 1 );
+    m_back.assign( m_columns * m_rows, TerminalCell() );
+    m_front.clear();
+    m_frontValid = false;
+}
+
+void Screen::clear( const SgrStyle &style )
+{
+    TerminalCell blank;
+    blank.style = style;
+
+    std::fill( m_back.begin(), m_back.end(), blank );
+}
+
+void Screen::fill( std::size_t row, std::size_t column, std::size_t width, std::size_t height, const TerminalCell &cell )
+{
+    const std::size_t endRow = std::min( m_rows, row + std::min( height, m_rows ) );
+    const std::size_t endColumn = std::min( m_columns, column + std::min( width, m_columns ) );
+
+    if( column >= endColumn )
+    {
+        return;
+    }
+
+    for( ; row < endRow; row++ )
+    {
+        splitWideCharacters( &at( row, 0 ), m_columns, column, endColumn );
+
+        for( std::size_t c = column; c < endColumn; c++ )
+        {
+            at( row, c ) = cell;
+        }
+    }
+}
+
+std::size_t Screen::print( std::size_t row, std::size_t column, std::string_view text, const SgrStyle &style )
+{
+    if( ( row >= m_rows ) || ( column >= m_columns ) )
+    {
+        return 0;
+    }
+
+    const char *p = text.data();
+    const char *end = p + text.size();
+    TerminalCell *cells = &at( row, 0 );
+    const std::size_t first = column;
+
+    splitWideCharacters( cells, m_columns, column, column );
+
+    while( ( p < end ) && ( column < m_columns ) )
+    {
+        char32_t c = decodeUtf8( p, end );
+
+        if( ( c < 0x20 ) || ( ( c >= 0x7F ) && ( c < 0xA0 ) ) )
+        {
+            c = REPLACEMENT_CHARACTER;
+        }
+
+        const unsigned int width = code_point_width( c );
+
+        if( ( width == 0 ) || ( column + width > m_columns ) )
+        {
+            // Zero-width code points can not be stored, and wide characters are not split
+            if( width == 0 )
+            {
+                continue;
+            }
+            break;
+        }
+
+        cells[column].character = c;
+        cells[column].style = style;
+
+        if( width == 2 )
+        {
+            cells[column + 1].character = TERMINAL_WIDE_CONTINUATION;
+            cells[column + 1].style = style;
+        }
+
+        column += width;
+    }
+
+    splitWideCharacters( cells, m_columns, column, column );
+
+    return column - first;
+}
+
+std::size_t Screen::present()
+{
+    m_output.clear();
+
+    if( m_synchronizedUpdates )
+    {
+        m_output.append( SYNCHRONIZED_UPDATE_BEGIN );
+    }
+
+    const std::size_t headerSize = m_output.size();
+
+    if( !m_frontValid )
+    {
+        m_output.append( FIRST_FRAME_SEQUENCE );
+        m_front.assign( m_back.size(), TerminalCell() );
+        m_style = SgrStyle();
+        m_cursorRow = 0;
+        m_cursorColumn = 0;
+        m_cursorKnown = true;
+        m_frontValid = true;
+    }
+
+    for( std::size_t row = 0; row < m_rows; row++ )
+    {
+        const TerminalCell *back = m_back.data() + row * m_columns;
+        TerminalCell *front = m_front.data() + row * m_columns;
+        bool cutWide = false;
+
+        // The front buffer holds the cells displayed: the cell covered by a wide character holds TERMINAL_WIDE_CONTINUATION
+        for( std::size_t column = 0; column < m_columns; )
+        {
+            const std::size_t width = cellWidth( back, column, m_columns );
+
+            if( !cutWide && ( back[column] == front[column] ) &&
+                ( ( width == 1 ) || ( front[column + 1].character == TERMINAL_WIDE_CONTINUATION ) ) )
+            {
+                column += width;
+                continue;
+            }
+
+            // Overwriting the first half of a wide character also erases its second half, which must be repainted
+            cutWide = ( column + width < m_columns ) && ( front[column + width].character == TERMINAL_WIDE_CONTINUATION );
+
+            move_cursor( row, column, back );
+            write_cell( back[column], width );
+
+            front[column] = back[column];
+            if( width == 2 )
+            {
+                front[column + 1] = TerminalCell{ TERMINAL_WIDE_CONTINUATION, back[column].style };
+            }
+            column += width;
+        }
+    }
+
+    if( m_output.size() == headerSize )
+    {
+        return 0;
+    }
+
+    if( m_synchronizedUpdates )
+    {
+        m_output.append( SYNCHRONIZED_UPDATE_END );
+    }
+
+    m_console.write_raw( m_output );
+    m_console.flush();
+    m_presented = true;
+
+    return m_output.size();
+}
+
+void Screen::release()
+{
+    CursorMotion motion;
+    motion.append( "\033[0m\033[" );
+    motion.append_number( m_rows );
+    motion.append( ";1H\r\n\033[?25h" );
+
+    m_console.write_raw( std::string_view( motion.text, motion.length ) );
+    m_console.flush();
+
+    m_presented = false;
+    m_frontValid = false;
+}
+
+void Screen::move_cursor( std::size_t row, std::size_t column, const TerminalCell *backRow )
+{
+    if( m_cursorKnown && ( row == m_cursorRow ) && ( column == m_cursorColumn ) )
+    {
+        return;
+    }
+
+    // Absolute position (CUP), valid from any position
+    CursorMotion best;
+    best.append( "\033[" );
+    if( ( row > 0 ) || ( column > 0 ) )
+    {
+        best.append_number( row + 1 );
+        best.append( ";" );
+        best.append_number( column + 1 );
+    }
+    best.append( "H" );
+
+    if( m_cursorKnown )
+    {
+        CursorMotion relative;
+
+        if( row == m_cursorRow )
+        {
+            relative.append_horizontal( m_cursorColumn, column );
+
+            // The unchanged cells of a short gap may be rewritten with less bytes than moving over them
+            const std::size_t gap = column - m_cursorColumn;
+            if( ( column > m_cursorColumn ) && ( gap <= MAX_REWRITE_GAP ) &&
+                ( rewrite_cost( backRow, m_cursorColumn, column ) <= std::min( relative.length, best.length ) ) )
+            {
+                for( std::size_t c = m_cursorColumn; c < column; )
+                {
+                    const std::size_t width = cellWidth( backRow, c, m_columns );
+                    write_cell( backRow[c], width );
+                    c += width;
+                }
+                return;
+            }
+        }
+        else
+        {
+            relative.append_csi( ( row > m_cursorRow ) ? ( row - m_cursorRow ) : ( m_cursorRow - row ), ( row > m_cursorRow ) ? 'B' : 'A' );
+            relative.append_horizontal( m_cursorColumn, column );
+
+            if( row == m_cursorRow + 1 )
+            {
+                // CR LF moves to the start of the next row with or without the output processing of the tty
+                CursorMotion newline;
+                newline.append( "\r\n" );
+                newline.append_csi( column, 'C' );
+
+                if( newline.length < relative.length )
+                {
+                    relative = newline;
+                }
+            }
+        }
+
+        if( relative.length < best.length )
+        {
+            best = relative;
+        }
+    }
+
+    m_output.append( best.text, best.length );
+    m_cursorRow = row;
+    m_cursorColumn = column;
+    m_cursorKnown = true;
+}
+
+void Screen::write_cell( const TerminalCell &cell, std::size_t width )
+{
+    if( !( cell.style == m_style ) )
+    {
+        const ColorCapability capability = m_console.uses_ansi_coloring() ? m_capability : ColorCapability::NONE;
+        m_output.append( sgrTransition( m_style, cell.style, capability ).view() );
+        m_style = cell.style;
+    }
+
+    // Characters that do not occupy exactly their cells (e.g. combining marks, or wide characters without their
+    // continuation cell) are displayed as blanks, so that the cursor advances as expected
+    const char32_t c = cell.character;
+    appendUtf8( m_output, ( code_point_width( c ) == width ) ? c : U' ' );
+
+    // After writing the last column the cursor position depends on the terminal wrapping behavior
+    m_cursorColumn += width;
+    if( m_cursorColumn == m_columns )
+    {
+        m_cursorKnown = false;
+    }
+}
+
+std::size_t Screen::rewrite_cost( const TerminalCell *cells, std::size_t first, std::size_t end ) const noexcept
+{
+    const ColorCapability capability = m_console.uses_ansi_coloring() ? m_capability : ColorCapability::NONE;
+    const SgrStyle *style = &m_style;
+    std::size_t cost = 0;
+
+    for( std::size_t i = first; i < end; i += cellWidth( cells, i, m_columns ) )
+    {
+        if( i + cellWidth( cells, i, m_columns ) > end )
+        {
+            // A wide character would overwrite the first cell that changed
+            return std::numeric_limits<std::size_t>::max();
+        }
+
+        if( !( cells[i].style == *style ) )
+        {
+            cost += sgrTransition( *style, cells[i].style, capability ).length;
+            style = &cells[i].style;
+        }
+
+        const char32_t c = cells[i].character;
+        cost += ( c < 0x80 ) ? 1 : ( c < 0x800 ) ? 2 : ( c < 0x10000 ) ? 3 : 4;
+    }
+
+    return cost;
+}
+
+} // namespace
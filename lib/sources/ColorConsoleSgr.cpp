@@ -0,0 +1,561 @@
+/**
+ * @file
+ * @brief      Implementation of the ColorConsole SGR escape sequences parser
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsoleSgr.hpp"
+#include "ColorConsoleAnsi.hpp"
+
+#include <cstdlib>
+
+namespace ColorConsole
+{
+
+//////////////////////////////////////////////////////////////////////////
+// Palette
+//
+
+/**
+ * RGB components of the 16 basic colors (xterm defaults), in ANSI order.
+ */
+static constexpr std::uint8_t BASIC_PALETTE[16][3] =
+{
+    {   0,   0,   0 }, { 205,   0,   0 }, {   0, 205,   0 }, { 205, 205,   0 },
+    {   0,   0, 238 }, { 205,   0, 205 }, {   0, 205, 205 }, { 229, 229, 229 },
+    { 127, 127, 127 }, { 255,   0,   0 }, {   0, 255,   0 }, { 255, 255,   0 },
+    {  92,  92, 255 }, { 255,   0, 255 }, {   0, 255, 255 }, { 255, 255, 255 }
+};
+
+/**
+ * Intensity levels of the 6x6x6 color cube of the 256-color palette.
+ */
+static constexpr std::uint8_t CUBE_LEVELS[6] = { 0, 95, 135, 175, 215, 255 };
+
+void sgrPaletteRgb( std::uint8_t index, std::uint8_t &red, std::uint8_t &green, std::uint8_t &blue ) noexcept
+{
+    if( index < 16 )
+    {
+        red = BASIC_PALETTE[index][0];
+        green = BASIC_PALETTE[index][1];
+        blue = BASIC_PALETTE[index][2];
+    }
+    else if( index < 232 )
+    {
+        const unsigned int cube = index - 16u;
+        red = CUBE_LEVELS[cube / 36];
+        green = CUBE_LEVELS[( cube / 6 ) % 6];
+        blue = CUBE_LEVELS[cube % 6];
+    }
+    else
+    {
+        red = green = blue = static_cast<std::uint8_t>( 8 + ( index - 232 ) * 10 );
+    }
+}
+
+/**
+ * Returns the index of the color of the 256-color palette (excluding the basic colors) nearest to an RGB
+ * color.
+ */
+static std::uint8_t nearestPaletteColor( std::uint8_t red, std::uint8_t green, std::uint8_t blue ) noexcept
+{
+    auto nearestLevel = []( std::uint8_t value ) noexcept
+    {
+        unsigned int level = 0;
+        for( unsigned int i = 1; i < 6; i++ )
+        {
+            if( std::abs( int( value ) - CUBE_LEVELS[i] ) < std::abs( int( value ) - CUBE_LEVELS[level] ) )
+            {
+                level = i;
+            }
+        }
+        return level;
+    };
+
+    auto distance = []( std::uint8_t index, std::uint8_t r, std::uint8_t g, std::uint8_t b ) noexcept
+    {
+        std::uint8_t pr, pg, pb;
+        sgrPaletteRgb( index, pr, pg, pb );
+        return ( long( r ) - pr ) * ( long( r ) - pr ) + ( long( g ) - pg ) * ( long( g ) - pg ) + ( long( b ) - pb ) * ( long( b ) - pb );
+    };
+
+    const std::uint8_t cube = static_cast<std::uint8_t>( 16 + 36 * nearestLevel( red ) + 6 * nearestLevel( green ) + nearestLevel( blue ) );
+
+    const int average = ( int( red ) + int( green ) + int( blue ) ) / 3;
+    const int greyStep = ( average < 8 ) ? 0 : ( average > 238 ) ? 23 : ( ( average - 8 + 5 ) / 10 );
+    const std::uint8_t grey = static_cast<std::uint8_t>( 232 + ( ( greyStep > 23 ) ? 23 : greyStep ) );
+
+    return ( distance( grey, red, green, blue ) < distance( cube, red, green, blue ) ) ? grey : cube;
+}
+
+/**
+ * Returns the index (in ANSI order) of the basic color nearest to an RGB color.
+ */
+static unsigned int nearestBasicColor( std::uint8_t red, std::uint8_t green, std::uint8_t blue ) noexcept
+{
+    unsigned int nearest = 0;
+    long nearestDistance = -1;
+
+    for( unsigned int i = 0; i < 16; i++ )
+    {
+        const long dr = long( red ) - BASIC_PALETTE[i][0];
+        const long dg = long( green ) - BASIC_PALETTE[i][1];
+        const long db = long( blue ) - BASIC_PALETTE[i][2];
+        const long distance = dr * dr + dg * dg + db * db;
+
+        if( ( nearestDistance < 0 ) || ( distance < nearestDistance ) )
+        {
+            nearest = i;
+            nearestDistance = distance;
+        }
+    }
+
+    return nearest;
+}
+
+/**
+ * Converts between ANSI color order (red in bit 0, blue in bit 2) and Color order (blue in bit 0, red in
+ * bit 2). The conversion is its own inverse.
+ */
+static constexpr unsigned int swapRedBlue( unsigned int index ) noexcept
+{
+    return ( ( index & 1u ) << 2 ) | ( index & 2u ) | ( ( index & 4u ) >> 2 ) | ( index & 8u );
+}
+
+/**
+ * Returns the index (in ANSI order) of the basic color nearest to a color that is not the default one.
+ */
+static unsigned int basicColorIndex( const SgrColor &color ) noexcept
+{
+    if( ( color.kind == SgrColor::Kind::INDEXED ) && ( color.index < 16 ) )
+    {
+        return color.index;
+    }
+
+    std::uint8_t red = color.red;
+    std::uint8_t green = color.green;
+    std::uint8_t blue = color.blue;
+
+    if( color.kind == SgrColor::Kind::INDEXED )
+    {
+        sgrPaletteRgb( color.index, red, green, blue );
+    }
+
+    return nearestBasicColor( red, green, blue );
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Style
+//
+
+Color SgrStyle::to_color() const noexcept
+{
+    if( ( foreground.kind == SgrColor::Kind::DEFAULT ) && ( background.kind == SgrColor::Kind::DEFAULT ) )
+    {
+        return Color::RESET;
+    }
+
+    unsigned int fg = static_cast<unsigned int>( Color::FG_LIGHT_GREY );
+
+    if( foreground.kind != SgrColor::Kind::DEFAULT )
+    {
+        unsigned int index = basicColorIndex( foreground );
+
+        // Bold basic colors are rendered as (and emitted by the library for) light colors
+        if( ( foreground.kind == SgrColor::Kind::INDEXED ) && ( foreground.index < 8 ) && ( attributes & SGR_BOLD ) )
+        {
+            index |= 8u;
+        }
+
+        fg = swapRedBlue( index );
+    }
+
+    unsigned int bg = 0;
+
+    if( background.kind != SgrColor::Kind::DEFAULT )
+    {
+        const unsigned int index = basicColorIndex( background );
+
+        bg = ( index == 0 ) ? static_cast<unsigned int>( Color::BG_BLACK ) : ( swapRedBlue( index ) << 4 );
+    }
+
+    return static_cast<Color>( bg | fg );
+}
+
+SgrStyle SgrStyle::from_color( Color color ) noexcept
+{
+    SgrStyle style;
+
+    if( color >= Color::RESET )
+    {
+        return style;
+    }
+
+    const unsigned int fg = swapRedBlue( foregroundIndex( color ) );
+
+    style.foreground = SgrColor::indexed( static_cast<std::uint8_t>( fg & 7u ) );
+    if( fg & 8u )
+    {
+        style.attributes = SGR_BOLD;
+    }
+
+    const unsigned int bg = backgroundIndex( color );
+
+    if( bg != 0 )
+    {
+        style.background = SgrColor::indexed( static_cast<std::uint8_t>( swapRedBlue( bg ) ) );
+    }
+    else if( static_cast<unsigned int>( color ) & static_cast<unsigned int>( Color::BG_BLACK ) )
+    {
+        style.background = SgrColor::indexed( 0 );
+    }
+
+    return style;
+}
+
+/**
+ * Parses an extended color (parameters following 38, 48 or 58).
+ *
+ * Supports the semicolon forms (<tt>5;n</tt> and <tt>2;r;g;b</tt>) and the colon forms (<tt>5:n</tt>,
+ * <tt>2:r:g:b</tt> and <tt>2:cs:r:g:b</tt>).
+ *
+ * @return The number of parameters consumed
+ */
+static std::size_t parseExtendedColor( const std::uint16_t *parameters, std::uint32_t subparameters,
+                                       std::size_t count, std::size_t pos, SgrColor &color, bool &valid ) noexcept
+{
+    valid = false;
+
+    auto isSubparameter = [subparameters]( std::size_t i ) { return ( ( subparameters >> i ) & 1u ) != 0; };
+    auto component = []( std::uint16_t value ) { return static_cast<std::uint8_t>( ( value > 255 ) ? 255 : value ); };
+
+    if( isSubparameter( pos ) )
+    {
+        std::size_t end = pos;
+        while( ( end < count ) && isSubparameter( end ) )
+        {
+            end++;
+        }
+
+        const std::size_t groupSize = end - pos;
+
+        if( ( groupSize >= 2 ) && ( parameters[pos] == 5 ) )
+        {
+            color = SgrColor::indexed( component( parameters[pos + 1] ) );
+            valid = true;
+        }
+        else if( ( groupSize >= 4 ) && ( parameters[pos] == 2 ) )
+        {
+            const std::size_t rgb = ( groupSize >= 5 ) ? ( pos + 2 ) : ( pos + 1 );
+            color = SgrColor::rgb( component( parameters[rgb] ), component( parameters[rgb + 1] ),
+                                   component( parameters[rgb + 2] ) );
+            valid = true;
+        }
+
+        return groupSize;
+    }
+
+    if( ( pos < count ) && ( parameters[pos] == 5 ) )
+    {
+        if( pos + 1 < count )
+        {
+            color = SgrColor::indexed( component( parameters[pos + 1] ) );
+            valid = true;
+        }
+        return 2;
+    }
+
+    if( ( pos < count ) && ( parameters[pos] == 2 ) )
+    {
+        if( pos + 3 < count )
+        {
+            color = SgrColor::rgb( component( parameters[pos + 1] ), component( parameters[pos + 2] ),
+                                   component( parameters[pos + 3] ) );
+            valid = true;
+        }
+        return 4;
+    }
+
+    return 0;
+}
+
+void SgrStyle::apply( const std::uint16_t *parameters, std::uint32_t subparameters, std::size_t count ) noexcept
+{
+    auto isSubparameter = [subparameters]( std::size_t i ) { return ( ( subparameters >> i ) & 1u ) != 0; };
+
+    std::size_t i = 0;
+
+    while( i < count )
+    {
+        const unsigned int code = parameters[i++];
+
+        switch( code )
+        {
+            case 0: *this = SgrStyle(); break;
+            case 1: attributes |= SGR_BOLD; break;
+            case 2: attributes |= SGR_DIM; break;
+            case 3: attributes |= SGR_ITALIC; break;
+            case 4:
+                // Underline styles (4:0 disables underline, 4:1 to 4:5 are underline variants)
+                if( ( i < count ) && isSubparameter( i ) && ( parameters[i] == 0 ) )
+                {
+                    attributes &= static_cast<std::uint8_t>( ~SGR_UNDERLINE );
+                }
+                else
+                {
+                    attributes |= SGR_UNDERLINE;
+                }
+                break;
+            case 5:
+            case 6: attributes |= SGR_BLINK; break;
+            case 7: attributes |= SGR_INVERSE; break;
+            case 8: attributes |= SGR_HIDDEN; break;
+            case 9: attributes |= SGR_STRIKE; break;
+            case 21: attributes |= SGR_UNDERLINE; break;
+            case 22: attributes &= static_cast<std::uint8_t>( ~( SGR_BOLD | SGR_DIM ) ); break;
+            case 23: attributes &= static_cast<std::uint8_t>( ~SGR_ITALIC ); break;
+            case 24: attributes &= static_cast<std::uint8_t>( ~SGR_UNDERLINE ); break;
+            case 25: attributes &= static_cast<std::uint8_t>( ~SGR_BLINK ); break;
+            case 27: attributes &= static_cast<std::uint8_t>( ~SGR_INVERSE ); break;
+            case 28: attributes &= static_cast<std::uint8_t>( ~SGR_HIDDEN ); break;
+            case 29: attributes &= static_cast<std::uint8_t>( ~SGR_STRIKE ); break;
+            case 39: foreground = SgrColor(); break;
+            case 49: background = SgrColor(); break;
+
+            case 38:
+            case 48:
+            case 58:
+            {
+                SgrColor color;
+                bool valid;
+
+                i += parseExtendedColor( parameters, subparameters, count, i, color, valid );
+
+                if( valid && ( code == 38 ) )
+                {
+                    foreground = color;
+                }
+                else if( valid && ( code == 48 ) )
+                {
+                    background = color;
+                }
+                // Underline colors (58) are not tracked
+                break;
+            }
+
+            default:
+                if( ( code >= 30 ) && ( code <= 37 ) )
+                {
+                    foreground = SgrColor::indexed( static_cast<std::uint8_t>( code - 30 ) );
+                }
+                else if( ( code >= 40 ) && ( code <= 47 ) )
+                {
+                    background = SgrColor::indexed( static_cast<std::uint8_t>( code - 40 ) );
+                }
+                else if( ( code >= 90 ) && ( code <= 97 ) )
+                {
+                    foreground = SgrColor::indexed( static_cast<std::uint8_t>( code - 90 + 8 ) );
+                }
+                else if( ( code >= 100 ) && ( code <= 107 ) )
+                {
+                    background = SgrColor::indexed( static_cast<std::uint8_t>( code - 100 + 8 ) );
+                }
+                // Other codes (fonts, frames, overline...) are ignored
+                break;
+        }
+
+        // Skip subparameters not consumed by the code
+        while( ( i < count ) && isSubparameter( i ) )
+        {
+            i++;
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Rendering
+//
+
+/**
+ * Bounded builder of SGR sequences.
+ */
+struct SgrSequenceBuilder
+{
+    SgrSequence &sequence;
+
+    void append( std::string_view str ) noexcept
+    {
+        const std::size_t n = ( str.size() < SGR_SEQUENCE_MAX_LENGTH - sequence.length ) ? str.size() : ( SGR_SEQUENCE_MAX_LENGTH - sequence.length );
+        std::memcpy( sequence.text + sequence.length, str.data(), n );
+        sequence.length += n;
+    }
+
+    void append_parameter( unsigned int value ) noexcept
+    {
+        char digits[4];
+        std::size_t n = 0;
+
+        do
+        {
+            digits[3 - n++] = static_cast<char>( '0' + value % 10 );
+            value /= 10;
+        } while( ( value > 0 ) && ( n < 4 ) );
+
+        // The first parameter follows the CSI without separator
+        if( sequence.text[sequence.length - 1] != '[' )
+        {
+            append( ";" );
+        }
+        append( std::string_view( digits + 4 - n, n ) );
+    }
+
+    void append_color( const SgrColor &color, bool foreground, ColorCapability capability ) noexcept
+    {
+        if( color.kind == SgrColor::Kind::DEFAULT )
+        {
+            return;
+        }
+
+        if( ( color.kind == SgrColor::Kind::INDEXED ) && ( color.index < 16 ) )
+        {
+            const unsigned int base = ( color.index < 8 ) ? ( foreground ? 30u : 40u ) : ( foreground ? 90u - 8u : 100u - 8u );
+            append_parameter( base + color.index );
+            return;
+        }
+
+        append_parameter( foreground ? 38u : 48u );
+
+        if( ( color.kind == SgrColor::Kind::RGB ) && ( capability == ColorCapability::TRUE_COLOR ) )
+        {
+            append_parameter( 2 );
+            append_parameter( color.red );
+            append_parameter( color.green );
+            append_parameter( color.blue );
+        }
+        else
+        {
+            append_parameter( 5 );
+            append_parameter( ( color.kind == SgrColor::Kind::RGB ) ? nearestPaletteColor( color.red, color.green, color.blue ) : color.index );
+        }
+    }
+};
+
+/**
+ * SGR codes that set the attributes, and the codes that reset them.
+ */
+static constexpr struct
+{
+    std::uint8_t attribute;
+    unsigned int code;
+    unsigned int resetCode;
+} ATTRIBUTE_CODES[] =
+{
+    { SGR_BOLD, 1, 22 }, { SGR_DIM, 2, 22 }, { SGR_ITALIC, 3, 23 }, { SGR_UNDERLINE, 4, 24 },
+    { SGR_BLINK, 5, 25 }, { SGR_INVERSE, 7, 27 }, { SGR_HIDDEN, 8, 28 }, { SGR_STRIKE, 9, 29 }
+};
+
+SgrSequence sgrSequence( const SgrStyle &style, ColorCapability capability ) noexcept
+{
+    SgrSequence sequence;
+    SgrSequenceBuilder builder { sequence };
+
+    if( capability == ColorCapability::NONE )
+    {
+        return sequence;
+    }
+
+    if( capability == ColorCapability::BASIC )
+    {
+        builder.append( ansiEscape( style.to_color() ).view() );
+        return sequence;
+    }
+
+    // The leading 0 resets the previous style
+    builder.append( "\033[0" );
+
+    for( const auto &attributeCode : ATTRIBUTE_CODES )
+    {
+        if( style.attributes & attributeCode.attribute )
+        {
+            builder.append_parameter( attributeCode.code );
+        }
+    }
+
+    builder.append_color( style.foreground, true, capability );
+    builder.append_color( style.background, false, capability );
+    builder.append( "m" );
+
+    return sequence;
+}
+
+SgrSequence sgrTransition( const SgrStyle &from, const SgrStyle &to, ColorCapability capability ) noexcept
+{
+    if( capability == ColorCapability::BASIC )
+    {
+        return ( from.to_color() == to.to_color() ) ? SgrSequence() : sgrSequence( to, capability );
+    }
+
+    if( ( capability == ColorCapability::NONE ) || ( from == to ) )
+    {
+        return SgrSequence();
+    }
+
+    const SgrSequence absolute = sgrSequence( to, capability );
+
+    // Relative sequence: only the attributes and colors that change
+    SgrSequence relative;
+    SgrSequenceBuilder builder { relative };
+    builder.append( "\033[" );
+
+    const std::uint8_t removed = from.attributes & ~to.attributes;
+    std::uint8_t added = to.attributes & ~from.attributes;
+
+    if( removed & ( SGR_BOLD | SGR_DIM ) )
+    {
+        // Bold and dim are reset together
+        added |= to.attributes & ( SGR_BOLD | SGR_DIM );
+    }
+
+    for( const auto &attributeCode : ATTRIBUTE_CODES )
+    {
+        if( ( removed & attributeCode.attribute ) && !( ( attributeCode.attribute == SGR_DIM ) && ( removed & SGR_BOLD ) ) )
+        {
+            builder.append_parameter( attributeCode.resetCode );
+        }
+    }
+
+    for( const auto &attributeCode : ATTRIBUTE_CODES )
+    {
+        if( added & attributeCode.attribute )
+        {
+            builder.append_parameter( attributeCode.code );
+        }
+    }
+
+    if( !( from.foreground == to.foreground ) )
+    {
+        if( to.foreground.kind == SgrColor::Kind::DEFAULT )
+        {
+            builder.append_parameter( 39 );
+        }
+        builder.append_color( to.foreground, true, capability );
+    }
+
+    if( !( from.background == to.background ) )
+    {
+        if( to.background.kind == SgrColor::Kind::DEFAULT )
+        {
+            builder.append_parameter( 49 );
+        }
+        builder.append_color( to.background, false, capability );
+    }
+
+    builder.append( "m" );
+
+    return ( relative.length < absolute.length ) ? relative : absolute;
+}
+
+} // namespace
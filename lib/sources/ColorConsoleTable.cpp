@@ -0,0 +1,466 @@
+/**
+ * @file
+ * @brief      Implementation of the ColorConsole table renderer
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsoleTable.hpp"
+#include "ColorConsoleAnsi.hpp"
+#include "ColorConsoleUtf8.hpp"
+#include "ColorConsoleWidth.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace ColorConsole
+{
+
+/**
+ * Characters used to draw the borders.
+ */
+struct BorderGlyphs
+{
+    std::string_view horizontal;
+    std::string_view vertical;
+    std::string_view rules[3][3];   // Left, middle and right joints of the top, middle and bottom rules
+};
+
+static constexpr BorderGlyphs ASCII_GLYPHS =
+{
+    "-", "|", { { "+", "+", "+" }, { "+", "+", "+" }, { "+", "+", "+" } }
+};
+
+static constexpr BorderGlyphs BOX_GLYPHS =
+{
+    "─", "│", { { "┌", "┬", "┐" }, { "├", "┼", "┤" }, { "└", "┴", "┘" } }
+};
+
+static constexpr std::string_view ELLIPSIS = "…";
+static constexpr std::string_view ASCII_ELLIPSIS = "~";
+
+static constexpr bool isControl( char32_t c ) noexcept
+{
+    return ( c < 0x20 ) || ( ( c >= 0x7F ) && ( c < 0xA0 ) );
+}
+
+/**
+ * Indicates if a text only contains printable ASCII characters.
+ */
+static bool isPrintableAscii( std::string_view text ) noexcept
+{
+    return printableAsciiPrefix( text.data(), text.data() + text.size() ) == text.size();
+}
+
+/**
+ * Indicates if the output supports Unicode characters: on Windows the consoles are switched to UTF-8 when
+ * initialized, and on other systems the encoding is taken from the locale environment variables.
+ */
+static bool isUnicodeOutput() noexcept
+{
+#ifdef WIN32
+    return true;
+#else
+    for( const char *name : { "LC_ALL", "LC_CTYPE", "LANG" } )
+    {
+        const char *value = std::getenv( name );
+
+        if( ( value != nullptr ) && ( *value != '\0' ) )
+        {
+            const std::string_view locale( value );
+            return ( locale.find( "UTF-8" ) != locale.npos ) || ( locale.find( "utf-8" ) != locale.npos ) ||
+                   ( locale.find( "UTF8" ) != locale.npos ) || ( locale.find( "utf8" ) != locale.npos );
+        }
+    }
+
+    return false;
+#endif
+}
+
+/**
+ * Appends the text of a cell as written: control characters are replaced by spaces and invalid UTF-8 sequences by
+ * the replacement character.
+ */
+static void appendCellText( std::string &buffer, std::string_view text )
+{
+    if( isPrintableAscii( text ) )
+    {
+        buffer.append( text );
+        return;
+    }
+
+    const char *p = text.data();
+    const char *end = p + text.size();
+
+    while( p < end )
+    {
+        const char *start = p;
+        const char32_t c = decodeUtf8( p, end );
+
+        if( isControl( c ) )
+        {
+            buffer.push_back( ' ' );
+        }
+        else if( c == REPLACEMENT_CHARACTER )
+        {
+            appendUtf8( buffer, c );
+        }
+        else
+        {
+            buffer.append( start, static_cast<std::size_t>( p - start ) );
+        }
+    }
+}
+
+/**
+ * Returns the background bits of a color.
+ */
+static constexpr unsigned int backgroundBits( Color color ) noexcept
+{
+    return ( color >= Color::RESET ) ? 0 : ( static_cast<unsigned int>( color ) & ( 0xF0u | static_cast<unsigned int>( Color::BG_BLACK ) ) );
+}
+
+Table::Table( Console &console, std::vector<TableColumn> columns )
+: m_console( console ), m_columns( std::move( columns ) ), m_borders( TableBorders::NONE ), m_borderColor( Color::RESET ),
+  m_headerColor( Color::RESET ), m_sampleRows( 0 ), m_ansi( console.uses_ansi_coloring() ), m_unicode( isUnicodeOutput() ), m_hasHeader( false ),
+  m_widthsFixed( false ), m_finished( false ), m_lineColor( Color::RESET ), m_escapeCacheNext( 0 )
+{
+    m_widths.reserve( m_columns.size() );
+
+    for( const TableColumn &column : m_columns )
+    {
+        std::size_t width = std::max<std::size_t>( column.minWidth, 1 );
+
+        if( !column.title.empty() )
+        {
+            std::string title;
+            appendCellText( title, column.title );
+            width = std::max( width, display_width( title ) );
+            m_hasHeader = true;
+        }
+
+        if( column.maxWidth > 0 )
+        {
+            width = std::min( width, std::max<std::size_t>( column.maxWidth, 1 ) );
+        }
+
+        m_widths.push_back( width );
+    }
+
+    m_rowCells.resize( m_columns.size() );
+}
+
+Table::~Table()
+{
+    finish();
+}
+
+void Table::add_row( std::span<const TableCell> cells )
+{
+    if( m_widthsFixed )
+    {
+        reserve_row_text( cells );
+
+        for( std::size_t i = 0; i < m_columns.size(); i++ )
+        {
+            const TableCell cell = ( i < cells.size() ) ? cells[i] : TableCell();
+            RowCell &rowCell = m_rowCells[i];
+            rowCell.text = row_text( cell.text );
+            rowCell.width = display_width( rowCell.text );
+            rowCell.color = cell.color;
+        }
+
+        write_row( m_rowCells.data(), false );
+        return;
+    }
+
+    for( std::size_t i = 0; i < m_columns.size(); i++ )
+    {
+        const TableCell cell = ( i < cells.size() ) ? cells[i] : TableCell();
+        const std::size_t offset = m_heldText.size();
+        appendCellText( m_heldText, cell.text );
+        const std::size_t length = m_heldText.size() - offset;
+        const std::size_t width = display_width( std::string_view( m_heldText ).substr( offset, length ) );
+
+        m_heldCells.push_back( HeldCell{ offset, length, width, cell.color } );
+
+        const std::size_t maxWidth = m_columns[i].maxWidth;
+        m_widths[i] = std::max( m_widths[i], ( maxWidth > 0 ) ? std::min( width, maxWidth ) : width );
+    }
+
+    if( ( m_sampleRows > 0 ) && ( m_heldCells.size() >= m_sampleRows * m_columns.size() ) )
+    {
+        fix_widths();
+    }
+}
+
+void Table::finish()
+{
+    if( m_finished )
+    {
+        return;
+    }
+
+    if( !m_widthsFixed )
+    {
+        fix_widths();
+    }
+
+    if( m_borders != TableBorders::NONE )
+    {
+        write_rule( Rule::BOTTOM );
+    }
+
+    m_console.flush();
+    m_finished = true;
+}
+
+void Table::fix_widths()
+{
+    m_widthsFixed = true;
+
+    // Room for the longest row that fits in the columns (text of up to 4 bytes per column, a color change per
+    // cell and border) so that the line buffer is not reallocated while writing
+    std::size_t lineSize = 0;
+    for( std::size_t width : m_widths )
+    {
+        lineSize += width * 4 + 8 + 2 * ANSI_ESCAPE_MAX_LENGTH;
+    }
+    m_line.reserve( lineSize + ANSI_ESCAPE_MAX_LENGTH + 8 );
+
+    if( m_borders != TableBorders::NONE )
+    {
+        write_rule( Rule::TOP );
+    }
+
+    if( m_hasHeader )
+    {
+        std::size_t titlesSize = 0;
+        for( const TableColumn &column : m_columns )
+        {
+            titlesSize += column.title.size();
+        }
+        m_rowText.clear();
+        m_rowText.reserve( titlesSize * 3 );
+
+        for( std::size_t i = 0; i < m_columns.size(); i++ )
+        {
+            RowCell &rowCell = m_rowCells[i];
+            rowCell.text = row_text( m_columns[i].title );
+            rowCell.width = display_width( rowCell.text );
+            rowCell.color = m_headerColor;
+        }
+
+        write_row( m_rowCells.data(), true );
+
+        if( m_borders != TableBorders::NONE )
+        {
+            write_rule( Rule::MIDDLE );
+        }
+    }
+
+    write_held_rows();
+}
+
+void Table::write_held_rows()
+{
+    for( std::size_t first = 0; first < m_heldCells.size(); first += m_columns.size() )
+    {
+        for( std::size_t i = 0; i < m_columns.size(); i++ )
+        {
+            const HeldCell &cell = m_heldCells[first + i];
+            m_rowCells[i] = RowCell{ std::string_view( m_heldText ).substr( cell.offset, cell.length ), cell.width, cell.color };
+        }
+
+        write_row( m_rowCells.data(), false );
+    }
+
+    m_heldCells.clear();
+    m_heldCells.shrink_to_fit();
+    m_heldText.clear();
+    m_heldText.shrink_to_fit();
+}
+
+void Table::write_row( const RowCell *cells, bool header )
+{
+    const BorderGlyphs *glyphs = ( m_borders == TableBorders::NONE ) ? nullptr :
+                                 ( ( m_borders == TableBorders::BOX ) && m_unicode ) ? &BOX_GLYPHS : &ASCII_GLYPHS;
+
+    for( std::size_t i = 0; i < m_columns.size(); i++ )
+    {
+        const RowCell &cell = cells[i];
+        const std::size_t columnWidth = m_widths[i];
+        const std::size_t padding = columnWidth - std::min( cell.width, columnWidth );
+        const Color color = header ? m_headerColor : cell.color;
+
+        if( glyphs != nullptr )
+        {
+            set_color( m_borderColor );
+            m_line.append( glyphs->vertical );
+            append_spaces( 1, color );
+        }
+        else if( i > 0 )
+        {
+            append_spaces( 2, Color::RESET );
+        }
+
+        std::size_t before = 0;
+        switch( m_columns[i].alignment )
+        {
+            case TableAlignment::RIGHT:
+                before = padding;
+                break;
+
+            case TableAlignment::CENTER:
+                before = padding / 2;
+                break;
+
+            default:
+                break;
+        }
+
+        append_spaces( before, color );
+        set_color( color );
+        const std::size_t written = append_text( cell, columnWidth );
+
+        append_spaces( columnWidth - before - written + ( ( glyphs != nullptr ) ? 1 : 0 ), color );
+    }
+
+    if( glyphs != nullptr )
+    {
+        set_color( m_borderColor );
+        m_line.append( glyphs->vertical );
+    }
+    else if( backgroundBits( m_lineColor ) == 0 )
+    {
+        // Trailing spaces at the end of a line without borders are only needed to show a background
+        while( !m_line.empty() && ( m_line.back() == ' ' ) )
+        {
+            m_line.pop_back();
+        }
+    }
+
+    flush_line();
+}
+
+void Table::write_rule( Rule rule )
+{
+    const BorderGlyphs &glyphs = ( ( m_borders == TableBorders::BOX ) && m_unicode ) ? BOX_GLYPHS : ASCII_GLYPHS;
+    const std::string_view *joints = glyphs.rules[static_cast<int>( rule )];
+
+    set_color( m_borderColor );
+    m_line.append( joints[0] );
+
+    for( std::size_t i = 0; i < m_columns.size(); i++ )
+    {
+        for( std::size_t n = m_widths[i] + 2; n > 0; n-- )
+        {
+            m_line.append( glyphs.horizontal );
+        }
+        m_line.append( ( i + 1 < m_columns.size() ) ? joints[1] : joints[2] );
+    }
+
+    flush_line();
+}
+
+void Table::set_color( Color color )
+{
+    if( color >= Color::RESET )
+    {
+        color = Color::RESET;
+    }
+
+    if( m_ansi && ( color != m_lineColor ) )
+    {
+        // Tables use few colors, so their escape sequences are cached
+        std::size_t i = 0;
+        while( ( i < ESCAPE_CACHE_SIZE ) && ( m_escapeCache[i].color != color ) )
+        {
+            i++;
+        }
+
+        if( i == ESCAPE_CACHE_SIZE )
+        {
+            i = m_escapeCacheNext;
+            m_escapeCacheNext = ( m_escapeCacheNext + 1 ) % ESCAPE_CACHE_SIZE;
+            m_escapeCache[i] = CachedEscape{ color, ansiEscape( color ) };
+        }
+
+        m_line.append( m_escapeCache[i].escape.view() );
+        m_lineColor = color;
+    }
+}
+
+void Table::append_spaces( std::size_t count, Color color )
+{
+    if( count == 0 )
+    {
+        return;
+    }
+
+    if( backgroundBits( color ) != backgroundBits( m_lineColor ) )
+    {
+        set_color( color );
+    }
+
+    m_line.append( count, ' ' );
+}
+
+std::size_t Table::append_text( const RowCell &cell, std::size_t columnWidth )
+{
+    if( cell.width <= columnWidth )
+    {
+        m_line.append( cell.text );
+        return cell.width;
+    }
+
+    // Leave room for the ellipsis
+    const std::string_view prefix = truncate_to_width( cell.text, columnWidth - 1 );
+    m_line.append( prefix );
+    m_line.append( m_unicode ? ELLIPSIS : ASCII_ELLIPSIS );
+
+    return display_width( prefix ) + 1;
+}
+
+void Table::reserve_row_text( std::span<const TableCell> cells )
+{
+    // Each byte is written as up to 3 bytes (invalid bytes as the replacement character), so that the views
+    // returned by row_text() are not invalidated
+    std::size_t size = 0;
+    for( const TableCell &cell : cells )
+    {
+        size += cell.text.size();
+    }
+
+    m_rowText.clear();
+    m_rowText.reserve( size * 3 );
+}
+
+std::string_view Table::row_text( std::string_view text )
+{
+    if( isPrintableAscii( text ) )
+    {
+        return text;
+    }
+
+    const std::size_t offset = m_rowText.size();
+    appendCellText( m_rowText, text );
+    return std::string_view( m_rowText ).substr( offset );
+}
+
+void Table::flush_line()
+{
+    if( m_lineColor != Color::RESET )
+    {
+        m_line.append( ANSI_RESET_SEQUENCE );
+        m_lineColor = Color::RESET;
+    }
+
+    m_line.push_back( '\n' );
+    m_console.write_raw( m_line );
+    m_line.clear();
+}
+
+} // namespace
@@ -0,0 +1,463 @@
+/**
+ * @file
+ * @brief      Implementation of the ColorConsole virtual terminal
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsoleTerminal.hpp"
+#include "ColorConsoleUtf8.hpp"
+#include "ColorConsoleWidth.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ColorConsole
+{
+
+/**
+ * Distance between tab stops.
+ */
+static constexpr std::size_t TAB_WIDTH = 8;
+
+VirtualTerminal::VirtualTerminal( std::size_t columns, std::size_t rows )
+: m_columns( std::max<std::size_t>( columns, 1 ) ), m_rows( std::max<std::size_t>( rows, 1 ) )
+{
+    reset();
+}
+
+void VirtualTerminal::reset()
+{
+    m_cells.assign( m_columns * m_rows, TerminalCell() );
+    m_topRow = 0;
+    m_cursorRow = 0;
+    m_cursorColumn = 0;
+    m_savedRow = 0;
+    m_savedColumn = 0;
+    m_pendingWrap = false;
+    m_autowrap = true;
+    m_cursorVisible = true;
+    m_codepoint = 0;
+    m_pendingBytes = 0;
+    m_parser.reset();
+    m_stats = TerminalStats();
+}
+
+void VirtualTerminal::write( std::string_view text )
+{
+    m_stats.bytes += text.size();
+
+    m_parser.process( text,
+                      [this]( const SgrStyle&, std::string_view run ) { print_text( run ); },
+                      [this]( const CsiSequence &sequence ) { execute( sequence ); } );
+}
+
+std::string VirtualTerminal::get_line( std::size_t row ) const
+{
+    const TerminalCell *cells = m_cells.data() + physical_row( row ) * m_columns;
+    std::size_t length = m_columns;
+
+    while( ( length > 0 ) && ( cells[length - 1].character == U' ' ) )
+    {
+        length--;
+    }
+
+    std::string line;
+    line.reserve( length );
+
+    for( std::size_t column = 0; column < length; column++ )
+    {
+        if( cells[column].character != TERMINAL_WIDE_CONTINUATION )
+        {
+            appendUtf8( line, cells[column].character );
+        }
+    }
+
+    return line;
+}
+
+std::string VirtualTerminal::get_text() const
+{
+    std::string text;
+    std::size_t textLength = 0;
+
+    for( std::size_t row = 0; row < m_rows; row++ )
+    {
+        if( row > 0 )
+        {
+            text.push_back( '\n' );
+        }
+
+        const std::string line = get_line( row );
+        if( !line.empty() )
+        {
+            text.append( line );
+            textLength = text.size();
+        }
+    }
+
+    // Drop the trailing blank rows
+    text.resize( textLength );
+    return text;
+}
+
+VirtualTerminal::int_type VirtualTerminal::overflow( int_type c )
+{
+    if( traits_type::eq_int_type( c, traits_type::eof() ) )
+    {
+        return traits_type::not_eof( c );
+    }
+
+    const char_type ch = traits_type::to_char_type( c );
+    write( std::string_view( &ch, 1 ) );
+
+    return c;
+}
+
+std::streamsize VirtualTerminal::xsputn( const char_type *s, std::streamsize n )
+{
+    write( std::string_view( s, static_cast<std::size_t>( n ) ) );
+
+    return n;
+}
+
+void VirtualTerminal::print_text( std::string_view text )
+{
+    const char *p = text.data();
+    const char *end = p + text.size();
+
+    while( p < end )
+    {
+        const unsigned char c = static_cast<unsigned char>( *p++ );
+
+        if( ( c >= 0x20 ) && ( c < 0x7F ) && ( m_pendingBytes == 0 ) )
+        {
+            p += print_ascii( p - 1, end ) - 1;
+            continue;
+        }
+
+        if( ( c & 0xC0 ) == 0x80 )
+        {
+            // Continuation byte
+            if( m_pendingBytes == 0 )
+            {
+                print( REPLACEMENT_CHARACTER, 1 );
+            }
+            else
+            {
+                m_codepoint = ( m_codepoint << 6 ) | ( c & 0x3F );
+                if( --m_pendingBytes == 0 )
+                {
+                    print( m_codepoint, code_point_width( m_codepoint ) );
+                }
+            }
+            continue;
+        }
+
+        if( m_pendingBytes > 0 )
+        {
+            // Truncated sequence
+            m_pendingBytes = 0;
+            print( REPLACEMENT_CHARACTER, 1 );
+        }
+
+        if( ( c >= 0x20 ) && ( c < 0x7F ) )
+        {
+            print( c, 1 );
+        }
+        else if( ( c >= 0xC2 ) && ( c <= 0xF4 ) )
+        {
+            m_pendingBytes = ( c >= 0xF0 ) ? 3 : ( c >= 0xE0 ) ? 2 : 1;
+            m_codepoint = c & ( 0x3F >> m_pendingBytes );
+        }
+        else if( c >= 0x80 )
+        {
+            print( REPLACEMENT_CHARACTER, 1 );
+        }
+        else if( c == '\n' )
+        {
+            m_stats.controls++;
+            line_feed();
+            m_cursorColumn = 0;
+        }
+        else if( c == '\r' )
+        {
+            m_stats.controls++;
+            m_cursorColumn = 0;
+            m_pendingWrap = false;
+        }
+        else if( c == '\b' )
+        {
+            m_stats.controls++;
+            m_cursorColumn -= ( m_cursorColumn > 0 ) ? 1 : 0;
+            m_pendingWrap = false;
+        }
+        else if( c == '\t' )
+        {
+            m_stats.controls++;
+            m_cursorColumn = std::min( ( m_cursorColumn / TAB_WIDTH + 1 ) * TAB_WIDTH, m_columns - 1 );
+            m_pendingWrap = false;
+        }
+    }
+}
+
+std::size_t VirtualTerminal::print_ascii( const char *text, const char *end )
+{
+    if( m_pendingWrap )
+    {
+        line_feed();
+        m_cursorColumn = 0;
+    }
+
+    // Run of printable ASCII characters up to the end of the row
+    TerminalCell *cells = row_cells( m_cursorRow );
+    const SgrStyle &style = m_parser.get_style();
+    const std::size_t maxLength = std::min( static_cast<std::size_t>( end - text ), m_columns - m_cursorColumn );
+    std::size_t length = 0;
+
+    while( ( length < maxLength ) && ( static_cast<unsigned char>( text[length] ) >= 0x20 ) &&
+           ( static_cast<unsigned char>( text[length] ) < 0x7F ) )
+    {
+        length++;
+    }
+
+    splitWideCharacters( cells, m_columns, m_cursorColumn, m_cursorColumn + length );
+
+    for( std::size_t i = 0; i < length; i++ )
+    {
+        TerminalCell &cell = cells[m_cursorColumn + i];
+        cell.character = static_cast<unsigned char>( text[i] );
+        cell.style = style;
+    }
+
+    m_stats.characters += length;
+    m_cursorColumn += length;
+
+    if( m_cursorColumn == m_columns )
+    {
+        m_cursorColumn = m_columns - 1;
+        m_pendingWrap = m_autowrap;
+    }
+
+    return length;
+}
+
+void VirtualTerminal::print( char32_t character, unsigned int width )
+{
+    if( width == 0 )
+    {
+        // Zero-width code points are combined with the previous character by terminals
+        return;
+    }
+
+    if( m_columns < width )
+    {
+        width = 1;
+    }
+
+    if( m_pendingWrap || ( ( width == 2 ) && m_autowrap && ( m_cursorColumn + 1 == m_columns ) ) )
+    {
+        line_feed();
+        m_cursorColumn = 0;
+    }
+    else if( m_cursorColumn + width > m_columns )
+    {
+        m_cursorColumn = m_columns - width;
+    }
+
+    TerminalCell *cells = row_cells( m_cursorRow );
+    const SgrStyle &style = m_parser.get_style();
+
+    splitWideCharacters( cells, m_columns, m_cursorColumn, m_cursorColumn + width );
+
+    cells[m_cursorColumn].character = character;
+    cells[m_cursorColumn].style = style;
+
+    if( width == 2 )
+    {
+        cells[m_cursorColumn + 1].character = TERMINAL_WIDE_CONTINUATION;
+        cells[m_cursorColumn + 1].style = style;
+    }
+
+    m_stats.characters++;
+
+    if( m_cursorColumn + width < m_columns )
+    {
+        m_cursorColumn += width;
+    }
+    else
+    {
+        m_cursorColumn = m_columns - 1;
+        m_pendingWrap = m_autowrap;
+    }
+}
+
+void VirtualTerminal::line_feed()
+{
+    m_pendingWrap = false;
+
+    if( m_cursorRow + 1 < m_rows )
+    {
+        m_cursorRow++;
+        return;
+    }
+
+    // Scroll up: the top row becomes the new bottom row
+    m_topRow = ( m_topRow + 1 < m_rows ) ? ( m_topRow + 1 ) : 0;
+    erase( m_rows - 1, 0, m_columns - 1 );
+    m_stats.scrolledLines++;
+}
+
+void VirtualTerminal::erase( std::size_t row, std::size_t firstColumn, std::size_t lastColumn )
+{
+    SgrStyle blankStyle;
+    blankStyle.background = m_parser.get_style().background;
+
+    splitWideCharacters( row_cells( row ), m_columns, firstColumn, lastColumn + 1 );
+
+    TerminalCell *cells = row_cells( row ) + firstColumn;
+    const std::size_t count = lastColumn + 1 - firstColumn;
+
+    // The blank cell is replicated by doubling copies, which are vectorized
+    cells[0].character = U' ';
+    cells[0].style = blankStyle;
+
+    for( std::size_t filled = 1; filled < count; filled *= 2 )
+    {
+        std::memcpy( cells + filled, cells, std::min( filled, count - filled ) * sizeof( TerminalCell ) );
+    }
+}
+
+void VirtualTerminal::move_cursor( std::size_t row, std::size_t column ) noexcept
+{
+    m_cursorRow = std::min( row, m_rows - 1 );
+    m_cursorColumn = std::min( column, m_columns - 1 );
+    m_pendingWrap = false;
+}
+
+void VirtualTerminal::execute( const CsiSequence &sequence )
+{
+    if( sequence.privateMarker == '?' )
+    {
+        if( ( sequence.final == 'h' ) || ( sequence.final == 'l' ) )
+        {
+            m_stats.controls++;
+
+            for( std::size_t i = 0; i < sequence.count; i++ )
+            {
+                if( sequence.parameters[i] == 7 )
+                {
+                    m_autowrap = ( sequence.final == 'h' );
+                }
+                else if( sequence.parameters[i] == 25 )
+                {
+                    m_cursorVisible = ( sequence.final == 'h' );
+                }
+            }
+        }
+        return;
+    }
+
+    if( sequence.privateMarker != 0 )
+    {
+        return;
+    }
+
+    const std::size_t n = sequence.get( 0, 1 );
+
+    m_stats.controls++;
+
+    switch( sequence.final )
+    {
+        case 'A':   // CUU
+            move_cursor( m_cursorRow - std::min( n, m_cursorRow ), m_cursorColumn );
+            break;
+
+        case 'B':   // CUD
+            move_cursor( m_cursorRow + n, m_cursorColumn );
+            break;
+
+        case 'C':   // CUF
+            move_cursor( m_cursorRow, m_cursorColumn + n );
+            break;
+
+        case 'D':   // CUB
+            move_cursor( m_cursorRow, m_cursorColumn - std::min( n, m_cursorColumn ) );
+            break;
+
+        case 'E':   // CNL
+            move_cursor( m_cursorRow + n, 0 );
+            break;
+
+        case 'F':   // CPL
+            move_cursor( m_cursorRow - std::min( n, m_cursorRow ), 0 );
+            break;
+
+        case 'G':   // CHA
+            move_cursor( m_cursorRow, n - 1 );
+            break;
+
+        case 'H':   // CUP
+        case 'f':   // HVP
+            move_cursor( n - 1, sequence.get( 1, 1 ) - 1u );
+            break;
+
+        case 'd':   // VPA
+            move_cursor( n - 1, m_cursorColumn );
+            break;
+
+        case 'J':   // ED
+        {
+            const std::uint16_t mode = sequence.get( 0, 0 );
+            const std::size_t firstRow = ( mode == 0 ) ? ( m_cursorRow + 1 ) : 0;
+            const std::size_t endRow = ( mode == 1 ) ? m_cursorRow : m_rows;
+
+            if( mode == 0 )
+            {
+                erase( m_cursorRow, m_cursorColumn, m_columns - 1 );
+            }
+            else if( mode == 1 )
+            {
+                erase( m_cursorRow, 0, m_cursorColumn );
+            }
+
+            for( std::size_t row = firstRow; row < endRow; row++ )
+            {
+                erase( row, 0, m_columns - 1 );
+            }
+
+            m_pendingWrap = false;
+            break;
+        }
+
+        case 'K':   // EL (on the last column with a pending wrap, the last character is erased like in the VT100)
+        {
+            const std::uint16_t mode = sequence.get( 0, 0 );
+            erase( m_cursorRow, ( mode == 0 ) ? m_cursorColumn : 0, ( mode == 1 ) ? m_cursorColumn : ( m_columns - 1 ) );
+            m_pendingWrap = false;
+            break;
+        }
+
+        case 'X':   // ECH
+            erase( m_cursorRow, m_cursorColumn, std::min( m_cursorColumn + n, m_columns ) - 1 );
+            m_pendingWrap = false;
+            break;
+
+        case 's':   // SCOSC
+            m_savedRow = m_cursorRow;
+            m_savedColumn = m_cursorColumn;
+            break;
+
+        case 'u':   // SCORC
+            move_cursor( m_savedRow, m_savedColumn );
+            break;
+
+        default:
+            m_stats.controls--;
+            break;
+    }
+}
+
+} // namespace
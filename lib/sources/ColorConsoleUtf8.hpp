@@ -0,0 +1,150 @@
+/**
+ * @file
+ * @brief      UTF-8 encoding and decoding helpers
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#ifndef COLORCONSOLEUTF8_HPP_
+#define COLORCONSOLEUTF8_HPP_
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && ( _M_IX86_FP >= 2 ) )
+#define COLORCONSOLE_UTF8_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace ColorConsole
+{
+
+/**
+ * Character displayed for invalid UTF-8 sequences.
+ */
+inline constexpr char32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+/**
+ * Appends a code point encoded in UTF-8.
+ */
+inline void appendUtf8( std::string &text, char32_t c )
+{
+    if( c < 0x80 )
+    {
+        text.push_back( static_cast<char>( c ) );
+    }
+    else if( c < 0x800 )
+    {
+        text.push_back( static_cast<char>( 0xC0 | ( c >> 6 ) ) );
+        text.push_back( static_cast<char>( 0x80 | ( c & 0x3F ) ) );
+    }
+    else if( c < 0x10000 )
+    {
+        text.push_back( static_cast<char>( 0xE0 | ( c >> 12 ) ) );
+        text.push_back( static_cast<char>( 0x80 | ( ( c >> 6 ) & 0x3F ) ) );
+        text.push_back( static_cast<char>( 0x80 | ( c & 0x3F ) ) );
+    }
+    else
+    {
+        text.push_back( static_cast<char>( 0xF0 | ( c >> 18 ) ) );
+        text.push_back( static_cast<char>( 0x80 | ( ( c >> 12 ) & 0x3F ) ) );
+        text.push_back( static_cast<char>( 0x80 | ( ( c >> 6 ) & 0x3F ) ) );
+        text.push_back( static_cast<char>( 0x80 | ( c & 0x3F ) ) );
+    }
+}
+
+/**
+ * Decodes the code point at the start of a UTF-8 text and advances past it. Invalid or truncated
+ * sequences are decoded as REPLACEMENT_CHARACTER.
+ *
+ * @param[in,out] p Position in the text (shall be less than @p end)
+ * @param[in] end End of the text
+ */
+inline char32_t decodeUtf8( const char *&p, const char *end ) noexcept
+{
+    const unsigned char c = static_cast<unsigned char>( *p++ );
+
+    if( c < 0x80 )
+    {
+        return c;
+    }
+
+    if( ( c < 0xC2 ) || ( c > 0xF4 ) )
+    {
+        return REPLACEMENT_CHARACTER;
+    }
+
+    unsigned int pendingBytes = ( c >= 0xF0 ) ? 3 : ( c >= 0xE0 ) ? 2 : 1;
+    char32_t codepoint = c & ( 0x3F >> pendingBytes );
+
+    for( ; pendingBytes > 0; pendingBytes-- )
+    {
+        if( ( p == end ) || ( ( static_cast<unsigned char>( *p ) & 0xC0 ) != 0x80 ) )
+        {
+            return REPLACEMENT_CHARACTER;
+        }
+        codepoint = ( codepoint << 6 ) | ( static_cast<unsigned char>( *p++ ) & 0x3F );
+    }
+
+    return codepoint;
+}
+
+/**
+ * Returns the length of the run of printable ASCII characters at the start of a text.
+ */
+inline std::size_t printableAsciiPrefix( const char *begin, const char *end ) noexcept
+{
+    const char *p = begin;
+
+#ifdef COLORCONSOLE_UTF8_SSE2
+    const __m128i below = _mm_set1_epi8( 0x1F );
+    const __m128i above = _mm_set1_epi8( 0x7F );
+
+    for( ; ( end - p ) >= 16; p += 16 )
+    {
+        // Bytes with the high bit set are negative, thus below 0x20
+        const __m128i chunk = _mm_loadu_si128( reinterpret_cast<const __m128i*>( p ) );
+        const __m128i printable = _mm_and_si128( _mm_cmpgt_epi8( chunk, below ), _mm_cmplt_epi8( chunk, above ) );
+        const unsigned int mask = static_cast<unsigned int>( _mm_movemask_epi8( printable ) ) ^ 0xFFFFu;
+        if( mask != 0 )
+        {
+            return static_cast<std::size_t>( p - begin ) + static_cast<std::size_t>( std::countr_zero( mask ) );
+        }
+    }
+#else
+    constexpr std::uint64_t ONES = 0x0101010101010101u;
+    constexpr std::uint64_t HIGH_BITS = 0x8080808080808080u;
+
+    for( ; ( end - p ) >= 8; p += 8 )
+    {
+        std::uint64_t word;
+        std::memcpy( &word, p, sizeof( word ) );
+
+        // High bit set, byte below 0x20 or byte equal to 0x7F (the lowest flagged byte is always exact)
+        const std::uint64_t del = word ^ ( ONES * 0x7F );
+        const std::uint64_t mask = ( word | ( ( word - ONES * 0x20 ) & ~word ) | ( ( del - ONES ) & ~del ) ) & HIGH_BITS;
+        if( mask != 0 )
+        {
+            if constexpr( std::endian::native == std::endian::little )
+            {
+                return static_cast<std::size_t>( p - begin ) + static_cast<std::size_t>( std::countr_zero( mask ) / 8 );
+            }
+            break;
+        }
+    }
+#endif
+
+    for( ; ( p < end ) && ( ( static_cast<unsigned char>( *p ) - 0x20u ) < 0x5Fu ); p++ )
+    {
+    }
+
+    return static_cast<std::size_t>( p - begin );
+}
+
+} // namespace
+
+#endif // header guard
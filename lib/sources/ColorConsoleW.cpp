@@ -39,29 +39,31 @@ int UT_fileno( FILE* _Stream );
 namespace ColorConsole
 {
 
-#ifndef UNIT_TEST
-ConsoleW &wcout = ConsoleW::wcout;
-ConsoleW &wcerr = ConsoleW::wcerr;
+// LCOV_EXCL_START
+ConsoleW& ConsoleW::get_wcout()
+{
+    static ConsoleW console( ConsoleType::STD_OUTPUT, std::wcout );
+    return console;
+}
 
-ConsoleW ConsoleW::wcout( ConsoleType::STD_OUTPUT );
-ConsoleW ConsoleW::wcerr( ConsoleType::STD_ERROR );
-#endif
+ConsoleW& ConsoleW::get_wcerr()
+{
+    static ConsoleW console( ConsoleType::STD_ERROR, std::wcerr );
+    return console;
+}
 
-// LCOV_EXCL_START
 void ConsoleW::Init()
 {
-#if defined(COLORCONSOLE_REQUIRE_INITIALIZATION) && !defined(UNIT_TEST)
-    wcout.initialize();
-    wcerr.initialize();
-#endif
+    static_cast<LazyStreamBuf<wchar_t>*>( get_wcout().m_ownedBuffer )->ensure_initialized();
+    static_cast<LazyStreamBuf<wchar_t>*>( get_wcerr().m_ownedBuffer )->ensure_initialized();
 }
 // LCOV_EXCL_STOP
 
 ConsoleW::ConsoleW( ConsoleType consoleType )
 #ifdef COLORCONSOLE_REQUIRE_INITIALIZATION
-: std::wostream( NULL ), m_coloringEnabled( true )
+: std::wostream( NULL ), m_coloringEnabled( true ), m_currentColor( Color::RESET ), m_ownedBuffer( NULL )
 #else
-: std::wostream( ( consoleType == ConsoleType::STD_ERROR ) ? std::wcerr.rdbuf() : std::wcout.rdbuf() ), m_coloringEnabled( true )
+: std::wostream( ( consoleType == ConsoleType::STD_ERROR ) ? std::wcerr.rdbuf() : std::wcout.rdbuf() ), m_coloringEnabled( true ), m_currentColor( Color::RESET ), m_ownedBuffer( NULL )
 #endif
 {
     m_consoleType = consoleType;
@@ -73,16 +75,40 @@ ConsoleW::ConsoleW( ConsoleType consoleType )
 #ifndef COLORCONSOLE_REQUIRE_INITIALIZATION
     initialize();
 #endif
+
+    attach_stats();
+}
+
+ConsoleW::ConsoleW( ConsoleType consoleType, std::wostream &target )
+: std::wostream( NULL ), m_coloringEnabled( true ), m_currentColor( Color::RESET ), m_ownedBuffer( NULL )
+{
+    m_consoleType = consoleType;
+
+#ifdef WIN32
+    m_handle = INVALID_HANDLE_VALUE;
+#endif
+
+    m_ownedBuffer = new LazyStreamBuf<wchar_t>( target, consoleType, &ConsoleW::initialize_lazily, this );
+    rdbuf( m_ownedBuffer );
+
+    attach_stats();
+}
+
+void ConsoleW::initialize_lazily( void *console )
+{
+    static_cast<ConsoleW*>( console )->initialize();
 }
 
 ConsoleW::ConsoleW( std::wstreambuf *sb, bool enableColoring )
-: std::wostream( sb ), m_coloringEnabled( enableColoring )
+: std::wostream( sb ), m_coloringEnabled( enableColoring ), m_currentColor( Color::RESET ), m_ownedBuffer( NULL )
 {
     m_consoleType = ConsoleType::CUSTOM;
 
 #ifdef WIN32
     m_handle = INVALID_HANDLE_VALUE;
 #endif
+
+    attach_stats();
 }
 
 ConsoleW::~ConsoleW()
@@ -107,6 +133,8 @@ ConsoleW::~ConsoleW()
         setAnsiColor( this, Color::RESET );
     }
 #endif
+
+    delete m_ownedBuffer;
 }
 
 void ConsoleW::initialize()
@@ -115,6 +143,7 @@ void ConsoleW::initialize()
     if( rdbuf() == NULL )
     {
         init( ( m_consoleType == ConsoleType::STD_ERROR ) ? std::wcerr.rdbuf() : std::wcout.rdbuf() );
+        attach_stats();
     }
 #endif
 
@@ -146,6 +175,12 @@ ConsoleW& ConsoleW::operator<<( Color color )
 
 void ConsoleW::set_color( Color color )
 {
+    ProbeTimer timer( COLORCONSOLE_PROBE_ENABLED( color_change ) );
+
+    m_currentColor = color;
+
+    std::size_t escapeSize = 0;
+
     if( m_coloringEnabled )
     {
 #if defined(WIN32) && !defined(COLORCONSOLE_FORCE_ANSI_ESCAPE_CODES)
@@ -164,15 +199,26 @@ void ConsoleW::set_color( Color color )
         }
         else if( m_consoleType == ConsoleType::CUSTOM )
         {
-            setAnsiColor( this, color );
+            const AnsiEscape escape = ansiEscape( color );
+            writeAnsiEscape( this, escape );
+            escapeSize = escape.size();
         }
 #else
         if( m_consoleType <= ConsoleType::CUSTOM )
         {
-            setAnsiColor( this, color );
+            const AnsiEscape escape = ansiEscape( color );
+            writeAnsiEscape( this, escape );
+            escapeSize = escape.size();
         }
 #endif
     }
+
+#ifdef COLORCONSOLE_ENABLE_STATS
+    m_stats.add_color_change( m_coloringEnabled, escapeSize );
+#endif
+
+    COLORCONSOLE_PROBE4( color_change, static_cast<int>( m_consoleType ), static_cast<unsigned int>( color ),
+                         escapeSize, timer.elapsed() );
 }
 
 } // namespace
@@ -0,0 +1,24 @@
+/**
+ * @file
+ * @brief      Definition of the ColorConsoleW global consoles references
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsoleW.hpp"
+
+namespace ColorConsole
+{
+
+// Defined apart from the consoles, so that programs linked statically that only use the accessors (or no console
+// at all) do not construct the consoles at startup.
+
+ConsoleW &ConsoleW::wcout = ConsoleW::get_wcout();
+ConsoleW &ConsoleW::wcerr = ConsoleW::get_wcerr();
+
+ConsoleW &wcout = ConsoleW::get_wcout();
+ConsoleW &wcerr = ConsoleW::get_wcerr();
+
+} // namespace
@@ -0,0 +1,421 @@
+/**
+ * @file
+ * @brief      Implementation of the display width functions
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsoleWidth.hpp"
+#include "ColorConsoleAnsiTokenizer.hpp"
+#include "ColorConsoleUtf8.hpp"
+#include "ColorConsoleWidthTable.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace ColorConsole
+{
+
+/**
+ * Properties of the code points stored in the width table (see tools/GenerateWidthTable.py).
+ */
+enum WidthProperty : unsigned int
+{
+    OTHER,
+    WIDE,
+    CONTROL,
+    EXTEND,
+    EXTEND_WIDE,
+    ZWJ,
+    SPACING_MARK,
+    REGIONAL_INDICATOR,
+    PICTOGRAPHIC,
+    PICTOGRAPHIC_WIDE,
+    HANGUL_L,
+    HANGUL_V,
+    HANGUL_T,
+    HANGUL_SYLLABLE
+};
+
+/**
+ * Width of the code points with each property when they start a grapheme cluster.
+ */
+static constexpr unsigned char PROPERTY_WIDTH[] = { 1, 2, 0, 0, 2, 0, 1, 1, 1, 2, 2, 0, 0, 2 };
+
+static constexpr char32_t MAX_CODE_POINT = 0x10FFFF;
+static constexpr char32_t VARIATION_SELECTOR_16 = 0xFE0F;
+static constexpr char32_t HANGUL_SYLLABLE_FIRST = 0xAC00;
+static constexpr char32_t HANGUL_SYLLABLE_T_COUNT = 28;
+static constexpr unsigned int ESC = 0x1B;
+
+static unsigned int widthProperty( char32_t c ) noexcept
+{
+    constexpr unsigned int INDEX2_MASK = ( 1u << ( WIDTH_TABLE_SHIFT1 - WIDTH_TABLE_SHIFT2 ) ) - 1;
+    constexpr unsigned int LEAF_MASK = ( 1u << WIDTH_TABLE_SHIFT2 ) - 1;
+
+    if( c > MAX_CODE_POINT )
+    {
+        return OTHER;
+    }
+
+    const unsigned int block = WIDTH_TABLE_INDEX1[c >> WIDTH_TABLE_SHIFT1];
+    const unsigned int leaf = WIDTH_TABLE_INDEX2[( block << ( WIDTH_TABLE_SHIFT1 - WIDTH_TABLE_SHIFT2 ) ) |
+                                                 ( ( c >> WIDTH_TABLE_SHIFT2 ) & INDEX2_MASK )];
+    const unsigned int index = ( leaf << WIDTH_TABLE_SHIFT2 ) | ( c & LEAF_MASK );
+
+    return ( WIDTH_TABLE_LEAVES[index >> 1] >> ( ( index & 1 ) * 4 ) ) & 0xF;
+}
+
+/**
+ * Decodes the code point at the start of a wide text and advances past it. Unpaired UTF-16 surrogates are
+ * decoded as REPLACEMENT_CHARACTER.
+ */
+static char32_t decodeWide( const wchar_t *&p, const wchar_t *end ) noexcept
+{
+    const char32_t c = static_cast<char32_t>( static_cast<std::make_unsigned_t<wchar_t>>( *p++ ) );
+
+    if constexpr( sizeof( wchar_t ) == 2 )
+    {
+        if( ( c >= 0xD800 ) && ( c <= 0xDFFF ) )
+        {
+            if( ( c <= 0xDBFF ) && ( p < end ) )
+            {
+                const char32_t low = static_cast<char32_t>( static_cast<std::make_unsigned_t<wchar_t>>( *p ) );
+                if( ( low >= 0xDC00 ) && ( low <= 0xDFFF ) )
+                {
+                    p++;
+                    return 0x10000 + ( ( c - 0xD800 ) << 10 ) + ( low - 0xDC00 );
+                }
+            }
+            return REPLACEMENT_CHARACTER;
+        }
+    }
+
+    return c;
+}
+
+/**
+ * Accumulates the width of the grapheme clusters of a text, up to a maximum width.
+ *
+ * The clusters are split following the rules of UAX #29 (extended grapheme clusters, without the Prepend rule),
+ * and each of them occupies the width of its first code point, but for emoji widened by a variation selector 16
+ * and pairs of regional indicators.
+ */
+class WidthMeter
+{
+public:
+    explicit WidthMeter( std::size_t maxWidth ) noexcept
+    : m_maxWidth( maxWidth )
+    {
+    }
+
+    /**
+     * Indicates if a cluster did not fit (no more text needs to be measured).
+     */
+    bool is_full() const noexcept
+    {
+        return m_full;
+    }
+
+    /**
+     * Adds a code point that ends at @p end of the text.
+     */
+    void add_code_point( char32_t c, std::size_t end ) noexcept
+    {
+        const unsigned int property = widthProperty( c );
+
+        if( m_open && continues_cluster( c, property ) )
+        {
+            if( ( c == VARIATION_SELECTOR_16 ) && ( m_base == PICTOGRAPHIC ) )
+            {
+                m_clusterWidth = 2;
+            }
+            else if( property == REGIONAL_INDICATOR )
+            {
+                m_clusterWidth = 2;
+            }
+
+            m_pictState = ( ( property == EXTEND ) || ( property == EXTEND_WIDE ) ) ? m_pictState :
+                          ( ( property == ZWJ ) && ( m_pictState == 1 ) ) ? 2 :
+                          ( ( property == PICTOGRAPHIC ) || ( property == PICTOGRAPHIC_WIDE ) ) ? 1 : 0;
+            m_riOdd = false;
+            m_clusterEnd = end;
+            set_previous( c, property );
+            return;
+        }
+
+        commit();
+
+        m_open = true;
+        m_base = property;
+        m_clusterWidth = PROPERTY_WIDTH[property];
+        m_clusterEnd = end;
+        m_pictState = ( ( property == PICTOGRAPHIC ) || ( property == PICTOGRAPHIC_WIDE ) ) ? 1 : 0;
+        m_riOdd = ( property == REGIONAL_INDICATOR );
+        set_previous( c, property );
+    }
+
+    /**
+     * Adds a run of @p count (> 0) printable ASCII characters starting at @p start of the text.
+     */
+    void add_ascii_run( std::size_t start, std::size_t count ) noexcept
+    {
+        commit();
+
+        // All but the last character are whole clusters (the last one may be extended by combining marks)
+        const std::size_t whole = count - 1;
+        if( !m_full )
+        {
+            const std::size_t available = m_maxWidth - m_width;
+            if( whole <= available )
+            {
+                m_width += whole;
+                m_fitEnd = start + whole;
+            }
+            else
+            {
+                m_width += available;
+                m_fitEnd = start + available;
+                m_full = true;
+            }
+        }
+
+        m_open = true;
+        m_base = OTHER;
+        m_clusterWidth = 1;
+        m_clusterEnd = start + count;
+        m_pictState = 0;
+        m_riOdd = false;
+        m_previous = OTHER;
+        m_previousCode = 0;
+    }
+
+    /**
+     * Finishes the measure, returning the width of the clusters that fit.
+     */
+    std::size_t finish() noexcept
+    {
+        commit();
+        return m_width;
+    }
+
+    /**
+     * Returns the end of the last cluster that fit.
+     */
+    std::size_t get_fit_end() const noexcept
+    {
+        return m_fitEnd;
+    }
+
+private:
+    bool continues_cluster( char32_t c, unsigned int property ) const noexcept
+    {
+        if( m_previous == CONTROL )
+        {
+            return ( m_previousCode == '\r' ) && ( c == '\n' );
+        }
+
+        switch( property )
+        {
+            case CONTROL:
+                return false;
+
+            case EXTEND:
+            case EXTEND_WIDE:
+            case ZWJ:
+            case SPACING_MARK:
+                return true;
+
+            case HANGUL_L:
+                return ( m_previous == HANGUL_L );
+
+            case HANGUL_V:
+                return ( m_previous == HANGUL_L ) || ( m_previous == HANGUL_V ) ||
+                       ( ( m_previous == HANGUL_SYLLABLE ) && m_previousLv );
+
+            case HANGUL_T:
+                return ( m_previous == HANGUL_V ) || ( m_previous == HANGUL_T ) || ( m_previous == HANGUL_SYLLABLE );
+
+            case HANGUL_SYLLABLE:
+                return ( m_previous == HANGUL_L );
+
+            case PICTOGRAPHIC:
+            case PICTOGRAPHIC_WIDE:
+                return ( m_previous == ZWJ ) && ( m_pictState == 2 );
+
+            case REGIONAL_INDICATOR:
+                return ( m_previous == REGIONAL_INDICATOR ) && m_riOdd;
+
+            default:
+                return false;
+        }
+    }
+
+    void set_previous( char32_t c, unsigned int property ) noexcept
+    {
+        m_previous = property;
+        m_previousCode = c;
+        m_previousLv = ( property == HANGUL_SYLLABLE ) && ( ( ( c - HANGUL_SYLLABLE_FIRST ) % HANGUL_SYLLABLE_T_COUNT ) == 0 );
+    }
+
+    void commit() noexcept
+    {
+        if( !m_open )
+        {
+            return;
+        }
+
+        m_open = false;
+
+        if( m_full )
+        {
+            return;
+        }
+
+        if( m_clusterWidth <= ( m_maxWidth - m_width ) )
+        {
+            m_width += m_clusterWidth;
+            m_fitEnd = m_clusterEnd;
+        }
+        else
+        {
+            m_full = true;
+        }
+    }
+
+    const std::size_t m_maxWidth;
+    std::size_t m_width = 0;
+    std::size_t m_fitEnd = 0;
+    bool m_full = false;
+
+    // Open cluster
+    bool m_open = false;
+    unsigned int m_base = OTHER;
+    unsigned int m_clusterWidth = 0;
+    std::size_t m_clusterEnd = 0;
+    unsigned int m_previous = OTHER;
+    char32_t m_previousCode = 0;
+    bool m_previousLv = false;
+    unsigned int m_pictState = 0;   // 1 after a pictographic and Extend*, 2 after a following ZWJ
+    bool m_riOdd = false;           // Odd number of consecutive regional indicators
+};
+
+/**
+ * Skips the escape sequence at a position of a text (just after its ESC), using the same tokenizer as AnsiStripper
+ * and SgrParser. Control characters embedded in the sequence are measured as text, and the sequence ends before a
+ * character that is not allowed in it (which is measured as text).
+ */
+template<typename CharT>
+static void skipEscapeSequence( WidthMeter &meter, const CharT *begin, const CharT *&p, const CharT *end ) noexcept
+{
+    AnsiTokenizer tokenizer;
+    tokenizer.start_sequence();
+
+    for( ; ( p < end ) && tokenizer.in_sequence(); p++ )
+    {
+        const char32_t c = static_cast<char32_t>( static_cast<std::make_unsigned_t<CharT>>( *p ) );
+        const AnsiTokenizer::Unit unit = tokenizer.advance( c );
+
+        if( unit == AnsiTokenizer::Unit::TEXT )
+        {
+            return;
+        }
+
+        if( unit == AnsiTokenizer::Unit::CONTROL )
+        {
+            meter.add_code_point( c, static_cast<std::size_t>( p + 1 - begin ) );
+        }
+    }
+}
+
+static void measure( WidthMeter &meter, std::string_view text ) noexcept
+{
+    const char *begin = text.data();
+    const char *end = begin + text.size();
+    const char *p = begin;
+
+    while( ( p < end ) && !meter.is_full() )
+    {
+        const unsigned char c = static_cast<unsigned char>( *p );
+
+        if( ( c - 0x20u ) < 0x5Fu )
+        {
+            const std::size_t count = printableAsciiPrefix( p, end );
+            meter.add_ascii_run( static_cast<std::size_t>( p - begin ), count );
+            p += count;
+        }
+        else if( c == ESC )
+        {
+            p++;
+            skipEscapeSequence( meter, begin, p, end );
+        }
+        else
+        {
+            const char32_t codePoint = decodeUtf8( p, end );
+            meter.add_code_point( codePoint, static_cast<std::size_t>( p - begin ) );
+        }
+    }
+}
+
+static void measure( WidthMeter &meter, std::wstring_view text ) noexcept
+{
+    const wchar_t *begin = text.data();
+    const wchar_t *end = begin + text.size();
+    const wchar_t *p = begin;
+
+    while( ( p < end ) && !meter.is_full() )
+    {
+        if( static_cast<std::make_unsigned_t<wchar_t>>( *p ) == ESC )
+        {
+            p++;
+            skipEscapeSequence( meter, begin, p, end );
+        }
+        else
+        {
+            const char32_t codePoint = decodeWide( p, end );
+            meter.add_code_point( codePoint, static_cast<std::size_t>( p - begin ) );
+        }
+    }
+}
+
+unsigned int code_point_width( char32_t c ) noexcept
+{
+    return PROPERTY_WIDTH[widthProperty( c )];
+}
+
+std::size_t display_width( std::string_view text ) noexcept
+{
+    WidthMeter meter( std::numeric_limits<std::size_t>::max() );
+    measure( meter, text );
+    return meter.finish();
+}
+
+std::size_t display_width( std::wstring_view text ) noexcept
+{
+    WidthMeter meter( std::numeric_limits<std::size_t>::max() );
+    measure( meter, text );
+    return meter.finish();
+}
+
+std::string_view truncate_to_width( std::string_view text, std::size_t width ) noexcept
+{
+    WidthMeter meter( width );
+    measure( meter, text );
+    meter.finish();
+    return text.substr( 0, meter.get_fit_end() );
+}
+
+std::wstring_view truncate_to_width( std::wstring_view text, std::size_t width ) noexcept
+{
+    WidthMeter meter( width );
+    measure( meter, text );
+    meter.finish();
+    return text.substr( 0, meter.get_fit_end() );
+}
+
+} // namespace
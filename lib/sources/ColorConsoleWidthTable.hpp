@@ -0,0 +1,362 @@
+/**
+ * @file
+ * @brief      Display width and grapheme cluster properties of the Unicode code points
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ *
+ * Generated by tools/GenerateWidthTable.py from Unicode 14.0.0. Do not edit.
+ */
+
+#ifndef COLORCONSOLEWIDTHTABLE_HPP_
+#define COLORCONSOLEWIDTHTABLE_HPP_
+
+#include <cstdint>
+
+namespace ColorConsole
+{
+
+/**
+ * Three-level table (9120 bytes) of the properties of the code points (4 bits each): the code point bits above
+ * WIDTH_TABLE_SHIFT1 index WIDTH_TABLE_INDEX1, which selects a block of WIDTH_TABLE_INDEX2, which selects a
+ * leaf of WIDTH_TABLE_LEAVES (2 properties per byte, the first one in the low nibble).
+ */
+inline constexpr unsigned int WIDTH_TABLE_SHIFT1 = 10;
+inline constexpr unsigned int WIDTH_TABLE_SHIFT2 = 5;
+
+// Properties: 0 = OTHER, 1 = WIDE, 2 = CONTROL, 3 = EXTEND, 4 = EXTEND_WIDE
+//             5 = ZWJ, 6 = SPACING_MARK, 7 = REGIONAL_INDICATOR, 8 = PICTOGRAPHIC, 9 = PICTOGRAPHIC_WIDE
+//             10 = HANGUL_L, 11 = HANGUL_V, 12 = HANGUL_T, 13 = HANGUL_SYLLABLE
+
+inline constexpr std::uint8_t WIDTH_TABLE_INDEX1[1088] =
+{
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 13, 13, 13, 13, 13, 14, 13, 13, 13, 13,
+    13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 15, 16, 17, 17, 17, 17, 17,
+    17, 17, 17, 17, 17, 18, 19, 19, 19, 19, 19, 19, 19, 19, 20, 21, 22, 19, 23, 24, 25, 26, 27, 28,
+    19, 19, 19, 19, 19, 29, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 30, 31, 13, 13, 13, 13,
+    13, 32, 13, 33, 19, 19, 19, 19, 19, 19, 19, 34, 35, 19, 19, 36, 19, 19, 19, 37, 38, 19, 39, 19,
+    40, 19, 41, 19, 42, 43, 44, 45, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13,
+    13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13,
+    13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 46,
+    13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13,
+    13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13,
+    13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 46, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 47, 48, 48, 48, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19,
+};
+
+inline constexpr std::uint16_t WIDTH_TABLE_INDEX2[1568] =
+{
+    0, 1, 1, 2, 0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    4, 4, 4, 5, 1, 1, 1, 1, 1, 1, 1, 1, 6, 1, 1, 1, 1, 1, 1, 1, 7, 8, 9, 1,
+    10, 1, 11, 12, 1, 1, 13, 14, 15, 16, 17, 1, 1, 18, 1, 19, 20, 21, 22, 1, 23, 1, 24, 25,
+    26, 27, 28, 29, 30, 31, 32, 33, 34, 31, 35, 36, 34, 31, 37, 38, 30, 39, 40, 29, 41, 42, 43, 1,
+    44, 45, 46, 29, 30, 39, 47, 29, 48, 49, 50, 29, 30, 1, 51, 52, 1, 53, 54, 1, 1, 55, 56, 1,
+    57, 58, 1, 59, 60, 61, 62, 1, 1, 63, 64, 65, 66, 1, 1, 1, 67, 67, 67, 68, 68, 69, 70, 70,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 71, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 72, 73, 74, 74, 1, 75, 76, 1,
+    77, 1, 1, 1, 78, 79, 1, 1, 1, 80, 1, 1, 1, 1, 1, 1, 81, 1, 82, 83, 1, 16, 84, 1,
+    85, 86, 87, 88, 89, 90, 1, 91, 1, 92, 1, 1, 1, 1, 93, 94, 1, 1, 1, 1, 1, 1, 4, 4,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 95, 96, 97, 98, 1, 1, 16, 99,
+    1, 100, 1, 1, 101, 102, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 103, 104, 1, 1, 105, 1, 106, 107,
+    1, 1, 1, 1, 1, 1, 108, 1, 1, 1, 1, 1, 1, 109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119,
+    120, 121, 122, 123, 124, 125, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 126, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 127, 1, 128, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 129,
+    1, 1, 1, 130, 1, 1, 1, 4, 1, 1, 1, 1, 131, 132, 132, 133, 132, 132, 132, 132, 132, 132, 134, 135,
+    132, 136, 137, 132, 138, 132, 132, 132, 139, 140, 132, 132, 141, 132, 132, 142, 143, 132, 144, 132, 145, 132, 132, 132,
+    132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
+    132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
+    132, 132, 132, 132, 132, 132, 1, 1, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
+    132, 132, 132, 132, 146, 132, 147, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 148, 149, 1, 1, 150,
+    1, 1, 1, 1, 1, 1, 1, 1, 151, 152, 1, 1, 153, 154, 155, 156, 1, 157, 158, 159, 26, 160, 161, 162,
+    1, 163, 164, 165, 1, 166, 167, 168, 1, 1, 1, 1, 1, 1, 1, 169, 170, 170, 170, 170, 170, 170, 170, 170,
+    170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+    170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+    170, 170, 170, 170, 170, 171, 172, 173, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 174, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 175, 176, 177, 178, 1, 1, 1, 2,
+    137, 132, 132, 179, 1, 1, 1, 180, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 181,
+    1, 1, 1, 1, 1, 1, 1, 182, 1, 1, 1, 183, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 184, 185, 1, 1, 1, 1, 1, 78, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 186, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 187, 1, 1,
+    1, 1, 18, 1, 188, 1, 1, 1, 189, 190, 191, 192, 89, 193, 194, 1, 195, 196, 197, 198, 89, 199, 200, 1,
+    1, 201, 1, 1, 1, 1, 130, 202, 48, 49, 203, 204, 1, 1, 1, 1, 1, 205, 206, 1, 1, 207, 208, 1,
+    1, 1, 1, 1, 1, 209, 210, 1, 1, 211, 182, 1, 1, 212, 1, 1, 71, 213, 1, 1, 1, 1, 1, 1,
+    1, 214, 1, 1, 1, 1, 1, 1, 1, 215, 216, 1, 1, 1, 217, 218, 219, 220, 221, 1, 222, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 223, 1, 1, 224, 225, 1, 1, 1, 226, 227, 1, 228, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 229, 1, 1, 1, 1, 1, 1, 1, 1, 1, 230, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 231,
+    1, 232, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 233, 234, 235, 1, 1, 236, 132, 132, 132, 132, 132, 132, 132, 132,
+    132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 237,
+    132, 132, 132, 132, 132, 132, 134, 1, 238, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 239, 132, 132, 132, 132, 132, 132, 132, 132,
+    132, 240, 241, 242, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 243, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 244, 245, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 4, 246, 191, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 247, 248, 249, 1, 1, 1, 1, 250, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 4, 251, 4, 252, 253, 254, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 255, 256, 1, 1, 1, 1, 1, 1, 1, 232, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 257, 1, 258, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 232, 1,
+    1, 1, 259, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    260, 113, 113, 113, 113, 113, 261, 113, 262, 106, 1, 263, 264, 265, 113, 266, 267, 268, 269, 270, 113, 113, 113, 113,
+    271, 272, 271, 273, 274, 271, 275, 276, 271, 277, 278, 271, 271, 271, 271, 279, 271, 280, 281, 282, 283, 260, 113, 284,
+    271, 271, 285, 1, 271, 271, 286, 287, 1, 1, 1, 288, 1, 1, 289, 290, 291, 1, 292, 1, 293, 294, 113, 113,
+    295, 296, 297, 271, 271, 271, 271, 271, 113, 113, 113, 298, 299, 300, 301, 302, 1, 1, 1, 1, 1, 1, 1, 1,
+    113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 113,
+    113, 113, 113, 113, 113, 113, 113, 303, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
+    132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 304, 0, 4, 4, 4, 0, 0, 0, 0,
+    4, 4, 4, 4, 4, 4, 4, 305, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+inline constexpr std::uint8_t WIDTH_TABLE_LEAVES[4896] =
+{
+    34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 32,
+    0, 0, 0, 0, 128, 0, 0, 8, 0, 0, 0, 0, 0, 0, 0, 0, 51, 51, 51, 51, 51, 51, 51, 51,
+    51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 48, 51, 51, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    48, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 48,
+    48, 3, 51, 48, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 34, 34, 34, 0, 0, 0, 0, 0,
+    51, 51, 51, 51, 51, 3, 2, 0, 0, 0, 0, 0, 0, 48, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51,
+    0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 51, 51, 51, 35, 48, 51, 51, 3, 48, 3, 51, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 32, 48, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 51, 51, 51, 51, 51, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 48, 51, 51,
+    51, 51, 0, 0, 0, 0, 48, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 51, 51, 48, 51, 51,
+    51, 51, 48, 51, 48, 51, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 48, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 34, 0, 0, 0, 51, 51, 51, 51,
+    0, 0, 0, 0, 0, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 50, 51, 51, 51, 51, 51, 51,
+    51, 51, 51, 51, 51, 51, 51, 51, 51, 99, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 99, 3, 102, 54, 51, 51, 51, 99, 102, 54, 102,
+    48, 51, 51, 51, 0, 0, 0, 0, 0, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    48, 102, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 3, 102, 54, 51, 3, 96, 6, 96, 54, 0, 0, 0, 0, 96, 0, 0, 0, 0,
+    0, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 48, 99, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 54, 3, 0, 48, 3, 48, 51, 0, 48, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 51, 0, 48, 0, 0, 0, 0, 0, 54, 51, 51, 48, 99, 96, 54, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 51, 51, 51,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 54, 54, 51, 3, 96, 6, 96, 54, 0,
+    0, 0, 48, 99, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 102, 99, 6, 0, 102, 6, 102, 54, 0,
+    0, 0, 0, 96, 0, 0, 0, 0, 99, 102, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 51, 99, 102, 6, 51, 3, 51, 51, 0,
+    0, 0, 48, 3, 0, 0, 0, 0, 102, 102, 6, 99, 6, 102, 51, 0, 0, 0, 96, 6, 0, 0, 0, 0,
+    51, 102, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 48, 3, 102, 54, 51, 3, 102, 6, 102, 54, 0, 0, 0, 0, 96, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 3, 0, 96, 102, 51, 3, 3, 102, 102, 102, 102, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 102, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 48, 0, 51, 51, 51, 3, 0, 0,
+    0, 0, 0, 48, 51, 51, 51, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    48, 0, 51, 51, 51, 51, 3, 0, 0, 0, 0, 0, 51, 51, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 48, 48, 48, 0, 0, 102, 0, 0, 0, 0, 0, 0, 0, 0, 48, 51, 51, 51, 51, 51, 51, 99,
+    51, 51, 3, 51, 0, 0, 48, 51, 51, 51, 51, 51, 48, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51,
+    51, 51, 51, 51, 51, 51, 3, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 96, 54, 51, 99, 51, 51, 51, 54, 99, 54, 3, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 102, 51, 0, 0, 51, 3, 102, 6, 96, 102, 102, 102, 0, 48, 51, 3, 0, 0, 0, 0, 0,
+    0, 99, 54, 99, 102, 102, 54, 96, 0, 0, 0, 0, 0, 102, 54, 0, 170, 170, 170, 170, 170, 170, 170, 170,
+    170, 170, 170, 170, 170, 170, 170, 170, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187,
+    187, 187, 187, 187, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204,
+    204, 204, 204, 204, 204, 204, 204, 204, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 48, 51,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 51, 99, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 51, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 51, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 51, 54, 51, 51, 51, 102, 102, 102, 102, 99, 54, 51, 51, 51,
+    51, 51, 0, 0, 0, 0, 48, 0, 0, 0, 0, 0, 0, 48, 51, 50, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 48, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 48, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 51, 99, 102, 54, 99, 102, 0, 0, 102, 99, 102, 102, 54, 51, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 48, 99, 54, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 96, 99, 51, 51, 51, 3, 99, 99, 54, 51, 51, 51, 99, 102, 102, 54, 51, 51, 51, 51, 3, 48,
+    51, 51, 51, 51, 51, 51, 51, 3, 0, 0, 0, 0, 0, 0, 0, 0, 51, 51, 6, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 99, 51, 51, 99, 99, 102,
+    102, 99, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 48, 51, 51,
+    51, 51, 0, 0, 0, 0, 0, 0, 51, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    96, 51, 51, 102, 51, 54, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 99, 51, 102, 54, 54,
+    51, 102, 0, 0, 0, 0, 0, 0, 0, 0, 102, 102, 102, 102, 51, 51, 51, 51, 102, 51, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 51, 3, 51, 51, 51, 51, 51, 51, 99, 51, 51, 51, 3, 0, 48, 0,
+    0, 0, 3, 96, 51, 0, 0, 0, 0, 0, 0, 0, 0, 32, 83, 34, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 34, 34, 34, 2, 0, 0, 0, 0, 0, 0, 8, 0, 0, 0, 0, 0, 128, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 34, 34, 2, 34, 34, 34, 34, 34, 0, 0, 0, 0, 0, 0, 0, 0,
+    51, 51, 51, 51, 51, 51, 51, 51, 3, 0, 0, 0, 0, 0, 0, 0, 0, 8, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 136, 136, 136, 0, 0, 0,
+    0, 0, 0, 0, 128, 8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 153, 0, 0, 0, 0, 0, 0, 24, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 128,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 144, 153, 137, 136, 137, 152, 0, 0, 136, 8, 0, 0,
+    0, 8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 136, 0, 0,
+    0, 0, 0, 8, 0, 0, 0, 0, 8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 128, 152, 9, 136, 136, 136, 128, 136, 136, 136, 136,
+    136, 8, 153, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136,
+    136, 136, 136, 136, 153, 153, 153, 153, 153, 153, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136,
+    136, 136, 136, 136, 136, 136, 136, 152, 136, 136, 136, 0, 0, 0, 0, 0, 136, 152, 136, 136, 136, 136, 136, 136,
+    152, 136, 136, 136, 136, 153, 136, 136, 136, 136, 136, 136, 136, 136, 152, 137, 136, 136, 153, 136, 136, 136, 136, 137,
+    136, 136, 137, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 137, 136, 136, 136, 153, 152, 136, 136, 137, 152, 136,
+    136, 136, 152, 0, 136, 153, 136, 136, 136, 8, 8, 8, 0, 0, 128, 0, 128, 0, 0, 0, 9, 0, 0, 0,
+    0, 128, 8, 0, 0, 0, 0, 0, 0, 0, 8, 128, 0, 0, 9, 9, 0, 144, 153, 144, 0, 0, 0, 0,
+    0, 128, 136, 136, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 144, 153, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 9, 0, 0, 0, 0, 0, 0, 144,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 136, 0, 0, 0, 0, 0, 0, 0, 128, 136, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 144, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 9, 0, 144, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 48, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 48, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 16, 17, 17,
+    17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17,
+    17, 17, 0, 0, 0, 0, 0, 0, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 17, 17, 17, 17, 17, 17, 0, 0, 17, 17, 17, 17, 17, 51, 51, 102,
+    25, 17, 17, 17, 17, 17, 145, 1, 16, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17,
+    17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 1, 48, 19, 17, 17, 0, 0, 16, 17, 17, 17, 17, 17,
+    17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 16, 17, 17, 17, 17, 17, 17, 17,
+    17, 17, 17, 17, 17, 17, 17, 1, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 0, 0, 0, 0, 0, 0,
+    17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 1,
+    17, 17, 17, 17, 0, 0, 0, 0, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17,
+    17, 17, 17, 145, 145, 17, 17, 17, 17, 17, 17, 17, 17, 17, 1, 0, 17, 17, 17, 17, 17, 17, 17, 17,
+    17, 17, 17, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 48,
+    51, 3, 51, 51, 51, 51, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 51,
+    0, 0, 0, 0, 0, 0, 0, 0, 51, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 3, 0, 48, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 96, 54, 99, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    102, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 102, 102, 102, 102, 102, 102, 102, 102, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    51, 51, 51, 51, 51, 51, 51, 51, 51, 0, 0, 0, 0, 0, 0, 48, 0, 0, 0, 51, 51, 51, 51, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 48, 51, 51, 51, 51, 51, 102, 0, 0, 0, 0, 0, 0,
+    170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 48, 102, 51, 51, 102, 51, 102, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 48, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 48, 51, 51, 99,
+    54, 99, 54, 3, 0, 0, 0, 0, 0, 48, 0, 0, 0, 0, 99, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 96, 99, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    3, 51, 3, 48, 3, 0, 0, 51, 48, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 96, 51, 102, 0, 0, 96, 3, 0, 0, 0, 0, 0, 96, 54, 102, 99, 6, 54, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221,
+    221, 221, 0, 0, 0, 0, 0, 0, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 43, 34, 194, 204, 204,
+    204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 34, 34,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 51, 51, 51, 51, 51, 51, 51, 51,
+    17, 17, 17, 17, 17, 0, 0, 0, 51, 51, 51, 51, 51, 51, 51, 51, 17, 17, 17, 17, 17, 17, 17, 17,
+    17, 17, 17, 17, 17, 17, 17, 17, 17, 1, 17, 17, 17, 17, 17, 17, 17, 17, 17, 1, 17, 17, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    17, 17, 17, 1, 0, 0, 0, 0, 0, 0, 0, 0, 32, 34, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 48, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 51, 51, 3, 0, 0, 48, 51, 48, 3, 0, 0, 51, 51,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 51, 3, 0, 48,
+    0, 0, 51, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 48, 3, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 51, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    54, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 51, 51, 51, 51, 51, 51, 51, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 3, 48, 3, 0, 0, 0, 0, 48, 0, 0, 0, 0, 0, 0, 0, 0,
+    102, 54, 51, 99, 54, 3, 32, 0, 0, 3, 0, 0, 0, 0, 32, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    51, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 48, 51, 51, 54, 51,
+    51, 51, 3, 0, 0, 0, 0, 0, 0, 0, 96, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 48, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 96, 102, 51, 51, 51, 51, 99, 6, 0, 0, 0, 48, 51, 3, 54, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 102, 54, 51, 102, 99, 51, 0, 0, 0, 3, 102, 54, 51, 51, 51, 3, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 99, 102, 6, 96, 6, 96, 102, 0, 0, 0, 0, 96, 0, 0, 0, 0,
+    0, 102, 0, 51, 51, 51, 3, 0, 51, 51, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 96, 102, 51, 51, 51, 51, 102, 51, 99, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3,
+    0, 0, 0, 0, 0, 0, 0, 0, 102, 54, 51, 51, 99, 99, 102, 54, 99, 51, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 96, 102, 51, 51, 0, 102, 102, 51, 54,
+    3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    102, 54, 51, 51, 51, 99, 54, 54, 0, 0, 0, 0, 0, 48, 54, 102, 51, 51, 51, 54, 0, 0, 0, 0,
+    102, 51, 51, 54, 51, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 102, 54,
+    51, 51, 51, 51, 54, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 102, 102, 102, 96, 6, 48, 99, 3,
+    6, 54, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    96, 102, 51, 51, 0, 51, 102, 102, 3, 0, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    48, 51, 51, 51, 51, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 48, 51, 51, 99, 48, 51, 3, 0, 0, 0, 48, 0, 0, 0, 0, 48, 51, 51, 99, 54, 51, 0, 0,
+    0, 0, 0, 0, 0, 51, 51, 51, 51, 51, 51, 99, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 96,
+    51, 51, 51, 3, 51, 51, 51, 54, 0, 0, 0, 0, 0, 0, 0, 0, 0, 51, 51, 51, 51, 51, 51, 51,
+    51, 51, 51, 51, 96, 51, 51, 51, 99, 51, 54, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    48, 51, 51, 3, 0, 3, 51, 48, 51, 51, 51, 48, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 102, 102, 6, 51, 96, 54, 54, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 48, 99, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 34, 34, 34, 34, 2, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 51, 51, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    51, 51, 51, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 48, 96, 102, 102, 102, 102, 102, 102, 102,
+    102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 0, 0, 0, 48,
+    51, 3, 0, 0, 0, 0, 0, 0, 17, 17, 3, 0, 0, 0, 0, 0, 102, 0, 0, 0, 0, 0, 0, 0,
+    17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 0, 0, 0, 0, 17, 17, 17, 17, 1, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 17, 17, 16, 17, 17, 17, 16, 1,
+    17, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    17, 1, 0, 0, 0, 0, 0, 0, 0, 0, 17, 17, 0, 0, 0, 0, 17, 17, 17, 17, 17, 17, 17, 17,
+    17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 48, 3, 34, 34, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    51, 51, 51, 51, 51, 51, 51, 0, 51, 51, 51, 51, 51, 51, 51, 51, 0, 0, 96, 54, 51, 0, 96, 102,
+    102, 38, 34, 34, 34, 50, 51, 51, 51, 3, 48, 51, 51, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 51, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 51, 3, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 3, 0, 48, 51, 51,
+    51, 51, 51, 51, 51, 51, 3, 0, 0, 0, 48, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 48, 51, 51, 48, 51, 51, 51, 51, 51, 51, 51, 0, 0, 0, 0, 0, 0, 0, 0,
+    51, 51, 51, 3, 51, 51, 51, 51, 51, 51, 51, 51, 3, 48, 51, 51, 51, 48, 3, 51, 51, 3, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 51, 51, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 51, 51, 51, 3, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 136, 136, 137, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136,
+    136, 136, 136, 136, 136, 136, 136, 152, 136, 136, 136, 136, 136, 136, 136, 136, 0, 0, 0, 0, 0, 0, 128, 136,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 136, 136, 136, 0, 0, 0, 0, 0, 0, 136,
+    0, 0, 0, 0, 0, 0, 0, 9, 144, 153, 153, 153, 153, 9, 0, 0, 0, 0, 0, 0, 0, 0, 128, 136,
+    136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 119, 119, 119, 119, 119, 119, 119, 119, 119, 119, 119, 119, 119,
+    145, 137, 136, 136, 136, 136, 136, 136, 17, 17, 17, 17, 17, 25, 17, 17, 17, 17, 17, 17, 17, 17, 17, 145,
+    17, 153, 153, 153, 153, 25, 136, 136, 17, 17, 17, 17, 129, 136, 136, 136, 153, 136, 136, 136, 136, 136, 136, 136,
+    153, 153, 153, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 153, 153, 153, 153, 153, 153, 153, 153,
+    153, 153, 153, 153, 153, 153, 153, 153, 137, 136, 136, 136, 136, 136, 152, 153, 153, 153, 153, 152, 153, 153, 153, 153,
+    153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 137, 153, 153, 153, 153, 153, 153, 153, 153, 153,
+    153, 153, 136, 136, 136, 136, 136, 136, 153, 153, 153, 153, 153, 137, 136, 152, 153, 153, 136, 136, 136, 136, 136, 136,
+    153, 153, 153, 153, 153, 153, 153, 153, 137, 136, 137, 136, 153, 73, 68, 68, 153, 153, 153, 153, 153, 153, 153, 153,
+    153, 153, 153, 153, 153, 153, 153, 137, 137, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153,
+    153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 137, 152, 153, 153, 153, 153, 153, 153, 153, 153,
+    153, 153, 153, 153, 153, 153, 153, 0, 0, 0, 0, 136, 136, 152, 153, 137, 153, 153, 153, 153, 153, 153, 153, 153,
+    153, 153, 153, 153, 136, 136, 136, 136, 136, 136, 136, 136, 136, 137, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136,
+    136, 136, 152, 137, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 152, 153, 153,
+    153, 153, 153, 153, 153, 153, 153, 153, 0, 0, 0, 0, 0, 0, 0, 0, 153, 153, 153, 136, 136, 136, 137, 136,
+    153, 137, 152, 153, 136, 136, 152, 153, 136, 136, 136, 136, 136, 152, 137, 136, 136, 136, 153, 153, 153, 153, 137, 136,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 136, 136, 136, 136, 136, 136, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 128, 136, 136, 136, 136, 136, 153, 153, 153, 153, 153, 153, 136, 136, 137, 136, 136, 136, 136, 136, 136, 136,
+    0, 0, 0, 0, 0, 0, 136, 136, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 136, 136, 136, 136,
+    0, 0, 0, 0, 0, 136, 136, 136, 0, 0, 0, 0, 136, 136, 136, 136, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 136, 136, 136, 136, 136, 136, 136, 136, 136, 0, 0, 0, 0, 0, 0, 153, 153,
+    153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 9, 153, 153,
+    153, 153, 153, 144, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 136, 136, 136, 136, 136, 136, 136, 136,
+    153, 153, 137, 136, 153, 153, 137, 136, 153, 153, 153, 137, 136, 136, 136, 136, 153, 153, 153, 153, 153, 153, 153, 153,
+    153, 153, 153, 153, 153, 153, 137, 136, 153, 153, 153, 153, 153, 137, 136, 136, 153, 153, 153, 136, 136, 136, 136, 136,
+    153, 153, 153, 153, 153, 136, 136, 136, 153, 153, 153, 153, 136, 136, 136, 136, 153, 153, 153, 137, 136, 136, 136, 136,
+    136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 0, 17, 17, 17, 17, 17, 17, 17, 17,
+    17, 17, 17, 17, 17, 17, 17, 0, 51, 51, 51, 51, 51, 51, 51, 51, 34, 34, 34, 34, 34, 34, 34, 34,
+};
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,292 @@
+/**
+ * @file
+ * @brief      Implementation of the word wrapping stream buffer
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+#include "ColorConsoleWrap.hpp"
+#include "ColorConsoleAnsi.hpp"
+#include "ColorConsoleWidth.hpp"
+
+#include <algorithm>
+
+namespace ColorConsole
+{
+
+static constexpr std::size_t TAB_WIDTH = 8;
+
+/**
+ * Minimum width of the continuation lines (so that wide characters always fit).
+ */
+static constexpr std::size_t MIN_LINE_WIDTH = 2;
+
+static constexpr bool isSpace( char c ) noexcept
+{
+    return ( c == ' ' ) || ( c == '\t' );
+}
+
+static constexpr bool isWordEnd( char c ) noexcept
+{
+    return isSpace( c ) || ( c == '\n' ) || ( c == '\r' );
+}
+
+WrapStreamBuf::WrapStreamBuf( std::streambuf *target, std::size_t width, std::size_t indent, ColorCapability capability )
+: m_target( target ), m_width( 0 ), m_requestedIndent( indent ), m_indent( 0 ), m_capability( capability ), m_column( 0 ),
+  m_lineStart( 0 ), m_continuation( false ), m_spacesWidth( 0 ), m_wordWidth( 0 )
+{
+    set_width( width );
+}
+
+WrapStreamBuf::~WrapStreamBuf()
+{
+    commit_word( m_parser.get_style() );
+    write_output();
+}
+
+void WrapStreamBuf::set_width( std::size_t width ) noexcept
+{
+    m_width = std::max( width, MIN_LINE_WIDTH );
+    m_indent = std::min( m_requestedIndent, m_width - MIN_LINE_WIDTH );
+}
+
+WrapStreamBuf::int_type WrapStreamBuf::overflow( int_type c )
+{
+    if( traits_type::eq_int_type( c, traits_type::eof() ) )
+    {
+        return traits_type::not_eof( c );
+    }
+
+    const char_type ch = traits_type::to_char_type( c );
+
+    return ( xsputn( &ch, 1 ) == 1 ) ? c : traits_type::eof();
+}
+
+std::streamsize WrapStreamBuf::xsputn( const char_type *s, std::streamsize n )
+{
+    const std::string_view chunk( s, static_cast<std::size_t>( n ) );
+    const char *position = chunk.data();
+
+    // The bytes between the runs of text are escape sequences
+    m_parser.process( chunk, [this, &position]( const SgrStyle &style, std::string_view text )
+    {
+        route_escapes( std::string_view( position, static_cast<std::size_t>( text.data() - position ) ), style );
+        process_text( text, style );
+        position = text.data() + text.size();
+    } );
+
+    route_escapes( std::string_view( position, static_cast<std::size_t>( chunk.data() + chunk.size() - position ) ),
+                   m_parser.get_style() );
+
+    return write_output() ? n : 0;
+}
+
+int WrapStreamBuf::sync()
+{
+    const SgrStyle &style = m_parser.get_style();
+
+    commit_word( style );
+
+    if( !m_spaces.empty() && ( ( m_column + m_spacesWidth ) <= m_width ) )
+    {
+        m_output.append( m_spaces );
+        m_column += m_spacesWidth;
+        m_spaces.clear();
+        m_spaceEscapes.clear();
+        m_spacesWidth = 0;
+        m_outputStyle = style;
+    }
+
+    return ( write_output() && ( m_target->pubsync() == 0 ) ) ? 0 : -1;
+}
+
+void WrapStreamBuf::route_escapes( std::string_view bytes, const SgrStyle &style )
+{
+    if( bytes.empty() )
+    {
+        return;
+    }
+
+    if( !m_word.empty() )
+    {
+        m_word.append( bytes );
+    }
+    else if( !m_spaces.empty() )
+    {
+        m_spaces.append( bytes );
+        m_spaceEscapes.append( bytes );
+    }
+    else
+    {
+        m_output.append( bytes );
+        m_outputStyle = style;
+    }
+}
+
+void WrapStreamBuf::process_text( std::string_view text, const SgrStyle &style )
+{
+    const char *p = text.data();
+    const char *end = p + text.size();
+
+    while( p < end )
+    {
+        if( isSpace( *p ) )
+        {
+            commit_word( style );
+
+            for( ; ( p < end ) && isSpace( *p ); p++ )
+            {
+                const std::size_t column = m_column + m_spacesWidth;
+                m_spacesWidth += ( *p == '\t' ) ? ( TAB_WIDTH - ( column % TAB_WIDTH ) ) : 1;
+                m_spaces.push_back( *p );
+            }
+        }
+        else if( ( *p == '\n' ) || ( *p == '\r' ) )
+        {
+            end_line( *p++, style );
+        }
+        else
+        {
+            const char *start = p;
+            for( ; ( p < end ) && !isWordEnd( *p ); p++ )
+            {
+            }
+
+            const std::string_view piece( start, static_cast<std::size_t>( p - start ) );
+
+            if( m_word.empty() )
+            {
+                m_wordStyle = style;
+            }
+            m_word.append( piece );
+            m_wordWidth += display_width( piece );
+
+            if( m_wordWidth > ( m_width - m_indent ) )
+            {
+                split_word();
+            }
+        }
+    }
+}
+
+void WrapStreamBuf::commit_word( const SgrStyle &style )
+{
+    if( m_word.empty() )
+    {
+        return;
+    }
+
+    place_word_start( m_wordWidth );
+
+    m_output.append( m_word );
+    m_column += m_wordWidth;
+    m_word.clear();
+    m_wordWidth = 0;
+    m_outputStyle = style;
+}
+
+void WrapStreamBuf::place_word_start( std::size_t wordWidth )
+{
+    if( ( m_column > m_lineStart ) && ( ( m_column + m_spacesWidth + wordWidth ) > m_width ) )
+    {
+        break_line( m_outputStyle );
+        m_output.append( m_spaceEscapes );
+    }
+    else if( ( ( m_column == m_lineStart ) && m_continuation ) || ( ( m_column + m_spacesWidth ) > m_width ) )
+    {
+        // Spaces at the start of continuation lines, or not fitting in the line, are dropped
+        m_output.append( m_spaceEscapes );
+    }
+    else
+    {
+        m_output.append( m_spaces );
+        m_column += m_spacesWidth;
+    }
+
+    m_spaces.clear();
+    m_spaceEscapes.clear();
+    m_spacesWidth = 0;
+    m_outputStyle = m_wordStyle;
+}
+
+void WrapStreamBuf::split_word()
+{
+    place_word_start( m_wordWidth );
+
+    while( m_wordWidth > ( m_width - m_column ) )
+    {
+        const std::string_view prefix = truncate_to_width( m_word, m_width - m_column );
+
+        // Style at the split point
+        SgrParser parser;
+        parser.set_style( m_wordStyle );
+        parser.process( prefix, []( const SgrStyle&, std::string_view ) {} );
+
+        m_output.append( prefix );
+        m_column += display_width( prefix );
+        m_word.erase( 0, prefix.size() );
+        m_wordWidth = display_width( m_word );
+        m_wordStyle = parser.get_style();
+
+        break_line( m_wordStyle );
+    }
+
+    m_outputStyle = m_wordStyle;
+}
+
+void WrapStreamBuf::break_line( const SgrStyle &style )
+{
+    const bool styled = !style.is_default();
+
+    if( styled )
+    {
+        m_output.append( ANSI_RESET_SEQUENCE );
+    }
+
+    m_output.push_back( '\n' );
+    m_output.append( m_indent, ' ' );
+
+    if( styled )
+    {
+        m_output.append( sgrSequence( style, m_capability ).view() );
+    }
+
+    m_column = m_indent;
+    m_lineStart = m_indent;
+    m_continuation = true;
+}
+
+void WrapStreamBuf::end_line( char c, const SgrStyle &style )
+{
+    commit_word( style );
+
+    // Trailing spaces are kept if they fit
+    m_output.append( ( ( m_column + m_spacesWidth ) <= m_width ) ? std::string_view( m_spaces ) : std::string_view( m_spaceEscapes ) );
+    m_spaces.clear();
+    m_spaceEscapes.clear();
+    m_spacesWidth = 0;
+
+    m_output.push_back( c );
+    m_column = 0;
+    m_lineStart = 0;
+    m_continuation = false;
+    m_outputStyle = style;
+}
+
+bool WrapStreamBuf::write_output()
+{
+    if( m_output.empty() )
+    {
+        return true;
+    }
+
+    const std::streamsize size = static_cast<std::streamsize>( m_output.size() );
+    const bool ok = ( m_target->sputn( m_output.data(), size ) == size );
+    m_output.clear();
+
+    return ok;
+}
+
+} // namespace
@@ -0,0 +1,137 @@
+/**
+ * @file
+ * @brief      Unit tests for the ColorConsole ANSI escape sequences remover
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleAnsiStrip.hpp"
+
+#include "TestHelpers.hpp"
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::AnsiStripper;
+using ColorConsole::AnsiStripStreamBuf;
+using ColorConsole::Color;
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsoleAnsiStrip )
+{
+    std::stringbuf outBuffer;
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsoleAnsiStrip, Sequences )
+{
+    // Verify
+    STRCMP_EQUAL( "plain", AnsiStripper::strip( "plain" ).c_str() );
+    STRCMP_EQUAL( "Error: x", AnsiStripper::strip( "\033[49;1;31mError\033[0m: \033[40;30mx\033[0m" ).c_str() );
+    STRCMP_EQUAL( "ab", AnsiStripper::strip( "a\033[2J\033[10;20H\033[?25lb" ).c_str() );
+    STRCMP_EQUAL( "link", AnsiStripper::strip( "\033]8;;http://x\033\\link\033]8;;\a" ).c_str() );
+    STRCMP_EQUAL( "ab", AnsiStripper::strip( "a\033Pq#0;2;0;0;0\033\\\033(Bb\0337" ).c_str() );
+    STRCMP_EQUAL( "a\nb", AnsiStripper::strip( "a\033[1\n;31mb" ).c_str() );
+    STRCMP_EQUAL( "ab", AnsiStripper::strip( "a\033[12\x18" "b" ).c_str() );
+    STRCMP_EQUAL( "a\xC3\xB1", AnsiStripper::strip( "a\033[\xC3\xB1" ).c_str() );
+    STRCMP_EQUAL( "\n", AnsiStripper::strip( "\033]0;title\033\033[31m\n" ).c_str() );
+}
+
+TEST( ColorConsoleAnsiStrip, SplitSequences )
+{
+    // Prepare
+    const std::string_view text = "\033[49;1;31mError\033[0m: \033]0;title\a\033[K\033(Bdone\033";
+
+    for( std::size_t split = 0; split <= text.size(); split++ )
+    {
+        AnsiStripper stripper;
+        std::string result;
+        auto append = [&result]( std::string_view run ) { result.append( run ); };
+
+        // Exercise
+        stripper.process( text.substr( 0, split ), append );
+        stripper.process( text.substr( split ), append );
+
+        // Verify
+        STRCMP_EQUAL( "Error: done", result.c_str() );
+        CHECK_TRUE( stripper.in_sequence() );
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // Byte by byte
+    //////////////////////////////////////////////////////////////////////////
+
+    // Prepare
+    AnsiStripper stripper;
+    std::string result;
+
+    // Exercise
+    for( char c : text )
+    {
+        stripper.process( std::string_view( &c, 1 ), [&result]( std::string_view run ) { result.append( run ); } );
+    }
+    stripper.reset();
+
+    // Verify
+    STRCMP_EQUAL( "Error: done", result.c_str() );
+    CHECK_FALSE( stripper.in_sequence() );
+}
+
+TEST( ColorConsoleAnsiStrip, AllColors )
+{
+    // Prepare
+    AnsiStripStreamBuf strip( &outBuffer );
+    ColorConsole::Console console( &strip );
+
+    // Exercise
+    for( unsigned int bg = 0; bg <= 0x10; bg++ )
+    {
+        for( unsigned int fg = 0; fg <= 0x0F; fg++ )
+        {
+            const unsigned int bgBits = ( bg == 0x10 ) ? static_cast<unsigned int>( Color::BG_BLACK ) : ( bg << 4 );
+            console << static_cast<Color>( bgBits | fg ) << 'x';
+        }
+        console << Color::RESET;
+    }
+    console << '\n';
+
+    // Verify
+    std::string expected( 17 * 16, 'x' );
+    expected += '\n';
+    STRCMP_EQUAL( expected.c_str(), outBuffer.str().c_str() );
+    CHECK_FALSE( strip.get_stripper().in_sequence() );
+    CHECK( strip.get_target() == &outBuffer );
+}
+
+TEST( ColorConsoleAnsiStrip, StreamBuf )
+{
+    // Prepare
+    AnsiStripStreamBuf strip( &outBuffer );
+    ColorConsole::Console console( &strip );
+
+    // Exercise
+    console << Color::FG_LIGHT_RED << "E" << Color::RESET << " disk " << 42 << "% full" << std::flush;
+    console.write_raw( "\033[49;34m" );
+    console.write_raw( "x\033[" );
+    console.write_raw( "0my" );
+
+    // Verify
+    STRCMP_EQUAL( "E disk 42% fullxy", readFromStringBuf( outBuffer ).c_str() );
+}
@@ -0,0 +1,185 @@
+/**
+ * @file
+ * @brief      Unit tests for the pattern-based colorizing of plain text
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsoleColorize.hpp"
+
+#include "TestHelpers.hpp"
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::Color;
+using ColorConsole::ColorizeScanner;
+using ColorConsole::ColorizeStreamBuf;
+using ColorConsole::Colorizer;
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsoleColorize )
+{
+    /**
+     * Colorizes a text split in chunks of the given size (0 for a single chunk), marking the colorized runs as
+     * <tt>[text]</tt>, or <tt>{text}</tt> if their color is not red.
+     */
+    std::string colorize( const Colorizer &colorizer, std::string_view text, std::size_t chunkSize = 0 )
+    {
+        std::string output;
+        ColorizeScanner scanner( colorizer, [&output]( std::string_view run, std::optional<Color> color )
+        {
+            if( !color.has_value() )
+            {
+                output.append( run );
+            }
+            else if( *color == Color::FG_LIGHT_RED )
+            {
+                output.append( "[" ).append( run ).append( "]" );
+            }
+            else
+            {
+                output.append( "{" ).append( run ).append( "}" );
+            }
+        } );
+
+        if( chunkSize == 0 )
+        {
+            scanner.process( text );
+        }
+        else
+        {
+            for( std::size_t i = 0; i < text.size(); i += chunkSize )
+            {
+                scanner.process( text.substr( i, chunkSize ) );
+            }
+        }
+        scanner.finish();
+
+        return output;
+    }
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsoleColorize, Keywords )
+{
+    // Prepare
+    const Colorizer colorizer( { { "ERROR", Color::FG_LIGHT_RED }, { "WARN", Color::FG_YELLOW },
+                                 { "WARNING", Color::FG_LIGHT_RED }, { "", Color::FG_YELLOW },
+                                 { "ERROR", Color::FG_YELLOW } } );
+
+    // Exercise & Verify
+    STRCMP_EQUAL( "[ERROR] disk full, {WARN} low memory, [WARNING]: retrying ([ERROR]S=2, WAR)",
+                  colorize( colorizer, "ERROR disk full, WARN low memory, WARNING: retrying (ERRORS=2, WAR)" ).c_str() );
+    STRCMP_EQUAL( "", colorize( colorizer, "" ).c_str() );
+    STRCMP_EQUAL( "no matches", colorize( colorizer, "no matches" ).c_str() );
+}
+
+TEST( ColorConsoleColorize, OverlappingKeywords )
+{
+    // Prepare
+    const Colorizer colorizer( { { "XER", Color::FG_LIGHT_RED }, { "ERROR", Color::FG_YELLOW }, { "ROR", Color::FG_LIGHT_RED },
+                                 { "bcd", Color::FG_LIGHT_RED }, { "abcde", Color::FG_YELLOW }, { "ERR", Color::FG_LIGHT_RED },
+                                 { "ERROR123", Color::FG_YELLOW }, { "OR", Color::FG_LIGHT_RED } } );
+
+    // Exercise & Verify: the leftmost match wins, then the longest one
+    STRCMP_EQUAL( "[XER][ROR]", colorize( colorizer, "XERROR" ).c_str() );
+    STRCMP_EQUAL( "{abcde} a[bcd]", colorize( colorizer, "abcde abcd" ).c_str() );
+    STRCMP_EQUAL( "{ERROR}12 {ERROR123} [ERR]x", colorize( colorizer, "ERROR12 ERROR123 ERRx" ).c_str() );
+}
+
+TEST( ColorConsoleColorize, Shapes )
+{
+    // Prepare
+    const Colorizer colorizer( { { "ERROR", Color::FG_LIGHT_RED } },
+                               { { std::string( Colorizer::IPV4_SHAPE ), Color::FG_LIGHT_CYAN },
+                                 { std::string( Colorizer::UUID_SHAPE ), Color::FG_LIGHT_CYAN },
+                                 { "req-%x{8,}", Color::FG_LIGHT_RED } } );
+
+    // Exercise & Verify
+    STRCMP_EQUAL( "[ERROR] from {10.0.0.1}, {192.168.100.200}: 1.2.3 a10.0.0.1 10.0.0.1x 1234.1.1.1 {1.2.3.4}",
+                  colorize( colorizer, "ERROR from 10.0.0.1, 192.168.100.200: 1.2.3 a10.0.0.1 10.0.0.1x 1234.1.1.1 1.2.3.4" ).c_str() );
+    STRCMP_EQUAL( "id={123e4567-e89b-12d3-a456-426614174000} [req-0badf00d] [req-0123456789] req-0123 req-0123456g",
+                  colorize( colorizer, "id=123e4567-e89b-12d3-a456-426614174000 req-0badf00d req-0123456789 req-0123 req-0123456g" ).c_str() );
+
+    // Exercise & Verify: keywords and shapes overlapping
+    STRCMP_EQUAL( "[ERROR]1.2.3.4 1.2.3.4[ERROR]", colorize( colorizer, "ERROR1.2.3.4 1.2.3.4ERROR" ).c_str() );
+}
+
+TEST( ColorConsoleColorize, ShapeSyntax )
+{
+    // Prepare
+    const Colorizer colorizer( {}, { { "%a+%d*", Color::FG_LIGHT_RED }, { "#%d?x{2,3}", Color::FG_YELLOW },
+                                     { "%%{%w{1", Color::FG_YELLOW }, { "", Color::FG_YELLOW } } );
+
+    // Exercise & Verify
+    STRCMP_EQUAL( "[abc] [abc123] 123abc !{#xx} {#5xxx} #[xxxx] !{%{_{1} {%{a{1}{1",
+                  colorize( colorizer, "abc abc123 123abc !#xx #5xxx #xxxx !%{_{1 %{a{1{1" ).c_str() );
+}
+
+TEST( ColorConsoleColorize, Chunks )
+{
+    // Prepare
+    const Colorizer colorizer( { { "ERROR", Color::FG_LIGHT_RED }, { "RORRIM", Color::FG_YELLOW }, { "WARN", Color::FG_YELLOW },
+                                 { "WARNING", Color::FG_LIGHT_RED }, { "日本", Color::FG_YELLOW } },
+                               { { std::string( Colorizer::IPV4_SHAPE ), Color::FG_LIGHT_CYAN },
+                                 { "req-%x{8,}", Color::FG_LIGHT_RED } } );
+    const std::string text = "ERRORRIM WARNIN WARNING 日本語 10.0.0.1 req-0badf00d0 ERROR\n"
+                             "ERRO 255.255.255.255:80 1.2.3 req-0badf00 WARN";
+
+    const std::string expected = colorize( colorizer, text );
+
+    // Verify
+    STRCMP_EQUAL( "[ERROR]RIM {WARN}IN [WARNING] {日本}語 {10.0.0.1} [req-0badf00d0] [ERROR]\n"
+                  "ERRO {255.255.255.255}:80 1.2.3 req-0badf00 {WARN}", expected.c_str() );
+
+    // Exercise & Verify
+    for( std::size_t chunkSize = 1; chunkSize < 12; chunkSize++ )
+    {
+        STRCMP_EQUAL( expected.c_str(), colorize( colorizer, text, chunkSize ).c_str() );
+    }
+}
+
+TEST( ColorConsoleColorize, StreamBuf )
+{
+    // Prepare
+    const Colorizer colorizer( { { "ERROR", Color::FG_LIGHT_RED } }, { { "%d+", Color::FG_YELLOW } } );
+    std::stringbuf output;
+    ColorConsole::Console console( &output, true );
+    console << Color::FG_LIGHT_GREEN;
+    readFromStringBuf( output );
+
+    {
+        ColorizeStreamBuf colorize( console, colorizer );
+        std::ostream stream( &colorize );
+
+        // Exercise
+        stream << "ERROR: 3 ERR" << std::flush;
+
+        // Verify: the text that can still be part of a match is held
+        STRCMP_EQUAL( "\033[49;1;31mERROR\033[49;1;32m: \033[49;1;33m3\033[49;1;32m ", readFromStringBuf( output ).c_str() );
+
+        // Exercise
+        stream << "ORS 42";
+    }
+
+    // Verify
+    STRCMP_EQUAL( "\033[49;1;31mERROR\033[49;1;32mS \033[49;1;33m42\033[49;1;32m", readFromStringBuf( output ).c_str() );
+    CHECK( console.get_color() == Color::FG_LIGHT_GREEN );
+}
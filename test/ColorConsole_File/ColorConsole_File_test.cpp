@@ -0,0 +1,193 @@
+/**
+ * @file
+ * @brief      Unit tests for the ColorConsole C stdio backend
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleFile.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::Color;
+
+static std::string readFromFile( std::FILE *file )
+{
+    std::string contents;
+    char buffer[256];
+
+    std::fflush( file );
+    std::rewind( file );
+
+    std::size_t n;
+    while( ( n = std::fread( buffer, 1, sizeof(buffer), file ) ) > 0 )
+    {
+        contents.append( buffer, n );
+    }
+
+    return contents;
+}
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsoleFile )
+{
+    std::FILE *file;
+
+    void setup()
+    {
+        file = std::tmpfile();
+        CHECK( file != NULL );
+    }
+
+    void teardown()
+    {
+        std::fclose( file );
+    }
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsoleFile, InterleavingWithPrintf )
+{
+    // Prepare
+    ColorConsole::Console* out = new ColorConsole::Console( file, true );
+
+    // Exercise
+    std::fprintf( file, "1:" );
+    *out << Color::FG_LIGHT_RED << "two" << Color::RESET;
+    std::fprintf( file, ":%d:", 3 );
+    *out << 'c' << 4 << std::flush;
+    std::fputs( "|", file );
+    out->write_raw( "raw" );
+    std::fputc( '\n', file );
+
+    // Verify
+    STRCMP_EQUAL( "1:\033[49;1;31mtwo\033[0m:3:c4|raw\n", readFromFile( file ).c_str() );
+    CHECK( out->good() );
+
+    // Cleanup
+    delete out;
+}
+
+TEST( ColorConsoleFile, ColoringDisabled )
+{
+    // Prepare
+    ColorConsole::Console* out = new ColorConsole::Console( file, false );
+
+    // Exercise
+    *out << Color::FG_LIGHT_RED << "two" << Color::RESET;
+    std::fprintf( file, "!" );
+
+    // Verify
+    STRCMP_EQUAL( "two!", readFromFile( file ).c_str() );
+
+    // Cleanup
+    delete out;
+}
+
+TEST( ColorConsoleFile, Lock )
+{
+    // Prepare
+    ColorConsole::FileStreamBuf buffer( file );
+    ColorConsole::Console* out = new ColorConsole::Console( &buffer, true );
+
+    // Exercise
+    buffer.lock();
+    *out << Color::FG_YELLOW << "W" << Color::RESET << " locked";
+    buffer.unlock();
+
+    // Verify
+    CHECK( buffer.get_file() == file );
+    STRCMP_EQUAL( "\033[49;1;33mW\033[0m locked", readFromFile( file ).c_str() );
+
+    // Cleanup
+    delete out;
+}
+
+TEST( ColorConsoleFile, PartialLineDoesNotBlock )
+{
+    // Prepare
+    ColorConsole::Console* out = new ColorConsole::Console( file, true );
+
+    // Exercise: a line left unended does not keep the C stream locked
+    *out << Color::FG_LIGHT_CYAN << "Progress: " << Color::RESET;
+    std::thread worker( [this]() { std::fprintf( file, "worker" ); } );
+    worker.join();
+    *out << "done\n";
+
+    // Verify
+    STRCMP_EQUAL( "\033[49;1;36mProgress: \033[0mworkerdone\n", readFromFile( file ).c_str() );
+
+    // Cleanup
+    delete out;
+}
+
+TEST( ColorConsoleFile, LinesFromThreads )
+{
+    // Prepare
+    const int LINES = 1000;
+    ColorConsole::FileStreamBuf buffer( file );
+    ColorConsole::Console out( &buffer, true );
+    std::atomic<int> ready( 0 );
+    auto writeLines = [&out, &buffer, &ready]( Color color, char name )
+    {
+        ready++;
+        while( ready < 2 )
+        {
+            std::this_thread::yield();
+        }
+        for( int i = 0; i < LINES; i++ )
+        {
+            // The lock keeps the insertions of the line together, also with the console shared between threads
+            std::lock_guard<ColorConsole::FileStreamBuf> guard( buffer );
+            out << color << name << Color::RESET << ": ";
+            std::this_thread::yield();  // Let the other thread try to write in the middle of the line
+            out << i << ' ' << name << '\n';
+        }
+    };
+
+    // Exercise
+    std::thread first( writeLines, Color::FG_LIGHT_RED, 'A' );
+    std::thread second( writeLines, Color::FG_LIGHT_GREEN, 'B' );
+    first.join();
+    second.join();
+
+    // Verify: each line is written without output from the other thread in the middle
+    std::istringstream lines( readFromFile( file ) );
+    std::string line;
+    int counts[2] = { 0, 0 };
+    while( std::getline( lines, line ) )
+    {
+        const bool isFirst = ( line.find( 'A' ) != std::string::npos );
+        const int index = isFirst ? counts[0]++ : counts[1]++;
+        const std::string expected = ( isFirst ? "\033[49;1;31mA\033[0m: " : "\033[49;1;32mB\033[0m: " ) +
+                                     std::to_string( index ) + ( isFirst ? " A" : " B" );
+        STRCMP_EQUAL( expected.c_str(), line.c_str() );
+    }
+    CHECK_EQUAL( LINES, counts[0] );
+    CHECK_EQUAL( LINES, counts[1] );
+}
@@ -0,0 +1,206 @@
+/**
+ * @file
+ * @brief      Unit tests for the ColorConsole std::format integration
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsole.hpp"
+
+#include "TestHelpers.hpp"
+
+#ifdef COLORCONSOLE_HAS_FORMAT
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::Color;
+using ColorConsole::styled;
+
+/**
+ * Value whose formatter prints into another console.
+ */
+struct NestedPrint
+{
+    ColorConsole::Console *console;
+};
+
+template<>
+struct std::formatter<NestedPrint, char> : std::formatter<std::string_view, char>
+{
+    template<class FormatContext>
+    auto format( const NestedPrint &value, FormatContext &ctx ) const
+    {
+        value.console->print( "inner {}", 1 );
+        return std::formatter<std::string_view, char>::format( "outer", ctx );
+    }
+};
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsoleFormat )
+{
+    std::stringbuf outBuffer;
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsoleFormat, Formatters )
+{
+    //////////////////////////////////////////////////////////////////////////
+    // Color
+    //
+
+    // Verify
+    STRCMP_EQUAL( "\033[49;1;33mx", std::format( "{}x", Color::FG_YELLOW ).c_str() );
+
+    //////////////////////////////////////////////////////////////////////////
+    // Styled value, padding excludes the escape sequences
+    //
+
+    // Verify
+    STRCMP_EQUAL( "[\033[49;1;31m   ERR\033[0m]", std::format( "[{:>6}]", styled( "ERR", Color::FG_LIGHT_RED ) ).c_str() );
+    STRCMP_EQUAL( "\033[44;37m0042\033[0m", std::format( "{:04}", styled( 42, Color::FG_LIGHT_GREY | Color::BG_DARK_BLUE ) ).c_str() );
+}
+
+TEST( ColorConsoleFormat, Print )
+{
+    //////////////////////////////////////////////////////////////////////////
+    // Creation
+    //
+
+    // Prepare
+
+    // Exercise
+    ColorConsole::Console* out = new ColorConsole::Console( &outBuffer, true );
+
+    // Verify
+    mock().checkExpectations();
+    CHECK_EQUAL( 0, outBuffer.in_avail() );
+
+    // Cleanup
+    mock().clear();
+
+    //////////////////////////////////////////////////////////////////////////
+    // Print with styled arguments, which restore the console color
+    //
+
+    // Prepare
+    out->set_color( Color::FG_WHITE );
+    readFromStringBuf( outBuffer );
+
+    // Exercise
+    out->print( "{}: {:<4}|", styled( "Disk", Color::FG_YELLOW ), 95 );
+
+    // Verify
+    mock().checkExpectations();
+    STRCMP_EQUAL( "\033[49;1;33mDisk\033[49;1;37m: 95  |", readFromStringBuf(outBuffer).c_str() );
+    CHECK_EQUAL( static_cast<int>( Color::FG_WHITE ), static_cast<int>( out->get_color() ) );
+
+    // Cleanup
+    mock().clear();
+
+    //////////////////////////////////////////////////////////////////////////
+    // Print with color arguments, which update the console color
+    //
+
+    // Prepare
+
+    // Exercise
+    out->print( "{}A{}", Color::FG_DARK_GREEN, Color::RESET );
+
+    // Verify
+    mock().checkExpectations();
+    STRCMP_EQUAL( "\033[49;32mA\033[0m", readFromStringBuf(outBuffer).c_str() );
+    CHECK_EQUAL( static_cast<int>( Color::RESET ), static_cast<int>( out->get_color() ) );
+
+    // Cleanup
+    mock().clear();
+
+    //////////////////////////////////////////////////////////////////////////
+    // Print with coloring disabled
+    //
+
+    // Prepare
+    out->disable_coloring();
+
+    // Exercise
+    out->print( "{}{:>3}{}", Color::FG_DARK_GREEN, styled( 7, Color::FG_DARK_RED ), Color::RESET );
+
+    // Verify
+    mock().checkExpectations();
+    STRCMP_EQUAL( "  7", readFromStringBuf(outBuffer).c_str() );
+    CHECK_EQUAL( static_cast<int>( Color::RESET ), static_cast<int>( out->get_color() ) );
+
+    // Cleanup
+    mock().clear();
+
+    //////////////////////////////////////////////////////////////////////////
+    // Colors are tracked with coloring disabled, and kept when enabled
+    //
+
+    // Prepare
+
+    // Exercise
+    out->print( "{}", Color::FG_DARK_GREEN );
+    out->enable_coloring();
+    out->print( "{}", styled( 'x', Color::FG_DARK_RED ) );
+
+    // Verify
+    mock().checkExpectations();
+    STRCMP_EQUAL( "\033[49;31mx\033[49;32m", readFromStringBuf(outBuffer).c_str() );
+    CHECK_EQUAL( static_cast<int>( Color::FG_DARK_GREEN ), static_cast<int>( out->get_color() ) );
+
+    // Cleanup
+    mock().clear();
+
+    //////////////////////////////////////////////////////////////////////////
+    // Print from a formatter into another console
+    //
+
+    // Prepare
+    std::stringbuf innerBuffer;
+    ColorConsole::Console inner( &innerBuffer, false );
+
+    // Exercise
+    out->print( "[{}|{}]", NestedPrint{ &inner }, 2 );
+
+    // Verify
+    mock().checkExpectations();
+    STRCMP_EQUAL( "[outer|2]", readFromStringBuf(outBuffer).c_str() );
+    STRCMP_EQUAL( "inner 1", readFromStringBuf(innerBuffer).c_str() );
+
+    // Cleanup
+    mock().clear();
+
+    //////////////////////////////////////////////////////////////////////////
+    // Destruction
+    //
+
+    // Prepare
+
+    // Exercise
+    delete out;
+
+    // Verify
+    mock().checkExpectations();
+    CHECK_EQUAL( 0, outBuffer.in_avail() );
+
+    // Cleanup
+}
+
+#endif
@@ -0,0 +1,162 @@
+/**
+ * @file
+ * @brief      Unit tests for the ColorConsole colored fragments
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsoleFragments.hpp"
+
+#include "TestHelpers.hpp"
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::Color;
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsoleFragments )
+{
+    std::stringbuf outBuffer;
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsoleFragments, Size )
+{
+    using namespace ColorConsole;
+
+    // Verify
+    static_assert( fragmentsSize( red( "E" ) + " x" ) == ( 10 + 1 + 4 + 2 ) );
+    static_assert( fragmentsSize( red( "E" ) + red( "F" ) ) == ( 10 + 2 + 4 ) );
+    static_assert( fragmentsSize( red( "E" ) + " x", Color::RESET, false ) == 3 );
+    static_assert( fragmentsSize( "a" + colored( "", Color::FG_DARK_BLUE ) + "b" ) == 2 );
+}
+
+TEST( ColorConsoleFragments, Output )
+{
+    using namespace ColorConsole;
+
+    //////////////////////////////////////////////////////////////////////////
+    // Creation
+    //
+
+    // Prepare
+
+    // Exercise
+    Console* out = new Console( &outBuffer, true );
+
+    // Verify
+    mock().checkExpectations();
+    CHECK_EQUAL( 0, outBuffer.in_avail() );
+
+    // Cleanup
+    mock().clear();
+
+    //////////////////////////////////////////////////////////////////////////
+    // Write composition, restoring the console color
+    //
+
+    // Prepare
+    std::string path = "main.cpp";
+    std::string message = "oops";
+
+    // Exercise
+    *out << red( "E" ) + " " + dim( path ) + ": " + message;
+
+    // Verify
+    mock().checkExpectations();
+    STRCMP_EQUAL( "\033[49;1;31mE\033[0m \033[49;1;30mmain.cpp\033[0m: oops", readFromStringBuf(outBuffer).c_str() );
+    CHECK_EQUAL( static_cast<int>( Color::RESET ), static_cast<int>( out->get_color() ) );
+
+    // Cleanup
+    mock().clear();
+
+    //////////////////////////////////////////////////////////////////////////
+    // Plain text is written with the current console color
+    //
+
+    // Prepare
+    out->set_color( Color::FG_DARK_BLUE );
+    readFromStringBuf(outBuffer);
+
+    // Exercise
+    *out << "[" + colored( "ok", Color::FG_DARK_GREEN ) + "]";
+
+    // Verify
+    mock().checkExpectations();
+    STRCMP_EQUAL( "[\033[49;32mok\033[49;34m]", readFromStringBuf(outBuffer).c_str() );
+    CHECK_EQUAL( static_cast<int>( Color::FG_DARK_BLUE ), static_cast<int>( out->get_color() ) );
+
+    // Cleanup
+    mock().clear();
+
+    //////////////////////////////////////////////////////////////////////////
+    // Large compositions
+    //
+
+    // Prepare
+    out->set_color( Color::RESET );
+    readFromStringBuf(outBuffer);
+    std::string large( 2000, 'x' );
+
+    // Exercise
+    *out << green( large ) + "!";
+
+    // Verify
+    mock().checkExpectations();
+    std::string expected = "\033[49;1;32m" + large + "\033[0m!";
+    std::string actual( expected.size() + 1, '\0' );
+    actual.resize( static_cast<std::size_t>( outBuffer.sgetn( &actual[0], static_cast<std::streamsize>( actual.size() ) ) ) );
+    STRCMP_EQUAL( expected.c_str(), actual.c_str() );
+
+    // Cleanup
+    mock().clear();
+
+    //////////////////////////////////////////////////////////////////////////
+    // Coloring disabled
+    //
+
+    // Prepare
+    out->enable_coloring( false );
+
+    // Exercise
+    *out << red( "E" ) + " " + dim( path );
+
+    // Verify
+    mock().checkExpectations();
+    STRCMP_EQUAL( "E main.cpp", readFromStringBuf(outBuffer).c_str() );
+
+    // Cleanup
+    mock().clear();
+
+    //////////////////////////////////////////////////////////////////////////
+    // Destruction
+    //
+
+    // Prepare
+
+    // Exercise
+    delete out;
+
+    // Verify
+    mock().checkExpectations();
+    CHECK_EQUAL( 0, outBuffer.in_avail() );
+
+    // Cleanup
+}
@@ -0,0 +1,162 @@
+/**
+ * @file
+ * @brief      Unit tests for the cached terminal size
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsoleGeometry.hpp"
+
+#include <vector>
+
+#if !defined(_WIN32)
+#include <csignal>
+#endif
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::ConsoleType;
+using ColorConsole::TerminalGeometry;
+using ColorConsole::TerminalSize;
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsoleGeometry )
+{
+    TerminalSize terminalSize = { 120, 40 };
+    bool terminal = true;
+    unsigned int queries = 0;
+
+    TerminalGeometry::Query fakeQuery()
+    {
+        return [this]( TerminalSize &size )
+        {
+            queries++;
+            size = terminalSize;
+            return terminal;
+        };
+    }
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsoleGeometry, QueriedOnce )
+{
+    // Prepare
+    TerminalGeometry geometry( fakeQuery() );
+
+    // Exercise & Verify
+    CHECK_EQUAL( 0u, queries );
+    CHECK( geometry.get_size() == TerminalSize( { 120, 40 } ) );
+    CHECK( geometry.is_terminal() );
+    CHECK( geometry.get_size() == TerminalSize( { 120, 40 } ) );
+    CHECK_EQUAL( 1u, queries );
+}
+
+TEST( ColorConsoleGeometry, Resize )
+{
+    // Prepare
+    TerminalGeometry geometry( fakeQuery() );
+    std::vector<TerminalSize> resizes;
+    geometry.on_resize( [&resizes]( TerminalSize size ) { resizes.push_back( size ); } );
+    geometry.get_size();
+
+    // Exercise
+    terminalSize = { 100, 30 };
+
+    // Verify: not queried until notified
+    CHECK_EQUAL( 120u, geometry.get_size().columns );
+
+    // Exercise
+    geometry.notify_resize();
+
+    // Verify
+    CHECK_EQUAL( 100u, geometry.get_size().columns );
+    CHECK_EQUAL( 2u, queries );
+    CHECK_EQUAL( 1u, resizes.size() );
+    CHECK( resizes[0] == TerminalSize( { 100, 30 } ) );
+
+    // Exercise: notified without changes
+    geometry.notify_resize();
+    geometry.get_size();
+
+    // Verify
+    CHECK_EQUAL( 3u, queries );
+    CHECK_EQUAL( 1u, resizes.size() );
+}
+
+TEST( ColorConsoleGeometry, NotTerminal )
+{
+    // Prepare
+    terminal = false;
+    TerminalGeometry geometry( fakeQuery(), { 132, 50 } );
+
+    // Exercise & Verify
+    CHECK( geometry.get_size() == TerminalSize( { 132, 50 } ) );
+    CHECK_FALSE( geometry.is_terminal() );
+
+    // Exercise
+    geometry.set_default_size( { 200, 60 } );
+
+    // Verify
+    CHECK( geometry.get_size() == TerminalSize( { 200, 60 } ) );
+
+    // Exercise & Verify
+    TerminalGeometry noQuery { TerminalGeometry::Query() };
+    CHECK( noQuery.get_size() == TerminalGeometry::DEFAULT_SIZE );
+}
+
+#if !defined(_WIN32)
+static volatile std::sig_atomic_t previousHandlerCalls = 0;
+
+TEST( ColorConsoleGeometry, SignalHandler )
+{
+    // Prepare
+    struct sigaction action = {};
+    action.sa_handler = []( int ) { previousHandlerCalls = previousHandlerCalls + 1; };
+    sigemptyset( &action.sa_mask );
+    sigaction( SIGWINCH, &action, nullptr );
+
+    TerminalGeometry &geometry = TerminalGeometry::for_console_type( ConsoleType::STD_OUTPUT );
+    TerminalGeometry &custom = TerminalGeometry::for_console_type( ConsoleType::CUSTOM );
+    geometry.set_default_size( { 90, 20 } );
+    geometry.get_size();
+
+    // Exercise
+    geometry.set_default_size( { 91, 20 } );
+    geometry.get_size();
+    std::vector<TerminalSize> resizes;
+    geometry.on_resize( [&resizes]( TerminalSize size ) { resizes.push_back( size ); } );
+    geometry.set_default_size( { 92, 20 } );
+    std::raise( SIGWINCH );
+
+    // Verify
+    CHECK_EQUAL( 1, previousHandlerCalls );
+    if( !geometry.is_terminal() )
+    {
+        CHECK_EQUAL( 92u, geometry.get_size().columns );
+        CHECK_EQUAL( 1u, resizes.size() );
+    }
+    CHECK( &custom != &geometry );
+    CHECK( &custom == &TerminalGeometry::for_console_type( ConsoleType::CUSTOM ) );
+    CHECK_FALSE( custom.is_terminal() );
+
+    // Cleanup
+    geometry.on_resize( TerminalGeometry::ResizeCallback() );
+}
+#endif
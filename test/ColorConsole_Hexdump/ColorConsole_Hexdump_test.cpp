@@ -0,0 +1,197 @@
+/**
+ * @file
+ * @brief      Unit tests for the colored hexadecimal dumps
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleHexdump.hpp"
+
+#include "TestHelpers.hpp"
+
+#include <algorithm>
+#include <string_view>
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::Color;
+using ColorConsole::HexdumpOptions;
+using ColorConsole::hexdump;
+
+static std::span<const std::byte> asBytes( std::string_view text )
+{
+    return std::as_bytes( std::span<const char>( text.data(), text.size() ) );
+}
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsoleHexdump )
+{
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsoleHexdump, Layout )
+{
+    // Prepare
+    std::stringbuf output;
+    ColorConsole::Console console( &output, false );
+    const std::string_view data( "Hello, World!\n\0\0\x80\x01", 18 );
+
+    // Exercise
+    hexdump( console, asBytes( data ) );
+
+    // Verify
+    STRCMP_EQUAL( "00000000  48 65 6c 6c 6f 2c 20 57  6f 72 6c 64 21 0a 00 00  |Hello, World!...|\n"
+                  "00000010  80 01                                             |..|\n"
+                  "00000012\n", readFromStringBuf( output ).c_str() );
+
+    // Exercise & Verify
+    hexdump( console, {} );
+    STRCMP_EQUAL( "", readFromStringBuf( output ).c_str() );
+}
+
+TEST( ColorConsoleHexdump, Options )
+{
+    // Prepare
+    std::stringbuf output;
+    ColorConsole::Console console( &output, false );
+    HexdumpOptions options;
+    options.bytesPerLine = 4;
+    options.groupSize = 2;
+    options.offset = 0xFFFFFFFE;
+    options.ascii = false;
+
+    // Exercise
+    hexdump( console, asBytes( "0123456789" ), options );
+
+    // Verify: the offsets are widened to fit the last one
+    STRCMP_EQUAL( "0fffffffe  30 31  32 33\n"
+                  "100000002  34 35  36 37\n"
+                  "100000006  38 39\n"
+                  "100000008\n", readFromStringBuf( output ).c_str() );
+}
+
+TEST( ColorConsoleHexdump, Colors )
+{
+    // Prepare
+    std::stringbuf output;
+    ColorConsole::Console console( &output, true );
+    HexdumpOptions options;
+    options.bytesPerLine = 8;
+    options.groupSize = 0;
+
+    // Exercise
+    hexdump( console, asBytes( std::string_view( "AB\0\x01\xFF", 5 ) ), options );
+
+    // Verify: the color is only switched where the class changes
+    STRCMP_EQUAL( "00000000  \033[49;1;36m41 42 \033[49;1;30m00 \033[49;1;32m01 \033[49;1;33mff           \033[0m|"
+                  "\033[49;1;36mAB\033[49;1;30m.\033[49;1;32m.\033[49;1;33m.\033[0m|\n"
+                  "00000005\n", readFromStringBuf( output ).c_str() );
+
+    // Prepare
+    options.zeroColor = Color::FG_WHITE | Color::BG_DARK_RED;
+    options.printableColor = Color::RESET;
+    options.offsetColor = Color::FG_DARK_GREY;
+    options.ascii = false;
+
+    // Exercise
+    hexdump( console, asBytes( std::string_view( "\0\0A", 3 ) ), options );
+
+    // Verify: spaces do not show backgrounds
+    STRCMP_EQUAL( "\033[49;1;30m00000000  \033[41;1;37m00\033[0m \033[41;1;37m00\033[0m 41\n"
+                  "\033[49;1;30m00000003\033[0m\n", readFromStringBuf( output ).c_str() );
+}
+
+TEST( ColorConsoleHexdump, ConsoleColor )
+{
+    // Prepare
+    std::stringbuf output;
+    ColorConsole::Console console( &output, true );
+    HexdumpOptions options;
+    options.ascii = false;
+    console << Color::FG_YELLOW;
+    readFromStringBuf( output );
+
+    // Exercise
+    hexdump( console, asBytes( "A" ), options );
+    console << "after";
+
+    // Verify: the dump starts from the console color and restores it
+    STRCMP_EQUAL( "\033[0m00000000  \033[49;1;36m41\033[0m\n"
+                  "00000001\n\033[49;1;33mafter", readFromStringBuf( output ).c_str() );
+    CHECK( console.get_color() == Color::FG_YELLOW );
+
+    // Exercise & Verify: nothing is written for empty data
+    hexdump( console, {}, options );
+    STRCMP_EQUAL( "", readFromStringBuf( output ).c_str() );
+}
+
+TEST( ColorConsoleHexdump, LongColoredLines )
+{
+    // Prepare: bright backgrounds switch the color before and after each byte, and the spaces reset it
+    std::stringbuf output;
+    ColorConsole::Console console( &output, true );
+    std::string data;
+    for( int i = 0; i < 64 * 1024; i++ )
+    {
+        data.push_back( ( i % 2 ) ? '\x80' : '\x01' );
+    }
+    HexdumpOptions options;
+    options.bytesPerLine = 1024;
+    options.groupSize = 1;
+    options.controlColor = static_cast<Color>( 0x8A );
+    options.highColor = static_cast<Color>( 0x9C );
+
+    // Exercise
+    hexdump( console, asBytes( data ), options );
+
+    // Verify
+    const std::string dump = readFromStringBuf( output );
+    CHECK_EQUAL( 65, std::count( dump.begin(), dump.end(), '\n' ) );
+    STRCMP_CONTAINS( "\n0000fc00  ", dump.c_str() );
+    CHECK( dump.compare( dump.size() - 9, 9, "00010000\n" ) == 0 );
+}
+
+TEST( ColorConsoleHexdump, AllBytes )
+{
+    // Prepare
+    std::stringbuf output;
+    ColorConsole::Console console( &output, false );
+    std::string data;
+    for( int i = 0; i < 256; i++ )
+    {
+        data.push_back( static_cast<char>( i ) );
+    }
+    HexdumpOptions options;
+    options.bytesPerLine = 32;
+    options.groupSize = 0;
+
+    // Exercise
+    hexdump( console, asBytes( data ), options );
+
+    // Verify: each byte is classified as expected
+    const std::string dump = readFromStringBuf( output );
+    STRCMP_CONTAINS( "00000000  00 01 02 03 04 05 06 07 08 09 0a 0b 0c 0d 0e 0f 10 11 12 13 14 15 16 17 18 19 1a 1b 1c 1d 1e 1f  "
+                     "|................................|\n", dump.c_str() );
+    STRCMP_CONTAINS( "|@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_|\n", dump.c_str() );
+    STRCMP_CONTAINS( "6e 6f 70 71 72 73 74 75 76 77 78 79 7a 7b 7c 7d 7e 7f  |`abcdefghijklmnopqrstuvwxyz{|}~.|\n", dump.c_str() );
+    STRCMP_CONTAINS( "000000e0  e0 e1 e2 e3 e4 e5 e6 e7 e8 e9 ea eb ec ed ee ef f0 f1 f2 f3 f4 f5 f6 f7 f8 f9 fa fb fc fd fe ff  "
+                     "|................................|\n00000100\n", dump.c_str() );
+}
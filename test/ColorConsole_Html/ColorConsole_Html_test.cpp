@@ -0,0 +1,143 @@
+/**
+ * @file
+ * @brief      Unit tests for the ColorConsole HTML converter
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleHtml.hpp"
+
+#include "TestHelpers.hpp"
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::Color;
+using ColorConsole::HtmlConverter;
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsoleHtml )
+{
+    std::stringbuf outBuffer;
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsoleHtml, Escaping )
+{
+    // Prepare
+    std::string text = "if( a < b && c > \"d\" )\tx\r\n\a";
+    text += std::string( 40, 'x' ) + "\xC3\xB1<";
+
+    // Exercise & Verify
+    STRCMP_EQUAL( ( "if( a &lt; b &amp;&amp; c &gt; &quot;d&quot; )\tx\n" + std::string( 40, 'x' ) + "\xC3\xB1&lt;" ).c_str(),
+                  HtmlConverter::convert( text ).c_str() );
+    STRCMP_EQUAL( "", HtmlConverter::convert( "" ).c_str() );
+}
+
+TEST( ColorConsoleHtml, LibraryColors )
+{
+    // Prepare
+    ColorConsole::Console console( &outBuffer );
+
+    // Exercise
+    console << Color::FG_LIGHT_RED << "Error" << Color::RESET << ": "
+            << ( Color::FG_DARK_BLUE | Color::BG_BLACK ) << "a" << ( Color::FG_WHITE | Color::BG_YELLOW ) << "b"
+            << Color::RESET << "\n";
+
+    // Verify
+    STRCMP_EQUAL( "<span class=\"cc-fg-light-red\">Error</span>: "
+                  "<span class=\"cc-fg-dark-blue cc-bg-black\">a</span>"
+                  "<span class=\"cc-fg-white cc-bg-yellow\">b</span>\n",
+                  HtmlConverter::convert( outBuffer.str() ).c_str() );
+}
+
+TEST( ColorConsoleHtml, ForeignStyles )
+{
+    // Exercise & Verify
+    STRCMP_EQUAL( "<span class=\"cc-bold cc-underline\" style=\"color:#ff0000;background-color:#0a141e;\">x</span>",
+                  HtmlConverter::convert( "\033[1;4;38;5;196;48;2;10;20;30mx" ).c_str() );
+    STRCMP_EQUAL( "<span class=\"cc-fg-inverse cc-bg-dark-green\">x</span>"
+                  "<span class=\"cc-fg-inverse cc-bg-inverse\">y</span>",
+                  HtmlConverter::convert( "\033[7;32mx\033[39my" ).c_str() );
+    STRCMP_EQUAL( "<span class=\"my-fg-light-grey my-italic\">x</span>",
+                  HtmlConverter::convert( "\033[3;97;2m\033[22;37mx", "my-" ).c_str() );
+}
+
+TEST( ColorConsoleHtml, MergeRuns )
+{
+    // Prepare
+    HtmlConverter converter( &outBuffer );
+
+    // Exercise
+    converter.write( "\033[49;1;31ma\033[49;1;31mb\033[22;91mc\033[" );
+    converter.write( "0m\033[0md\033[32me" );
+    converter.write( "f" );
+    CHECK_TRUE( converter.finish() );
+
+    // Verify
+    STRCMP_EQUAL( "<span class=\"cc-fg-light-red\">abc</span>d<span class=\"cc-fg-dark-green\">ef</span>",
+                  readFromStringBuf( outBuffer ).c_str() );
+    CHECK_TRUE( converter.good() );
+    CHECK( converter.get_target() == &outBuffer );
+}
+
+TEST( ColorConsoleHtml, Stylesheet )
+{
+    // Exercise
+    std::string css = HtmlConverter::stylesheet();
+
+    // Verify
+    CHECK( css.find( "pre.cc-console {" ) != std::string::npos );
+    CHECK( css.find( ".cc-fg-light-red { color: #ff0000; }" ) != std::string::npos );
+    CHECK( css.find( ".cc-bg-black { background-color: #000000; }" ) != std::string::npos );
+    CHECK( css.find( ".cc-bg-white { background-color: #ffffff; }" ) != std::string::npos );
+    CHECK( css.find( ".cc-underline {" ) != std::string::npos );
+}
+
+TEST( ColorConsoleHtml, ClassPrefix )
+{
+    // Prepare
+    const std::string longPrefix = "a-very-long-prefix-";
+
+    // Exercise & Verify
+    CHECK( HtmlConverter::class_prefix( "my_app-" ) == "my_app-" );
+    CHECK( HtmlConverter::class_prefix( longPrefix ) == "a-very-long-pref" );
+    CHECK( HtmlConverter::class_prefix( "x\"><script>" ) == "x" );
+    CHECK( HtmlConverter::class_prefix( "a{}b" ) == "a" );
+    CHECK( HtmlConverter::class_prefix( "1st-" ) == "" );
+    CHECK( HtmlConverter::class_prefix( "" ) == "" );
+
+    // Exercise & Verify: the converter and the stylesheet use the same prefix
+    STRCMP_EQUAL( "<span class=\"a-very-long-preffg-light-red\">x</span>",
+                  HtmlConverter::convert( "\033[49;1;31mx", longPrefix ).c_str() );
+    CHECK( HtmlConverter::stylesheet( longPrefix ).find( ".a-very-long-preffg-light-red {" ) != std::string::npos );
+    CHECK( HtmlConverter::stylesheet( longPrefix ).find( "a-very-long-prefix" ) == std::string::npos );
+
+    STRCMP_EQUAL( "<span class=\"xfg-light-red\">x</span>", HtmlConverter::convert( "\033[49;1;31mx", "x\"><i>" ).c_str() );
+    CHECK( HtmlConverter::stylesheet( "x{}" ).find( '{', 0 ) == HtmlConverter::stylesheet( "x" ).find( '{', 0 ) );
+}
+
+TEST( ColorConsoleHtml, EmptyClassParts )
+{
+    // Exercise & Verify: an empty prefix and single-part class names append empty strings to the tag
+    STRCMP_EQUAL( "<span class=\"fg-light-red\">x</span>", HtmlConverter::convert( "\033[49;1;31mx", "" ).c_str() );
+    STRCMP_EQUAL( "<span class=\"cc-fg-inverse cc-bg-inverse\">x</span>", HtmlConverter::convert( "\033[7mx" ).c_str() );
+    STRCMP_EQUAL( "<span class=\"fg-inverse bg-inverse\">x</span>", HtmlConverter::convert( "\033[7mx", "" ).c_str() );
+}
@@ -0,0 +1,278 @@
+/**
+ * @file
+ * @brief      Unit tests for the streaming JSON pretty printer
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleJson.hpp"
+
+#include "TestHelpers.hpp"
+
+#include <algorithm>
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::Color;
+using ColorConsole::JsonColors;
+using ColorConsole::JsonPrinter;
+
+/**
+ * String buffer that records the size of the largest write.
+ */
+class MaxWriteStringBuf : public std::stringbuf
+{
+public:
+    std::streamsize get_max_write() const noexcept
+    {
+        return m_maxWrite;
+    }
+
+protected:
+    std::streamsize xsputn( const char_type *s, std::streamsize count ) override
+    {
+        m_maxWrite = std::max( m_maxWrite, count );
+        return std::stringbuf::xsputn( s, count );
+    }
+
+private:
+    std::streamsize m_maxWrite = 0;
+};
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsoleJson )
+{
+    /**
+     * Pretty prints a text split in chunks of the given size (0 for a single chunk).
+     */
+    std::string prettyPrint( std::string_view text, std::size_t chunkSize = 0, bool ansi = true )
+    {
+        std::stringbuf output;
+        ColorConsole::Console console( &output, ansi );
+        JsonPrinter printer( console );
+
+        if( chunkSize == 0 )
+        {
+            printer.process( text );
+        }
+        else
+        {
+            for( std::size_t i = 0; i < text.size(); i += chunkSize )
+            {
+                printer.process( text.substr( i, chunkSize ) );
+            }
+        }
+        printer.finish();
+
+        return readFromStringBuf( output );
+    }
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsoleJson, Layout )
+{
+    // Prepare
+    std::stringbuf output;
+    ColorConsole::Console console( &output, false );
+    JsonPrinter printer( console );
+
+    // Exercise
+    CHECK_TRUE( printer.process( "{\"name\":\"demo\",\"tags\":[\"a\", \"b\"],\"empty\":{ },\"none\":[],\n"
+                                 "\"n\":-1.5e+3,\"ok\":true,\"nil\":null}" ) );
+    CHECK_TRUE( printer.finish() );
+
+    // Verify
+    STRCMP_EQUAL( "{\n"
+                  "  \"name\": \"demo\",\n"
+                  "  \"tags\": [\n"
+                  "    \"a\",\n"
+                  "    \"b\"\n"
+                  "  ],\n"
+                  "  \"empty\": {},\n"
+                  "  \"none\": [],\n"
+                  "  \"n\": -1.5e+3,\n"
+                  "  \"ok\": true,\n"
+                  "  \"nil\": null\n"
+                  "}\n", readFromStringBuf( output ).c_str() );
+
+    // Exercise & Verify: several top-level values
+    CHECK_TRUE( printer.process( " 1 \"x\"\n[0]0" ) );
+    CHECK_TRUE( printer.finish() );
+    STRCMP_EQUAL( "1\n\"x\"\n[\n  0\n]\n0\n", readFromStringBuf( output ).c_str() );
+}
+
+TEST( ColorConsoleJson, Colors )
+{
+    // Exercise & Verify
+    STRCMP_EQUAL( "{\n  \033[49;1;34m\"k\"\033[0m: [\n    \033[49;1;36m1\033[0m,\n    \033[49;1;32m\"s\"\033[0m,\n"
+                  "    \033[49;1;33mfalse\n  \033[0m]\n}\n", prettyPrint( "{\"k\":[1,\"s\",false]}" ).c_str() );
+
+    // Prepare
+    std::stringbuf output;
+    ColorConsole::Console console( &output, true );
+    JsonColors colors;
+    colors.key = Color::RESET;
+    colors.punctuation = Color::FG_DARK_GREY;
+    JsonPrinter printer( console, colors, 1 );
+
+    // Exercise
+    printer.process( "{\"a\":\"b\"}" );
+    printer.finish();
+
+    // Verify
+    STRCMP_EQUAL( "\033[49;1;30m{\n \033[0m\"a\"\033[49;1;30m: \033[49;1;32m\"b\"\n\033[49;1;30m}\033[0m\n",
+                  readFromStringBuf( output ).c_str() );
+}
+
+TEST( ColorConsoleJson, ConsoleColor )
+{
+    // Prepare
+    std::stringbuf output;
+    ColorConsole::Console console( &output, true );
+    JsonPrinter printer( console );
+    console << Color::FG_YELLOW;
+    readFromStringBuf( output );
+
+    // Exercise
+    printer.process( "{\"a\":[1,true]}" );
+    printer.finish();
+    console << "after";
+
+    // Verify: the output starts from the console color and restores it
+    STRCMP_EQUAL( "\033[0m{\n  \033[49;1;34m\"a\"\033[0m: [\n    \033[49;1;36m1\033[0m,\n    \033[49;1;33mtrue\n"
+                  "  \033[0m]\n}\n\033[49;1;33mafter", readFromStringBuf( output ).c_str() );
+    CHECK( console.get_color() == Color::FG_YELLOW );
+
+    // Exercise & Verify: invalid text is written in the default color too
+    console << Color::FG_LIGHT_RED;
+    readFromStringBuf( output );
+    printer.process( "x" );
+    printer.finish();
+    STRCMP_EQUAL( "\033[0mx\033[49;1;31m\033[0m\n\033[49;1;31m", readFromStringBuf( output ).c_str() );
+}
+
+TEST( ColorConsoleJson, Strings )
+{
+    // Prepare
+    const std::string body = std::string( 40, 'x' ) + "\\\"" + std::string( 20, 'y' ) + "\\u00E9\\n\\\\\\/ 日本";
+
+    // Exercise & Verify: the bodies are copied as they are
+    STRCMP_EQUAL( ( "\033[49;1;32m\"" + body + "\"\033[0m\n" ).c_str(), prettyPrint( "\"" + body + "\"" ).c_str() );
+}
+
+TEST( ColorConsoleJson, Chunks )
+{
+    // Prepare
+    const std::string text = "{\"id\":12345,\"price\":-0.25E-2,\"name\":\"" + std::string( 37, 'n' ) + "\\\"q\\u0041\","
+                             "\"list\":[true,false,null,[],{},[{\"x\":0}]],\"text\":\"" + std::string( 70, 't' ) + "\"} 42";
+
+    const std::string expected = prettyPrint( text, 0, false );
+
+    // Exercise & Verify
+    for( std::size_t chunkSize = 1; chunkSize < 20; chunkSize++ )
+    {
+        STRCMP_EQUAL( expected.c_str(), prettyPrint( text, chunkSize, false ).c_str() );
+    }
+
+    // Exercise & Verify: a token split across chunks continues in its color
+    STRCMP_EQUAL( "\033[49;1;36m12\033[0m\033[49;1;36m34\033[0m\n", prettyPrint( "1234", 2 ).c_str() );
+}
+
+TEST( ColorConsoleJson, Errors )
+{
+    // Prepare
+    std::stringbuf output;
+    ColorConsole::Console console( &output, false );
+    JsonPrinter printer( console );
+
+    // Exercise & Verify: the text is written as is from the error
+    CHECK_FALSE( printer.process( "{\"a\":01, \"b\"" ) );
+    CHECK_FALSE( printer.process( ": 2}" ) );
+    CHECK_TRUE( printer.has_error() );
+    CHECK_EQUAL( 6u, printer.get_error_offset() );
+    CHECK_FALSE( printer.finish() );
+    STRCMP_EQUAL( "{\n  \"a\": 01, \"b\": 2}\n", readFromStringBuf( output ).c_str() );
+
+    // Exercise & Verify: the text after the error is sanitized
+    CHECK_FALSE( printer.process( "[1 \033[2J\xC2\x9B" ) );
+    CHECK_FALSE( printer.process( "31m\x80\n" ) );
+    CHECK_FALSE( printer.finish() );
+    STRCMP_EQUAL( "[\n  1 \\x1b[2J\\u009b31m\\x80\n", readFromStringBuf( output ).c_str() );
+
+    // Exercise & Verify: the whitespace skipped before the error is written too
+    CHECK_FALSE( printer.process( "[1 \n 2]" ) );
+    CHECK_FALSE( printer.finish() );
+    STRCMP_EQUAL( "[\n  1 \n 2]\n", readFromStringBuf( output ).c_str() );
+
+    // Exercise & Verify: incomplete text
+    CHECK_TRUE( printer.process( "[1," ) );
+    CHECK_FALSE( printer.finish() );
+    STRCMP_EQUAL( "[\n  1,\n  \n", readFromStringBuf( output ).c_str() );
+
+    // Exercise & Verify: invalid tokens
+    const char *invalid[] = { "\"a\tb\"", "[1 2]", "{\"a\" 1}", "{1:2}", "[1,]", "tru", "nul1", "-", "1.", "1e+", "\"\\x\"",
+                              "\"\\u12G4\"", "]", "[}" };
+    for( const char *text : invalid )
+    {
+        printer.process( text );
+        CHECK_FALSE( printer.finish() );
+        readFromStringBuf( output );
+    }
+
+    // Exercise & Verify: the printer is reset after finish()
+    CHECK_TRUE( printer.process( "[]" ) );
+    CHECK_TRUE( printer.finish() );
+    STRCMP_EQUAL( "[]\n", readFromStringBuf( output ).c_str() );
+}
+
+TEST( ColorConsoleJson, LargeChunks )
+{
+    // Prepare
+    MaxWriteStringBuf output;
+    ColorConsole::Console console( &output, true );
+    JsonPrinter printer( console );
+    const std::string body( 100 * 1024, 'x' );
+
+    // Exercise
+    CHECK_TRUE( printer.process( "[\"" + body + "\"]" ) );
+    CHECK_FALSE( printer.process( "," + body ) );
+    printer.finish();
+
+    // Verify: long strings and invalid text are written in blocks
+    const std::string dump = output.str();
+    CHECK( output.get_max_write() <= static_cast<std::streamsize>( 32 * 1024 + ColorConsole::ANSI_ESCAPE_MAX_LENGTH ) );
+    CHECK_EQUAL( 2 * body.size(), static_cast<std::size_t>( std::count( dump.begin(), dump.end(), 'x' ) ) );
+}
+
+TEST( ColorConsoleJson, Depth )
+{
+    // Prepare
+    std::stringbuf output;
+    ColorConsole::Console console( &output, false );
+    JsonPrinter printer( console, {}, 0 );
+    const std::string deepest = std::string( JsonPrinter::MAX_DEPTH, '[' ) + std::string( JsonPrinter::MAX_DEPTH, ']' );
+
+    // Exercise & Verify
+    CHECK_TRUE( printer.process( deepest ) );
+    CHECK_TRUE( printer.finish() );
+    CHECK_FALSE( printer.process( "[" + deepest + "]" ) );
+    CHECK_FALSE( printer.finish() );
+}
@@ -0,0 +1,141 @@
+/**
+ * @file
+ * @brief      Unit tests for the lazy initialization of the ColorConsole global consoles
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleHelpers.hpp"
+
+#include "TestHelpers.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::Color;
+using ColorConsole::LazyStreamBuf;
+
+static std::atomic<int> initializationCount( 0 );
+
+static void countInitialization( void *console )
+{
+    CHECK( console != NULL );
+    initializationCount++;
+}
+
+/**
+ * Stream buffer that counts the characters written from several threads.
+ */
+class CountingStreamBuf : public std::streambuf
+{
+public:
+    std::size_t get_count()
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        return m_count;
+    }
+
+protected:
+    int_type overflow( int_type ch ) override
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_count++;
+        return traits_type::not_eof( ch );
+    }
+
+    std::streamsize xsputn( const char_type*, std::streamsize count ) override
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_count += static_cast<std::size_t>( count );
+        return count;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::size_t m_count = 0;
+};
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsoleLazy )
+{
+    std::stringbuf outBuffer;
+
+    void setup()
+    {
+        initializationCount = 0;
+    }
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsoleLazy, InitializedOnFirstUse )
+{
+    // Prepare
+    std::ostream target( &outBuffer );
+    LazyStreamBuf<char> lazyBuffer( target, ColorConsole::ConsoleType::STD_OUTPUT, &countInitialization, &target );
+
+    // Exercise
+    ColorConsole::Console* out = new ColorConsole::Console( &lazyBuffer, true );
+
+    // Verify
+    CHECK_EQUAL( 0, initializationCount.load() );
+    CHECK_FALSE( lazyBuffer.is_initialized() );
+
+    // Exercise
+    *out << Color::FG_LIGHT_RED << "E" << Color::RESET << '!' << std::flush;
+
+    // Verify
+    CHECK_EQUAL( 1, initializationCount.load() );
+    CHECK( lazyBuffer.is_initialized() );
+    STRCMP_EQUAL( "\033[49;1;31mE\033[0m!", readFromStringBuf(outBuffer).c_str() );
+
+    // Cleanup
+    out->disable_coloring();
+    delete out;
+}
+
+TEST( ColorConsoleLazy, InitializedOnceByConcurrentUsers )
+{
+    // Prepare
+    CountingStreamBuf sink;
+    std::ostream target( &sink );
+    LazyStreamBuf<char> lazyBuffer( target, ColorConsole::ConsoleType::STD_OUTPUT, &countInitialization, &target );
+    std::vector<std::thread> threads;
+
+    // Exercise
+    for( int i = 0; i < 8; i++ )
+    {
+        threads.emplace_back( [&lazyBuffer]() { lazyBuffer.sputn( "x", 1 ); } );
+    }
+
+    for( std::thread &thread : threads )
+    {
+        thread.join();
+    }
+
+    // Verify
+    CHECK_EQUAL( 1, initializationCount.load() );
+    CHECK_EQUAL( 8u, sink.get_count() );
+}
@@ -0,0 +1,225 @@
+/**
+ * @file
+ * @brief      Unit tests for the ColorConsole live region
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleLiveRegion.hpp"
+#include "ColorConsoleTerminal.hpp"
+
+#include "TestHelpers.hpp"
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::Color;
+using ColorConsole::LiveRegion;
+using ColorConsole::ProgressBar;
+using ColorConsole::SgrColor;
+using ColorConsole::VirtualTerminal;
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsoleLiveRegion )
+{
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsoleLiveRegion, OutputAboveBars )
+{
+    // Prepare
+    VirtualTerminal terminal( 60, 10 );
+    ColorConsole::Console console( &terminal, true );
+    LiveRegion region( console, 10, 60 );
+    ProgressBar &download = region.add_bar( "download", 200 );
+    ProgressBar &spinner = region.add_spinner( "waiting" );
+    region.render();
+
+    // Exercise
+    download.set( 50 );
+    console << "first " << Color::FG_LIGHT_RED << "line";
+    console << Color::RESET << "\nsecond line\n" << Color::FG_YELLOW << "third";
+    spinner.finish();
+    console << " line\n";
+
+    // Verify
+    STRCMP_EQUAL( "first line", terminal.get_line( 0 ).c_str() );
+    STRCMP_EQUAL( "second line", terminal.get_line( 1 ).c_str() );
+    STRCMP_EQUAL( "third line", terminal.get_line( 2 ).c_str() );
+    STRCMP_EQUAL( "download                 [#####---------------]  25% 50/200", terminal.get_line( 3 ).c_str() );
+    STRCMP_EQUAL( "waiting                  done", terminal.get_line( 4 ).c_str() );
+    CHECK( terminal.get_cell( 0, 6 ).style.foreground == SgrColor::indexed( 1 ) );
+    CHECK( terminal.get_cell( 3, 0 ).style.is_default() );
+    CHECK( terminal.get_style().foreground == SgrColor::indexed( 3 ) );
+    CHECK_EQUAL( 4u, terminal.get_cursor_row() );
+}
+
+TEST( ColorConsoleLiveRegion, ChangedLinesOnly )
+{
+    // Prepare
+    std::stringbuf output;
+    ColorConsole::Console console( &output, true );
+    LiveRegion region( console, 10, 60 );
+    ProgressBar &first = region.add_bar( "first", 10 );
+    ProgressBar &second = region.add_bar( "second", 10 );
+    region.render();
+    readFromStringBuf( output );
+
+    // Exercise
+    second.advance( 3 );
+    region.render();
+
+    // Verify
+    STRCMP_EQUAL( "\033[?2026h\rsecond                   [\033[49;1;32m######\033[49;1;30m"
+                  "----------------\033[0m]  30% 3/10\033[K\033[?2026l", readFromStringBuf( output ).c_str() );
+
+    // Exercise
+    region.render();
+
+    // Verify
+    STRCMP_EQUAL( "", readFromStringBuf( output ).c_str() );
+
+    // Exercise
+    first.finish();
+    region.render();
+
+    // Verify
+    STRCMP_EQUAL( "\033[?2026h\r\033[1Afirst                    [\033[49;1;32m#####################\033[0m"
+                  "] 100% 10/10\033[K\033[1B\033[?2026l", readFromStringBuf( output ).c_str() );
+}
+
+TEST( ColorConsoleLiveRegion, NarrowTerminal )
+{
+    // Prepare
+    VirtualTerminal terminal( 20, 10 );
+    ColorConsole::Console console( &terminal, true );
+    LiveRegion region( console, 10, 20 );
+    ProgressBar &download = region.add_bar( "download-archive", 200 );
+    region.add_spinner( "waiting" );
+    region.render();
+
+    // Exercise: the lines must not wrap, or the region would not be erased properly
+    download.set( 50 );
+    console << "output\n";
+
+    // Verify
+    STRCMP_EQUAL( "output\ndownload- []  25% 5\nwaiting   -", terminal.get_text().c_str() );
+    CHECK_EQUAL( 2u, terminal.get_cursor_row() );
+}
+
+TEST( ColorConsoleLiveRegion, Destruction )
+{
+    // Prepare
+    VirtualTerminal terminal( 60, 10 );
+    ColorConsole::Console console( &terminal, true );
+
+    {
+        LiveRegion region( console, 10, 60 );
+        region.add_bar( "task", 4 ).set( 4 );
+        region.render();
+
+        // Exercise
+        console << "partial";
+    }
+
+    // Verify
+    STRCMP_EQUAL( "task                     [#######################] 100% 4/4\npartial", terminal.get_text().c_str() );
+    CHECK( console.rdbuf() == &terminal );
+}
+
+TEST( ColorConsoleLiveRegion, NoAnsi )
+{
+    // Prepare
+    std::stringbuf output;
+    ColorConsole::Console console( &output, false );
+    LiveRegion region( console, 10, 60 );
+    ProgressBar &first = region.add_bar( "first", 10 );
+    region.add_spinner( "second" );
+
+    // Exercise
+    region.render();
+    console << "log\n";
+    first.finish();
+    region.render();
+    region.render();
+
+    // Verify
+    STRCMP_EQUAL( "log\nfirst                    [#####################] 100% 10/10\n", readFromStringBuf( output ).c_str() );
+}
+
+TEST( ColorConsoleLiveRegion, Threads )
+{
+    // Prepare
+    VirtualTerminal terminal( 80, 500 );
+    ColorConsole::Console console( &terminal, true );
+    std::vector<std::thread> workers;
+    std::mutex consoleMutex;
+
+    {
+        LiveRegion region( console, 1000, 80 );
+        region.start();
+
+        // Exercise
+        for( int worker = 0; worker < 4; worker++ )
+        {
+            ProgressBar &bar = region.add_bar( "worker " + std::to_string( worker ), 100 );
+            workers.emplace_back( [&console, &consoleMutex, &region, &bar, worker]()
+            {
+                for( int i = 0; i < 100; i++ )
+                {
+                    bar.advance();
+                    region.tick();
+                    if( i % 10 == 0 )
+                    {
+                        std::lock_guard<std::mutex> lock( consoleMutex );
+                        console << ( "worker " + std::to_string( worker ) + " step " + std::to_string( i ) + "\n" );
+                    }
+                }
+                bar.finish();
+            } );
+        }
+
+        for( std::thread &thread : workers )
+        {
+            thread.join();
+        }
+    }
+
+    // Verify: every output line is complete, followed by the final state of the bars
+    std::vector<int> steps( 4, 0 );
+    for( std::size_t row = 0; row < 40; row++ )
+    {
+        const std::string line = terminal.get_line( row );
+        STRCMP_CONTAINS( "worker ", line.c_str() );
+        const int worker = line[7] - '0';
+        CHECK_EQUAL( std::to_string( steps[worker] ), line.substr( 14 ) );
+        steps[worker] += 10;
+    }
+    for( std::size_t row = 40; row < 44; row++ )
+    {
+        STRCMP_CONTAINS( "] 100% 100/100", terminal.get_line( row ).c_str() );
+    }
+    STRCMP_EQUAL( "", terminal.get_line( 44 ).c_str() );
+}
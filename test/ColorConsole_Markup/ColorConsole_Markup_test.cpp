@@ -0,0 +1,197 @@
+/**
+ * @file
+ * @brief      Unit tests for the ColorConsole compile-time markup
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsoleMarkup.hpp"
+
+#include "TestHelpers.hpp"
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::markup;
+using ColorConsole::Color;
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsoleMarkup )
+{
+    std::stringbuf outBuffer;
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsoleMarkup, Compilation )
+{
+    //////////////////////////////////////////////////////////////////////////
+    // Plain text
+    //
+
+    // Verify
+    constexpr auto plain = markup<"Nothing to color">;
+    static_assert( plain.view().changeCount == 0 );
+    STRCMP_EQUAL( "Nothing to color", std::string( plain.view().ansi ).c_str() );
+
+    //////////////////////////////////////////////////////////////////////////
+    // Foreground and background colors
+    //
+
+    // Verify
+    constexpr auto colored = markup<"{fg:light_red}ERROR{/} {bg:blue}x{/}">;
+    static_assert( colored.view().changeCount == 4 );
+    STRCMP_EQUAL( "\033[49;1;31mERROR\033[0m \033[44;30mx\033[0m", std::string( colored.view().ansi ).c_str() );
+    STRCMP_EQUAL( "ERROR x", std::string( colored.view().plain ).c_str() );
+    CHECK_EQUAL( static_cast<int>( Color::RESET ), static_cast<int>( colored.view().finalColor ) );
+
+    //////////////////////////////////////////////////////////////////////////
+    // Nested tags restore the enclosing color, redundant changes are coalesced
+    //
+
+    // Verify
+    constexpr auto nested = markup<"{yellow,bg:dark_red}A{fg:white}B{/}{/}{red}{/}C">;
+    STRCMP_EQUAL( "\033[41;1;33mA\033[41;1;37mB\033[0mC", std::string( nested.view().ansi ).c_str() );
+    CHECK_EQUAL( 2u, nested.view().changes[2].position );
+
+    //////////////////////////////////////////////////////////////////////////
+    // Literal braces
+    //
+
+    // Verify
+    constexpr auto braces = markup<"{{{green}x{/}}}">;
+    STRCMP_EQUAL( "{\033[49;32mx\033[0m}", std::string( braces.view().ansi ).c_str() );
+    STRCMP_EQUAL( "{x}", std::string( braces.view().plain ).c_str() );
+
+    //////////////////////////////////////////////////////////////////////////
+    // Unclosed tags leave the color set
+    //
+
+    // Verify
+    constexpr auto unclosed = markup<"{bg:black,fg:light_green}OK">;
+    STRCMP_EQUAL( "\033[40;1;32mOK", std::string( unclosed.view().ansi ).c_str() );
+    CHECK_EQUAL( static_cast<int>( Color::FG_LIGHT_GREEN | Color::BG_BLACK ), static_cast<int>( unclosed.view().finalColor ) );
+}
+
+TEST( ColorConsoleMarkup, Validation )
+{
+    using ColorConsole::isValidMarkup;
+    using ColorConsole::measureMarkup;
+    using ColorConsole::MarkupError;
+
+    static_assert( isValidMarkup( "{red}x{/}" ) );
+    static_assert( isValidMarkup( "{ fg:red , bg:none }x" ) );
+
+    CHECK( measureMarkup( "{red" ).status.error == MarkupError::UNTERMINATED_TAG );
+    CHECK( measureMarkup( "a}b" ).status.error == MarkupError::UNMATCHED_BRACE );
+    CHECK( measureMarkup( "{}" ).status.error == MarkupError::EMPTY_TAG );
+    CHECK( measureMarkup( "{red,}" ).status.error == MarkupError::EMPTY_TAG );
+    CHECK( measureMarkup( "{fg:pink}" ).status.error == MarkupError::UNKNOWN_COLOR );
+    CHECK( measureMarkup( "{bg:none,reddish}" ).status.error == MarkupError::UNKNOWN_COLOR );
+    CHECK( measureMarkup( "x{/}" ).status.error == MarkupError::UNBALANCED_CLOSE );
+    CHECK_EQUAL( 1, measureMarkup( "x{/}" ).status.position );
+    CHECK( measureMarkup( "{red}{red}{red}{red}{red}{red}{red}{red}{red}{red}{red}{red}{red}{red}{red}{red}{red}" ).status.error
+           == MarkupError::NESTING_TOO_DEEP );
+}
+
+TEST( ColorConsoleMarkup, Output )
+{
+    //////////////////////////////////////////////////////////////////////////
+    // Creation
+    //
+
+    // Prepare
+
+    // Exercise
+    ColorConsole::Console* out = new ColorConsole::Console( &outBuffer, true );
+
+    // Verify
+    mock().checkExpectations();
+    CHECK_EQUAL( 0, outBuffer.in_avail() );
+    CHECK_EQUAL( static_cast<int>( Color::RESET ), static_cast<int>( out->get_color() ) );
+
+    // Cleanup
+    mock().clear();
+
+    //////////////////////////////////////////////////////////////////////////
+    // Write markup
+    //
+
+    // Prepare
+
+    // Exercise
+    *out << markup<"{light_cyan}Info:{/} {bg:white}done">;
+
+    // Verify
+    mock().checkExpectations();
+    STRCMP_EQUAL( "\033[49;1;36mInfo:\033[0m \033[107;30mdone", readFromStringBuf(outBuffer).c_str() );
+    CHECK_EQUAL( static_cast<int>( Color::BG_WHITE ), static_cast<int>( out->get_color() ) );
+
+    // Cleanup
+    mock().clear();
+
+    //////////////////////////////////////////////////////////////////////////
+    // Write markup without colors
+    //
+
+    // Prepare
+
+    // Exercise
+    *out << markup<"Plain">;
+
+    // Verify
+    mock().checkExpectations();
+    STRCMP_EQUAL( "Plain", readFromStringBuf(outBuffer).c_str() );
+    CHECK_EQUAL( static_cast<int>( Color::BG_WHITE ), static_cast<int>( out->get_color() ) );
+
+    // Cleanup
+    mock().clear();
+
+    //////////////////////////////////////////////////////////////////////////
+    // Write markup with coloring disabled
+    //
+
+    // Prepare
+    out->disable_coloring();
+
+    // Exercise
+    *out << markup<"{red}A{/}B">;
+
+    // Verify
+    mock().checkExpectations();
+    STRCMP_EQUAL( "AB", readFromStringBuf(outBuffer).c_str() );
+    CHECK_EQUAL( static_cast<int>( Color::RESET ), static_cast<int>( out->get_color() ) );
+
+    // Cleanup
+    mock().clear();
+
+    //////////////////////////////////////////////////////////////////////////
+    // Destruction
+    //
+
+    // Prepare
+
+    // Exercise
+    delete out;
+
+    // Verify
+    mock().checkExpectations();
+    CHECK_EQUAL( 0, outBuffer.in_avail() );
+
+    // Cleanup
+}
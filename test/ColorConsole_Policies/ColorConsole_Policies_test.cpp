@@ -0,0 +1,166 @@
+/**
+ * @file
+ * @brief      Unit tests for the ColorConsole color policies
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsole.hpp"
+#include "ColorConsolePolicies.hpp"
+
+#include "TestHelpers.hpp"
+
+#include <iomanip>
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::Color;
+using ColorConsole::ColorRun;
+using ColorConsole::DynamicColorPolicy;
+
+/**
+ * Custom policy that renders colors as tags.
+ */
+struct TagColorPolicy
+{
+    unsigned int calls = 0;
+
+    void set_color( std::ostream &out, Color color )
+    {
+        calls++;
+        out << "<" << std::hex << static_cast<int>( color ) << std::dec << ">";
+    }
+};
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsolePolicies )
+{
+    std::stringbuf outBuffer;
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsolePolicies, Ansi )
+{
+    // Prepare
+    ColorConsole::AnsiConsole* out = new ColorConsole::AnsiConsole( &outBuffer );
+
+    // Exercise
+    *out << Color::FG_LIGHT_RED << "E" << Color::RESET << ' ' << std::setw( 3 ) << 7 << std::endl;
+
+    // Verify
+    STRCMP_EQUAL( "\033[49;1;31mE\033[0m   7\n", readFromStringBuf(outBuffer).c_str() );
+
+    // Exercise
+    out->set_color( Color::FG_DARK_BLUE );
+    delete out;
+
+    // Verify
+    STRCMP_EQUAL( "\033[49;34m\033[0m", readFromStringBuf(outBuffer).c_str() );
+}
+
+TEST( ColorConsolePolicies, NoColor )
+{
+    // Prepare
+    ColorConsole::PlainConsole* out = new ColorConsole::PlainConsole( &outBuffer );
+
+    // Exercise
+    *out << Color::FG_LIGHT_RED << "E" << Color::FG_YELLOW << " x";
+
+    // Verify
+    STRCMP_EQUAL( "E x", readFromStringBuf(outBuffer).c_str() );
+    CHECK_EQUAL( static_cast<int>( Color::FG_YELLOW ), static_cast<int>( out->get_color() ) );
+
+    // Cleanup
+    delete out;
+    CHECK_EQUAL( 0, outBuffer.in_avail() );
+}
+
+TEST( ColorConsolePolicies, Recording )
+{
+    // Prepare
+    ColorConsole::RecordingConsole out;
+
+    // Exercise
+    out << "a" << Color::FG_LIGHT_RED << Color::FG_YELLOW << "bc" << 1 << Color::FG_YELLOW << "d" << Color::RESET << "e";
+
+    // Verify
+    std::vector<ColorRun> runs = out.get_policy().runs();
+    STRCMP_EQUAL( "abc1de", std::string( out.get_policy().text() ).c_str() );
+    CHECK_EQUAL( 3u, runs.size() );
+    CHECK_EQUAL( static_cast<int>( Color::RESET ), static_cast<int>( runs[0].color ) );
+    STRCMP_EQUAL( "a", std::string( runs[0].text ).c_str() );
+    CHECK_EQUAL( static_cast<int>( Color::FG_YELLOW ), static_cast<int>( runs[1].color ) );
+    STRCMP_EQUAL( "bc1d", std::string( runs[1].text ).c_str() );
+    CHECK_EQUAL( static_cast<int>( Color::RESET ), static_cast<int>( runs[2].color ) );
+    STRCMP_EQUAL( "e", std::string( runs[2].text ).c_str() );
+
+    // Exercise
+    out.get_policy().clear();
+
+    // Verify
+    CHECK_EQUAL( 0u, out.get_policy().runs().size() );
+}
+
+TEST( ColorConsolePolicies, Custom )
+{
+    // Prepare
+    ColorConsole::BasicConsole<TagColorPolicy> out( &outBuffer );
+
+    // Exercise
+    out << Color::FG_WHITE << "w" << Color::RESET;
+
+    // Verify
+    STRCMP_EQUAL( "<f>w<20000>", readFromStringBuf(outBuffer).c_str() );
+    CHECK_EQUAL( 2u, out.get_policy().calls );
+}
+
+TEST( ColorConsolePolicies, Dynamic )
+{
+    // Prepare
+    ColorConsole::Console* out = new ColorConsole::Console( &outBuffer, true );
+    std::ostream stream( &outBuffer );
+    DynamicColorPolicy policy;
+
+    // Exercise
+    policy.set_color( stream, Color::FG_LIGHT_RED );
+
+    // Verify
+    CHECK( policy.get_mode() == DynamicColorPolicy::Mode::ANSI );
+    STRCMP_EQUAL( "\033[49;1;31m", readFromStringBuf(outBuffer).c_str() );
+
+    // Exercise
+    policy.set_mode( DynamicColorPolicy::Mode::NONE );
+    policy.set_color( stream, Color::FG_LIGHT_RED );
+
+    // Verify
+    CHECK_EQUAL( 0, outBuffer.in_avail() );
+
+    // Exercise
+    out->disable_coloring();
+    *out << Color::FG_LIGHT_RED << "x";
+    out->enable_coloring();
+    *out << Color::RESET << "y";
+
+    // Verify
+    STRCMP_EQUAL( "x\033[0my", readFromStringBuf(outBuffer).c_str() );
+
+    // Cleanup
+    delete out;
+}
@@ -0,0 +1,243 @@
+/**
+ * @file
+ * @brief      Unit tests for the ColorConsole recordings of colored output
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleRecording.hpp"
+
+#include "TestHelpers.hpp"
+
+#include <sstream>
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::Color;
+using ColorConsole::ColorCapability;
+using ColorConsole::RecordingReader;
+using ColorConsole::RecordingStreamBuf;
+using ColorConsole::RecordingWriter;
+using ColorConsole::SgrStyle;
+
+/**
+ * Writes a recording with one line per millisecond, colored by its number.
+ */
+static std::string recordLines( unsigned int lineCount, bool finish = true )
+{
+    std::stringbuf recording;
+    {
+        RecordingWriter writer( &recording );
+
+        for( unsigned int i = 0; i < lineCount; i++ )
+        {
+            const std::string line = "line " + std::to_string( i ) + "\n";
+            writer.write( SgrStyle::from_color( static_cast<Color>( i % 16 ) ), line, i );
+        }
+
+        if( !finish )
+        {
+            writer.flush_block();
+            return recording.str();
+        }
+    }
+
+    return recording.str();
+}
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsoleRecording )
+{
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsoleRecording, ConsoleRoundTrip )
+{
+    // Prepare
+    std::stringbuf recording;
+    {
+        RecordingStreamBuf recorder( &recording );
+        ColorConsole::Console console( &recorder );
+
+        console << Color::FG_LIGHT_RED << "Error" << Color::RESET << ": disk " << ( Color::FG_WHITE | Color::BG_DARK_BLUE )
+                << 97 << '%' << Color::RESET << " full\n";
+        console.write_raw( "\033[4;38;2;1;2;3mrgb\033[0m\n" );
+    }
+    std::istringstream input( recording.str() );
+
+    // Exercise
+    RecordingReader reader( input );
+    std::string plain;
+    std::string basic;
+    std::string full;
+    SgrStyle currentStyle;
+    reader.replay_from_line( 0, [&]( const SgrStyle &style, std::string_view text, std::uint64_t )
+    {
+        if( !( style == currentStyle ) )
+        {
+            basic.append( ColorConsole::sgrSequence( style, ColorCapability::BASIC ).view() );
+            full.append( ColorConsole::sgrSequence( style, ColorCapability::TRUE_COLOR ).view() );
+            currentStyle = style;
+        }
+        plain.append( text );
+        basic.append( text );
+        full.append( text );
+    } );
+
+    // Verify
+    CHECK_TRUE( reader.is_valid() );
+    CHECK( reader.get_start_time() > 0 );
+    CHECK_EQUAL( 1u, reader.get_blocks().size() );
+    STRCMP_EQUAL( "Error: disk 97% full\nrgb\n", plain.c_str() );
+    STRCMP_EQUAL( "\033[49;1;31mError\033[0m: disk \033[44;1;37m97%\033[0m full\n\033[49;30mrgb\033[0m\n", basic.c_str() );
+    STRCMP_EQUAL( "\033[0;1;31mError\033[0m: disk \033[0;1;37;44m97%\033[0m full\n\033[0;4;38;2;1;2;3mrgb\033[0m\n", full.c_str() );
+}
+
+TEST( ColorConsoleRecording, Compact )
+{
+    // Prepare
+    std::string ansi;
+    for( unsigned int i = 0; i < 20000; i++ )
+    {
+        ansi += ColorConsole::ansiEscape( static_cast<Color>( i % 16 ) ).view();
+        ansi += "line " + std::to_string( i ) + "\n";
+    }
+
+    std::stringbuf recording;
+    {
+        RecordingStreamBuf recorder( &recording );
+        recorder.sputn( ansi.data(), static_cast<std::streamsize>( ansi.size() ) );
+    }
+
+    // Verify
+    CHECK( recording.str().size() < ansi.size() * 3 / 4 );
+}
+
+TEST( ColorConsoleRecording, SeekLine )
+{
+    // Prepare
+    std::istringstream input( recordLines( 20000 ) );
+    RecordingReader reader( input );
+    std::string text;
+    SgrStyle firstStyle;
+
+    // Exercise
+    reader.replay_from_line( 12345, [&]( const SgrStyle &style, std::string_view run, std::uint64_t )
+    {
+        if( text.empty() )
+        {
+            firstStyle = style;
+        }
+        text.append( run );
+    } );
+
+    // Verify
+    CHECK( reader.get_blocks().size() > 2 );
+    CHECK( reader.get_blocks()[reader.find_line( 12345 )].line < 12345 );
+    STRCMP_EQUAL( "line 12345\nline 12346\n", text.substr( 0, 22 ).c_str() );
+    CHECK( text.size() > 7000 * 10 );
+    CHECK_EQUAL( static_cast<unsigned int>( 12345 % 16 ), static_cast<unsigned int>( firstStyle.to_color() ) );
+
+    // Exercise
+    text.clear();
+    reader.replay_from_line( 0, [&]( const SgrStyle&, std::string_view run, std::uint64_t ) { text.append( run ); } );
+
+    // Verify
+    STRCMP_EQUAL( "line 0\nline 1\n", text.substr( 0, 14 ).c_str() );
+}
+
+TEST( ColorConsoleRecording, SeekTime )
+{
+    // Prepare
+    std::istringstream input( recordLines( 20000 ) );
+    RecordingReader reader( input );
+    std::string text;
+    std::uint64_t firstTime = 0;
+
+    // Exercise
+    reader.replay_from_time( 15000, [&]( const SgrStyle&, std::string_view run, std::uint64_t time )
+    {
+        if( text.empty() )
+        {
+            firstTime = time;
+        }
+        text.append( run );
+    } );
+
+    // Verify
+    CHECK_EQUAL( 15000u, firstTime );
+    STRCMP_EQUAL( "line 15000\n", text.substr( 0, 11 ).c_str() );
+    CHECK_EQUAL( reader.get_blocks().size() - 1, reader.find_time( 1000000 ) );
+    CHECK_EQUAL( 0u, reader.find_time( 0 ) );
+}
+
+TEST( ColorConsoleRecording, MissingIndex )
+{
+    // Prepare
+    const std::string complete = recordLines( 20000 );
+    std::string interrupted = recordLines( 20000, false );
+    std::istringstream completeInput( complete );
+    const std::size_t blockCount = RecordingReader( completeInput ).get_blocks().size();
+
+    // Exercise
+    std::istringstream input( interrupted );
+    RecordingReader reader( input );
+
+    // Verify
+    CHECK_TRUE( reader.is_valid() );
+    CHECK_EQUAL( blockCount, reader.get_blocks().size() );
+
+    // Exercise (truncated last block)
+    interrupted.resize( interrupted.size() - 10 );
+    std::istringstream truncatedInput( interrupted );
+    RecordingReader truncated( truncatedInput );
+    std::string text;
+    bool ok = truncated.replay_from_line( 0, [&]( const SgrStyle&, std::string_view run, std::uint64_t ) { text.append( run ); } );
+
+    // Verify
+    CHECK_TRUE( ok );
+    CHECK_EQUAL( blockCount - 1, truncated.get_blocks().size() );
+    STRCMP_EQUAL( "line 0\n", text.substr( 0, 7 ).c_str() );
+}
+
+TEST( ColorConsoleRecording, Corrupted )
+{
+    // Prepare
+    std::string data = recordLines( 100 );
+    data[20] = '\x7F';
+
+    std::istringstream input( data );
+    RecordingReader reader( input );
+
+    // Exercise
+    bool ok = reader.read_block( 0, []( const SgrStyle&, std::string_view, std::uint64_t ) {} );
+
+    // Verify
+    CHECK_FALSE( ok );
+    CHECK_FALSE( reader.read_block( 1000, []( const SgrStyle&, std::string_view, std::uint64_t ) {} ) );
+
+    // Exercise
+    std::istringstream invalidInput( "not a recording" );
+    RecordingReader invalid( invalidInput );
+
+    // Verify
+    CHECK_FALSE( invalid.is_valid() );
+}
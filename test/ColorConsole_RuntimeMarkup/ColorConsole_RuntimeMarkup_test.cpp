@@ -0,0 +1,253 @@
+/**
+ * @file
+ * @brief      Unit tests for the ColorConsole runtime markup
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsolePalette.hpp"
+
+#include "TestHelpers.hpp"
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::Color;
+using ColorConsole::Palette;
+
+/**
+ * Argument that writes enough templates to replace all the entries of the template cache.
+ */
+struct CacheFlooder
+{
+};
+
+static std::ostream& operator<<( ColorConsole::Console &console, const CacheFlooder& )
+{
+    for( int i = 0; i < 64; i++ )
+    {
+        std::string markup = "{0}";
+        markup[1] = static_cast<char>( '0' + ( i % 10 ) );
+        markup.append( static_cast<std::size_t>( i ), '-' );
+        console.printm( markup, "", "", "", "", "", "", "", "", "", "" );
+    }
+    return console;
+}
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsoleRuntimeMarkup )
+{
+    std::stringbuf outBuffer;
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsoleRuntimeMarkup, Palette )
+{
+    Palette palette( false );
+    Color color = Color::RESET;
+
+    CHECK_FALSE( palette.find( "warn", color ) );
+
+    unsigned long long version = palette.get_version();
+    palette.set( "warn", Color::FG_BROWN );
+    CHECK( palette.get_version() != version );
+    CHECK( palette.find( "warn", color ) );
+    CHECK_EQUAL( static_cast<int>( Color::FG_BROWN ), static_cast<int>( color ) );
+
+    CHECK( palette.remove( "warn" ) );
+    CHECK_FALSE( palette.remove( "warn" ) );
+    CHECK_FALSE( palette.find( "warn", color ) );
+
+    CHECK( Palette::default_palette().find( "error", color ) );
+    CHECK_EQUAL( static_cast<int>( Color::FG_LIGHT_RED ), static_cast<int>( color ) );
+}
+
+TEST( ColorConsoleRuntimeMarkup, Validation )
+{
+    using ColorConsole::MarkupError;
+    using ColorConsole::validateMarkup;
+
+    Palette palette( false );
+    palette.set( "alert", Color::FG_WHITE | Color::BG_DARK_RED );
+
+    CHECK( validateMarkup( "{warn}Disk {}%{/}" ).error == MarkupError::NONE );
+    CHECK( validateMarkup( "{alert}{0}{1}{/}", palette ).error == MarkupError::NONE );
+    CHECK( validateMarkup( "{warn}", palette ).error == MarkupError::UNKNOWN_COLOR );
+    CHECK( validateMarkup( "{1x}" ).error == MarkupError::UNKNOWN_COLOR );
+    CHECK( validateMarkup( "{9999}" ).error == MarkupError::NONE );
+    CHECK( validateMarkup( "{10000}" ).error == MarkupError::UNKNOWN_COLOR );
+    CHECK( validateMarkup( "{18446744073709551617}" ).error == MarkupError::UNKNOWN_COLOR );
+}
+
+TEST( ColorConsoleRuntimeMarkup, Output )
+{
+    //////////////////////////////////////////////////////////////////////////
+    // Creation
+    //
+
+    // Prepare
+
+    // Exercise
+    ColorConsole::Console* out = new ColorConsole::Console( &outBuffer, true );
+
+    // Verify
+    mock().checkExpectations();
+    CHECK_EQUAL( 0, outBuffer.in_avail() );
+    CHECK( out->get_palette() == NULL );
+
+    // Cleanup
+    mock().clear();
+
+    //////////////////////////////////////////////////////////////////////////
+    // Write markup with style and argument
+    //
+
+    // Prepare
+    std::string markup = "{warn}Disk {}%{/}";
+
+    // Exercise
+    out->printm( markup, 95 );
+
+    // Verify
+    mock().checkExpectations();
+    STRCMP_EQUAL( "\033[49;1;33mDisk 95%\033[0m", readFromStringBuf(outBuffer).c_str() );
+    CHECK_EQUAL( static_cast<int>( Color::RESET ), static_cast<int>( out->get_color() ) );
+
+    // Cleanup
+    mock().clear();
+
+    //////////////////////////////////////////////////////////////////////////
+    // Write the same template (cached) with other arguments
+    //
+
+    // Prepare
+
+    // Exercise
+    out->printm( markup, "full" );
+
+    // Verify
+    mock().checkExpectations();
+    STRCMP_EQUAL( "\033[49;1;33mDisk full%\033[0m", readFromStringBuf(outBuffer).c_str() );
+
+    // Cleanup
+    mock().clear();
+
+    //////////////////////////////////////////////////////////////////////////
+    // Write the same address with other contents
+    //
+
+    // Prepare
+    markup = "{ok}Disk {}{/}";
+
+    // Exercise
+    out->printm( markup, 'A' );
+
+    // Verify
+    mock().checkExpectations();
+    STRCMP_EQUAL( "\033[49;1;32mDisk A\033[0m", readFromStringBuf(outBuffer).c_str() );
+
+    // Cleanup
+    mock().clear();
+
+    //////////////////////////////////////////////////////////////////////////
+    // Write with custom palette, positional arguments and color names
+    //
+
+    // Prepare
+    Palette palette( false );
+    palette.set( "alert", Color::FG_WHITE | Color::BG_DARK_RED );
+    out->set_palette( &palette );
+
+    // Exercise
+    out->printm( "{alert}{1}{fg:yellow}{0}{/}{/}", "B", "A" );
+
+    // Verify
+    mock().checkExpectations();
+    STRCMP_EQUAL( "\033[41;1;37mA\033[41;1;33mB\033[0m", readFromStringBuf(outBuffer).c_str() );
+
+    // Cleanup
+    mock().clear();
+
+    //////////////////////////////////////////////////////////////////////////
+    // Palette modification invalidates the cached template
+    //
+
+    // Prepare
+    palette.set( "alert", Color::FG_LIGHT_MAGENTA );
+
+    // Exercise
+    out->printm( "{alert}{1}{fg:yellow}{0}{/}{/}", "B", "A" );
+
+    // Verify
+    mock().checkExpectations();
+    STRCMP_EQUAL( "\033[49;1;35mA\033[49;1;33mB\033[0m", readFromStringBuf(outBuffer).c_str() );
+
+    // Cleanup
+    mock().clear();
+
+    //////////////////////////////////////////////////////////////////////////
+    // Templates written from arguments replace the cached template being written
+    //
+
+    // Prepare
+    out->set_palette( NULL );
+
+    // Exercise
+    out->printm( "{ok}<{}>{/}{warn}<{}>{/}", CacheFlooder(), CacheFlooder() );
+
+    // Verify
+    mock().checkExpectations();
+    const std::string flood( 64 * 63 / 2, '-' );
+    STRCMP_EQUAL( ( "\033[49;1;32m<" + flood + ">\033[49;1;33m<" + flood + ">\033[0m" ).c_str(), readFromStringBuf(outBuffer).c_str() );
+
+    // Cleanup
+    mock().clear();
+    out->set_palette( &palette );
+
+    //////////////////////////////////////////////////////////////////////////
+    // Invalid templates are written as is
+    //
+
+    // Prepare
+
+    // Exercise
+    out->printm( "{warn}Disk {}%", 1 );
+
+    // Verify
+    mock().checkExpectations();
+    STRCMP_EQUAL( "{warn}Disk {}%", readFromStringBuf(outBuffer).c_str() );
+
+    // Cleanup
+    mock().clear();
+
+    //////////////////////////////////////////////////////////////////////////
+    // Destruction
+    //
+
+    // Prepare
+
+    // Exercise
+    delete out;
+
+    // Verify
+    mock().checkExpectations();
+    STRCMP_EQUAL( "\033[0m", readFromStringBuf(outBuffer).c_str() );
+
+    // Cleanup
+}
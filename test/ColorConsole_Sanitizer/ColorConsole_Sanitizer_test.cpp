@@ -0,0 +1,255 @@
+/**
+ * @file
+ * @brief      Unit tests for the ColorConsole untrusted text sanitizer
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleSanitizer.hpp"
+
+#include "TestHelpers.hpp"
+
+#include <random>
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::Color;
+using ColorConsole::SanitizeMode;
+using ColorConsole::UnsafeSequence;
+using ColorConsole::findUnsafeSequence;
+using ColorConsole::sanitized;
+using ColorConsole::sanitizeText;
+
+/**
+ * Straightforward (byte by byte) implementation of findUnsafeSequence(), used as reference.
+ */
+static UnsafeSequence findUnsafeSequenceReference( std::string_view text )
+{
+    const unsigned char *data = reinterpret_cast<const unsigned char*>( text.data() );
+    std::size_t pos = 0;
+
+    while( pos < text.size() )
+    {
+        unsigned char c = data[pos];
+
+        if( c < 0x80 )
+        {
+            if( ( c < 0x20 && c != '\t' && c != '\n' ) || ( c == 0x7F ) )
+            {
+                return { pos, 1 };
+            }
+            pos++;
+            continue;
+        }
+
+        std::size_t length = ( c >= 0xF0 ) ? 4 : ( c >= 0xE0 ) ? 3 : ( c >= 0xC0 ) ? 2 : 0;
+        if( ( length == 0 ) || ( c > 0xF4 ) || ( pos + length > text.size() ) )
+        {
+            return { pos, 1 };
+        }
+
+        unsigned int codePoint = c & ( 0x7Fu >> length );
+        for( std::size_t i = 1; i < length; i++ )
+        {
+            if( ( data[pos + i] & 0xC0 ) != 0x80 )
+            {
+                return { pos, 1 };
+            }
+            codePoint = ( codePoint << 6 ) | ( data[pos + i] & 0x3Fu );
+        }
+
+        const unsigned int minCodePoint[] = { 0, 0, 0x80, 0x800, 0x10000 };
+        if( ( codePoint < minCodePoint[length] ) || ( codePoint > 0x10FFFF ) || ( ( codePoint >= 0xD800 ) && ( codePoint <= 0xDFFF ) ) )
+        {
+            return { pos, 1 };
+        }
+
+        if( codePoint < 0xA0 )
+        {
+            return { pos, 2 };
+        }
+
+        pos += length;
+    }
+
+    return { text.size(), 0 };
+}
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsoleSanitizer )
+{
+    std::stringbuf outBuffer;
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsoleSanitizer, SafeText )
+{
+    // Prepare
+    std::string text = "Plain ASCII text\twith tabs,\nnewlines and UTF-8: \xC3\xB1 \xE2\x82\xAC \xF0\x9F\x98\x80 ";
+    text += std::string( 100, 'x' );
+
+    // Exercise
+    UnsafeSequence unsafe = findUnsafeSequence( text );
+
+    // Verify
+    CHECK_EQUAL( text.size(), unsafe.position );
+    CHECK_EQUAL( 0u, unsafe.length );
+    STRCMP_EQUAL( text.c_str(), sanitizeText( text ).c_str() );
+}
+
+TEST( ColorConsoleSanitizer, UnsafeSequences )
+{
+    //////////////////////////////////////////////////////////////////////////
+    // Control characters
+    //////////////////////////////////////////////////////////////////////////
+
+    // Verify
+    STRCMP_EQUAL( "A\\x1b[31mB\\x0d\\x7f\\x00", sanitizeText( std::string_view( "A\033[31mB\r\x7F\0", 10 ) ).c_str() );
+
+    //////////////////////////////////////////////////////////////////////////
+    // C1 control characters
+    //////////////////////////////////////////////////////////////////////////
+
+    // Verify
+    STRCMP_EQUAL( "x\\u009b31my\\u0085", sanitizeText( "x\xC2\x9B" "31my\xC2\x85" ).c_str() );
+    STRCMP_EQUAL( "\xC2\xA0", sanitizeText( "\xC2\xA0" ).c_str() );
+
+    //////////////////////////////////////////////////////////////////////////
+    // Invalid UTF-8
+    //////////////////////////////////////////////////////////////////////////
+
+    // Verify
+    STRCMP_EQUAL( "\\xc0\\xaf", sanitizeText( "\xC0\xAF" ).c_str() );                  // Overlong
+    STRCMP_EQUAL( "\\xed\\xa0\\x80", sanitizeText( "\xED\xA0\x80" ).c_str() );          // Surrogate
+    STRCMP_EQUAL( "\\xf4\\x90\\x80\\x80", sanitizeText( "\xF4\x90\x80\x80" ).c_str() ); // Beyond U+10FFFF
+    STRCMP_EQUAL( "ab\\xe2\\x82", sanitizeText( "ab\xE2\x82" ).c_str() );               // Truncated
+    STRCMP_EQUAL( "\\x80z", sanitizeText( "\x80z" ).c_str() );                         // Lone continuation
+
+    //////////////////////////////////////////////////////////////////////////
+    // Replacement
+    //////////////////////////////////////////////////////////////////////////
+
+    // Verify
+    STRCMP_EQUAL( "a\xEF\xBF\xBD" "b\xEF\xBF\xBD", sanitizeText( "a\033b\xC2\x9B", SanitizeMode::REPLACE ).c_str() );
+    STRCMP_EQUAL( "a\033b", sanitizeText( "a\033b", SanitizeMode::NONE ).c_str() );
+}
+
+TEST( ColorConsoleSanitizer, UnsafeSequencePositions )
+{
+    // Prepare
+    std::string text( 100, 'a' );
+
+    for( std::size_t i = 0; i < text.size(); i++ )
+    {
+        std::string dirty = text;
+        dirty[i] = '\033';
+
+        // Exercise
+        UnsafeSequence unsafe = findUnsafeSequence( dirty );
+
+        // Verify
+        CHECK_EQUAL( i, unsafe.position );
+        CHECK_EQUAL( 1u, unsafe.length );
+    }
+}
+
+TEST( ColorConsoleSanitizer, Fuzz )
+{
+    // Prepare
+    std::mt19937 generator( 12345 );
+    const char alphabet[] = { 'a', ' ', '\t', '\n', '\r', '\033', '\x7F', '\0', '\x80', '\x9B', '\xA0', '\xBF',
+                              '\xC0', '\xC2', '\xDF', '\xE0', '\xED', '\xEF', '\xF0', '\xF4', '\xF5', '\xFF' };
+
+    for( int iteration = 0; iteration < 20000; iteration++ )
+    {
+        std::string text( generator() % 80, 'x' );
+        const bool mostlyAscii = ( iteration % 2 ) == 0;
+
+        for( char &c : text )
+        {
+            if( !mostlyAscii || ( ( generator() % 16 ) == 0 ) )
+            {
+                c = alphabet[generator() % sizeof( alphabet )];
+            }
+        }
+
+        // Exercise
+        UnsafeSequence unsafe = findUnsafeSequence( text );
+        UnsafeSequence expected = findUnsafeSequenceReference( text );
+        std::string escaped = sanitizeText( text, SanitizeMode::ESCAPE );
+        std::string replaced = sanitizeText( text, SanitizeMode::REPLACE );
+
+        // Verify
+        CHECK_EQUAL( expected.position, unsafe.position );
+        CHECK_EQUAL( expected.length, unsafe.length );
+        CHECK_EQUAL( 0u, findUnsafeSequence( escaped ).length );
+        CHECK_EQUAL( 0u, findUnsafeSequence( replaced ).length );
+        if( unsafe.length == 0 )
+        {
+            CHECK( escaped == text );
+        }
+    }
+}
+
+TEST( ColorConsoleSanitizer, Insert )
+{
+    // Prepare
+    ColorConsole::Console console( &outBuffer );
+
+    // Exercise
+    console << Color::FG_LIGHT_RED << "User: " << sanitized( "bob\033[32m" ) << Color::RESET;
+    console.width( 12 );
+    console << sanitized( "x\033y" ) << '|';
+    console << sanitized( "x\033y", SanitizeMode::REPLACE ) << std::string( "\033" );
+
+    // Verify
+    STRCMP_EQUAL( "\033[49;1;31mUser: bob\\x1b[32m\033[0m      x\\x1by|x\xEF\xBF\xBDy\033",
+                  readFromStringBuf( outBuffer ).c_str() );
+}
+
+TEST( ColorConsoleSanitizer, ConsoleWide )
+{
+    // Prepare
+    ColorConsole::Console console( &outBuffer );
+    const std::string text = "b\033c";
+
+    // Exercise
+    console.set_sanitize_mode( SanitizeMode::ESCAPE );
+    console << Color::FG_DARK_BLUE << "a\033" << text << std::string_view( "\xC2\x9B" )
+            << reinterpret_cast<const unsigned char*>( "\r" ) << Color::RESET;
+
+    // Verify
+    CHECK( SanitizeMode::ESCAPE == console.get_sanitize_mode() );
+    STRCMP_EQUAL( "\033[49;34ma\\x1bb\\x1bc\\u009b\\x0d\033[0m", readFromStringBuf( outBuffer ).c_str() );
+
+    // Exercise: single characters
+    console << '\033' << 'x' << static_cast<unsigned char>( 0x9B ) << static_cast<signed char>( '\b' ) << '\n';
+
+    // Verify
+    STRCMP_EQUAL( "\\x1bx\\x9b\\x08\n", readFromStringBuf( outBuffer ).c_str() );
+
+    // Exercise
+    console.set_sanitize_mode( SanitizeMode::NONE );
+    console << "\033" << '\033';
+
+    // Verify
+    STRCMP_EQUAL( "\033\033", readFromStringBuf( outBuffer ).c_str() );
+}
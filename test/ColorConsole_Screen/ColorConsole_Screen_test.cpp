@@ -0,0 +1,246 @@
+/**
+ * @file
+ * @brief      Unit tests for the ColorConsole double-buffered screen
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleScreen.hpp"
+#include "ColorConsoleTerminal.hpp"
+#include "ColorConsoleWidth.hpp"
+
+#include "TestHelpers.hpp"
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::Color;
+using ColorConsole::ColorCapability;
+using ColorConsole::Screen;
+using ColorConsole::SgrColor;
+using ColorConsole::SgrStyle;
+using ColorConsole::TerminalCell;
+using ColorConsole::VirtualTerminal;
+
+/**
+ * Checks that the virtual terminal displays the back buffer of the screen.
+ */
+static void checkDisplayed( const Screen &screen, const VirtualTerminal &terminal )
+{
+    const std::size_t columns = screen.get_columns();
+
+    for( std::size_t row = 0; row < screen.get_rows(); row++ )
+    {
+        for( std::size_t column = 0; column < columns; column++ )
+        {
+            const TerminalCell &cell = screen.get_cell( row, column );
+            const unsigned int width = ColorConsole::code_point_width( cell.character );
+
+            if( ( width == 2 ) && ( column + 1 < columns ) &&
+                ( screen.get_cell( row, column + 1 ).character == ColorConsole::TERMINAL_WIDE_CONTINUATION ) )
+            {
+                // Wide characters cover the next cell
+                CHECK( cell == terminal.get_cell( row, column ) );
+                CHECK( ColorConsole::TERMINAL_WIDE_CONTINUATION == terminal.get_cell( row, ++column ).character );
+            }
+            else if( width != 1 )
+            {
+                // Characters that do not occupy exactly their cells are displayed as blanks
+                CHECK( ( TerminalCell{ U' ', cell.style } ) == terminal.get_cell( row, column ) );
+            }
+            else
+            {
+                CHECK( cell == terminal.get_cell( row, column ) );
+            }
+        }
+    }
+}
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsoleScreen )
+{
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsoleScreen, RandomFrames )
+{
+    // Prepare
+    VirtualTerminal terminal( 40, 12 );
+    ColorConsole::Console console( &terminal, true );
+    Screen screen( console, 40, 12 );
+
+    const SgrStyle styles[] =
+    {
+        SgrStyle(), SgrStyle::from_color( Color::FG_LIGHT_RED ), SgrStyle::from_color( Color::FG_WHITE | Color::BG_DARK_BLUE ),
+        SgrStyle{ SgrColor::rgb( 10, 200, 30 ), SgrColor::indexed( 200 ), ColorConsole::SGR_UNDERLINE | ColorConsole::SGR_DIM },
+        SgrStyle{ SgrColor(), SgrColor::indexed( 9 ), ColorConsole::SGR_BOLD | ColorConsole::SGR_ITALIC }
+    };
+    const char32_t characters[] = { U' ', U'a', U'#', U'é', U'█', U'\U0001F600' };
+    unsigned int seed = 12345;
+    auto random = [&seed]( unsigned int range )
+    {
+        seed = seed * 1103515245u + 12345u;
+        return ( seed >> 16 ) % range;
+    };
+
+    for( int frame = 0; frame < 200; frame++ )
+    {
+        // Exercise: few scattered changes, runs of changes or a full repaint
+        const unsigned int changes = ( frame % 50 == 0 ) ? 480 : random( 30 );
+        for( unsigned int i = 0; i < changes; i++ )
+        {
+            TerminalCell &cell = screen.at( random( 12 ), random( 40 ) );
+            cell.character = characters[random( 6 )];
+            cell.style = styles[random( 5 )];
+        }
+        screen.print( random( 12 ), random( 40 ), ( frame % 2 ) ? "status: ok" : "\xE7\x8A\xB6\xE6\x80\x81: ok", styles[random( 5 )] );
+
+        screen.present();
+
+        // Verify
+        checkDisplayed( screen, terminal );
+    }
+
+    CHECK_EQUAL( 0u, terminal.get_stats().scrolledLines );
+}
+
+TEST( ColorConsoleScreen, MinimalUpdates )
+{
+    // Prepare
+    std::stringbuf output;
+    ColorConsole::Console console( &output, true );
+    Screen screen( console, 80, 24 );
+    screen.print( 0, 0, "CPU 10%" );
+    screen.print( 1, 0, "MEM 20%" );
+    screen.present();
+    readFromStringBuf( output );
+
+    // Exercise
+    const std::size_t unchangedSize = screen.present();
+
+    // Verify
+    CHECK_EQUAL( 0u, unchangedSize );
+    STRCMP_EQUAL( "", readFromStringBuf( output ).c_str() );
+
+    // Exercise
+    screen.print( 0, 4, "15" );
+    screen.print( 1, 4, "25", SgrStyle::from_color( Color::FG_LIGHT_RED ) );
+    const std::size_t changedSize = screen.present();
+
+    // Verify
+    STRCMP_EQUAL( "\033[?2026h\033[A\b\b5\033[B\b\b\033[1;31m25\033[?2026l", readFromStringBuf( output ).c_str() );
+    CHECK_EQUAL( 36u, changedSize );
+
+    // Exercise: the unchanged gap is rewritten, as it is shorter than moving over it
+    screen.set_synchronized_updates( false );
+    screen.print( 1, 3, "*", SgrStyle::from_color( Color::FG_LIGHT_RED ) );
+    screen.print( 1, 6, "!", SgrStyle::from_color( Color::FG_LIGHT_RED ) );
+    screen.present();
+
+    // Verify
+    STRCMP_EQUAL( "\b\b\b*25!", readFromStringBuf( output ).c_str() );
+}
+
+TEST( ColorConsoleScreen, Release )
+{
+    // Prepare
+    VirtualTerminal terminal( 20, 5 );
+    ColorConsole::Console console( &terminal, true );
+
+    {
+        Screen screen( console, 20, 5 );
+        screen.print( 0, 0, "top", SgrStyle::from_color( Color::FG_YELLOW ) );
+        screen.print( 4, 15, "bottom\x01", SgrStyle::from_color( Color::FG_YELLOW ) );
+
+        // Exercise
+        screen.present();
+
+        // Verify
+        STRCMP_EQUAL( "top\n\n\n\n               botto", terminal.get_text().c_str() );
+        CHECK_FALSE( terminal.is_cursor_visible() );
+    }
+
+    // Verify
+    CHECK_TRUE( terminal.is_cursor_visible() );
+    CHECK_TRUE( terminal.get_style().is_default() );
+    CHECK_EQUAL( 1u, terminal.get_stats().scrolledLines );
+    CHECK_EQUAL( 4u, terminal.get_cursor_row() );
+    CHECK_EQUAL( 0u, terminal.get_cursor_column() );
+}
+
+TEST( ColorConsoleScreen, Resize )
+{
+    // Prepare
+    VirtualTerminal terminal( 30, 6 );
+    ColorConsole::Console console( &terminal, true );
+    Screen screen( console, 20, 4 );
+    screen.fill( 0, 0, 100, 100, TerminalCell{ U'x', SgrStyle() } );
+    screen.present();
+
+    // Exercise
+    screen.resize( 30, 6 );
+    screen.fill( 1, 1, 2, 2, TerminalCell{ U'o', SgrStyle::from_color( Color::BG_DARK_GREEN ) } );
+    screen.present();
+
+    // Verify
+    STRCMP_EQUAL( "\n oo\n oo", terminal.get_text().c_str() );
+    checkDisplayed( screen, terminal );
+}
+
+TEST( ColorConsoleScreen, WideCharacters )
+{
+    // Prepare
+    VirtualTerminal terminal( 10, 3 );
+    ColorConsole::Console console( &terminal, true );
+    Screen screen( console, 10, 3 );
+
+    // Exercise: wide characters occupy two cells, combining marks none, and wide characters are not split
+    const std::size_t used = screen.print( 0, 0, "\xE6\x97\xA5\xE6\x9C\xAC" "e\xCC\x81" "abcd\xE6\x97\xA5" );
+    screen.present();
+
+    // Verify
+    CHECK_EQUAL( 9u, used );
+    STRCMP_EQUAL( "\xE6\x97\xA5\xE6\x9C\xAC" "eabcd", terminal.get_text().c_str() );
+    checkDisplayed( screen, terminal );
+
+    // Exercise: overwriting half of a wide character blanks its other half
+    screen.print( 0, 3, "x" );
+    screen.present();
+
+    // Verify
+    STRCMP_EQUAL( "\xE6\x97\xA5 x" "eabcd", terminal.get_text().c_str() );
+    checkDisplayed( screen, terminal );
+}
+
+TEST( ColorConsoleScreen, SgrTransition )
+{
+    // Prepare
+    const SgrStyle bold = SgrStyle{ SgrColor::indexed( 1 ), SgrColor(), ColorConsole::SGR_BOLD | ColorConsole::SGR_DIM };
+    const SgrStyle dim = SgrStyle{ SgrColor::indexed( 1 ), SgrColor::indexed( 4 ), ColorConsole::SGR_DIM };
+
+    // Exercise & Verify
+    STRCMP_EQUAL( "", ColorConsole::sgrTransition( bold, bold, ColorCapability::TRUE_COLOR ).view().data() );
+    STRCMP_EQUAL( "\033[22;2;44m", std::string( ColorConsole::sgrTransition( bold, dim, ColorCapability::TRUE_COLOR ).view() ).c_str() );
+    STRCMP_EQUAL( "\033[0m", std::string( ColorConsole::sgrTransition( dim, SgrStyle(), ColorCapability::TRUE_COLOR ).view() ).c_str() );
+    STRCMP_EQUAL( "\033[39m", std::string( ColorConsole::sgrTransition( SgrStyle{ SgrColor::indexed( 3 ), SgrColor::indexed( 4 ), 0 },
+                                                                        SgrStyle{ SgrColor(), SgrColor::indexed( 4 ), 0 },
+                                                                        ColorCapability::TRUE_COLOR ).view() ).c_str() );
+    STRCMP_EQUAL( "", std::string( ColorConsole::sgrTransition( bold, dim, ColorCapability::NONE ).view() ).c_str() );
+}
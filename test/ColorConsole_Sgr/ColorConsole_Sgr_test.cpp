@@ -0,0 +1,311 @@
+/**
+ * @file
+ * @brief      Unit tests for the ColorConsole SGR escape sequences parser
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleAnsiStrip.hpp"
+#include "ColorConsoleHelpers.hpp"
+#include "ColorConsoleSgr.hpp"
+
+#include "TestHelpers.hpp"
+
+#include <random>
+#include <sstream>
+#include <vector>
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::AnsiStripper;
+using ColorConsole::Color;
+using ColorConsole::SgrColor;
+using ColorConsole::SgrParser;
+using ColorConsole::SgrStyle;
+
+/**
+ * Text parsed into runs, with the style of each character.
+ */
+struct ParsedText
+{
+    std::string text;
+    std::vector<SgrStyle> styles;
+
+    void append( const SgrStyle &style, std::string_view run )
+    {
+        text.append( run );
+        styles.insert( styles.end(), run.size(), style );
+    }
+};
+
+static ParsedText parse( std::string_view text )
+{
+    ParsedText result;
+    SgrParser parser;
+
+    parser.process( text, [&result]( const SgrStyle &style, std::string_view run ) { result.append( style, run ); } );
+
+    return result;
+}
+
+/**
+ * Returns all the colors (all the foreground and background combinations, and RESET).
+ */
+static std::vector<Color> allColors()
+{
+    std::vector<Color> colors;
+
+    for( unsigned int bg = 0; bg <= 0x10; bg++ )
+    {
+        for( unsigned int fg = 0; fg <= 0x0F; fg++ )
+        {
+            const unsigned int bgBits = ( bg == 0x10 ) ? static_cast<unsigned int>( Color::BG_BLACK ) : ( bg << 4 );
+            colors.push_back( static_cast<Color>( bgBits | fg ) );
+        }
+    }
+    colors.push_back( Color::RESET );
+
+    return colors;
+}
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsoleSgr )
+{
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsoleSgr, RoundTripAllColors )
+{
+    for( Color color : allColors() )
+    {
+        // Prepare
+        std::ostringstream out;
+        ColorConsole::setAnsiColor( &out, color );
+        out << "x";
+
+        // Exercise
+        ParsedText parsed = parse( out.str() );
+
+        // Verify
+        STRCMP_EQUAL( "x", parsed.text.c_str() );
+        CHECK_EQUAL( static_cast<unsigned int>( color ), static_cast<unsigned int>( parsed.styles[0].to_color() ) );
+        CHECK( SgrStyle::from_color( color ) == parsed.styles[0] );
+    }
+}
+
+TEST( ColorConsoleSgr, ConsoleOutput )
+{
+    // Prepare
+    std::stringbuf outBuffer;
+    ColorConsole::Console console( &outBuffer );
+    const std::vector<Color> colors = allColors();
+
+    for( Color color : colors )
+    {
+        console << color << 'x' << Color::RESET << 'y';
+    }
+
+    // Exercise
+    ParsedText parsed = parse( outBuffer.str() );
+
+    // Verify
+    CHECK_EQUAL( 2 * colors.size(), parsed.text.size() );
+    for( std::size_t i = 0; i < colors.size(); i++ )
+    {
+        CHECK_EQUAL( static_cast<unsigned int>( colors[i] ), static_cast<unsigned int>( parsed.styles[2 * i].to_color() ) );
+        CHECK_TRUE( parsed.styles[2 * i + 1].is_default() );
+    }
+}
+
+TEST( ColorConsoleSgr, ForeignCodes )
+{
+    //////////////////////////////////////////////////////////////////////////
+    // Attributes and bright colors
+    //////////////////////////////////////////////////////////////////////////
+
+    // Exercise
+    ParsedText parsed = parse( "\033[1;3;4;9;91;103ma\033[22;23;24;29mb\033[39;49mc\033[7;2md\033[mE" );
+
+    // Verify
+    STRCMP_EQUAL( "abcdE", parsed.text.c_str() );
+    CHECK( SgrColor::indexed( 9 ) == parsed.styles[0].foreground );
+    CHECK( SgrColor::indexed( 11 ) == parsed.styles[0].background );
+    CHECK_EQUAL( ColorConsole::SGR_BOLD | ColorConsole::SGR_ITALIC | ColorConsole::SGR_UNDERLINE | ColorConsole::SGR_STRIKE,
+                 parsed.styles[0].attributes );
+    CHECK( ( Color::FG_LIGHT_RED | Color::BG_YELLOW ) == parsed.styles[0].to_color() );
+    CHECK_EQUAL( 0, parsed.styles[1].attributes );
+    CHECK( SgrColor::indexed( 9 ) == parsed.styles[1].foreground );
+    CHECK( Color::RESET == parsed.styles[2].to_color() );
+    CHECK_EQUAL( ColorConsole::SGR_INVERSE | ColorConsole::SGR_DIM, parsed.styles[3].attributes );
+    CHECK_TRUE( parsed.styles[4].is_default() );
+
+    //////////////////////////////////////////////////////////////////////////
+    // 256-color and direct colors
+    //////////////////////////////////////////////////////////////////////////
+
+    // Exercise
+    parsed = parse( "\033[38;5;196;48;2;0;0;250ma\033[38:2::10:20:30;48:5:16mb\033[38:2:1:2:3;4:0mc" );
+
+    // Verify
+    CHECK( SgrColor::indexed( 196 ) == parsed.styles[0].foreground );
+    CHECK( SgrColor::rgb( 0, 0, 250 ) == parsed.styles[0].background );
+    CHECK( ( Color::FG_LIGHT_RED | Color::BG_DARK_BLUE ) == parsed.styles[0].to_color() );
+    CHECK( SgrColor::rgb( 10, 20, 30 ) == parsed.styles[1].foreground );
+    CHECK( SgrColor::indexed( 16 ) == parsed.styles[1].background );
+    CHECK( ( Color::FG_BLACK | Color::BG_BLACK ) == parsed.styles[1].to_color() );
+    CHECK( SgrColor::rgb( 1, 2, 3 ) == parsed.styles[2].foreground );
+    CHECK_EQUAL( 0, parsed.styles[2].attributes );
+
+    //////////////////////////////////////////////////////////////////////////
+    // Default foreground
+    //////////////////////////////////////////////////////////////////////////
+
+    // Exercise
+    parsed = parse( "\033[44ma" );
+
+    // Verify
+    CHECK( ( Color::FG_LIGHT_GREY | Color::BG_DARK_BLUE ) == parsed.styles[0].to_color() );
+
+    //////////////////////////////////////////////////////////////////////////
+    // Not SGR sequences
+    //////////////////////////////////////////////////////////////////////////
+
+    // Exercise
+    parsed = parse( "\033[31ma\033[?1m\033[0 m\033]0;title\a\033[2Kb" );
+
+    // Verify
+    STRCMP_EQUAL( "ab", parsed.text.c_str() );
+    CHECK( SgrColor::indexed( 1 ) == parsed.styles[1].foreground );
+
+    //////////////////////////////////////////////////////////////////////////
+    // Too many parameters
+    //////////////////////////////////////////////////////////////////////////
+
+    // Exercise
+    std::string many = "\033[";
+    for( int i = 0; i < 100; i++ )
+    {
+        many += "1;";
+    }
+    many += "99999999;32ma";
+    parsed = parse( many );
+
+    // Verify
+    STRCMP_EQUAL( "a", parsed.text.c_str() );
+    CHECK( SgrColor() == parsed.styles[0].foreground );
+    CHECK_EQUAL( ColorConsole::SGR_BOLD, parsed.styles[0].attributes );
+}
+
+TEST( ColorConsoleSgr, SplitSequences )
+{
+    // Prepare
+    const std::string_view text = "\033[49;1;31mError\033[0m: \033[38:2::1:2:3m\033]0;title\a\033[K\033(Bdone\033[1";
+    const ParsedText expected = parse( text );
+
+    for( std::size_t split = 0; split <= text.size(); split++ )
+    {
+        SgrParser parser;
+        ParsedText parsed;
+        auto append = [&parsed]( const SgrStyle &style, std::string_view run ) { parsed.append( style, run ); };
+
+        // Exercise
+        parser.process( text.substr( 0, split ), append );
+        parser.process( text.substr( split ), append );
+
+        // Verify
+        STRCMP_EQUAL( "Error: done", parsed.text.c_str() );
+        CHECK( expected.styles == parsed.styles );
+        CHECK_TRUE( parser.in_sequence() );
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // Byte by byte
+    //////////////////////////////////////////////////////////////////////////
+
+    // Prepare
+    SgrParser parser;
+    ParsedText parsed;
+
+    // Exercise
+    for( char c : text )
+    {
+        parser.process( std::string_view( &c, 1 ), [&parsed]( const SgrStyle &style, std::string_view run ) { parsed.append( style, run ); } );
+    }
+
+    // Verify
+    CHECK( expected.styles == parsed.styles );
+    CHECK( SgrColor::rgb( 1, 2, 3 ) == parser.get_style().foreground );
+
+    // Exercise
+    parser.reset();
+
+    // Verify
+    CHECK_FALSE( parser.in_sequence() );
+    CHECK_TRUE( parser.get_style().is_default() );
+}
+
+TEST( ColorConsoleSgr, SameTextAsStripper )
+{
+    // Prepare
+    std::mt19937 generator( 12345 );
+    const char alphabet[] = { 'a', '\n', '\033', '[', ']', ';', ':', '1', '3', '8', '5', 'm', 'K', '?', ' ',
+                              '\a', '\\', '\x18', '\x7F', '\xC3' };
+
+    for( int iteration = 0; iteration < 20000; iteration++ )
+    {
+        std::string text( generator() % 40, 'x' );
+        for( char &c : text )
+        {
+            c = alphabet[generator() % sizeof( alphabet )];
+        }
+
+        // Exercise
+        ParsedText parsed = parse( text );
+
+        // Verify
+        CHECK( AnsiStripper::strip( text ) == parsed.text );
+    }
+}
+
+TEST( ColorConsoleSgr, Sequences )
+{
+    // Prepare
+    SgrStyle style = parse( "\033[1;4;31;48;2;0;0;250mx" ).styles[0];
+    SgrStyle palette = parse( "\033[38;5;200;103mx" ).styles[0];
+
+    // Exercise & Verify
+    STRCMP_EQUAL( "", ColorConsole::sgrSequence( style, ColorConsole::ColorCapability::NONE ).view().data() );
+    STRCMP_EQUAL( "\033[44;1;31m", std::string( ColorConsole::sgrSequence( style, ColorConsole::ColorCapability::BASIC ).view() ).c_str() );
+    STRCMP_EQUAL( "\033[0;1;4;31;48;5;21m", std::string( ColorConsole::sgrSequence( style, ColorConsole::ColorCapability::PALETTE_256 ).view() ).c_str() );
+    STRCMP_EQUAL( "\033[0;1;4;31;48;2;0;0;250m", std::string( ColorConsole::sgrSequence( style, ColorConsole::ColorCapability::TRUE_COLOR ).view() ).c_str() );
+    STRCMP_EQUAL( "\033[0;38;5;200;103m", std::string( ColorConsole::sgrSequence( palette, ColorConsole::ColorCapability::PALETTE_256 ).view() ).c_str() );
+    STRCMP_EQUAL( "\033[0m", std::string( ColorConsole::sgrSequence( SgrStyle(), ColorConsole::ColorCapability::BASIC ).view() ).c_str() );
+    STRCMP_EQUAL( "\033[0m", std::string( ColorConsole::sgrSequence( SgrStyle(), ColorConsole::ColorCapability::TRUE_COLOR ).view() ).c_str() );
+
+    for( Color color : allColors() )
+    {
+        // Exercise
+        const std::string sequence( ColorConsole::sgrSequence( SgrStyle::from_color( color ), ColorConsole::ColorCapability::TRUE_COLOR ).view() );
+
+        // Verify
+        CHECK( SgrStyle::from_color( color ) == parse( sequence + "x" ).styles[0] );
+    }
+}
@@ -0,0 +1,140 @@
+/**
+ * @file
+ * @brief      Unit tests for the ColorConsole output statistics
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleW.hpp"
+#include "ColorConsoleFragments.hpp"
+#include "ColorConsoleMarkup.hpp"
+
+#include "TestHelpers.hpp"
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::Color;
+using ColorConsole::ConsoleStats;
+using ColorConsole::ConsoleStatsSnapshot;
+
+static unsigned long long histogramTotal( const unsigned long long (&histogram)[ColorConsole::STATS_LATENCY_BUCKETS] )
+{
+    unsigned long long total = 0;
+    for( unsigned long long count : histogram )
+    {
+        total += count;
+    }
+    return total;
+}
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsoleStats )
+{
+    std::stringbuf outBuffer;
+    std::wstringbuf wideOutBuffer;
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsoleStats, LatencyBuckets )
+{
+    // Verify
+    static_assert( ColorConsole::STATS_ENABLED );
+    static_assert( ConsoleStats::latency_bucket( 0 ) == 0 );
+    static_assert( ConsoleStats::latency_bucket( 1 ) == 0 );
+    static_assert( ConsoleStats::latency_bucket( 2 ) == 1 );
+    static_assert( ConsoleStats::latency_bucket( 1023 ) == 9 );
+    static_assert( ConsoleStats::latency_bucket( 1024 ) == 10 );
+    static_assert( ConsoleStats::latency_bucket( ~0ull ) == ( ColorConsole::STATS_LATENCY_BUCKETS - 1 ) );
+}
+
+TEST( ColorConsoleStats, Console )
+{
+    using namespace ColorConsole;
+
+    // Prepare
+    Console* out = new Console( &outBuffer, true );
+
+    // Exercise
+    *out << Color::FG_LIGHT_RED << "E" << Color::RESET << " x" << std::flush;
+
+    // Verify
+    ConsoleStatsSnapshot stats = out->get_stats();
+    CHECK_EQUAL( 3u, stats.payloadBytes );
+    CHECK_EQUAL( 10u + 4u, stats.escapeBytes );
+    CHECK_EQUAL( 2u, stats.colorChangesRequested );
+    CHECK_EQUAL( 2u, stats.colorChangesEmitted );
+    CHECK_EQUAL( 4u, stats.writes );
+    CHECK_EQUAL( 1u, stats.flushes );
+    CHECK_EQUAL( 4u, histogramTotal( stats.writeLatency ) );
+    CHECK_EQUAL( 1u, histogramTotal( stats.flushLatency ) );
+    STRCMP_EQUAL( "\033[49;1;31mE\033[0m x", readFromStringBuf(outBuffer).c_str() );
+
+    // Exercise
+    out->reset_stats();
+    *out << red( "E" ) + " x";
+    *out << markup<"{green}ok{/}">;
+
+    // Verify
+    stats = out->get_stats();
+    CHECK_EQUAL( 5u, stats.payloadBytes );
+    CHECK_EQUAL( 10u + 4u + 8u + 4u, stats.escapeBytes );
+    CHECK_EQUAL( 4u, stats.colorChangesEmitted );
+    CHECK_EQUAL( 2u, stats.writes );
+
+    // Exercise
+    out->reset_stats();
+    out->disable_coloring();
+    *out << Color::FG_LIGHT_RED << "E";
+
+    // Verify
+    stats = out->get_stats();
+    CHECK_EQUAL( 1u, stats.payloadBytes );
+    CHECK_EQUAL( 0u, stats.escapeBytes );
+    CHECK_EQUAL( 1u, stats.colorChangesRequested );
+    CHECK_EQUAL( 0u, stats.colorChangesEmitted );
+
+    // Cleanup
+    delete out;
+}
+
+TEST( ColorConsoleStats, ConsoleW )
+{
+    // Prepare
+    ColorConsole::ConsoleW* out = new ColorConsole::ConsoleW( &wideOutBuffer, true );
+
+    // Exercise
+    *out << Color::FG_LIGHT_RED << L"E" << Color::RESET;
+
+    // Verify
+    ConsoleStatsSnapshot stats = out->get_stats();
+    CHECK_EQUAL( 1u, stats.payloadBytes );
+    CHECK_EQUAL( 10u + 4u, stats.escapeBytes );
+    CHECK_EQUAL( 2u, stats.colorChangesEmitted );
+
+    // Exercise
+    out->reset_stats();
+
+    // Verify
+    CHECK_EQUAL( 0u, out->get_stats().escapeBytes );
+
+    // Cleanup
+    delete out;
+}
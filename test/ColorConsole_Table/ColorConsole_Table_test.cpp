@@ -0,0 +1,167 @@
+/**
+ * @file
+ * @brief      Unit tests for the ColorConsole table renderer
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleTable.hpp"
+
+#include "TestHelpers.hpp"
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::Color;
+using ColorConsole::Table;
+using ColorConsole::TableAlignment;
+using ColorConsole::TableBorders;
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsoleTable )
+{
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsoleTable, DisplayWidth )
+{
+    // Prepare
+    std::stringbuf output;
+    ColorConsole::Console console( &output, false );
+    Table table( console, { { "Name" }, { "Count", TableAlignment::RIGHT }, { "Note", TableAlignment::CENTER } } );
+
+    // Exercise
+    table.add_row( { { "café" }, { "7" }, { "ok" } } );
+    table.add_row( { { "日本語" }, { "1234567" }, { "a\tb" } } );
+    table.finish();
+
+    // Verify
+    STRCMP_EQUAL( "Name      Count  Note\n"
+                  "café          7   ok\n"
+                  "日本語  1234567  a b\n", readFromStringBuf( output ).c_str() );
+    CHECK_EQUAL( 6u, table.get_width( 0 ) );
+}
+
+TEST( ColorConsoleTable, Borders )
+{
+    // Prepare
+    std::stringbuf output;
+    ColorConsole::Console console( &output, false );
+
+    {
+        Table table( console, { { "Service" }, { "Up", TableAlignment::RIGHT } } );
+        table.set_borders( TableBorders::BOX );
+        table.set_unicode( true );
+
+        // Exercise
+        table.add_row( { { "auth" }, { "yes" } } );
+    }
+
+    // Verify
+    STRCMP_EQUAL( "┌─────────┬─────┐\n"
+                  "│ Service │  Up │\n"
+                  "├─────────┼─────┤\n"
+                  "│ auth    │ yes │\n"
+                  "└─────────┴─────┘\n", readFromStringBuf( output ).c_str() );
+
+    {
+        Table table( console, { {}, {} } );
+        table.set_borders( TableBorders::ASCII );
+
+        // Exercise
+        table.add_row( { { "a" }, { "b" } } );
+    }
+
+    // Verify
+    STRCMP_EQUAL( "+---+---+\n"
+                  "| a | b |\n"
+                  "+---+---+\n", readFromStringBuf( output ).c_str() );
+}
+
+TEST( ColorConsoleTable, AsciiFallback )
+{
+    // Prepare
+    std::stringbuf output;
+    ColorConsole::Console console( &output, false );
+    Table table( console, { { "Service", TableAlignment::LEFT, 0, 6 }, { "Up" } } );
+    table.set_borders( TableBorders::BOX );
+    table.set_unicode( false );
+
+    // Exercise
+    table.add_row( { { "authentication" }, { "yes" } } );
+    table.finish();
+
+    // Verify
+    STRCMP_EQUAL( "+--------+-----+\n"
+                  "| Servi~ | Up  |\n"
+                  "+--------+-----+\n"
+                  "| authe~ | yes |\n"
+                  "+--------+-----+\n", readFromStringBuf( output ).c_str() );
+}
+
+TEST( ColorConsoleTable, ColorTransitions )
+{
+    // Prepare
+    std::stringbuf output;
+    ColorConsole::Console console( &output, true );
+    Table table( console, { {}, {}, {} } );
+
+    // Exercise
+    table.add_row( { { "one", Color::FG_LIGHT_RED }, { "two", Color::FG_LIGHT_RED }, { "three" } } );
+    table.add_row( { { "x", Color::FG_WHITE | Color::BG_DARK_BLUE }, { "y" }, { "z", Color::FG_WHITE | Color::BG_DARK_BLUE } } );
+    table.finish();
+
+    // Verify
+    STRCMP_EQUAL( "\033[49;1;31mone  two  \033[0mthree\n"
+                  "\033[44;1;37mx  \033[0m  y    \033[44;1;37mz    \033[0m\n", readFromStringBuf( output ).c_str() );
+}
+
+TEST( ColorConsoleTable, Streaming )
+{
+    // Prepare
+    std::stringbuf output;
+    ColorConsole::Console console( &output, false );
+    Table table( console, { { "Id", TableAlignment::RIGHT }, { "Message", TableAlignment::LEFT, 0, 12 } } );
+    table.set_streaming( 2 );
+    table.set_unicode( true );
+
+    // Exercise
+    table.add_row( { { "1" }, { "started" } } );
+
+    // Verify
+    STRCMP_EQUAL( "", readFromStringBuf( output ).c_str() );
+
+    // Exercise
+    table.add_row( { { "2" }, { "a message that is too long" } } );
+
+    // Verify
+    STRCMP_EQUAL( "Id  Message\n"
+                  " 1  started\n"
+                  " 2  a message t…\n", readFromStringBuf( output ).c_str() );
+
+    // Exercise
+    table.add_row( { { "300" }, { "漢字漢字漢字漢字" } } );
+    table.add_row( { { "4" } } );
+    table.finish();
+
+    // Verify
+    STRCMP_EQUAL( "3…  漢字漢字漢…\n"
+                  " 4\n", readFromStringBuf( output ).c_str() );
+}
@@ -0,0 +1,226 @@
+/**
+ * @file
+ * @brief      Unit tests for the ColorConsole virtual terminal
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleTerminal.hpp"
+
+#include "TestHelpers.hpp"
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::Color;
+using ColorConsole::VirtualTerminal;
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsoleTerminal )
+{
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsoleTerminal, ConsoleOutput )
+{
+    // Prepare
+    VirtualTerminal terminal( 40, 5 );
+    ColorConsole::Console console( &terminal, true );
+
+    // Exercise
+    console << Color::FG_LIGHT_RED << "Error" << Color::RESET << ": disk " << ( Color::FG_WHITE | Color::BG_DARK_BLUE ) << 97
+            << '%' << ColorConsole::endl << Color::RESET << "done";
+
+    // Verify
+    STRCMP_EQUAL( "Error: disk 97%\ndone", terminal.get_text().c_str() );
+    CHECK( Color::FG_LIGHT_RED == terminal.get_cell( 0, 0 ).style.to_color() );
+    CHECK_TRUE( terminal.get_cell( 0, 5 ).style.is_default() );
+    CHECK( ( Color::FG_WHITE | Color::BG_DARK_BLUE ) == terminal.get_cell( 0, 12 ).style.to_color() );
+
+    // The line was cleared with the background color before the newline
+    CHECK( ' ' == terminal.get_cell( 0, 39 ).character );
+    CHECK( ColorConsole::SgrColor::indexed( 4 ) == terminal.get_cell( 0, 39 ).style.background );
+    CHECK_TRUE( terminal.get_cell( 1, 0 ).style.is_default() );
+    CHECK_EQUAL( 1u, terminal.get_cursor_row() );
+    CHECK_EQUAL( 4u, terminal.get_cursor_column() );
+}
+
+TEST( ColorConsoleTerminal, Wrapping )
+{
+    // Prepare
+    VirtualTerminal terminal( 10, 5 );
+
+    // Exercise
+    terminal.write( "0123456789abcdefghijklmnopqrstuvwxyz\n0123456789\nend" );
+
+    // Verify
+    STRCMP_EQUAL( "abcdefghij\nklmnopqrst\nuvwxyz\n0123456789\nend", terminal.get_text().c_str() );
+    CHECK_EQUAL( 1u, terminal.get_stats().scrolledLines );
+
+    // Exercise: a full line stays on the last column until the next character is written
+    terminal.reset();
+    terminal.write( "0123456789" );
+
+    // Verify
+    CHECK_EQUAL( 0u, terminal.get_cursor_row() );
+    CHECK_EQUAL( 9u, terminal.get_cursor_column() );
+
+    // Exercise
+    terminal.write( "\r\nnext" );
+
+    // Verify
+    STRCMP_EQUAL( "0123456789\nnext", terminal.get_text().c_str() );
+
+    // Exercise: without autowrap, the last column is overwritten
+    terminal.reset();
+    terminal.write( "\033[?7l0123456789abc" );
+
+    // Verify
+    STRCMP_EQUAL( "012345678c", terminal.get_text().c_str() );
+}
+
+TEST( ColorConsoleTerminal, Scrolling )
+{
+    // Prepare
+    VirtualTerminal terminal( 20, 3 );
+
+    // Exercise
+    for( int i = 0; i < 1000; i++ )
+    {
+        terminal.write( "line " + std::to_string( i ) + "\n" );
+    }
+
+    // Verify
+    STRCMP_EQUAL( "line 998\nline 999", terminal.get_text().c_str() );
+    STRCMP_EQUAL( "", terminal.get_line( 2 ).c_str() );
+    CHECK_EQUAL( 998u, terminal.get_stats().scrolledLines );
+    CHECK_EQUAL( 2u, terminal.get_cursor_row() );
+}
+
+TEST( ColorConsoleTerminal, CursorAndErase )
+{
+    // Prepare
+    VirtualTerminal terminal( 10, 4 );
+    terminal.write( "aaaaaaaaaa\r\nbbbbbbbbbb\r\ncccccccccc\r\ndddddddddd" );
+
+    // Exercise
+    terminal.write( "\033[2;3H\033[K\033[3;4H\033[1K\033[1;1H\033[2C\033[44m\033[3X\033[0m\033[4;5H\033[0J\033[?25l" );
+
+    // Verify
+    STRCMP_EQUAL( "aa   aaaaa\nbb\n    cccccc\ndddd", terminal.get_text().c_str() );
+    CHECK( ColorConsole::SgrColor::indexed( 4 ) == terminal.get_cell( 0, 3 ).style.background );
+    CHECK_TRUE( terminal.get_cell( 1, 5 ).style.is_default() );
+    CHECK_EQUAL( 3u, terminal.get_cursor_row() );
+    CHECK_EQUAL( 4u, terminal.get_cursor_column() );
+    CHECK_FALSE( terminal.is_cursor_visible() );
+
+    // Exercise
+    terminal.write( "\033[s\033[99;99H*\033[u\033[A\033[D+" );
+
+    // Verify
+    CHECK( U'*' == terminal.get_cell( 3, 9 ).character );
+    CHECK( U'+' == terminal.get_cell( 2, 3 ).character );
+
+    // Exercise
+    terminal.write( "\033[2J" );
+
+    // Verify
+    STRCMP_EQUAL( "", terminal.get_text().c_str() );
+    CHECK_EQUAL( 2u, terminal.get_cursor_row() );
+    CHECK_EQUAL( 4u, terminal.get_cursor_column() );
+}
+
+TEST( ColorConsoleTerminal, EraseAtLastColumn )
+{
+    // Prepare
+    VirtualTerminal terminal( 10, 4 );
+
+    // Exercise: like in the VT100, the erasure starts at the last column
+    terminal.write( "0123456789\033[K\n" );
+
+    // Verify
+    STRCMP_EQUAL( "012345678", terminal.get_text().c_str() );
+    CHECK_EQUAL( 1u, terminal.get_cursor_row() );
+}
+
+TEST( ColorConsoleTerminal, Utf8AndChunks )
+{
+    // Prepare
+    const std::string text = "h\xC3\xA9llo \xE2\x82\xAC \xF0\x9F\x98\x80 \033[1;31mbad\xFF\xC3 end\033[0m\tx\by\n";
+    VirtualTerminal whole( 30, 3 );
+    VirtualTerminal chunked( 30, 3 );
+
+    // Exercise
+    whole.write( text );
+    for( char c : text )
+    {
+        chunked.sputc( c );
+    }
+
+    // Verify
+    STRCMP_EQUAL( "h\xC3\xA9llo \xE2\x82\xAC \xF0\x9F\x98\x80 bad\xEF\xBF\xBD\xEF\xBF\xBD end    y", whole.get_text().c_str() );
+    STRCMP_EQUAL( whole.get_text().c_str(), chunked.get_text().c_str() );
+    CHECK( U'\U0001F600' == whole.get_cell( 0, 8 ).character );
+    CHECK( ColorConsole::TERMINAL_WIDE_CONTINUATION == whole.get_cell( 0, 9 ).character );
+    CHECK( ColorConsole::SgrColor::indexed( 1 ) == whole.get_cell( 0, 11 ).style.foreground );
+    CHECK_EQUAL( ColorConsole::SGR_BOLD, whole.get_cell( 0, 11 ).style.attributes );
+
+    for( std::size_t column = 0; column < whole.get_columns(); column++ )
+    {
+        CHECK( whole.get_cell( 0, column ) == chunked.get_cell( 0, column ) );
+    }
+
+    CHECK_EQUAL( text.size(), whole.get_stats().bytes );
+    CHECK_EQUAL( 21u, whole.get_stats().characters );
+    CHECK_EQUAL( 3u, whole.get_stats().controls );
+}
+
+TEST( ColorConsoleTerminal, WideAndCombiningCharacters )
+{
+    // Prepare
+    VirtualTerminal terminal( 5, 3 );
+
+    // Exercise: CJK characters occupy two columns, and combining marks none
+    terminal.write( "\xE6\x97\xA5\xE6\x9C\xAC" );
+
+    // Verify
+    CHECK_EQUAL( 4u, terminal.get_cursor_column() );
+
+    // Exercise
+    terminal.write( "e\xCC\x81" );
+
+    // Verify
+    STRCMP_EQUAL( "\xE6\x97\xA5\xE6\x9C\xAC" "e", terminal.get_text().c_str() );
+    CHECK_EQUAL( 0u, terminal.get_cursor_row() );
+
+    // Exercise: a wide character that does not fit in the row wraps to the next one
+    terminal.write( "\r\nabcd\xE6\x97\xA5" );
+
+    // Verify
+    STRCMP_EQUAL( "\xE6\x97\xA5\xE6\x9C\xAC" "e\nabcd\n\xE6\x97\xA5", terminal.get_text().c_str() );
+    CHECK_EQUAL( 2u, terminal.get_cursor_row() );
+    CHECK_EQUAL( 2u, terminal.get_cursor_column() );
+
+    // Exercise: overwriting half of a wide character blanks its other half
+    terminal.write( "\033[1;2Hx\033[3;1Hy" );
+
+    // Verify
+    STRCMP_EQUAL( " x\xE6\x9C\xAC" "e\nabcd\ny", terminal.get_text().c_str() );
+}
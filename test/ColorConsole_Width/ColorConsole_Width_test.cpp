@@ -0,0 +1,126 @@
+/**
+ * @file
+ * @brief      Unit tests for the display width functions
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsoleWidth.hpp"
+
+#include <string>
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::code_point_width;
+using ColorConsole::display_width;
+using ColorConsole::truncate_to_width;
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsoleWidth )
+{
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsoleWidth, CodePoints )
+{
+    // Exercise & Verify
+    CHECK_EQUAL( 1u, code_point_width( U'a' ) );
+    CHECK_EQUAL( 0u, code_point_width( U'\t' ) );
+    CHECK_EQUAL( 0u, code_point_width( 0x9B ) );
+    CHECK_EQUAL( 1u, code_point_width( U'é' ) );
+    CHECK_EQUAL( 0u, code_point_width( 0x0301 ) );
+    CHECK_EQUAL( 0u, code_point_width( 0x200B ) );
+    CHECK_EQUAL( 2u, code_point_width( U'日' ) );
+    CHECK_EQUAL( 2u, code_point_width( 0xFF21 ) );
+    CHECK_EQUAL( 2u, code_point_width( 0x1F600 ) );
+    CHECK_EQUAL( 1u, code_point_width( 0x2764 ) );
+    CHECK_EQUAL( 0u, code_point_width( 0xFE0F ) );
+    CHECK_EQUAL( 2u, code_point_width( 0x20000 ) );
+    CHECK_EQUAL( 1u, code_point_width( 0x110000 ) );
+}
+
+TEST( ColorConsoleWidth, Text )
+{
+    // Exercise & Verify
+    CHECK_EQUAL( 0u, display_width( "" ) );
+    CHECK_EQUAL( 43u, display_width( "The quick brown fox jumps over the lazy dog" ) );
+    CHECK_EQUAL( 4u, display_width( "café" ) );
+    CHECK_EQUAL( 6u, display_width( "日本語" ) );
+    CHECK_EQUAL( 9u, display_width( "ｆｕｌｌ!" ) );
+    CHECK_EQUAL( 2u, display_width( "a\tb\n\r\n" ) );
+    CHECK_EQUAL( 2u, display_width( "\xFF\xC3" ) );
+}
+
+TEST( ColorConsoleWidth, GraphemeClusters )
+{
+    // Exercise & Verify: ZWJ sequence, emoji modifier, variation selector, flags and Hangul jamo
+    CHECK_EQUAL( 2u, display_width( "\U0001F468‍\U0001F469‍\U0001F467" ) );
+    CHECK_EQUAL( 2u, display_width( "\U0001F44D\U0001F3FD" ) );
+    CHECK_EQUAL( 1u, display_width( "❤" ) );
+    CHECK_EQUAL( 2u, display_width( "❤️" ) );
+    CHECK_EQUAL( 4u, display_width( "\U0001F1EA\U0001F1F8\U0001F1EB\U0001F1F7" ) );
+    CHECK_EQUAL( 3u, display_width( "\U0001F1EA\U0001F1F8\U0001F1EB" ) );
+    CHECK_EQUAL( 2u, display_width( "각" ) );
+    CHECK_EQUAL( 4u, display_width( "한글" ) );
+}
+
+TEST( ColorConsoleWidth, EscapeSequences )
+{
+    // Exercise & Verify
+    CHECK_EQUAL( 6u, display_width( "\033[49;1;31mred\033[0m ok" ) );
+    CHECK_EQUAL( 4u, display_width( "\033]8;;https://example.com\033\\link\033]8;;\a" ) );
+    CHECK_EQUAL( 2u, display_width( "\033(Bab\033" ) );
+    CHECK_EQUAL( 4u, display_width( "cafe\033[1m\xCC\x81" ) );
+
+    // Like AnsiStripper: a non-ASCII character ends the sequence and is text, and embedded controls are executed
+    CHECK_EQUAL( 5u, display_width( "cafe\033[1\xE1\xB8\xBF" ) );
+    CHECK_EQUAL( 6u, display_width( "ab\033[1\r;31mcd\033]0;title\033[0mef" ) );
+    CHECK_EQUAL( 3u, display_width( L"\033[31mred\033[0m" ) );
+}
+
+TEST( ColorConsoleWidth, Truncation )
+{
+    // Exercise & Verify
+    CHECK( truncate_to_width( "abcdef", 4 ) == "abcd" );
+    CHECK( truncate_to_width( "abc", 4 ) == "abc" );
+    CHECK( truncate_to_width( "abc", 0 ) == "" );
+    CHECK( truncate_to_width( "abcéf", 4 ) == "abcé" );
+    CHECK( truncate_to_width( "abcé", 3 ) == "abc" );
+    CHECK( truncate_to_width( "日本語", 5 ) == "日本" );
+    CHECK( truncate_to_width( "a\U0001F468‍\U0001F469b", 2 ) == "a" );
+    CHECK( truncate_to_width( "a\U0001F468‍\U0001F469b", 3 ) == "a\U0001F468‍\U0001F469" );
+    CHECK( truncate_to_width( "\U0001F1EA\U0001F1F8\U0001F1EB\U0001F1F7", 3 ) == "\U0001F1EA\U0001F1F8" );
+    CHECK( truncate_to_width( "\033[31mred\033[0m", 3 ) == "\033[31mred" );
+    CHECK( truncate_to_width( "\033[31mred\033[0m", 2 ) == "\033[31mre" );
+
+    const std::string longText = std::string( 100, 'x' ) + "日本";
+    CHECK( truncate_to_width( longText, 101 ) == std::string_view( longText ).substr( 0, 100 ) );
+    CHECK( truncate_to_width( longText, 102 ) == std::string_view( longText ).substr( 0, 103 ) );
+    CHECK( truncate_to_width( longText, 50 ) == std::string_view( longText ).substr( 0, 50 ) );
+}
+
+TEST( ColorConsoleWidth, WideText )
+{
+    // Exercise & Verify
+    CHECK_EQUAL( 9u, display_width( L"\033[1mcafé 日本" ) );
+    CHECK_EQUAL( 2u, display_width( L"\U0001F468‍\U0001F469‍\U0001F467" ) );
+    CHECK( truncate_to_width( std::wstring_view( L"ab日本" ), 3 ) == L"ab" );
+    CHECK( truncate_to_width( std::wstring_view( L"\U0001F600x" ), 2 ) == L"\U0001F600" );
+}
@@ -0,0 +1,181 @@
+/**
+ * @file
+ * @brief      Unit tests for the word wrapping stream buffer
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleWrap.hpp"
+
+#include "TestHelpers.hpp"
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::Color;
+using ColorConsole::ColorCapability;
+using ColorConsole::WrapStreamBuf;
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsoleWrap )
+{
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsoleWrap, WordBoundaries )
+{
+    // Prepare
+    std::stringbuf output;
+    WrapStreamBuf wrap( &output, 20 );
+    ColorConsole::Console console( &wrap, false );
+
+    // Exercise
+    console << "The quick brown fox jumps over the lazy dog\n";
+    console << "  short line  \n";
+
+    // Verify
+    STRCMP_EQUAL( "The quick brown fox\n"
+                  "jumps over the lazy\n"
+                  "dog\n"
+                  "  short line  \n", readFromStringBuf( output ).c_str() );
+}
+
+TEST( ColorConsoleWrap, HangingIndent )
+{
+    // Prepare
+    std::stringbuf output;
+    WrapStreamBuf wrap( &output, 16, 4 );
+    ColorConsole::Console console( &wrap, false );
+
+    // Exercise
+    console << "error: the file could not be opened\n";
+
+    // Verify
+    STRCMP_EQUAL( "error: the file\n"
+                  "    could not be\n"
+                  "    opened\n", readFromStringBuf( output ).c_str() );
+}
+
+TEST( ColorConsoleWrap, ColorCarried )
+{
+    // Prepare
+    std::stringbuf output;
+    WrapStreamBuf wrap( &output, 12, 2, ColorCapability::BASIC );
+    ColorConsole::Console console( &wrap, true );
+
+    // Exercise
+    console << Color::FG_LIGHT_RED << "alpha beta gamma" << Color::RESET << " end\n";
+
+    // Verify
+    STRCMP_EQUAL( "\033[49;1;31malpha beta\033[0m\n"
+                  "  \033[49;1;31mgamma\033[0m end\n", readFromStringBuf( output ).c_str() );
+
+    // Exercise: escape sequences between the spaces at the wrap point are kept
+    console << "one two \033[44mthree\033[0m\n";
+
+    // Verify
+    STRCMP_EQUAL( "one two\n"
+                  "  \033[44mthree\033[0m\n", readFromStringBuf( output ).c_str() );
+}
+
+TEST( ColorConsoleWrap, LongWords )
+{
+    // Prepare
+    std::stringbuf output;
+
+    {
+        WrapStreamBuf wrap( &output, 8, 2 );
+        ColorConsole::Console console( &wrap, false );
+
+        // Exercise
+        console << "id: 0123456789abcdef\n";
+    }
+
+    // Verify
+    STRCMP_EQUAL( "id:\n"
+                  "  012345\n"
+                  "  6789ab\n"
+                  "  cdef\n", readFromStringBuf( output ).c_str() );
+
+    {
+        WrapStreamBuf wrap( &output, 5 );
+        ColorConsole::Console console( &wrap, false );
+
+        // Exercise
+        console << "日本語日本語";
+    }
+
+    // Verify
+    STRCMP_EQUAL( "日本\n"
+                  "語日\n"
+                  "本語", readFromStringBuf( output ).c_str() );
+}
+
+TEST( ColorConsoleWrap, Streaming )
+{
+    // Prepare
+    const std::string text = "\033[31mred text\033[0m and 日本語 words that wrap\taround\033[44m blue\033[0m\n"
+                             "\033]8;;https://example.com\033\\link\033]8;;\033\\ and a verylongwordthatdoesnotfit.\n";
+    std::stringbuf expected;
+    std::stringbuf output;
+
+    {
+        WrapStreamBuf wrap( &expected, 14, 3 );
+        wrap.sputn( text.data(), static_cast<std::streamsize>( text.size() ) );
+    }
+
+    // Exercise
+    {
+        WrapStreamBuf wrap( &output, 14, 3 );
+        for( char c : text )
+        {
+            wrap.sputc( c );
+        }
+    }
+
+    // Verify
+    STRCMP_EQUAL( readFromStringBuf( expected ).c_str(), readFromStringBuf( output ).c_str() );
+}
+
+TEST( ColorConsoleWrap, Flush )
+{
+    // Prepare
+    std::stringbuf output;
+    WrapStreamBuf wrap( &output, 20 );
+    ColorConsole::Console console( &wrap, false );
+
+    // Exercise
+    console << "Name: ";
+
+    // Verify
+    STRCMP_EQUAL( "Name:", readFromStringBuf( output ).c_str() );
+
+    // Exercise
+    console << std::flush;
+
+    // Verify
+    STRCMP_EQUAL( " ", readFromStringBuf( output ).c_str() );
+
+    // Exercise
+    console << "alice" << std::endl;
+
+    // Verify
+    STRCMP_EQUAL( "alice\n", readFromStringBuf( output ).c_str() );
+}
@@ -0,0 +1,143 @@
+/**
+ * @file
+ * @brief      Unit tests for the ColorConsole colored text writer
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include "ColorConsole.hpp"
+#include "ColorConsoleWriter.hpp"
+
+#include "TestHelpers.hpp"
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+using ColorConsole::Color;
+using ColorConsole::ColorWriter;
+using ColorConsole::InlineColorWriter;
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ColorConsoleWriter )
+{
+    std::stringbuf outBuffer;
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+TEST( ColorConsoleWriter, Append )
+{
+    // Prepare
+    char buffer[64];
+    ColorWriter writer( buffer );
+
+    // Exercise
+    writer << Color::FG_LIGHT_RED << "E" << Color::FG_LIGHT_RED << Color::RESET << ' ' << -42 << " " << 7u;
+
+    // Verify
+    STRCMP_EQUAL( "\033[49;1;31mE\033[0m -42 7", std::string( writer.finish() ).c_str() );
+    CHECK_FALSE( writer.is_truncated() );
+    CHECK_EQUAL( 64u, writer.capacity() );
+
+    // Exercise
+    writer.clear();
+    writer << Color::FG_DARK_BLUE << "x";
+
+    // Verify
+    CHECK_EQUAL( static_cast<int>( Color::FG_DARK_BLUE ), static_cast<int>( writer.get_color() ) );
+    STRCMP_EQUAL( "\033[49;34mx\033[0m", std::string( writer.finish() ).c_str() );
+}
+
+TEST( ColorConsoleWriter, ColoringDisabled )
+{
+    // Prepare
+    InlineColorWriter<16> writer( false );
+
+    // Exercise
+    writer << Color::FG_LIGHT_RED << "E" << Color::RESET << " x";
+
+    // Verify
+    STRCMP_EQUAL( "E x", std::string( writer.finish() ).c_str() );
+}
+
+TEST( ColorConsoleWriter, Truncation )
+{
+    //////////////////////////////////////////////////////////////////////////
+    // Text is truncated keeping room to reset the color
+    //
+
+    // Prepare
+    InlineColorWriter<16> writer;
+
+    // Exercise
+    CHECK( writer.set_color( Color::FG_LIGHT_RED ) );
+    CHECK_FALSE( writer.append( "0123456789" ) );
+
+    // Verify
+    CHECK( writer.is_truncated() );
+    STRCMP_EQUAL( "\033[49;1;31m01\033[0m", std::string( writer.finish() ).c_str() );
+    CHECK_EQUAL( 16u, writer.size() );
+
+    //////////////////////////////////////////////////////////////////////////
+    // Escape sequences are not split
+    //
+
+    // Exercise
+    writer.clear();
+    CHECK( writer.append( "0123" ) );
+    CHECK_FALSE( writer.set_color( Color::FG_LIGHT_RED ) );
+
+    // Verify
+    CHECK( writer.is_truncated() );
+    STRCMP_EQUAL( "0123", std::string( writer.finish() ).c_str() );
+
+    //////////////////////////////////////////////////////////////////////////
+    // Numbers and UTF-8 characters are not split
+    //
+
+    // Exercise
+    writer.clear();
+    CHECK( writer.append( "0123456789abcd" ) );
+    CHECK_FALSE( writer.append_integer( 123 ) );
+    CHECK_FALSE( writer.append( "\xE2\x82\xAC" ) );
+    CHECK( writer.append( 'e' ) );
+    CHECK( writer.append( 'f' ) );
+    CHECK_FALSE( writer.append( 'g' ) );
+
+    // Verify
+    STRCMP_EQUAL( "0123456789abcdef", std::string( writer.finish() ).c_str() );
+}
+
+TEST( ColorConsoleWriter, WriteRaw )
+{
+    // Prepare
+    ColorConsole::Console* out = new ColorConsole::Console( &outBuffer, true );
+    InlineColorWriter<64> writer( out->uses_ansi_coloring() );
+    writer << Color::FG_YELLOW << "W" << Color::RESET << " raw";
+
+    // Exercise
+    out->write_raw( writer.finish() );
+
+    // Verify
+    STRCMP_EQUAL( "\033[49;1;33mW\033[0m raw", readFromStringBuf(outBuffer).c_str() );
+    CHECK( out->good() );
+    CHECK_EQUAL( static_cast<int>( Color::RESET ), static_cast<int>( out->get_color() ) );
+
+    // Cleanup
+    delete out;
+}
@@ -3,6 +3,9 @@ if( NOT MSVC )
     set( CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -Wall" )
 endif()
 
+set( CMAKE_CXX_STANDARD 20 )
+set( CMAKE_CXX_STANDARD_REQUIRED ON )
+
 set( CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DUNIT_TEST" )
 set( CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DUNIT_TEST" )
 
@@ -13,11 +13,16 @@
 
 std::string readFromStringBuf( std::stringbuf& buf )
 {
-    char tmpNarrowBuf[100] = "\0";
+    std::string text;
+    char tmpNarrowBuf[100];
 
-    std::streamsize n = buf.sgetn( tmpNarrowBuf, 100 );
-    tmpNarrowBuf[n] = '\0';
-    return std::string( tmpNarrowBuf );
+    std::streamsize n;
+    while( ( n = buf.sgetn( tmpNarrowBuf, sizeof( tmpNarrowBuf ) ) ) > 0 )
+    {
+        text.append( tmpNarrowBuf, static_cast<std::size_t>( n ) );
+    }
+
+    return text;
 }
 
 static std::string wideToNarrow( const wchar_t *t )
@@ -31,9 +36,14 @@ static std::string wideToNarrow( const wchar_t *t )
 
 std::string readFromStringBuf( std::wstringbuf& buf )
 {
-    wchar_t tmpWideBuf[100] = L"\0";
+    std::wstring text;
+    wchar_t tmpWideBuf[100];
+
+    std::streamsize n;
+    while( ( n = buf.sgetn( tmpWideBuf, sizeof( tmpWideBuf ) / sizeof( wchar_t ) ) ) > 0 )
+    {
+        text.append( tmpWideBuf, static_cast<std::size_t>( n ) );
+    }
 
-    std::streamsize n = buf.sgetn( tmpWideBuf, 100 );
-    tmpWideBuf[n] = L'\0';
-    return wideToNarrow( tmpWideBuf );
+    return wideToNarrow( text.c_str() );
 }
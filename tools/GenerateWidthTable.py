@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+#
+# Generates lib/sources/ColorConsoleWidthTable.hpp, the table of the display width and grapheme cluster
+# properties of the Unicode code points, from the Unicode Character Database bundled with Python
+# (unicodedata) and the Extended_Pictographic ranges of emoji-data.txt listed below.
+#
+# Usage: tools/GenerateWidthTable.py > lib/sources/ColorConsoleWidthTable.hpp
+#
+
+import sys
+import unicodedata
+
+# Properties (shall match the WidthProperty enumeration of ColorConsoleWidth.cpp)
+OTHER, WIDE, CONTROL, EXTEND, EXTEND_WIDE, ZWJ, SPACING_MARK, REGIONAL_INDICATOR, PICTOGRAPHIC, \
+    PICTOGRAPHIC_WIDE, HANGUL_L, HANGUL_V, HANGUL_T, HANGUL_SYLLABLE = range( 14 )
+
+PROPERTY_NAMES = [ 'OTHER', 'WIDE', 'CONTROL', 'EXTEND', 'EXTEND_WIDE', 'ZWJ', 'SPACING_MARK', 'REGIONAL_INDICATOR',
+                   'PICTOGRAPHIC', 'PICTOGRAPHIC_WIDE', 'HANGUL_L', 'HANGUL_V', 'HANGUL_T', 'HANGUL_SYLLABLE' ]
+
+# Extended_Pictographic code points (emoji-data.txt)
+EXTENDED_PICTOGRAPHIC = [
+    (0x00A9, 0x00A9), (0x00AE, 0x00AE), (0x203C, 0x203C), (0x2049, 0x2049), (0x2122, 0x2122), (0x2139, 0x2139),
+    (0x2194, 0x2199), (0x21A9, 0x21AA), (0x231A, 0x231B), (0x2328, 0x2328), (0x2388, 0x2388), (0x23CF, 0x23CF),
+    (0x23E9, 0x23F3), (0x23F8, 0x23FA), (0x24C2, 0x24C2), (0x25AA, 0x25AB), (0x25B6, 0x25B6), (0x25C0, 0x25C0),
+    (0x25FB, 0x25FE), (0x2600, 0x2605), (0x2607, 0x2612), (0x2614, 0x2685), (0x2690, 0x2705), (0x2708, 0x2712),
+    (0x2714, 0x2714), (0x2716, 0x2716), (0x271D, 0x271D), (0x2721, 0x2721), (0x2728, 0x2728), (0x2733, 0x2734),
+    (0x2744, 0x2744), (0x2747, 0x2747), (0x274C, 0x274C), (0x274E, 0x274E), (0x2753, 0x2755), (0x2757, 0x2757),
+    (0x2763, 0x2767), (0x2795, 0x2797), (0x27A1, 0x27A1), (0x27B0, 0x27B0), (0x27BF, 0x27BF), (0x2934, 0x2935),
+    (0x2B05, 0x2B07), (0x2B1B, 0x2B1C), (0x2B50, 0x2B50), (0x2B55, 0x2B55), (0x3030, 0x3030), (0x303D, 0x303D),
+    (0x3297, 0x3297), (0x3299, 0x3299), (0x1F000, 0x1F0FF), (0x1F10D, 0x1F10F), (0x1F12F, 0x1F12F),
+    (0x1F16C, 0x1F171), (0x1F17E, 0x1F17F), (0x1F18E, 0x1F18E), (0x1F191, 0x1F19A), (0x1F1AD, 0x1F1E5),
+    (0x1F201, 0x1F20F), (0x1F21A, 0x1F21A), (0x1F22F, 0x1F22F), (0x1F232, 0x1F23A), (0x1F23C, 0x1F23F),
+    (0x1F249, 0x1F3FA), (0x1F400, 0x1F53D), (0x1F546, 0x1F64F), (0x1F680, 0x1F6FF), (0x1F774, 0x1F77F),
+    (0x1F7D5, 0x1F7FF), (0x1F80C, 0x1F80F), (0x1F848, 0x1F84F), (0x1F85A, 0x1F85F), (0x1F888, 0x1F88F),
+    (0x1F8AE, 0x1F8FF), (0x1F90C, 0x1F93A), (0x1F93C, 0x1F945), (0x1F947, 0x1FAFF), (0x1FC00, 0x1FFFD)
+]
+
+# Blocks where unassigned code points are wide by default (EastAsianWidth.txt)
+WIDE_BLOCKS = [ (0x3400, 0x4DBF), (0x4E00, 0x9FFF), (0xF900, 0xFAFF), (0x20000, 0x2FFFD), (0x30000, 0x3FFFD) ]
+
+def in_ranges( cp, ranges ):
+    return any( first <= cp <= last for first, last in ranges )
+
+def is_wide( cp, category ):
+    if category == 'Cn':
+        return in_ranges( cp, WIDE_BLOCKS )
+    return unicodedata.east_asian_width( chr( cp ) ) in ( 'W', 'F' )
+
+def property_of( cp ):
+    category = unicodedata.category( chr( cp ) )
+
+    if cp == 0x200D:
+        return ZWJ
+    if 0x1F3FB <= cp <= 0x1F3FF:
+        return EXTEND_WIDE              # Emoji modifiers (skin tones)
+    if cp == 0x200C or category in ( 'Mn', 'Me' ) or 0xE0020 <= cp <= 0xE007F:
+        return EXTEND
+    if cp < 0x20 or 0x7F <= cp < 0xA0 or category in ( 'Cc', 'Zl', 'Zp' ) or ( category == 'Cf' and cp != 0x00AD ):
+        return CONTROL
+    if category == 'Cn' and ( 0xD7B0 <= cp <= 0xD7FF or 0xE0000 <= cp <= 0xE0FFF ):
+        return CONTROL                  # Default ignorable
+    if 0x1F1E6 <= cp <= 0x1F1FF:
+        return REGIONAL_INDICATOR
+    if category == 'Mc':
+        return SPACING_MARK
+    if 0x1100 <= cp <= 0x115F or 0xA960 <= cp <= 0xA97C:
+        return HANGUL_L
+    if 0x1160 <= cp <= 0x11A7 or 0xD7B0 <= cp <= 0xD7C6:
+        return HANGUL_V
+    if 0x11A8 <= cp <= 0x11FF or 0xD7CB <= cp <= 0xD7FB:
+        return HANGUL_T
+    if 0xAC00 <= cp <= 0xD7A3:
+        return HANGUL_SYLLABLE
+    if in_ranges( cp, EXTENDED_PICTOGRAPHIC ):
+        return PICTOGRAPHIC_WIDE if is_wide( cp, category ) else PICTOGRAPHIC
+    return WIDE if is_wide( cp, category ) else OTHER
+
+def build_tables( values, index_bits, leaf_bits ):
+    leaves = {}
+    blocks = {}
+    index1 = []
+    for i in range( 0, len( values ), 1 << ( index_bits + leaf_bits ) ):
+        block = []
+        for j in range( i, i + ( 1 << ( index_bits + leaf_bits ) ), 1 << leaf_bits ):
+            block.append( leaves.setdefault( tuple( values[j:j + ( 1 << leaf_bits )] ), len( leaves ) ) )
+        index1.append( blocks.setdefault( tuple( block ), len( blocks ) ) )
+    return index1, list( blocks ), list( leaves )
+
+def table_size( index1, blocks, leaves ):
+    return len( index1 ) * ( 1 if len( blocks ) <= 256 else 2 ) + \
+           sum( len( b ) for b in blocks ) * ( 1 if len( leaves ) <= 256 else 2 ) + \
+           sum( len( l ) for l in leaves ) // 2
+
+def write_array( out, ctype, name, values, per_line = 24 ):
+    out.write( 'inline constexpr %s %s[%d] =\n{\n' % ( ctype, name, len( values ) ) )
+    for i in range( 0, len( values ), per_line ):
+        out.write( '    ' + ', '.join( str( v ) for v in values[i:i + per_line] ) + ',\n' )
+    out.write( '};\n\n' )
+
+def main():
+    values = [ property_of( cp ) for cp in range( 0x110000 ) ]
+
+    best = None
+    for index_bits in range( 2, 9 ):
+        for leaf_bits in range( 3, 9 ):
+            tables = build_tables( values, index_bits, leaf_bits )
+            size = table_size( *tables )
+            if best is None or size < best[0]:
+                best = ( size, index_bits, leaf_bits, tables )
+
+    size, index_bits, leaf_bits, ( index1, blocks, leaves ) = best
+
+    out = sys.stdout
+    out.write( '''/**
+ * @file
+ * @brief      Display width and grapheme cluster properties of the Unicode code points
+ * @project    ColorConsoleLib
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2020 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ *
+ * Generated by tools/GenerateWidthTable.py from Unicode %s. Do not edit.
+ */
+
+#ifndef COLORCONSOLEWIDTHTABLE_HPP_
+#define COLORCONSOLEWIDTHTABLE_HPP_
+
+#include <cstdint>
+
+namespace ColorConsole
+{
+
+/**
+ * Three-level table (%d bytes) of the properties of the code points (4 bits each): the code point bits above
+ * WIDTH_TABLE_SHIFT1 index WIDTH_TABLE_INDEX1, which selects a block of WIDTH_TABLE_INDEX2, which selects a
+ * leaf of WIDTH_TABLE_LEAVES (2 properties per byte, the first one in the low nibble).
+ */
+inline constexpr unsigned int WIDTH_TABLE_SHIFT1 = %d;
+inline constexpr unsigned int WIDTH_TABLE_SHIFT2 = %d;
+
+''' % ( unicodedata.unidata_version, size, index_bits + leaf_bits, leaf_bits ) )
+
+    names = [ '%d = %s' % ( i, n ) for i, n in enumerate( PROPERTY_NAMES ) ]
+    for i in range( 0, len( names ), 5 ):
+        out.write( '// %s%s\n' % ( 'Properties: ' if i == 0 else '            ', ', '.join( names[i:i + 5] ) ) )
+    out.write( '\n' )
+
+    write_array( out, 'std::uint8_t' if len( blocks ) <= 256 else 'std::uint16_t', 'WIDTH_TABLE_INDEX1', index1 )
+    write_array( out, 'std::uint8_t' if len( leaves ) <= 256 else 'std::uint16_t', 'WIDTH_TABLE_INDEX2',
+                 [ leaf for block in blocks for leaf in block ] )
+    packed = []
+    for leaf in leaves:
+        for i in range( 0, len( leaf ), 2 ):
+            packed.append( leaf[i] | ( leaf[i + 1] << 4 ) )
+    write_array( out, 'std::uint8_t', 'WIDTH_TABLE_LEAVES', packed )
+
+    out.write( '} // namespace\n\n#endif // header guard\n' )
+
+if __name__ == '__main__':
+    main()